@@ -0,0 +1,387 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#define _POSIX_C_SOURCE 200112
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "ceed-auto.h"
+
+//------------------------------------------------------------------------------
+// Wall clock time
+//------------------------------------------------------------------------------
+static double CeedOperatorGetTime_Auto(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9*ts.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+// Destroy Candidate Operators, except the selected one
+//------------------------------------------------------------------------------
+static int CeedOperatorDestroyShadows_Auto(CeedInt numcandidates,
+    CeedInt numfields, CeedOperator_Auto *impl) {
+  int ierr;
+
+  for (CeedInt c=0; c<numcandidates; c++) {
+    if (c == impl->winner)
+      continue;
+    ierr = CeedOperatorDestroy(&impl->shadows[c]); CeedChk(ierr);
+    for (CeedInt i=0; i<numfields; i++) {
+      ierr = CeedBasisDestroy(&impl->bases[c*numfields + i]); CeedChk(ierr);
+    }
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Setup Candidate Operators
+//   Each candidate operator shares the restrictions, vectors, and QFunction of
+//   the operator; tensor product bases are recreated on the candidate backend
+//   so that its tensor contractions are used.
+//------------------------------------------------------------------------------
+static int CeedOperatorSetup_Auto(CeedOperator op) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  Ceed_Auto *data;
+  ierr = CeedGetData(ceed, &data); CeedChk(ierr);
+  CeedOperator_Auto *impl;
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  CeedInt numinputfields, numoutputfields, numelements, Q;
+  ierr = CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
+  CeedChk(ierr);
+  ierr = CeedOperatorGetNumElements(op, &numelements); CeedChk(ierr);
+  ierr = CeedOperatorGetNumQuadraturePoints(op, &Q); CeedChk(ierr);
+  CeedOperatorField *opinputfields, *opoutputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, &opoutputfields);
+  CeedChk(ierr);
+  CeedQFunctionField *qfinputfields, *qfoutputfields;
+  ierr = CeedQFunctionGetFields(qf, &qfinputfields, &qfoutputfields);
+  CeedChk(ierr);
+  bool compress, stream;
+  ierr = CeedOperatorGetCompressPassiveFields(op, &compress); CeedChk(ierr);
+  ierr = CeedOperatorGetStreamPassiveFields(op, &stream); CeedChk(ierr);
+  const CeedInt numcandidates = data->numcandidates;
+  const CeedInt numfields = numinputfields + numoutputfields;
+
+  ierr = CeedCalloc(numcandidates, &impl->shadows); CeedChk(ierr);
+  ierr = CeedCalloc(numcandidates*numfields, &impl->bases); CeedChk(ierr);
+  ierr = CeedCalloc(numcandidates, &impl->times); CeedChk(ierr);
+  impl->winner = -1;
+
+  // Key for persisted decisions
+  char *source;
+  ierr = CeedQFunctionGetSourcePath(qf, &source); CeedChk(ierr);
+  size_t len = snprintf(impl->key, sizeof(impl->key), "%s:%d:%d",
+                        source ? source : "", numelements, Q);
+
+  for (CeedInt c=0; c<numcandidates; c++) {
+    ierr = CeedOperatorCreate(data->candidates[c], qf, CEED_QFUNCTION_NONE,
+                              CEED_QFUNCTION_NONE, &impl->shadows[c]);
+    CeedChk(ierr);
+    ierr = CeedOperatorSetCompressPassiveFields(impl->shadows[c], compress);
+    CeedChk(ierr);
+    ierr = CeedOperatorSetStreamPassiveFields(impl->shadows[c], stream);
+    CeedChk(ierr);
+    for (CeedInt i=0; i<numfields; i++) {
+      CeedOperatorField opfield = i < numinputfields ? opinputfields[i] :
+                                  opoutputfields[i-numinputfields];
+      CeedQFunctionField qffield = i < numinputfields ? qfinputfields[i] :
+                                   qfoutputfields[i-numinputfields];
+      char *fieldname;
+      CeedElemRestriction r;
+      CeedBasis basis;
+      CeedVector vec;
+      ierr = CeedQFunctionFieldGetName(qffield, &fieldname); CeedChk(ierr);
+      ierr = CeedOperatorFieldGetElemRestriction(opfield, &r); CeedChk(ierr);
+      ierr = CeedOperatorFieldGetBasis(opfield, &basis); CeedChk(ierr);
+      ierr = CeedOperatorFieldGetVector(opfield, &vec); CeedChk(ierr);
+
+      // Recreate tensor product bases on candidate backend
+      bool istensor = false;
+      if (basis != CEED_BASIS_COLLOCATED) {
+        ierr = CeedBasisIsTensor(basis, &istensor); CeedChk(ierr);
+      }
+      if (istensor) {
+        CeedInt dim, ncomp, P1d, Q1d;
+        const CeedScalar *interp1d, *grad1d, *qref1d, *qweight1d;
+        ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
+        ierr = CeedBasisGetNumComponents(basis, &ncomp); CeedChk(ierr);
+        ierr = CeedBasisGetNumNodes1D(basis, &P1d); CeedChk(ierr);
+        ierr = CeedBasisGetNumQuadraturePoints1D(basis, &Q1d); CeedChk(ierr);
+        ierr = CeedBasisGetInterp1D(basis, &interp1d); CeedChk(ierr);
+        ierr = CeedBasisGetGrad1D(basis, &grad1d); CeedChk(ierr);
+        ierr = CeedBasisGetQRef(basis, &qref1d); CeedChk(ierr);
+        ierr = CeedBasisGetQWeights(basis, &qweight1d); CeedChk(ierr);
+        ierr = CeedBasisCreateTensorH1(data->candidates[c], dim, ncomp, P1d, Q1d,
+                                       interp1d, grad1d, qref1d, qweight1d,
+                                       &impl->bases[c*numfields + i]);
+        CeedChk(ierr);
+        basis = impl->bases[c*numfields + i];
+        if (c == 0 && len < sizeof(impl->key))
+          len += snprintf(&impl->key[len], sizeof(impl->key) - len,
+                          ":%d,%d,%d,%d", dim, ncomp, P1d, Q1d);
+      }
+      ierr = CeedOperatorSetField(impl->shadows[c], fieldname, r, basis, vec);
+      CeedChk(ierr);
+    }
+  }
+
+  // Previously persisted decision
+  FILE *file = data->tuningfile ? fopen(data->tuningfile, "r") : NULL;
+  if (file) {
+    char line[sizeof(impl->key) + CEED_MAX_RESOURCE_LEN + 2];
+    while (impl->winner < 0 && fgets(line, sizeof(line), file)) {
+      char *resource = strchr(line, '\t');
+      if (!resource)
+        continue;
+      *resource++ = '\0';
+      resource[strcspn(resource, "\n")] = '\0';
+      if (strcmp(line, impl->key))
+        continue;
+      for (CeedInt c=0; c<numcandidates; c++) {
+        const char *candidate;
+        ierr = CeedGetResource(data->candidates[c], &candidate); CeedChk(ierr);
+        if (!strcmp(candidate, resource))
+          impl->winner = c;
+      }
+    }
+    fclose(file);
+  }
+  if (impl->winner >= 0) {
+    CeedDebug("Auto backend: %s reusing persisted decision", impl->key);
+    ierr = CeedOperatorDestroyShadows_Auto(numcandidates, numfields, impl);
+    CeedChk(ierr);
+  }
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Select Fastest Candidate
+//------------------------------------------------------------------------------
+static int CeedOperatorSelect_Auto(CeedOperator op) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  Ceed_Auto *data;
+  ierr = CeedGetData(ceed, &data); CeedChk(ierr);
+  CeedOperator_Auto *impl;
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+  CeedInt numargs;
+  ierr = CeedOperatorGetNumArgs(op, &numargs); CeedChk(ierr);
+  const char *resource;
+
+  impl->winner = 0;
+  for (CeedInt c=1; c<data->numcandidates; c++)
+    if (impl->times[c] < impl->times[impl->winner])
+      impl->winner = c;
+  ierr = CeedGetResource(data->candidates[impl->winner], &resource);
+  CeedChk(ierr);
+
+  // Log
+  for (CeedInt c=0; c<data->numcandidates; c++) {
+    const char *candidate;
+    ierr = CeedGetResource(data->candidates[c], &candidate); CeedChk(ierr);
+    CeedDebug("Auto backend: %s %s %g s", impl->key, candidate, impl->times[c]);
+  }
+  CeedDebug("Auto backend: %s selected %s", impl->key, resource);
+
+  // Persist
+  FILE *file = data->tuningfile ? fopen(data->tuningfile, "a") : NULL;
+  if (file) {
+    fprintf(file, "%s\t%s\n", impl->key, resource);
+    fclose(file);
+  }
+
+  ierr = CeedOperatorDestroyShadows_Auto(data->numcandidates, numargs, impl);
+  CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Performance Counters
+//   Counters of the parent operator accumulate the counts of its candidates
+//------------------------------------------------------------------------------
+static int CeedOperatorPerfBegin_Auto(CeedPerf perf, CeedOperator shadow,
+                                      CeedPerfCounters *before) {
+  int ierr;
+
+  ierr = CeedOperatorSetPerfCounters(shadow, !!perf); CeedChk(ierr);
+  if (perf)
+    for (CeedInt p=0; p<CEED_PERF_QFUNCTION+1; p++) {
+      ierr = CeedOperatorGetPerfCounters(shadow, p, &before[p]); CeedChk(ierr);
+    }
+  return 0;
+}
+
+static int CeedOperatorPerfEnd_Auto(CeedPerf perf, CeedOperator shadow,
+                                    const CeedPerfCounters *before) {
+  int ierr;
+  CeedPerfCounters after;
+
+  if (!perf)
+    return 0;
+  for (CeedInt p=0; p<CEED_PERF_QFUNCTION+1; p++) {
+    ierr = CeedOperatorGetPerfCounters(shadow, p, &after); CeedChk(ierr);
+    after.calls -= before[p].calls;
+    after.time -= before[p].time;
+    after.cycles -= after.cycles < 0 ? 0 : before[p].cycles;
+    after.instructions -= after.instructions < 0 ? 0 : before[p].instructions;
+    after.llcmisses -= after.llcmisses < 0 ? 0 : before[p].llcmisses;
+    after.fpops -= after.fpops < 0 ? 0 : before[p].fpops;
+    ierr = CeedPerfAddCounters(perf, p, &after); CeedChk(ierr);
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Operator Apply
+//------------------------------------------------------------------------------
+static int CeedOperatorApplyAdd_Auto(CeedOperator op, CeedVector invec,
+                                     CeedVector outvec, CeedRequest *request) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  Ceed_Auto *data;
+  ierr = CeedGetData(ceed, &data); CeedChk(ierr);
+  CeedOperator_Auto *impl;
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+  CeedPerf perf;
+  ierr = CeedOperatorGetPerf(op, &perf); CeedChk(ierr);
+  CeedPerfCounters before[CEED_PERF_QFUNCTION+1];
+
+  // Setup
+  if (!impl->shadows) {
+    ierr = CeedOperatorSetup_Auto(op); CeedChk(ierr);
+    ierr = CeedOperatorSetSetupDone(op); CeedChk(ierr);
+  }
+
+  // Apply selected candidate
+  if (impl->winner >= 0) {
+    CeedOperator shadow = impl->shadows[impl->winner];
+    ierr = CeedOperatorPerfBegin_Auto(perf, shadow, before); CeedChk(ierr);
+    ierr = CeedOperatorApplyAdd(shadow, invec, outvec, request); CeedChk(ierr);
+    ierr = CeedOperatorPerfEnd_Auto(perf, shadow, before); CeedChk(ierr);
+    return 0;
+  }
+
+  // Time candidates in turn; the first application of each includes setup
+  const CeedInt c = impl->numapplies % data->numcandidates;
+  const CeedInt trial = impl->numapplies / data->numcandidates;
+  ierr = CeedOperatorPerfBegin_Auto(perf, impl->shadows[c], before);
+  CeedChk(ierr);
+  double time = CeedOperatorGetTime_Auto();
+  ierr = CeedOperatorApplyAdd(impl->shadows[c], invec, outvec, request);
+  CeedChk(ierr);
+  time = CeedOperatorGetTime_Auto() - time;
+  ierr = CeedOperatorPerfEnd_Auto(perf, impl->shadows[c], before);
+  CeedChk(ierr);
+  if (trial == 1 || (trial > 1 && time < impl->times[c]))
+    impl->times[c] = time;
+  impl->numapplies++;
+
+  if (impl->numapplies == (CEED_AUTO_NUM_TRIALS + 1)*data->numcandidates) {
+    ierr = CeedOperatorSelect_Auto(op); CeedChk(ierr);
+  }
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Operator Apply Batch
+//   Batched applications are not timed; they use the selected candidate, or
+//   the preferred candidate while tuning.
+//------------------------------------------------------------------------------
+static int CeedOperatorApplyAddBatch_Auto(CeedOperator op, CeedInt nbatch,
+    CeedVector invec, CeedVector outvec, CeedRequest *request) {
+  int ierr;
+  CeedOperator_Auto *impl;
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+
+  // Setup
+  if (!impl->shadows) {
+    ierr = CeedOperatorSetup_Auto(op); CeedChk(ierr);
+    ierr = CeedOperatorSetSetupDone(op); CeedChk(ierr);
+  }
+
+  CeedPerf perf;
+  ierr = CeedOperatorGetPerf(op, &perf); CeedChk(ierr);
+  CeedPerfCounters before[CEED_PERF_QFUNCTION+1];
+  CeedOperator shadow = impl->shadows[impl->winner >= 0 ? impl->winner : 0];
+  ierr = CeedOperatorPerfBegin_Auto(perf, shadow, before); CeedChk(ierr);
+  ierr = CeedOperatorApplyAddBatch(shadow, nbatch, invec, outvec, request);
+  CeedChk(ierr);
+  ierr = CeedOperatorPerfEnd_Auto(perf, shadow, before); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Operator Destroy
+//------------------------------------------------------------------------------
+static int CeedOperatorDestroy_Auto(CeedOperator op) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  Ceed_Auto *data;
+  ierr = CeedGetData(ceed, &data); CeedChk(ierr);
+  CeedOperator_Auto *impl;
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+  CeedInt numargs;
+  ierr = CeedOperatorGetNumArgs(op, &numargs); CeedChk(ierr);
+
+  if (impl->shadows) {
+    for (CeedInt c=0; c<data->numcandidates; c++) {
+      ierr = CeedOperatorDestroy(&impl->shadows[c]); CeedChk(ierr);
+      for (CeedInt i=0; i<numargs; i++) {
+        ierr = CeedBasisDestroy(&impl->bases[c*numargs + i]); CeedChk(ierr);
+      }
+    }
+  }
+  ierr = CeedFree(&impl->shadows); CeedChk(ierr);
+  ierr = CeedFree(&impl->bases); CeedChk(ierr);
+  ierr = CeedFree(&impl->times); CeedChk(ierr);
+  ierr = CeedFree(&impl); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Operator Create
+//------------------------------------------------------------------------------
+int CeedOperatorCreate_Auto(CeedOperator op) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  CeedOperator_Auto *impl;
+
+  ierr = CeedCalloc(1, &impl); CeedChk(ierr);
+  ierr = CeedOperatorSetData(op, impl); CeedChk(ierr);
+
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "ApplyAdd",
+                                CeedOperatorApplyAdd_Auto); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "ApplyAddBatch",
+                                CeedOperatorApplyAddBatch_Auto); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "Destroy",
+                                CeedOperatorDestroy_Auto); CeedChk(ierr);
+  return 0;
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,95 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <stdlib.h>
+#include <string.h>
+#include "ceed-auto.h"
+
+// Candidate backends, in order of preference in case of ties
+static const char *const candidates[] = {
+  "/cpu/self/xsmm/blocked", "/cpu/self/xsmm/serial",
+  "/cpu/self/avx/blocked", "/cpu/self/avx/serial",
+  "/cpu/self/opt/blocked", "/cpu/self/opt/serial",
+  "/cpu/self/ref/blocked", "/cpu/self/ref/serial",
+};
+
+//------------------------------------------------------------------------------
+// Backend Destroy
+//------------------------------------------------------------------------------
+static int CeedDestroy_Auto(Ceed ceed) {
+  int ierr;
+  Ceed_Auto *data;
+  ierr = CeedGetData(ceed, &data); CeedChk(ierr);
+
+  for (CeedInt i=0; i<data->numcandidates; i++) {
+    ierr = CeedDestroy(&data->candidates[i]); CeedChk(ierr);
+  }
+  ierr = CeedFree(&data->candidates); CeedChk(ierr);
+  ierr = CeedFree(&data); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Backend Init
+//------------------------------------------------------------------------------
+static int CeedInit_Auto(const char *resource, Ceed ceed) {
+  int ierr;
+  if (strcmp(resource, "/cpu/self/auto"))
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "Auto backend cannot use resource: %s", resource);
+  // LCOV_EXCL_STOP
+  ierr = CeedSetDeterministic(ceed, true); CeedChk(ierr);
+
+  // Create reference CEED that implementation will be dispatched
+  //   through unless overridden
+  Ceed ceedref;
+  CeedInit("/cpu/self/ref/serial", &ceedref);
+  ierr = CeedSetDelegate(ceed, ceedref); CeedChk(ierr);
+
+  ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "Destroy",
+                                CeedDestroy_Auto); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "OperatorCreate",
+                                CeedOperatorCreate_Auto); CeedChk(ierr);
+
+  // Candidate backends that are available in this build
+  Ceed_Auto *data;
+  ierr = CeedCalloc(1, &data); CeedChk(ierr);
+  const CeedInt numcandidates = sizeof(candidates) / sizeof(candidates[0]);
+  ierr = CeedCalloc(numcandidates, &data->candidates); CeedChk(ierr);
+  for (CeedInt i=0; i<numcandidates; i++) {
+    bool isregistered;
+    ierr = CeedIsRegistered(candidates[i], &isregistered); CeedChk(ierr);
+    if (isregistered) {
+      ierr = CeedInit(candidates[i], &data->candidates[data->numcandidates]);
+      CeedChk(ierr);
+      data->numcandidates++;
+    }
+  }
+  data->tuningfile = getenv("CEED_AUTO_TUNING_FILE");
+  ierr = CeedSetData(ceed, data); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Backend Register
+//------------------------------------------------------------------------------
+__attribute__((constructor))
+static void Register(void) {
+  CeedRegister("/cpu/self/auto", CeedInit_Auto, 90);
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,39 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <ceed-backend.h>
+#include <string.h>
+
+// Number of timed applications of each candidate backend, after one warm-up
+//   application that includes backend setup
+#define CEED_AUTO_NUM_TRIALS 2
+
+typedef struct {
+  CeedInt numcandidates;
+  Ceed *candidates;      /// Ceed contexts of candidate backends
+  const char *tuningfile; /// File to persist decisions, if any
+} Ceed_Auto;
+
+typedef struct {
+  CeedOperator *shadows; /// Operator on each candidate backend
+  CeedBasis *bases;      /// Bases on each candidate backend, per field
+  double *times;         /// Best time of each candidate
+  CeedInt numapplies;    /// Number of applications while tuning
+  CeedInt winner;        /// Selected candidate, or -1 while tuning
+  char key[1024];        /// Description of operator for persisted decisions
+} CeedOperator_Auto;
+
+CEED_INTERN int CeedOperatorCreate_Auto(CeedOperator op);
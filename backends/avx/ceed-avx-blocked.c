@@ -21,8 +21,19 @@
 //------------------------------------------------------------------------------
 static int CeedInit_Avx(const char *resource, Ceed ceed) {
   int ierr;
-  if (strcmp(resource, "/cpu/self") && strcmp(resource, "/cpu/self/avx")
-      && strcmp(resource, "/cpu/self/avx/blocked"))
+  // Block size, optionally given as /cpu/self/avx/blocked/[blksize], is
+  //   passed on to the opt backend
+  const char *blkprefix = "/cpu/self/avx/blocked/";
+  char optresource[64] = "/cpu/self/opt/blocked";
+  if (!strncmp(resource, blkprefix, strlen(blkprefix))) {
+    if (strlen(resource) - strlen(blkprefix) > 8)
+      // LCOV_EXCL_START
+      return CeedError(ceed, 1, "AVX backend cannot use resource: %s",
+                       resource);
+    // LCOV_EXCL_STOP
+    strcat(optresource, &resource[strlen(blkprefix)-1]);
+  } else if (strcmp(resource, "/cpu/self") && strcmp(resource, "/cpu/self/avx")
+             && strcmp(resource, "/cpu/self/avx/blocked"))
     // LCOV_EXCL_START
     return CeedError(ceed, 1, "AVX backend cannot use resource: %s", resource);
   // LCOV_EXCL_STOP
@@ -31,7 +42,7 @@ static int CeedInit_Avx(const char *resource, Ceed ceed) {
   // Create reference CEED that implementation will be dispatched
   //   through unless overridden
   Ceed ceedref;
-  CeedInit("/cpu/self/opt/blocked", &ceedref);
+  ierr = CeedInit(optresource, &ceedref); CeedChk(ierr);
   ierr = CeedSetDelegate(ceed, ceedref); CeedChk(ierr);
 
   ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "TensorContractCreate",
@@ -234,6 +234,55 @@ static inline int CeedTensorContract_Avx_Single(CeedTensorContract contract,
   return 0;
 }
 
+//------------------------------------------------------------------------------
+// Serial Tensor Contract Small C
+//   For 1 < C < CC, the columns are too few to fill a vector, so rows are
+//   vectorized over J instead, with one register per column
+//------------------------------------------------------------------------------
+static inline int CeedTensorContract_Avx_SmallC(CeedTensorContract contract,
+    CeedInt A, CeedInt B, CeedInt C, CeedInt J, const CeedScalar *restrict t,
+    CeedTransposeMode tmode, const CeedInt Add, const CeedScalar *restrict u,
+    CeedScalar *restrict v, const CeedInt CC) {
+  CeedInt tstride0 = B, tstride1 = 1;
+  if (tmode == CEED_TRANSPOSE) {
+    tstride0 = 1; tstride1 = J;
+  }
+
+  for (CeedInt a=0; a<A; a++) {
+    // Blocks of 4 rows, the last block padded with zero rows
+    for (CeedInt j=0; j<J; j+=4) {
+      const CeedInt JJ = CeedIntMin(4, J-j);
+      __m256d vv[CC]; // Output tile to be held in registers
+      for (CeedInt c=0; c<C; c++)
+        vv[c] = _mm256_setzero_pd();
+
+      for (CeedInt b=0; b<B; b++) {
+        __m256d tqv;
+        if (JJ == 4) {
+          tqv = _mm256_set_pd(t[(j+3)*tstride0 + b*tstride1],
+                              t[(j+2)*tstride0 + b*tstride1],
+                              t[(j+1)*tstride0 + b*tstride1],
+                              t[(j+0)*tstride0 + b*tstride1]);
+        } else {
+          CeedScalar tq[4] = {0.0, 0.0, 0.0, 0.0};
+          for (CeedInt jj=0; jj<JJ; jj++)
+            tq[jj] = t[(j+jj)*tstride0 + b*tstride1];
+          tqv = _mm256_loadu_pd(tq);
+        }
+        for (CeedInt c=0; c<C; c++) // unroll
+          fmadd(vv[c], tqv, _mm256_set1_pd(u[(a*B+b)*C+c]));
+      }
+      for (CeedInt c=0; c<C; c++) {
+        CeedScalar vq[4];
+        _mm256_storeu_pd(vq, vv[c]);
+        for (CeedInt jj=0; jj<JJ; jj++)
+          v[(a*J+j+jj)*C+c] += vq[jj];
+      }
+    }
+  }
+  return 0;
+}
+
 //------------------------------------------------------------------------------
 // Tensor Contract - Common Sizes
 //------------------------------------------------------------------------------
@@ -244,6 +293,13 @@ static int CeedTensorContract_Avx_Blocked_4_8(CeedTensorContract contract,
   return CeedTensorContract_Avx_Blocked(contract, A, B, C, J, t, tmode, Add, u,
                                         v, 4, 8);
 }
+static int CeedTensorContract_Avx_Blocked_4_4(CeedTensorContract contract,
+    CeedInt A, CeedInt B, CeedInt C, CeedInt J, const CeedScalar *restrict t,
+    CeedTransposeMode tmode, const CeedInt Add, const CeedScalar *restrict u,
+    CeedScalar *restrict v) {
+  return CeedTensorContract_Avx_Blocked(contract, A, B, C, J, t, tmode, Add, u,
+                                        v, 4, 4);
+}
 static int CeedTensorContract_Avx_Remainder_8_8(CeedTensorContract contract,
     CeedInt A, CeedInt B, CeedInt C, CeedInt J, const CeedScalar *restrict t,
     CeedTransposeMode tmode, const CeedInt Add, const CeedScalar *restrict u,
@@ -258,6 +314,13 @@ static int CeedTensorContract_Avx_Single_4_8(CeedTensorContract contract,
   return CeedTensorContract_Avx_Single(contract, A, B, C, J, t, tmode, Add, u,
                                        v, 4, 8);
 }
+static int CeedTensorContract_Avx_SmallC_8(CeedTensorContract contract,
+    CeedInt A, CeedInt B, CeedInt C, CeedInt J, const CeedScalar *restrict t,
+    CeedTransposeMode tmode, const CeedInt Add, const CeedScalar *restrict u,
+    CeedScalar *restrict v) {
+  return CeedTensorContract_Avx_SmallC(contract, A, B, C, J, t, tmode, Add, u,
+                                       v, 8);
+}
 
 //------------------------------------------------------------------------------
 // Tensor Contract Apply
@@ -279,6 +342,14 @@ static int CeedTensorContractApply_Avx(CeedTensorContract contract, CeedInt A,
     // Serial C=1 Case
     CeedTensorContract_Avx_Single_4_8(contract, A, B, C, J, t, tmode, true, u,
                                       v);
+  } else if (C == 4) {
+    // Blocks of 4 elements
+    CeedTensorContract_Avx_Blocked_4_4(contract, A, B, C, J, t, tmode, true,
+                                       u, v);
+  } else if (C < blksize) {
+    // Serial small C Case
+    CeedTensorContract_Avx_SmallC_8(contract, A, B, C, J, t, tmode, true, u,
+                                    v);
   } else {
     // Blocks of 8 columns
     if (C >= blksize)
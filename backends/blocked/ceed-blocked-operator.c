@@ -73,17 +73,49 @@ static int CeedOperatorSetupFields_Blocked(CeedQFunction qf,
         ierr = CeedElemRestrictionGetOffsets(r, CEED_MEM_HOST, &offsets);
         CeedChk(ierr);
         ierr = CeedElemRestrictionGetCompStride(r, &compstride); CeedChk(ierr);
-        ierr = CeedElemRestrictionCreateBlocked(ceed, nelem, elemsize,
-                                                blksize, ncomp, compstride,
-                                                lsize, CEED_MEM_HOST,
-                                                CEED_COPY_VALUES, offsets,
-                                                &blkrestr[i+starte]);
+        CeedInt gsize;
+        ierr = CeedElemRestrictionGetGhostSize(r, &gsize); CeedChk(ierr);
+        ierr = CeedElemRestrictionCreateBlockedGhosted(ceed, nelem, elemsize,
+               blksize, ncomp, compstride, lsize, gsize, CEED_MEM_HOST,
+               CEED_COPY_VALUES, offsets, &blkrestr[i+starte]);
         CeedChk(ierr);
         ierr = CeedElemRestrictionRestoreOffsets(r, &offsets); CeedChk(ierr);
+        if (gsize) {
+          // Ghost vectors are shared with the user restriction
+          CeedVector ghostin, ghostout;
+          ierr = CeedElemRestrictionGetGhostVectors(r, &ghostin, &ghostout);
+          CeedChk(ierr);
+          ierr = CeedElemRestrictionSetGhostVectors(blkrestr[i+starte], ghostin,
+                 ghostout); CeedChk(ierr);
+        }
+      }
+      CeedVector vec;
+      ierr = CeedOperatorFieldGetVector(opfields[i], &vec); CeedChk(ierr);
+      bool isconstant;
+      ierr = CeedElemRestrictionIsConstant(r, &isconstant); CeedChk(ierr);
+      if (!inOrOut && vec != CEED_VECTOR_ACTIVE && emode == CEED_EVAL_NONE &&
+          isconstant) {
+        // Constant passive inputs are broadcast into the Q-vector and need no
+        //   E-vector
+      } else if (!inOrOut && vec != CEED_VECTOR_ACTIVE) {
+        // Passive inputs share E-vectors with other operators
+        ierr = CeedGetCachedEVector(ceed, r, blksize, vec, blkrestr[i+starte],
+                                    &fullevecs[i+starte]); CeedChk(ierr);
+        // Restrict now, so CeedOperatorSetupAll() also takes this out of the
+        //   first application; vectors holding a batch are left for apply
+        CeedInt length;
+        ierr = CeedVectorGetLength(vec, &length); CeedChk(ierr);
+        if (length == lsize) {
+          ierr = CeedUpdateCachedEVector(ceed, blkrestr[i+starte], vec,
+                                         fullevecs[i+starte],
+                                         CEED_REQUEST_IMMEDIATE);
+          CeedChk(ierr);
+        }
+      } else {
+        ierr = CeedElemRestrictionCreateVector(blkrestr[i+starte], NULL,
+                                               &fullevecs[i+starte]);
+        CeedChk(ierr);
       }
-      ierr = CeedElemRestrictionCreateVector(blkrestr[i+starte], NULL,
-                                             &fullevecs[i+starte]);
-      CeedChk(ierr);
     }
 
     switch(emode) {
@@ -124,6 +156,48 @@ static int CeedOperatorSetupFields_Blocked(CeedQFunction qf,
   return 0;
 }
 
+//------------------------------------------------------------------------------
+// Setup Scratch Vectors
+//   Lists the active input and the output E-vectors and the Q-vectors, which
+//   only hold data during an application, so they can share the scratch pool
+//   of the Ceed with other operators. Passive input E-vectors stay cached and
+//   Q-vectors for CEED_EVAL_NONE point into E-vectors.
+//------------------------------------------------------------------------------
+static int CeedOperatorSetupScratch_Blocked(CeedOperator op, CeedQFunction qf,
+    CeedOperator_Blocked *impl) {
+  int ierr;
+  const CeedInt numin = impl->numein, numout = impl->numeout;
+  CeedInt n = 0;
+  CeedOperatorField *opinputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, NULL); CeedChk(ierr);
+  CeedQFunctionField *qfinputfields, *qfoutputfields;
+  ierr = CeedQFunctionGetFields(qf, &qfinputfields, &qfoutputfields);
+  CeedChk(ierr);
+
+  ierr = CeedCalloc(2*(numin + numout), &impl->scratchvecs); CeedChk(ierr);
+  for (CeedInt i=0; i<numin + numout; i++) {
+    const bool isin = i < numin;
+    CeedEvalMode emode;
+    ierr = CeedQFunctionFieldGetEvalMode(isin ? qfinputfields[i] :
+                                         qfoutputfields[i-numin], &emode);
+    CeedChk(ierr);
+    if (emode == CEED_EVAL_WEIGHT)
+      continue;
+    CeedVector vec = CEED_VECTOR_ACTIVE;
+    if (isin) {
+      ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+    }
+    if (vec == CEED_VECTOR_ACTIVE)
+      impl->scratchvecs[n++] = impl->evecs[i];
+    if (emode == CEED_EVAL_INTERP || emode == CEED_EVAL_GRAD)
+      impl->scratchvecs[n++] = isin ? impl->qvecsin[i] :
+                               impl->qvecsout[i-numin];
+  }
+  impl->numscratch = n;
+
+  return 0;
+}
+
 //------------------------------------------------------------------------------
 // Setup Operator
 //------------------------------------------------------------------------------
@@ -158,7 +232,6 @@ static int CeedOperatorSetup_Blocked(CeedOperator op) {
   ierr = CeedCalloc(numinputfields + numoutputfields, &impl->edata);
   CeedChk(ierr);
 
-  ierr = CeedCalloc(16, &impl->inputstate); CeedChk(ierr);
   ierr = CeedCalloc(16, &impl->evecsin); CeedChk(ierr);
   ierr = CeedCalloc(16, &impl->evecsout); CeedChk(ierr);
   ierr = CeedCalloc(16, &impl->qvecsin); CeedChk(ierr);
@@ -198,6 +271,9 @@ static int CeedOperatorSetup_Blocked(CeedOperator op) {
     }
   }
 
+  // Scratch vectors
+  ierr = CeedOperatorSetupScratch_Blocked(op, qf, impl); CeedChk(ierr);
+
   ierr = CeedOperatorSetSetupDone(op); CeedChk(ierr);
 
   return 0;
@@ -213,7 +289,6 @@ static inline int CeedOperatorSetupInputs_Blocked(CeedInt numinputfields,
   CeedInt ierr;
   CeedEvalMode emode;
   CeedVector vec;
-  uint64_t state;
 
   for (CeedInt i=0; i<numinputfields; i++) {
     // Get input vector
@@ -229,13 +304,23 @@ static inline int CeedOperatorSetupInputs_Blocked(CeedInt numinputfields,
     CeedChk(ierr);
     if (emode == CEED_EVAL_WEIGHT) { // Skip
     } else {
-      // Restrict
-      ierr = CeedVectorGetState(vec, &state); CeedChk(ierr);
-      if (state != impl->inputstate[i] || vec == invec) {
+      // Restrict active input; passive inputs are only restricted when
+      //   changed, sharing the E-vector with other operators
+      if (!impl->evecs[i]) {
+        // Constant input, broadcast into the Q-vector
+        ierr = CeedElemRestrictionApplyConstant(impl->blkrestr[i], 8, vec,
+                                                impl->qvecsin[i]); CeedChk(ierr);
+        continue;
+      } else if (vec == invec) {
         ierr = CeedElemRestrictionApply(impl->blkrestr[i], CEED_NOTRANSPOSE,
                                         vec, impl->evecs[i], request);
         CeedChk(ierr);
-        impl->inputstate[i] = state;
+      } else {
+        Ceed ceed;
+        ierr = CeedElemRestrictionGetCeed(impl->blkrestr[i], &ceed);
+        CeedChk(ierr);
+        ierr = CeedUpdateCachedEVector(ceed, impl->blkrestr[i], vec,
+                                       impl->evecs[i], request); CeedChk(ierr);
       }
       // Get evec
       ierr = CeedVectorGetArrayRead(impl->evecs[i], CEED_MEM_HOST,
@@ -279,6 +364,8 @@ static inline int CeedOperatorInputBasis_Blocked(CeedInt e, CeedInt Q,
     // Basis action
     switch(emode) {
     case CEED_EVAL_NONE:
+      if (!impl->evecs[i]) // Constant input, already broadcast
+        break;
       ierr = CeedVectorSetArray(impl->qvecsin[i], CEED_MEM_HOST,
                                 CEED_USE_POINTER,
                                 &impl->edata[i][e*Q*size]); CeedChk(ierr);
@@ -408,7 +495,7 @@ static inline int CeedOperatorRestoreInputs_Blocked(CeedInt numinputfields,
     }
     ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
     CeedChk(ierr);
-    if (emode == CEED_EVAL_WEIGHT) { // Skip
+    if (emode == CEED_EVAL_WEIGHT || !impl->evecs[i]) { // Skip
     } else {
       ierr = CeedVectorRestoreArrayRead(impl->evecs[i],
                                         (const CeedScalar **) &impl->edata[i]);
@@ -419,11 +506,13 @@ static inline int CeedOperatorRestoreInputs_Blocked(CeedInt numinputfields,
 }
 
 //------------------------------------------------------------------------------
-// Operator Apply
+// Operator Apply Core
+//   With dot non-NULL, also computes the inner product of the active input
+//   E-vector with the active output E-vectors, which share its restriction,
+//   skipping the padding elements of the last block.
 //------------------------------------------------------------------------------
-static int CeedOperatorApplyAdd_Blocked(CeedOperator op, CeedVector invec,
-                                        CeedVector outvec,
-                                        CeedRequest *request) {
+static int CeedOperatorApplyAddCore_Blocked(CeedOperator op, CeedVector invec,
+    CeedVector outvec, CeedScalar *dot, CeedRequest *request) {
   int ierr;
   CeedOperator_Blocked *impl;
   ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
@@ -444,14 +533,23 @@ static int CeedOperatorApplyAdd_Blocked(CeedOperator op, CeedVector invec,
   CeedChk(ierr);
   CeedEvalMode emode;
   CeedVector vec;
+  CeedPerf perf;
+  ierr = CeedOperatorGetPerf(op, &perf); CeedChk(ierr);
 
   // Setup
   ierr = CeedOperatorSetup_Blocked(op); CeedChk(ierr);
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  CeedScalar *scratch;
+  ierr = CeedGetScratchVectors(ceed, impl->numscratch, impl->scratchvecs,
+                               &scratch); CeedChk(ierr);
 
   // Input Evecs and Restriction
+  CeedPerfStart(perf, CEED_PERF_RESTRICTION);
   ierr = CeedOperatorSetupInputs_Blocked(numinputfields, qfinputfields,
                                          opinputfields, invec, false, impl,
                                          request); CeedChk(ierr);
+  CeedPerfStop(perf, CEED_PERF_RESTRICTION);
 
   // Output Evecs
   for (CeedInt i=0; i<numoutputfields; i++) {
@@ -476,21 +574,56 @@ static int CeedOperatorApplyAdd_Blocked(CeedOperator op, CeedVector invec,
     }
 
     // Input basis apply
+    CeedPerfStart(perf, CEED_PERF_BASIS);
     ierr = CeedOperatorInputBasis_Blocked(e, Q, qfinputfields, opinputfields,
                                           numinputfields, blksize, false, impl);
     CeedChk(ierr);
+    CeedPerfStop(perf, CEED_PERF_BASIS);
 
     // Q function
     if (!impl->identityqf) {
+      CeedPerfStart(perf, CEED_PERF_QFUNCTION);
       ierr = CeedQFunctionApply(qf, Q*blksize, impl->qvecsin, impl->qvecsout);
       CeedChk(ierr);
+      CeedPerfStop(perf, CEED_PERF_QFUNCTION);
     }
 
     // Output basis apply
+    CeedPerfStart(perf, CEED_PERF_BASIS);
     ierr = CeedOperatorOutputBasis_Blocked(e, Q, qfoutputfields, opoutputfields,
                                            blksize, numinputfields,
                                            numoutputfields, op, impl);
     CeedChk(ierr);
+    CeedPerfStop(perf, CEED_PERF_BASIS);
+  }
+
+  // Inner product of active input and output E-vectors
+  if (dot) {
+    CeedInt activein = -1, length;
+    for (CeedInt i=0; i<numinputfields && activein < 0; i++) {
+      ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+      if (vec == CEED_VECTOR_ACTIVE)
+        activein = i;
+    }
+    ierr = CeedVectorGetLength(impl->evecs[activein], &length); CeedChk(ierr);
+    const CeedInt nnodes = length / (nblks*blksize);
+    const CeedScalar *ein = impl->edata[activein];
+    CeedScalar sum = 0;
+    for (CeedInt i=0; i<numoutputfields; i++) {
+      ierr = CeedOperatorFieldGetVector(opoutputfields[i], &vec); CeedChk(ierr);
+      if (vec != CEED_VECTOR_ACTIVE)
+        continue;
+      const CeedScalar *eout = impl->edata[i + numinputfields];
+      for (CeedInt b=0; b<nblks; b++) {
+        const CeedInt nlanes = CeedIntMin(blksize, numelements - b*blksize);
+        for (CeedInt k=0; k<nnodes; k++)
+          for (CeedInt j=0; j<nlanes; j++) {
+            const CeedInt idx = (b*nnodes + k)*blksize + j;
+            sum += ein[idx] * eout[idx];
+          }
+      }
+    }
+    *dot = sum;
   }
 
   // Output restriction
@@ -504,19 +637,40 @@ static int CeedOperatorApplyAdd_Blocked(CeedOperator op, CeedVector invec,
     if (vec == CEED_VECTOR_ACTIVE)
       vec = outvec;
     // Restrict
+    CeedPerfStart(perf, CEED_PERF_RESTRICTION);
     ierr = CeedElemRestrictionApply(impl->blkrestr[i+impl->numein],
                                     CEED_TRANSPOSE, impl->evecs[i+impl->numein],
                                     vec, request); CeedChk(ierr);
-
+    CeedPerfStop(perf, CEED_PERF_RESTRICTION);
   }
 
   // Restore input arrays
   ierr = CeedOperatorRestoreInputs_Blocked(numinputfields, qfinputfields,
          opinputfields, false, impl); CeedChk(ierr);
 
+  ierr = CeedRestoreScratchVectors(ceed, impl->numscratch, impl->scratchvecs,
+                                   &scratch); CeedChk(ierr);
+
   return 0;
 }
 
+//------------------------------------------------------------------------------
+// Operator Apply
+//------------------------------------------------------------------------------
+static int CeedOperatorApplyAdd_Blocked(CeedOperator op, CeedVector invec,
+                                        CeedVector outvec,
+                                        CeedRequest *request) {
+  return CeedOperatorApplyAddCore_Blocked(op, invec, outvec, NULL, request);
+}
+
+//------------------------------------------------------------------------------
+// Operator Apply with Inner Product
+//------------------------------------------------------------------------------
+static int CeedOperatorApplyAddDot_Blocked(CeedOperator op, CeedVector invec,
+    CeedVector outvec, CeedScalar *dot, CeedRequest *request) {
+  return CeedOperatorApplyAddCore_Blocked(op, invec, outvec, dot, request);
+}
+
 //------------------------------------------------------------------------------
 // Assemble Linear QFunction
 //------------------------------------------------------------------------------
@@ -555,6 +709,9 @@ static int CeedOperatorLinearAssembleQFunction_Blocked(CeedOperator op,
     // LCOV_EXCL_START
     return CeedError(ceed, 1, "Assembling identity qfunctions not supported");
   // LCOV_EXCL_STOP
+  CeedScalar *scratch;
+  ierr = CeedGetScratchVectors(ceed, impl->numscratch, impl->scratchvecs,
+                               &scratch); CeedChk(ierr);
 
   // Input Evecs and Restriction
   ierr = CeedOperatorSetupInputs_Blocked(numinputfields, qfinputfields,
@@ -667,6 +824,8 @@ static int CeedOperatorLinearAssembleQFunction_Blocked(CeedOperator op,
   // Restore input arrays
   ierr = CeedOperatorRestoreInputs_Blocked(numinputfields, qfinputfields,
          opinputfields, true, impl); CeedChk(ierr);
+  ierr = CeedRestoreScratchVectors(ceed, impl->numscratch, impl->scratchvecs,
+                                   &scratch); CeedChk(ierr);
 
   // Output blocked restriction
   ierr = CeedVectorRestoreArray(lvec, &a); CeedChk(ierr);
@@ -696,15 +855,27 @@ static int CeedOperatorDestroy_Blocked(CeedOperator op) {
   int ierr;
   CeedOperator_Blocked *impl;
   ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+  CeedOperatorField *opinputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, NULL); CeedChk(ierr);
 
   for (CeedInt i=0; i<impl->numein+impl->numeout; i++) {
+    CeedVector vec = CEED_VECTOR_ACTIVE;
+    if (i < impl->numein) {
+      ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+    }
+    if (vec != CEED_VECTOR_ACTIVE && impl->evecs[i]) {
+      Ceed ceed;
+      ierr = CeedElemRestrictionGetCeed(impl->blkrestr[i], &ceed);
+      CeedChk(ierr);
+      ierr = CeedRestoreCachedEVector(ceed, &impl->evecs[i]); CeedChk(ierr);
+    } else {
+      ierr = CeedVectorDestroy(&impl->evecs[i]); CeedChk(ierr);
+    }
     ierr = CeedElemRestrictionDestroy(&impl->blkrestr[i]); CeedChk(ierr);
-    ierr = CeedVectorDestroy(&impl->evecs[i]); CeedChk(ierr);
   }
   ierr = CeedFree(&impl->blkrestr); CeedChk(ierr);
   ierr = CeedFree(&impl->evecs); CeedChk(ierr);
   ierr = CeedFree(&impl->edata); CeedChk(ierr);
-  ierr = CeedFree(&impl->inputstate); CeedChk(ierr);
 
   for (CeedInt i=0; i<impl->numein; i++) {
     ierr = CeedVectorDestroy(&impl->evecsin[i]); CeedChk(ierr);
@@ -719,6 +890,7 @@ static int CeedOperatorDestroy_Blocked(CeedOperator op) {
   }
   ierr = CeedFree(&impl->evecsout); CeedChk(ierr);
   ierr = CeedFree(&impl->qvecsout); CeedChk(ierr);
+  ierr = CeedFree(&impl->scratchvecs); CeedChk(ierr);
 
   ierr = CeedFree(&impl); CeedChk(ierr);
   return 0;
@@ -741,6 +913,10 @@ int CeedOperatorCreate_Blocked(CeedOperator op) {
   CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "Operator", op, "ApplyAdd",
                                 CeedOperatorApplyAdd_Blocked); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "ApplyAddDot",
+                                CeedOperatorApplyAddDot_Blocked); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "Setup",
+                                CeedOperatorSetup_Blocked); CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "Operator", op, "Destroy",
                                 CeedOperatorDestroy_Blocked); CeedChk(ierr);
   return 0;
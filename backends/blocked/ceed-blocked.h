@@ -27,13 +27,15 @@ typedef struct {
   CeedVector
   *evecs;   /// E-vectors needed to apply operator (input followed by outputs)
   CeedScalar **edata;
-  uint64_t *inputstate;  /// State counter of inputs
   CeedVector *evecsin;   /// Input E-vectors needed to apply operator
   CeedVector *evecsout;  /// Output E-vectors needed to apply operator
   CeedVector *qvecsin;   /// Input Q-vectors needed to apply operator
   CeedVector *qvecsout;  /// Output Q-vectors needed to apply operator
   CeedInt    numein;
   CeedInt    numeout;
+  CeedVector *scratchvecs; /// Vectors backed by the scratch pool of the Ceed
+  ///                           while the operator is applied
+  CeedInt    numscratch;
 } CeedOperator_Blocked;
 
 CEED_INTERN int CeedOperatorCreate_Blocked(CeedOperator op);
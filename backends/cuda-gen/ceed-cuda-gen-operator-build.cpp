@@ -799,6 +799,7 @@ extern "C" int CeedCudaGenOperatorBuild(CeedOperator op) {
 
   code << "\n#define CEED_QFUNCTION(name) inline __device__ int name\n";
   code << "\n#define CeedPragmaSIMD\n";
+  code << "\n#define CeedAssumeAligned(ptr) (ptr)\n";
 
   // Find dim and Q1d
   bool useCollograd = true;
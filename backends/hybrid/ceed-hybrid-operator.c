@@ -0,0 +1,612 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#define _POSIX_C_SOURCE 200112
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include "ceed-hybrid.h"
+
+//------------------------------------------------------------------------------
+// Wall clock time
+//------------------------------------------------------------------------------
+static double CeedOperatorGetTime_Hybrid(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9*ts.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+// Restriction to the elements [start, start + nelem) of a restriction
+//   Strided restrictions are expressed with offsets, so the elements of a
+//   partition keep their place in the E-vector ordering of the full operator.
+//------------------------------------------------------------------------------
+static int CeedElemRestrictionCreatePart_Hybrid(Ceed ceed,
+    CeedElemRestriction r, CeedInt start, CeedInt nelem,
+    CeedElemRestriction *part) {
+  int ierr;
+  CeedInt elemsize, ncomp, compstride, lsize;
+  ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumComponents(r, &ncomp); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetLVectorSize(r, &lsize); CeedChk(ierr);
+  bool isstrided, isconstant;
+  ierr = CeedElemRestrictionIsStrided(r, &isstrided); CeedChk(ierr);
+  ierr = CeedElemRestrictionIsConstant(r, &isconstant); CeedChk(ierr);
+  if (isconstant) {
+    // Constant restrictions stay constant, with no offsets
+    CeedInt strides[3];
+    ierr = CeedElemRestrictionGetStrides(r, &strides); CeedChk(ierr);
+    ierr = CeedElemRestrictionCreateStrided(ceed, nelem, elemsize, ncomp, lsize,
+                                            strides, part); CeedChk(ierr);
+    return 0;
+  }
+  CeedInt *offsets;
+  ierr = CeedMalloc(nelem*elemsize, &offsets); CeedChk(ierr);
+
+  if (isstrided) {
+    CeedInt strides[3] = {1, elemsize, elemsize*ncomp};
+    bool backendstrides;
+    ierr = CeedElemRestrictionHasBackendStrides(r, &backendstrides);
+    CeedChk(ierr);
+    if (!backendstrides) {
+      ierr = CeedElemRestrictionGetStrides(r, &strides); CeedChk(ierr);
+    }
+    for (CeedInt e=0; e<nelem; e++)
+      for (CeedInt i=0; i<elemsize; i++)
+        offsets[e*elemsize + i] = i*strides[0] + (start + e)*strides[2];
+    compstride = strides[1];
+  } else {
+    const CeedInt *roffsets;
+    ierr = CeedElemRestrictionGetCompStride(r, &compstride); CeedChk(ierr);
+    ierr = CeedElemRestrictionGetOffsets(r, CEED_MEM_HOST, &roffsets);
+    CeedChk(ierr);
+    for (CeedInt i=0; i<nelem*elemsize; i++)
+      offsets[i] = roffsets[start*elemsize + i];
+    ierr = CeedElemRestrictionRestoreOffsets(r, &roffsets); CeedChk(ierr);
+  }
+  ierr = CeedElemRestrictionCreate(ceed, nelem, elemsize, ncomp, compstride,
+                                   lsize, CEED_MEM_HOST, CEED_OWN_POINTER,
+                                   offsets, part); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Destroy Partition Operators
+//------------------------------------------------------------------------------
+static int CeedOperatorDestroyParts_Hybrid(CeedInt numfields,
+    CeedOperator_Hybrid *impl) {
+  int ierr;
+
+  for (CeedInt p=0; p<2; p++) {
+    ierr = CeedOperatorDestroy(&impl->parts[p]); CeedChk(ierr);
+    ierr = CeedQFunctionDestroy(&impl->qfs[p]); CeedChk(ierr);
+  }
+  if (impl->rstrs)
+    for (CeedInt i=0; i<2*numfields; i++) {
+      ierr = CeedElemRestrictionDestroy(&impl->rstrs[i]); CeedChk(ierr);
+      ierr = CeedBasisDestroy(&impl->bases[i]); CeedChk(ierr);
+    }
+  ierr = CeedFree(&impl->rstrs); CeedChk(ierr);
+  ierr = CeedFree(&impl->bases); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Setup Partition Operators
+//   The first partition holds elements [0, split) and the second the remaining
+//   elements. Each partition has its own restrictions and QFunction copy, so
+//   the two can be applied concurrently; tensor product bases are recreated on
+//   the backend of the partition so that its tensor contractions are used.
+//------------------------------------------------------------------------------
+static int CeedOperatorSetupParts_Hybrid(CeedOperator op, CeedInt split) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  Ceed_Hybrid *data;
+  ierr = CeedGetData(ceed, &data); CeedChk(ierr);
+  CeedOperator_Hybrid *impl;
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  CeedInt numinputfields, numoutputfields, numelements;
+  ierr = CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
+  CeedChk(ierr);
+  ierr = CeedOperatorGetNumElements(op, &numelements); CeedChk(ierr);
+  CeedOperatorField *opinputfields, *opoutputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, &opoutputfields);
+  CeedChk(ierr);
+  CeedQFunctionField *qfinputfields, *qfoutputfields;
+  ierr = CeedQFunctionGetFields(qf, &qfinputfields, &qfoutputfields);
+  CeedChk(ierr);
+  bool compress, stream;
+  ierr = CeedOperatorGetCompressPassiveFields(op, &compress); CeedChk(ierr);
+  ierr = CeedOperatorGetStreamPassiveFields(op, &stream); CeedChk(ierr);
+  const CeedInt numfields = numinputfields + numoutputfields;
+
+  // Whole operator on the first partition when it cannot be split
+  bool isfortran;
+  ierr = CeedQFunctionGetFortranStatus(qf, &isfortran); CeedChk(ierr);
+  impl->single = isfortran || split <= 0 || split >= numelements;
+  impl->serial = false;
+  for (CeedInt i=0; i<numfields; i++) {
+    CeedOperatorField opfield = i < numinputfields ? opinputfields[i] :
+                                opoutputfields[i-numinputfields];
+    CeedElemRestriction r;
+    CeedVector vec;
+    ierr = CeedOperatorFieldGetElemRestriction(opfield, &r); CeedChk(ierr);
+    ierr = CeedOperatorFieldGetVector(opfield, &vec); CeedChk(ierr);
+    if (r != CEED_ELEMRESTRICTION_NONE) {
+      CeedInt gsize;
+      ierr = CeedElemRestrictionGetGhostSize(r, &gsize); CeedChk(ierr);
+      impl->single = impl->single || gsize > 0;
+    }
+    if (i >= numinputfields && vec != CEED_VECTOR_ACTIVE)
+      impl->serial = true;
+  }
+  if (impl->single)
+    split = numelements;
+  impl->split = split;
+  impl->numapplies = 0;
+  impl->times[0] = impl->times[1] = 0;
+
+  ierr = CeedCalloc(2*numfields, &impl->rstrs); CeedChk(ierr);
+  ierr = CeedCalloc(2*numfields, &impl->bases); CeedChk(ierr);
+  for (CeedInt p=0; p<(impl->single ? 1 : 2); p++) {
+    const CeedInt start = p ? split : 0;
+    const CeedInt nelem = p ? numelements - split : split;
+    if (!impl->single) {
+      ierr = CeedQFunctionCreateCopy(qf, data->delegates[p], &impl->qfs[p]);
+      CeedChk(ierr);
+    }
+    ierr = CeedOperatorCreate(data->delegates[p],
+                              impl->single ? qf : impl->qfs[p],
+                              CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                              &impl->parts[p]); CeedChk(ierr);
+    ierr = CeedOperatorSetCompressPassiveFields(impl->parts[p], compress);
+    CeedChk(ierr);
+    ierr = CeedOperatorSetStreamPassiveFields(impl->parts[p], stream);
+    CeedChk(ierr);
+    for (CeedInt i=0; i<numfields; i++) {
+      CeedOperatorField opfield = i < numinputfields ? opinputfields[i] :
+                                  opoutputfields[i-numinputfields];
+      CeedQFunctionField qffield = i < numinputfields ? qfinputfields[i] :
+                                   qfoutputfields[i-numinputfields];
+      char *fieldname;
+      CeedElemRestriction r;
+      CeedBasis basis;
+      CeedVector vec;
+      ierr = CeedQFunctionFieldGetName(qffield, &fieldname); CeedChk(ierr);
+      ierr = CeedOperatorFieldGetElemRestriction(opfield, &r); CeedChk(ierr);
+      ierr = CeedOperatorFieldGetBasis(opfield, &basis); CeedChk(ierr);
+      ierr = CeedOperatorFieldGetVector(opfield, &vec); CeedChk(ierr);
+
+      // Restriction to the elements of the partition, shared by fields that
+      //   share a restriction
+      if (r != CEED_ELEMRESTRICTION_NONE && !impl->single) {
+        CeedInt j = 0;
+        for (; j<i; j++) {
+          CeedElemRestriction rj;
+          ierr = CeedOperatorFieldGetElemRestriction(j < numinputfields ?
+                 opinputfields[j] : opoutputfields[j-numinputfields], &rj);
+          CeedChk(ierr);
+          if (rj == r && impl->rstrs[p*numfields + j])
+            break;
+        }
+        if (j == i) {
+          ierr = CeedElemRestrictionCreatePart_Hybrid(data->delegates[p], r,
+                 start, nelem, &impl->rstrs[p*numfields + i]); CeedChk(ierr);
+        }
+        r = impl->rstrs[p*numfields + j];
+      }
+
+      // Recreate tensor product bases on partition backend
+      bool istensor = false;
+      if (basis != CEED_BASIS_COLLOCATED) {
+        ierr = CeedBasisIsTensor(basis, &istensor); CeedChk(ierr);
+      }
+      if (istensor) {
+        CeedInt dim, ncomp, P1d, Q1d;
+        const CeedScalar *interp1d, *grad1d, *qref1d, *qweight1d;
+        ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
+        ierr = CeedBasisGetNumComponents(basis, &ncomp); CeedChk(ierr);
+        ierr = CeedBasisGetNumNodes1D(basis, &P1d); CeedChk(ierr);
+        ierr = CeedBasisGetNumQuadraturePoints1D(basis, &Q1d); CeedChk(ierr);
+        ierr = CeedBasisGetInterp1D(basis, &interp1d); CeedChk(ierr);
+        ierr = CeedBasisGetGrad1D(basis, &grad1d); CeedChk(ierr);
+        ierr = CeedBasisGetQRef(basis, &qref1d); CeedChk(ierr);
+        ierr = CeedBasisGetQWeights(basis, &qweight1d); CeedChk(ierr);
+        ierr = CeedBasisCreateTensorH1(data->delegates[p], dim, ncomp, P1d,
+                                       Q1d, interp1d, grad1d, qref1d,
+                                       qweight1d, &impl->bases[p*numfields + i]);
+        CeedChk(ierr);
+        basis = impl->bases[p*numfields + i];
+      }
+      ierr = CeedOperatorSetField(impl->parts[p], fieldname, r, basis, vec);
+      CeedChk(ierr);
+    }
+  }
+  CeedDebug("Hybrid backend: %d elements split %d + %d", numelements, split,
+            numelements - split);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Rebalance Partitions
+//   The split follows the measured throughput of the two partitions, in
+//   multiples of the block size, and is only changed when it moves by more
+//   than the tolerance, since repartitioning repeats the setup.
+//------------------------------------------------------------------------------
+static int CeedOperatorRebalance_Hybrid(CeedOperator op) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  CeedOperator_Hybrid *impl;
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+  CeedInt numelements, numargs;
+  ierr = CeedOperatorGetNumElements(op, &numelements); CeedChk(ierr);
+  ierr = CeedOperatorGetNumArgs(op, &numargs); CeedChk(ierr);
+  const CeedInt blksize = numelements >= 4*CEED_HYBRID_BLOCK ?
+                          CEED_HYBRID_BLOCK : 1;
+
+  // Elements per second of each partition
+  const double rate0 = impl->split / impl->times[0];
+  const double rate1 = (numelements - impl->split) / impl->times[1];
+  if (!(rate0 > 0 && rate1 > 0))
+    return 0;
+  CeedInt split = numelements * rate0 / (rate0 + rate1);
+  split = (split + blksize/2) / blksize * blksize;
+  if (split < blksize)
+    split = blksize;
+  if (split > numelements - blksize)
+    split = (numelements - blksize) / blksize * blksize;
+
+  CeedInt change = abs(split - impl->split);
+  if (change > blksize && change > CEED_HYBRID_TOLERANCE*numelements) {
+    CeedDebug("Hybrid backend: %g, %g elements/s", rate0, rate1);
+    ierr = CeedOperatorDestroyParts_Hybrid(numargs, impl); CeedChk(ierr);
+    ierr = CeedOperatorSetupParts_Hybrid(op, split); CeedChk(ierr);
+  } else {
+    impl->numapplies = 1;
+    impl->times[0] = impl->times[1] = 0;
+  }
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Performance Counters
+//   Counters of the parent operator accumulate the counts of its partitions
+//------------------------------------------------------------------------------
+static int CeedOperatorPerfBegin_Hybrid(CeedPerf perf, CeedOperator part,
+                                        CeedPerfCounters *before) {
+  int ierr;
+
+  ierr = CeedOperatorSetPerfCounters(part, !!perf); CeedChk(ierr);
+  if (perf)
+    for (CeedInt p=0; p<CEED_PERF_QFUNCTION+1; p++) {
+      ierr = CeedOperatorGetPerfCounters(part, p, &before[p]); CeedChk(ierr);
+    }
+  return 0;
+}
+
+static int CeedOperatorPerfEnd_Hybrid(CeedPerf perf, CeedOperator part,
+                                      const CeedPerfCounters *before) {
+  int ierr;
+  CeedPerfCounters after;
+
+  if (!perf)
+    return 0;
+  for (CeedInt p=0; p<CEED_PERF_QFUNCTION+1; p++) {
+    ierr = CeedOperatorGetPerfCounters(part, p, &after); CeedChk(ierr);
+    after.calls -= before[p].calls;
+    after.time -= before[p].time;
+    after.cycles -= after.cycles < 0 ? 0 : before[p].cycles;
+    after.instructions -= after.instructions < 0 ? 0 : before[p].instructions;
+    after.llcmisses -= after.llcmisses < 0 ? 0 : before[p].llcmisses;
+    after.fpops -= after.fpops < 0 ? 0 : before[p].fpops;
+    ierr = CeedPerfAddCounters(perf, p, &after); CeedChk(ierr);
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Partition Application, run on a separate thread
+//------------------------------------------------------------------------------
+typedef struct {
+  CeedOperator op;
+  CeedVector invec, outvec;
+  CeedScalar *dot;
+  double time;
+  int ierr;
+} CeedOperatorPart_Hybrid;
+
+static void *CeedOperatorApplyPart_Hybrid(void *arg) {
+  CeedOperatorPart_Hybrid *part = arg;
+
+  part->time = CeedOperatorGetTime_Hybrid();
+  if (part->dot)
+    part->ierr = CeedOperatorApplyAddWithDot(part->op, part->invec,
+                 part->outvec, part->dot, CEED_REQUEST_IMMEDIATE);
+  else
+    part->ierr = CeedOperatorApplyAdd(part->op, part->invec, part->outvec,
+                                      CEED_REQUEST_IMMEDIATE);
+  part->time = CeedOperatorGetTime_Hybrid() - part->time;
+  return NULL;
+}
+
+//------------------------------------------------------------------------------
+// Operator Setup, with an even split
+//------------------------------------------------------------------------------
+static int CeedOperatorSetup_Hybrid(CeedOperator op) {
+  int ierr;
+  CeedInt numelements;
+  ierr = CeedOperatorGetNumElements(op, &numelements); CeedChk(ierr);
+  const CeedInt blksize = numelements >= 4*CEED_HYBRID_BLOCK ?
+                          CEED_HYBRID_BLOCK : 1;
+
+  CeedInt split = (numelements / 2 + blksize/2) / blksize * blksize;
+  ierr = CeedOperatorSetupParts_Hybrid(op, split); CeedChk(ierr);
+  ierr = CeedOperatorSetSetupDone(op); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Operator Apply Core
+//   With dot non-NULL, each partition also computes the inner product of the
+//   active input with its contribution to the output, and these are summed.
+//------------------------------------------------------------------------------
+static int CeedOperatorApplyAddCore_Hybrid(CeedOperator op, CeedVector invec,
+    CeedVector outvec, CeedScalar *dot, CeedRequest *request) {
+  int ierr;
+  CeedOperator_Hybrid *impl;
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  CeedInt numinputfields, numoutputfields;
+  ierr = CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
+  CeedChk(ierr);
+  CeedOperatorField *opinputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, NULL); CeedChk(ierr);
+
+  CeedPerf perf;
+  ierr = CeedOperatorGetPerf(op, &perf); CeedChk(ierr);
+  CeedPerfCounters before[2][CEED_PERF_QFUNCTION+1];
+
+  // Setup
+  if (!impl->parts[0]) {
+    ierr = CeedOperatorSetup_Hybrid(op); CeedChk(ierr);
+  }
+  if (impl->single) {
+    ierr = CeedOperatorPerfBegin_Hybrid(perf, impl->parts[0], before[0]);
+    CeedChk(ierr);
+    if (dot) {
+      ierr = CeedOperatorApplyAddWithDot(impl->parts[0], invec, outvec, dot,
+                                         request); CeedChk(ierr);
+    } else {
+      ierr = CeedOperatorApplyAdd(impl->parts[0], invec, outvec, request);
+      CeedChk(ierr);
+    }
+    ierr = CeedOperatorPerfEnd_Hybrid(perf, impl->parts[0], before[0]);
+    CeedChk(ierr);
+    return 0;
+  }
+
+  // Point QFunction copies to the current context data
+  CeedQFunctionContext ctx;
+  ierr = CeedQFunctionGetContext(qf, &ctx); CeedChk(ierr);
+  if (ctx) {
+    void *data, *ctxdata;
+    size_t ctxsize;
+    ierr = CeedQFunctionContextGetData(ctx, CEED_MEM_HOST, &data);
+    CeedChk(ierr);
+    ctxdata = data;
+    ierr = CeedQFunctionContextRestoreData(ctx, &data); CeedChk(ierr);
+    ierr = CeedQFunctionContextGetContextSize(ctx, &ctxsize); CeedChk(ierr);
+    if (ctxdata != impl->ctxdata) {
+      for (CeedInt p=0; p<2; p++) {
+        CeedQFunctionContext partctx;
+        ierr = CeedQFunctionGetContext(impl->qfs[p], &partctx); CeedChk(ierr);
+        ierr = CeedQFunctionContextSetData(partctx, CEED_MEM_HOST,
+                                           CEED_USE_POINTER, ctxsize, ctxdata);
+        CeedChk(ierr);
+      }
+      impl->ctxdata = ctxdata;
+    }
+  }
+
+  // Input vectors are read by both partitions, prepare host arrays first
+  for (CeedInt i=0; i<numinputfields; i++) {
+    CeedVector vec;
+    ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+    if (vec == CEED_VECTOR_ACTIVE)
+      vec = invec;
+    if (vec != CEED_VECTOR_NONE) {
+      const CeedScalar *array;
+      ierr = CeedVectorGetArrayRead(vec, CEED_MEM_HOST, &array); CeedChk(ierr);
+      ierr = CeedVectorRestoreArrayRead(vec, &array); CeedChk(ierr);
+    }
+  }
+
+  // Active output of the second partition
+  CeedScalar partdot = 0;
+  CeedOperatorPart_Hybrid part = {impl->parts[1], invec, outvec,
+                                  dot ? &partdot : NULL, 0, 0
+                                 };
+  if (outvec != CEED_VECTOR_NONE && !impl->serial) {
+    CeedInt length, worklength = -1;
+    ierr = CeedVectorGetLength(outvec, &length); CeedChk(ierr);
+    if (impl->work) {
+      ierr = CeedVectorGetLength(impl->work, &worklength); CeedChk(ierr);
+    }
+    if (worklength != length) {
+      Ceed ceed;
+      ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+      ierr = CeedVectorDestroy(&impl->work); CeedChk(ierr);
+      ierr = CeedVectorCreate(ceed, length, &impl->work); CeedChk(ierr);
+    }
+    ierr = CeedVectorSetValue(impl->work, 0.0); CeedChk(ierr);
+    part.outvec = impl->work;
+  }
+
+  // Apply partitions, the second one on a separate thread
+  for (CeedInt p=0; p<2; p++) {
+    ierr = CeedOperatorPerfBegin_Hybrid(perf, impl->parts[p], before[p]);
+    CeedChk(ierr);
+  }
+  pthread_t thread;
+  bool threaded = !impl->serial &&
+                  !pthread_create(&thread, NULL, CeedOperatorApplyPart_Hybrid,
+                                  &part);
+  double time = CeedOperatorGetTime_Hybrid();
+  if (dot) {
+    ierr = CeedOperatorApplyAddWithDot(impl->parts[0], invec, outvec, dot,
+                                       CEED_REQUEST_IMMEDIATE); CeedChk(ierr);
+  } else {
+    ierr = CeedOperatorApplyAdd(impl->parts[0], invec, outvec,
+                                CEED_REQUEST_IMMEDIATE); CeedChk(ierr);
+  }
+  time = CeedOperatorGetTime_Hybrid() - time;
+  if (threaded)
+    pthread_join(thread, NULL);
+  else
+    CeedOperatorApplyPart_Hybrid(&part);
+  CeedChk(part.ierr);
+  if (dot)
+    *dot += partdot;
+  for (CeedInt p=0; p<2; p++) {
+    ierr = CeedOperatorPerfEnd_Hybrid(perf, impl->parts[p], before[p]);
+    CeedChk(ierr);
+  }
+
+  // Sum output of the second partition
+  if (part.outvec != outvec) {
+    CeedInt length;
+    CeedScalar *out;
+    const CeedScalar *work;
+    ierr = CeedVectorGetLength(outvec, &length); CeedChk(ierr);
+    ierr = CeedVectorGetArray(outvec, CEED_MEM_HOST, &out); CeedChk(ierr);
+    ierr = CeedVectorGetArrayRead(impl->work, CEED_MEM_HOST, &work);
+    CeedChk(ierr);
+    for (CeedInt i=0; i<length; i++)
+      out[i] += work[i];
+    ierr = CeedVectorRestoreArray(outvec, &out); CeedChk(ierr);
+    ierr = CeedVectorRestoreArrayRead(impl->work, &work); CeedChk(ierr);
+  }
+
+  // Balance; the first application after partitioning includes setup
+  if (impl->numapplies++ > 0) {
+    impl->times[0] += time;
+    impl->times[1] += part.time;
+  }
+  if (impl->numapplies == CEED_HYBRID_NUM_TRIALS + 1) {
+    ierr = CeedOperatorRebalance_Hybrid(op); CeedChk(ierr);
+  }
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Operator Apply
+//------------------------------------------------------------------------------
+static int CeedOperatorApplyAdd_Hybrid(CeedOperator op, CeedVector invec,
+                                       CeedVector outvec,
+                                       CeedRequest *request) {
+  return CeedOperatorApplyAddCore_Hybrid(op, invec, outvec, NULL, request);
+}
+
+//------------------------------------------------------------------------------
+// Operator Apply with Inner Product
+//------------------------------------------------------------------------------
+static int CeedOperatorApplyAddDot_Hybrid(CeedOperator op, CeedVector invec,
+    CeedVector outvec, CeedScalar *dot, CeedRequest *request) {
+  return CeedOperatorApplyAddCore_Hybrid(op, invec, outvec, dot, request);
+}
+
+//------------------------------------------------------------------------------
+// Operator Apply Batch
+//   Batched applications are not timed; the partitions are applied one after
+//   the other, as the batch members share the field vectors of each partition.
+//------------------------------------------------------------------------------
+static int CeedOperatorApplyAddBatch_Hybrid(CeedOperator op, CeedInt nbatch,
+    CeedVector invec, CeedVector outvec, CeedRequest *request) {
+  int ierr;
+  CeedOperator_Hybrid *impl;
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+  CeedPerf perf;
+  ierr = CeedOperatorGetPerf(op, &perf); CeedChk(ierr);
+  CeedPerfCounters before[CEED_PERF_QFUNCTION+1];
+
+  // Setup
+  if (!impl->parts[0]) {
+    ierr = CeedOperatorSetup_Hybrid(op); CeedChk(ierr);
+  }
+
+  for (CeedInt p=0; p<(impl->single ? 1 : 2); p++) {
+    ierr = CeedOperatorPerfBegin_Hybrid(perf, impl->parts[p], before);
+    CeedChk(ierr);
+    ierr = CeedOperatorApplyAddBatch(impl->parts[p], nbatch, invec, outvec,
+                                     request); CeedChk(ierr);
+    ierr = CeedOperatorPerfEnd_Hybrid(perf, impl->parts[p], before);
+    CeedChk(ierr);
+  }
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Operator Destroy
+//------------------------------------------------------------------------------
+static int CeedOperatorDestroy_Hybrid(CeedOperator op) {
+  int ierr;
+  CeedOperator_Hybrid *impl;
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+  CeedInt numargs;
+  ierr = CeedOperatorGetNumArgs(op, &numargs); CeedChk(ierr);
+
+  ierr = CeedOperatorDestroyParts_Hybrid(numargs, impl); CeedChk(ierr);
+  ierr = CeedVectorDestroy(&impl->work); CeedChk(ierr);
+  ierr = CeedFree(&impl); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Operator Create
+//------------------------------------------------------------------------------
+int CeedOperatorCreate_Hybrid(CeedOperator op) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  CeedOperator_Hybrid *impl;
+
+  ierr = CeedCalloc(1, &impl); CeedChk(ierr);
+  ierr = CeedOperatorSetData(op, impl); CeedChk(ierr);
+
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "ApplyAdd",
+                                CeedOperatorApplyAdd_Hybrid); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "ApplyAddBatch",
+                                CeedOperatorApplyAddBatch_Hybrid); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "ApplyAddDot",
+                                CeedOperatorApplyAddDot_Hybrid); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "Destroy",
+                                CeedOperatorDestroy_Hybrid); CeedChk(ierr);
+  return 0;
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,112 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <stdlib.h>
+#include <string.h>
+#include "ceed-hybrid.h"
+
+// Default partition backends, the first two available are used
+static const char *const defaults[] = {
+  "/cpu/self/avx/blocked", "/cpu/self/opt/blocked", "/cpu/self/ref/blocked",
+};
+
+//------------------------------------------------------------------------------
+// Backend Destroy
+//------------------------------------------------------------------------------
+static int CeedDestroy_Hybrid(Ceed ceed) {
+  int ierr;
+  Ceed_Hybrid *data;
+  ierr = CeedGetData(ceed, &data); CeedChk(ierr);
+
+  for (CeedInt i=0; i<2; i++) {
+    ierr = CeedDestroy(&data->delegates[i]); CeedChk(ierr);
+  }
+  ierr = CeedFree(&data); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Backend Init
+//------------------------------------------------------------------------------
+static int CeedInit_Hybrid(const char *resource, Ceed ceed) {
+  int ierr;
+  if (strcmp(resource, "/cpu/self/hybrid"))
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "Hybrid backend cannot use resource: %s",
+                     resource);
+  // LCOV_EXCL_STOP
+  ierr = CeedSetDeterministic(ceed, true); CeedChk(ierr);
+
+  // Create reference CEED that implementation will be dispatched
+  //   through unless overridden
+  Ceed ceedref;
+  CeedInit("/cpu/self/ref/serial", &ceedref);
+  ierr = CeedSetDelegate(ceed, ceedref); CeedChk(ierr);
+
+  ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "Destroy",
+                                CeedDestroy_Hybrid); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "OperatorCreate",
+                                CeedOperatorCreate_Hybrid); CeedChk(ierr);
+
+  // Partition backends, given as "resource0,resource1" or the defaults
+  Ceed_Hybrid *data;
+  ierr = CeedCalloc(1, &data); CeedChk(ierr);
+  const char *list = getenv("CEED_HYBRID_BACKENDS");
+  CeedInt numdelegates = 0;
+  if (list) {
+    char delegate[CEED_MAX_RESOURCE_LEN];
+    for (CeedInt i=0; i<2; i++) {
+      size_t len = strcspn(list, ",");
+      if (len == 0 || len >= sizeof(delegate))
+        // LCOV_EXCL_START
+        return CeedError(ceed, 1, "Invalid CEED_HYBRID_BACKENDS: %s",
+                         getenv("CEED_HYBRID_BACKENDS"));
+      // LCOV_EXCL_STOP
+      memcpy(delegate, list, len);
+      delegate[len] = '\0';
+      ierr = CeedInit(delegate, &data->delegates[numdelegates++]);
+      CeedChk(ierr);
+      list += len + (list[len] == ',');
+    }
+  } else {
+    const CeedInt numdefaults = sizeof(defaults) / sizeof(defaults[0]);
+    for (CeedInt i=0; i<numdefaults && numdelegates<2; i++) {
+      bool isregistered;
+      ierr = CeedIsRegistered(defaults[i], &isregistered); CeedChk(ierr);
+      if (isregistered) {
+        ierr = CeedInit(defaults[i], &data->delegates[numdelegates++]);
+        CeedChk(ierr);
+      }
+    }
+  }
+  if (numdelegates < 2)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "Hybrid backend requires two backends");
+  // LCOV_EXCL_STOP
+  ierr = CeedSetData(ceed, data); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Backend Register
+//------------------------------------------------------------------------------
+__attribute__((constructor))
+static void Register(void) {
+  CeedRegister("/cpu/self/hybrid", CeedInit_Hybrid, 95);
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,45 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <ceed-backend.h>
+#include <stdbool.h>
+
+// Granularity of the element split, the block size of the blocked backends
+#define CEED_HYBRID_BLOCK 8
+// Number of timed applications between checks of the balance of partitions
+#define CEED_HYBRID_NUM_TRIALS 4
+// Relative change of the split that triggers repartitioning
+#define CEED_HYBRID_TOLERANCE 0.05
+
+typedef struct {
+  Ceed delegates[2];    /// Ceed contexts of the two partitions
+} Ceed_Hybrid;
+
+typedef struct {
+  CeedOperator parts[2];     /// Operator on the elements of each partition
+  CeedQFunction qfs[2];      /// QFunction copy of each partition
+  CeedElemRestriction *rstrs;/// Restrictions of each partition, per field
+  CeedBasis *bases;          /// Bases on each partition backend, per field
+  CeedVector work;           /// Active output of the second partition
+  void *ctxdata;             /// Context data aliased by the QFunction copies
+  CeedInt split;             /// Number of elements of the first partition
+  CeedInt numapplies;        /// Applications since last partitioning
+  double times[2];           /// Accumulated time of each partition
+  bool single;               /// Whole operator on the first partition
+  bool serial;               /// Partitions share passive outputs
+} CeedOperator_Hybrid;
+
+CEED_INTERN int CeedOperatorCreate_Hybrid(CeedOperator op);
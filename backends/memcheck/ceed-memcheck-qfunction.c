@@ -22,8 +22,10 @@
 static int CeedQFunctionApply_Memcheck(CeedQFunction qf, CeedInt Q,
                                        CeedVector *U, CeedVector *V) {
   int ierr;
-  CeedQFunction_Memcheck *impl;
-  ierr = CeedQFunctionGetData(qf, &impl); CeedChk(ierr);
+  // Field pointers live on the stack so concurrent applies of one QFunction
+  //   do not overwrite each other
+  const CeedScalar *inputs[16];
+  CeedScalar *outputs[16];
 
   CeedQFunctionContext ctx;
   ierr = CeedQFunctionGetContext(qf, &ctx); CeedChk(ierr);
@@ -33,31 +35,29 @@ static int CeedQFunctionApply_Memcheck(CeedQFunction qf, CeedInt Q,
     CeedChk(ierr);
   }
 
-  CeedQFunctionUser f = NULL;
-  ierr = CeedQFunctionGetUserFunction(qf, &f); CeedChk(ierr);
-
   CeedInt nIn, nOut;
   ierr = CeedQFunctionGetNumArgs(qf, &nIn, &nOut); CeedChk(ierr);
 
   for (int i = 0; i<nIn; i++) {
-    ierr = CeedVectorGetArrayRead(U[i], CEED_MEM_HOST, &impl->inputs[i]);
+    ierr = CeedVectorGetArrayRead(U[i], CEED_MEM_HOST, &inputs[i]);
     CeedChk(ierr);
   }
   for (int i = 0; i<nOut; i++) {
-    ierr = CeedVectorGetArray(V[i], CEED_MEM_HOST, &impl->outputs[i]);
+    ierr = CeedVectorGetArray(V[i], CEED_MEM_HOST, &outputs[i]);
     CeedChk(ierr);
     CeedInt len;
     ierr = CeedVectorGetLength(V[i], &len); CeedChk(ierr);
-    VALGRIND_MAKE_MEM_UNDEFINED(impl->outputs[i], len);
+    VALGRIND_MAKE_MEM_UNDEFINED(outputs[i], len);
   }
 
-  ierr = f(ctxData, Q, impl->inputs, impl->outputs); CeedChk(ierr);
+  ierr = CeedQFunctionCallUser(qf, ctxData, Q, inputs, outputs);
+  CeedChk(ierr);
 
   for (int i = 0; i<nIn; i++) {
-    ierr = CeedVectorRestoreArrayRead(U[i], &impl->inputs[i]); CeedChk(ierr);
+    ierr = CeedVectorRestoreArrayRead(U[i], &inputs[i]); CeedChk(ierr);
   }
   for (int i = 0; i<nOut; i++) {
-    ierr = CeedVectorRestoreArray(V[i], &impl->outputs[i]); CeedChk(ierr);
+    ierr = CeedVectorRestoreArray(V[i], &outputs[i]); CeedChk(ierr);
   }
   if (ctx) {
     ierr = CeedQFunctionContextRestoreData(ctx, &ctxData); CeedChk(ierr);
@@ -74,8 +74,6 @@ static int CeedQFunctionDestroy_Memcheck(CeedQFunction qf) {
   CeedQFunction_Memcheck *impl;
   ierr = CeedQFunctionGetData(qf, (void *)&impl); CeedChk(ierr);
 
-  ierr = CeedFree(&impl->inputs); CeedChk(ierr);
-  ierr = CeedFree(&impl->outputs); CeedChk(ierr);
   ierr = CeedFree(&impl); CeedChk(ierr);
 
   return 0;
@@ -91,10 +89,11 @@ int CeedQFunctionCreate_Memcheck(CeedQFunction qf) {
 
   CeedQFunction_Memcheck *impl;
   ierr = CeedCalloc(1, &impl); CeedChk(ierr);
-  ierr = CeedCalloc(16, &impl->inputs); CeedChk(ierr);
-  ierr = CeedCalloc(16, &impl->outputs); CeedChk(ierr);
   ierr = CeedQFunctionSetData(qf, impl); CeedChk(ierr);
 
+  // The User Function is called through CeedQFunctionCallUser(), which pads
+  ierr = CeedQFunctionSetPadded(qf, true); CeedChk(ierr);
+
   ierr = CeedSetBackendFunction(ceed, "QFunction", qf, "Apply",
                                 CeedQFunctionApply_Memcheck); CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "QFunction", qf, "Destroy",
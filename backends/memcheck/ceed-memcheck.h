@@ -19,8 +19,6 @@
 #include <valgrind/memcheck.h>
 
 typedef struct {
-  const CeedScalar **inputs;
-  CeedScalar **outputs;
   bool setupdone;
 } CeedQFunction_Memcheck;
 
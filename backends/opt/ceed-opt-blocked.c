@@ -14,6 +14,7 @@
 // software, applications, hardware, advanced system engineering and early
 // testbed platforms, in support of the nation's exascale computing imperative.
 
+#include <stdlib.h>
 #include <string.h>
 #include "ceed-opt.h"
 
@@ -34,8 +35,20 @@ static int CeedDestroy_Opt(Ceed ceed) {
 //------------------------------------------------------------------------------
 static int CeedInit_Opt_Blocked(const char *resource, Ceed ceed) {
   int ierr;
-  if (strcmp(resource, "/cpu/self") && strcmp(resource, "/cpu/self/opt")
-      && strcmp(resource, "/cpu/self/opt/blocked"))
+  // Block size, optionally given as /cpu/self/opt/blocked/[blksize] to match
+  //   SIMD width, e.g. 4, 8, or 16
+  const char *blkprefix = "/cpu/self/opt/blocked/";
+  CeedInt blksize = 8;
+  if (!strncmp(resource, blkprefix, strlen(blkprefix))) {
+    char *end;
+    blksize = strtol(&resource[strlen(blkprefix)], &end, 10);
+    if (*end || blksize < 1 || blksize > CEED_OPT_MAX_BLKSIZE)
+      // LCOV_EXCL_START
+      return CeedError(ceed, 1, "Opt backend cannot use resource: %s",
+                       resource);
+    // LCOV_EXCL_STOP
+  } else if (strcmp(resource, "/cpu/self") && strcmp(resource, "/cpu/self/opt")
+             && strcmp(resource, "/cpu/self/opt/blocked"))
     // LCOV_EXCL_START
     return CeedError(ceed, 1, "Opt backend cannot use resource: %s", resource);
   // LCOV_EXCL_STOP
@@ -55,7 +68,7 @@ static int CeedInit_Opt_Blocked(const char *resource, Ceed ceed) {
   // Set blocksize
   Ceed_Opt *data;
   ierr = CeedCalloc(1, &data); CeedChk(ierr);
-  data->blksize = 8;
+  data->blksize = blksize;
   ierr = CeedSetData(ceed, data); CeedChk(ierr);
 
   return 0;
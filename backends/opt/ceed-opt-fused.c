@@ -0,0 +1,381 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <ceed-backend.h>
+#include <string.h>
+#include "ceed-opt.h"
+
+// Fused kernels apply restriction, tensor basis, gallery QFunction, and
+//   transpose for one block of interlaced elements at a time, with the 1D
+//   basis sizes known at compile time. Element data is stored with the element
+//   within the block as fastest index.
+
+// Number of elements interlaced in a block of the fused kernels
+#define CEED_OPT_FUSED_BLKSIZE 8
+
+// Kernels are only specialized if the sizes are propagated into the loops,
+//   which compilers do not do at low optimization levels without forced
+//   inlining
+#if defined(__GNUC__) || defined(__clang__) || defined(__INTEL_COMPILER)
+#  define CEED_OPT_FUSED_INLINE static inline __attribute__((always_inline))
+#else
+#  define CEED_OPT_FUSED_INLINE static inline
+#endif
+
+//------------------------------------------------------------------------------
+// Blocked Tensor Contract
+//   v[a, j, c] (+)= sum_k t[j, k] u[a, k, c], with t of shape [J, K], or
+//   of shape [K, J] for the transpose
+//------------------------------------------------------------------------------
+CEED_OPT_FUSED_INLINE void CeedFusedContract_Opt(const CeedInt A,
+    const CeedInt J, const CeedInt K, const CeedInt C,
+    const CeedScalar *restrict t, CeedTransposeMode tmode, const bool add,
+    const CeedScalar *restrict u, CeedScalar *restrict v) {
+  const CeedInt L = CEED_OPT_FUSED_BLKSIZE, JJ = 4;
+  const CeedInt tstride0 = tmode == CEED_TRANSPOSE ? 1 : K;
+  const CeedInt tstride1 = tmode == CEED_TRANSPOSE ? J : 1;
+
+  for (CeedInt a=0; a<A; a++)
+    for (CeedInt c=0; c<C; c++) {
+      // Tiles of JJ rows, each input row is loaded once per tile
+      for (CeedInt j=0; j<J; j+=JJ) {
+        CeedScalar vv[JJ][CEED_OPT_FUSED_BLKSIZE];
+        for (CeedInt jj=0; jj<JJ; jj++)
+          CeedPragmaSIMD
+          for (CeedInt l=0; l<L; l++)
+            vv[jj][l] = add && j+jj < J ? v[((a*J+j+jj)*C+c)*L+l] : 0.0;
+        for (CeedInt k=0; k<K; k++) {
+          const CeedScalar *uu = &u[((a*K+k)*C+c)*L];
+          for (CeedInt jj=0; jj<JJ; jj++) {
+            const CeedScalar tt = j+jj < J ? t[(j+jj)*tstride0 + k*tstride1] :
+                                  0.0;
+            CeedPragmaSIMD
+            for (CeedInt l=0; l<L; l++)
+              vv[jj][l] += tt * uu[l];
+          }
+        }
+        for (CeedInt jj=0; jj<CeedIntMin(JJ, J-j); jj++)
+          CeedPragmaSIMD
+          for (CeedInt l=0; l<L; l++)
+            v[((a*J+j+jj)*C+c)*L+l] = vv[jj][l];
+      }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Gather and Scatter
+//   Padding elements repeat the last element and are discarded on scatter
+//------------------------------------------------------------------------------
+CEED_OPT_FUSED_INLINE void CeedFusedGather_Opt(const CeedInt P3,
+    CeedInt e, CeedInt nelem, const CeedInt *offsets,
+    const CeedScalar *restrict u, CeedScalar *restrict ue) {
+  const CeedInt L = CEED_OPT_FUSED_BLKSIZE;
+  for (CeedInt l=0; l<L; l++) {
+    const CeedInt *elemoffsets = &offsets[CeedIntMin(e+l, nelem-1)*P3];
+    for (CeedInt i=0; i<P3; i++)
+      ue[i*L+l] = u[elemoffsets[i]];
+  }
+}
+
+CEED_OPT_FUSED_INLINE void CeedFusedScatter_Opt(const CeedInt P3,
+    CeedInt e, CeedInt nelem, const CeedInt *offsets,
+    const CeedScalar *restrict ve, CeedScalar *restrict v) {
+  const CeedInt L = CEED_OPT_FUSED_BLKSIZE;
+  for (CeedInt l=0; l<CeedIntMin(L, nelem-e); l++) {
+    const CeedInt *elemoffsets = &offsets[(e+l)*P3];
+    for (CeedInt i=0; i<P3; i++)
+      v[elemoffsets[i]] += ve[i*L+l];
+  }
+}
+
+//------------------------------------------------------------------------------
+// Mass 3D
+//   Gallery QFunction MassApply, v = qdata u at each quadrature point
+//------------------------------------------------------------------------------
+CEED_OPT_FUSED_INLINE int CeedOperatorApplyAddFusedMass3D_Opt(
+    const CeedInt P, const CeedInt Q, CeedInt nelem, const CeedInt *offsets,
+    const CeedScalar *B, const CeedScalar *G, const CeedScalar *qd,
+    const CeedInt *qdstrides, const CeedScalar *u, CeedScalar *v) {
+  const CeedInt L = CEED_OPT_FUSED_BLKSIZE;
+  const CeedInt P3 = P*P*P, Q3 = Q*Q*Q;
+  CeedScalar ue[P3*L], t1[P*P*Q*L], t2[P*Q*Q*L], uq[Q3*L];
+
+  for (CeedInt e=0; e<nelem; e+=L) {
+    CeedFusedGather_Opt(P3, e, nelem, offsets, u, ue);
+
+    // Interpolate, fastest dimension first
+    CeedFusedContract_Opt(P*P, Q, P, 1, B, CEED_NOTRANSPOSE, false, ue, t1);
+    CeedFusedContract_Opt(P, Q, P, Q, B, CEED_NOTRANSPOSE, false, t1, t2);
+    CeedFusedContract_Opt(1, Q, P, Q*Q, B, CEED_NOTRANSPOSE, false, t2, uq);
+
+    // QFunction
+    for (CeedInt l=0; l<L; l++) {
+      const CeedScalar *elemqd = &qd[CeedIntMin(e+l, nelem-1)*qdstrides[2]];
+      for (CeedInt i=0; i<Q3; i++)
+        uq[i*L+l] *= elemqd[i*qdstrides[0]];
+    }
+
+    // Interpolate transpose
+    CeedFusedContract_Opt(Q*Q, P, Q, 1, B, CEED_TRANSPOSE, false, uq, t2);
+    CeedFusedContract_Opt(Q, P, Q, P, B, CEED_TRANSPOSE, false, t2, t1);
+    CeedFusedContract_Opt(1, P, Q, P*P, B, CEED_TRANSPOSE, false, t1, ue);
+
+    CeedFusedScatter_Opt(P3, e, nelem, offsets, ue, v);
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Poisson 3D
+//   Gallery QFunction Poisson3DApply, dv = qdata du at each quadrature point,
+//   with qdata the symmetric 3x3 matrix in Voigt notation
+//------------------------------------------------------------------------------
+CEED_OPT_FUSED_INLINE int CeedOperatorApplyAddFusedPoisson3D_Opt(
+    const CeedInt P, const CeedInt Q, CeedInt nelem, const CeedInt *offsets,
+    const CeedScalar *B, const CeedScalar *G, const CeedScalar *qd,
+    const CeedInt *qdstrides, const CeedScalar *u, CeedScalar *v) {
+  const CeedInt L = CEED_OPT_FUSED_BLKSIZE;
+  const CeedInt P3 = P*P*P, Q3 = Q*Q*Q;
+  CeedScalar ue[P3*L], x[P*P*Q*L], y[P*P*Q*L], p[P*Q*Q*L], q[P*Q*Q*L],
+             r[P*Q*Q*L], du[3][Q3*L];
+
+  for (CeedInt e=0; e<nelem; e+=L) {
+    CeedFusedGather_Opt(P3, e, nelem, offsets, u, ue);
+
+    // Gradient, derivative d uses G in contraction d, fastest dimension first
+    CeedFusedContract_Opt(P*P, Q, P, 1, B, CEED_NOTRANSPOSE, false, ue, x);
+    CeedFusedContract_Opt(P*P, Q, P, 1, G, CEED_NOTRANSPOSE, false, ue, y);
+    CeedFusedContract_Opt(P, Q, P, Q, B, CEED_NOTRANSPOSE, false, y, p);
+    CeedFusedContract_Opt(P, Q, P, Q, G, CEED_NOTRANSPOSE, false, x, q);
+    CeedFusedContract_Opt(P, Q, P, Q, B, CEED_NOTRANSPOSE, false, x, r);
+    CeedFusedContract_Opt(1, Q, P, Q*Q, B, CEED_NOTRANSPOSE, false, p, du[0]);
+    CeedFusedContract_Opt(1, Q, P, Q*Q, B, CEED_NOTRANSPOSE, false, q, du[1]);
+    CeedFusedContract_Opt(1, Q, P, Q*Q, G, CEED_NOTRANSPOSE, false, r, du[2]);
+
+    // QFunction
+    for (CeedInt l=0; l<L; l++) {
+      const CeedScalar *elemqd = &qd[CeedIntMin(e+l, nelem-1)*qdstrides[2]];
+      for (CeedInt i=0; i<Q3; i++) {
+        const CeedScalar *pt = &elemqd[i*qdstrides[0]];
+        const CeedInt s = qdstrides[1];
+        const CeedScalar du0 = du[0][i*L+l], du1 = du[1][i*L+l],
+                         du2 = du[2][i*L+l];
+        du[0][i*L+l] = du0*pt[0*s] + du1*pt[5*s] + du2*pt[4*s];
+        du[1][i*L+l] = du0*pt[5*s] + du1*pt[1*s] + du2*pt[3*s];
+        du[2][i*L+l] = du0*pt[4*s] + du1*pt[3*s] + du2*pt[2*s];
+      }
+    }
+
+    // Gradient transpose, slowest dimension first to share contractions
+    CeedFusedContract_Opt(1, P, Q, Q*Q, B, CEED_TRANSPOSE, false, du[0], p);
+    CeedFusedContract_Opt(1, P, Q, Q*Q, B, CEED_TRANSPOSE, false, du[1], q);
+    CeedFusedContract_Opt(1, P, Q, Q*Q, G, CEED_TRANSPOSE, false, du[2], r);
+    CeedFusedContract_Opt(P, P, Q, Q, B, CEED_TRANSPOSE, false, p, x);
+    CeedFusedContract_Opt(P, P, Q, Q, G, CEED_TRANSPOSE, false, q, y);
+    CeedFusedContract_Opt(P, P, Q, Q, B, CEED_TRANSPOSE, true, r, y);
+    CeedFusedContract_Opt(P*P, P, Q, 1, G, CEED_TRANSPOSE, false, x, ue);
+    CeedFusedContract_Opt(P*P, P, Q, 1, B, CEED_TRANSPOSE, true, y, ue);
+
+    CeedFusedScatter_Opt(P3, e, nelem, offsets, ue, v);
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Specialized Kernels
+//------------------------------------------------------------------------------
+#define CEED_OPT_FUSED_KERNELS(P, Q)                                           \
+static int CeedOperatorApplyAddFusedMass3D_Opt_##P##_##Q(CeedInt nelem,        \
+    const CeedInt *offsets, const CeedScalar *B, const CeedScalar *G,          \
+    const CeedScalar *qd, const CeedInt *qdstrides, const CeedScalar *u,       \
+    CeedScalar *v) {                                                           \
+  return CeedOperatorApplyAddFusedMass3D_Opt(P, Q, nelem, offsets, B, G, qd,   \
+         qdstrides, u, v);                                                     \
+}                                                                              \
+static int CeedOperatorApplyAddFusedPoisson3D_Opt_##P##_##Q(CeedInt nelem,     \
+    const CeedInt *offsets, const CeedScalar *B, const CeedScalar *G,          \
+    const CeedScalar *qd, const CeedInt *qdstrides, const CeedScalar *u,       \
+    CeedScalar *v) {                                                           \
+  return CeedOperatorApplyAddFusedPoisson3D_Opt(P, Q, nelem, offsets, B, G,    \
+         qd, qdstrides, u, v);                                                 \
+}
+
+// Supported (P1d, Q1d), Q1d = P1d, P1d + 1, or P1d + 2
+#define CEED_OPT_FUSED_SIZES(X)                                                \
+  X(2, 2) X(2, 3) X(2, 4) X(3, 3) X(3, 4) X(3, 5) X(4, 4) X(4, 5) X(4, 6)      \
+  X(5, 5) X(5, 6) X(5, 7) X(6, 6) X(6, 7) X(6, 8) X(7, 7) X(7, 8) X(7, 9)      \
+  X(8, 8) X(8, 9) X(8, 10)
+
+CEED_OPT_FUSED_SIZES(CEED_OPT_FUSED_KERNELS)
+
+#define CEED_OPT_FUSED_SELECT(P, Q)                                            \
+  case 100*P + Q:                                                              \
+    *kernel = ismass ? CeedOperatorApplyAddFusedMass3D_Opt_##P##_##Q :         \
+              CeedOperatorApplyAddFusedPoisson3D_Opt_##P##_##Q;                \
+    break;
+
+//------------------------------------------------------------------------------
+// Operator Setup Fused
+//   Selects a fused kernel for an operator applying a gallery mass or Poisson
+//   QFunction with a scalar 3D tensor basis of supported size and passive
+//   quadrature data; kernel is left NULL otherwise
+//------------------------------------------------------------------------------
+int CeedOperatorSetupFused_Opt(CeedOperator op) {
+  int ierr;
+  CeedOperator_Opt *impl;
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+  CeedOperatorFusedKernel_Opt *kernel = &impl->fused;
+  impl->fusedchecked = true;
+  *kernel = NULL;
+
+  // Gallery QFunction
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  const char *name;
+  ierr = CeedQFunctionGetGalleryName(qf, &name); CeedChk(ierr);
+  if (!name || (strcmp(name, "MassApply") && strcmp(name, "Poisson3DApply")))
+    return 0;
+  bool ismass = !strcmp(name, "MassApply");
+  CeedQFunctionContext ctx;
+  ierr = CeedQFunctionGetContext(qf, &ctx); CeedChk(ierr);
+  CeedInt numinputfields, numoutputfields;
+  ierr = CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
+  CeedChk(ierr);
+  if (ctx || numinputfields != 2 || numoutputfields != 1)
+    return 0;
+
+  // Active field, same restriction and basis for input and output
+  CeedOperatorField *opinputfields, *opoutputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, &opoutputfields);
+  CeedChk(ierr);
+  CeedElemRestriction rstr, rstrout;
+  CeedBasis basis, basisout;
+  CeedVector vec, vecout;
+  ierr = CeedOperatorFieldGetElemRestriction(opinputfields[0], &rstr);
+  CeedChk(ierr);
+  ierr = CeedOperatorFieldGetElemRestriction(opoutputfields[0], &rstrout);
+  CeedChk(ierr);
+  ierr = CeedOperatorFieldGetBasis(opinputfields[0], &basis); CeedChk(ierr);
+  ierr = CeedOperatorFieldGetBasis(opoutputfields[0], &basisout); CeedChk(ierr);
+  ierr = CeedOperatorFieldGetVector(opinputfields[0], &vec); CeedChk(ierr);
+  ierr = CeedOperatorFieldGetVector(opoutputfields[0], &vecout); CeedChk(ierr);
+  if (rstr != rstrout || basis != basisout || vec != CEED_VECTOR_ACTIVE ||
+      vecout != CEED_VECTOR_ACTIVE)
+    return 0;
+
+  // Scalar L-vector with offsets and no ghost values
+  bool strided;
+  CeedInt ncomp, gsize;
+  ierr = CeedElemRestrictionIsStrided(rstr, &strided); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumComponents(rstr, &ncomp); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetGhostSize(rstr, &gsize); CeedChk(ierr);
+  if (strided || ncomp != 1 || gsize)
+    return 0;
+
+  // Scalar 3D tensor basis
+  bool istensor;
+  CeedInt dim, P1d, Q1d;
+  ierr = CeedBasisIsTensor(basis, &istensor); CeedChk(ierr);
+  if (!istensor)
+    return 0;
+  ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
+  ierr = CeedBasisGetNumComponents(basis, &ncomp); CeedChk(ierr);
+  ierr = CeedBasisGetNumNodes1D(basis, &P1d); CeedChk(ierr);
+  ierr = CeedBasisGetNumQuadraturePoints1D(basis, &Q1d); CeedChk(ierr);
+  if (dim != 3 || ncomp != 1)
+    return 0;
+
+  // Passive quadrature data, not compressed or streamed
+  bool compress, stream;
+  ierr = CeedOperatorGetCompressPassiveFields(op, &compress); CeedChk(ierr);
+  ierr = CeedOperatorGetStreamPassiveFields(op, &stream); CeedChk(ierr);
+  ierr = CeedOperatorFieldGetElemRestriction(opinputfields[1], &rstr);
+  CeedChk(ierr);
+  ierr = CeedOperatorFieldGetBasis(opinputfields[1], &basis); CeedChk(ierr);
+  ierr = CeedOperatorFieldGetVector(opinputfields[1], &vec); CeedChk(ierr);
+  ierr = CeedElemRestrictionIsStrided(rstr, &strided); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumComponents(rstr, &ncomp); CeedChk(ierr);
+  if (compress || stream || vec == CEED_VECTOR_ACTIVE ||
+      basis != CEED_BASIS_COLLOCATED || !strided || ncomp != (ismass ? 1 : 6))
+    return 0;
+
+  switch (100*P1d + Q1d) {
+    CEED_OPT_FUSED_SIZES(CEED_OPT_FUSED_SELECT)
+  default:
+    break;
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Operator Apply Fused
+//------------------------------------------------------------------------------
+int CeedOperatorApplyAddFused_Opt(CeedOperator op, CeedVector invec,
+                                  CeedVector outvec) {
+  int ierr;
+  CeedOperator_Opt *impl;
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+  CeedInt nelem;
+  ierr = CeedOperatorGetNumElements(op, &nelem); CeedChk(ierr);
+  CeedOperatorField *opinputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, NULL); CeedChk(ierr);
+
+  // Active restriction and basis
+  CeedElemRestriction rstr;
+  CeedBasis basis;
+  const CeedInt *offsets;
+  const CeedScalar *B, *G;
+  ierr = CeedOperatorFieldGetElemRestriction(opinputfields[0], &rstr);
+  CeedChk(ierr);
+  ierr = CeedOperatorFieldGetBasis(opinputfields[0], &basis); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetOffsets(rstr, CEED_MEM_HOST, &offsets);
+  CeedChk(ierr);
+  ierr = CeedBasisGetInterp1D(basis, &B); CeedChk(ierr);
+  ierr = CeedBasisGetGrad1D(basis, &G); CeedChk(ierr);
+
+  // Quadrature data
+  CeedElemRestriction qdrstr;
+  CeedVector qdvec;
+  CeedInt qdstrides[3];
+  bool backendstrides;
+  const CeedScalar *qd;
+  ierr = CeedOperatorFieldGetElemRestriction(opinputfields[1], &qdrstr);
+  CeedChk(ierr);
+  ierr = CeedOperatorFieldGetVector(opinputfields[1], &qdvec); CeedChk(ierr);
+  ierr = CeedElemRestrictionHasBackendStrides(qdrstr, &backendstrides);
+  CeedChk(ierr);
+  if (backendstrides) {
+    ierr = CeedElemRestrictionGetELayout(qdrstr, &qdstrides); CeedChk(ierr);
+  } else {
+    ierr = CeedElemRestrictionGetStrides(qdrstr, &qdstrides); CeedChk(ierr);
+  }
+  ierr = CeedVectorGetArrayRead(qdvec, CEED_MEM_HOST, &qd); CeedChk(ierr);
+
+  // Apply
+  const CeedScalar *u;
+  CeedScalar *v;
+  ierr = CeedVectorGetArrayRead(invec, CEED_MEM_HOST, &u); CeedChk(ierr);
+  ierr = CeedVectorGetArray(outvec, CEED_MEM_HOST, &v); CeedChk(ierr);
+  ierr = impl->fused(nelem, offsets, B, G, qd, qdstrides, u, v); CeedChk(ierr);
+
+  // Restore
+  ierr = CeedVectorRestoreArrayRead(invec, &u); CeedChk(ierr);
+  ierr = CeedVectorRestoreArray(outvec, &v); CeedChk(ierr);
+  ierr = CeedVectorRestoreArrayRead(qdvec, &qd); CeedChk(ierr);
+  ierr = CeedElemRestrictionRestoreOffsets(rstr, &offsets); CeedChk(ierr);
+  return 0;
+}
+//------------------------------------------------------------------------------
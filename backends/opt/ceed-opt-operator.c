@@ -14,17 +14,36 @@
 // software, applications, hardware, advanced system engineering and early
 // testbed platforms, in support of the nation's exascale computing imperative.
 
+#define _POSIX_C_SOURCE 200112
+#include <math.h>
+#include <stdint.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #include "ceed-opt.h"
 
+// Relative tolerance for detecting element-wise constant passive inputs
+#define CEED_OPT_COMPRESS_TOL (1E4*CEED_EPSILON)
+
+// Compression modes of a block of a passive input
+enum {
+  CEED_OPT_COMPRESS_NONE = 0,     // All quadrature point values stored
+  CEED_OPT_COMPRESS_CONSTANT = 1, // One value per component and element
+  CEED_OPT_COMPRESS_WEIGHTED = 2, // One value per component and element,
+  //                                 scaled by the quadrature weights
+};
+
+// Number of element blocks of streamed passive inputs to prefetch ahead
+#define CEED_OPT_STREAM_AHEAD 64
+
 //------------------------------------------------------------------------------
 // Setup Input/Output Fields
 //------------------------------------------------------------------------------
 static int CeedOperatorSetupFields_Opt(CeedQFunction qf, CeedOperator op,
                                        bool inOrOut, const CeedInt blksize,
                                        CeedElemRestriction *blkrestr,
-                                       CeedVector *fullevecs, CeedVector *evecs,
-                                       CeedVector *qvecs, CeedInt starte,
+                                       CeedVector *evecs, CeedVector *qvecs,
+                                       CeedInt starte,
                                        CeedInt numfields, CeedInt Q) {
   CeedInt dim, ierr, ncomp, size, P;
   Ceed ceed;
@@ -74,17 +93,24 @@ static int CeedOperatorSetupFields_Opt(CeedQFunction qf, CeedOperator op,
         ierr = CeedElemRestrictionGetOffsets(r, CEED_MEM_HOST, &offsets);
         CeedChk(ierr);
         ierr = CeedElemRestrictionGetCompStride(r, &compstride); CeedChk(ierr);
-        ierr = CeedElemRestrictionCreateBlocked(ceed, nelem, elemsize,
-                                                blksize, ncomp, compstride,
-                                                lsize, CEED_MEM_HOST,
-                                                CEED_COPY_VALUES, offsets,
-                                                &blkrestr[i+starte]);
+        CeedInt gsize;
+        ierr = CeedElemRestrictionGetGhostSize(r, &gsize); CeedChk(ierr);
+        ierr = CeedElemRestrictionCreateBlockedGhosted(ceed, nelem, elemsize,
+               blksize, ncomp, compstride, lsize, gsize, CEED_MEM_HOST,
+               CEED_COPY_VALUES, offsets, &blkrestr[i+starte]);
         CeedChk(ierr);
         ierr = CeedElemRestrictionRestoreOffsets(r, &offsets); CeedChk(ierr);
+        if (gsize) {
+          // Ghost vectors are shared with the user restriction
+          CeedVector ghostin, ghostout;
+          ierr = CeedElemRestrictionGetGhostVectors(r, &ghostin, &ghostout);
+          CeedChk(ierr);
+          ierr = CeedElemRestrictionSetGhostVectors(blkrestr[i+starte], ghostin,
+                 ghostout); CeedChk(ierr);
+        }
       }
-      ierr = CeedElemRestrictionCreateVector(blkrestr[i+starte], NULL,
-                                             &fullevecs[i+starte]);
-      CeedChk(ierr);
+      // Full E-vectors are only kept for passive inputs, created on first
+      //   use in CeedOperatorSetupInputs_Opt()
     }
 
     switch(emode) {
@@ -126,6 +152,230 @@ static int CeedOperatorSetupFields_Opt(CeedQFunction qf, CeedOperator op,
   return 0;
 }
 
+//------------------------------------------------------------------------------
+// Setup Stream Range
+//   Computes the range of L-vector indices read by each element block of a
+//   blocked restriction, for prefetching streamed passive inputs.
+//------------------------------------------------------------------------------
+static int CeedOperatorSetupStreamRange_Opt(CeedElemRestriction blkrestr,
+    CeedInt blksize, CeedInt **range) {
+  CeedInt ierr;
+  CeedInt nelem, elemsize, ncomp, lsize;
+  ierr = CeedElemRestrictionGetNumElements(blkrestr, &nelem); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetElementSize(blkrestr, &elemsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumComponents(blkrestr, &ncomp); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetLVectorSize(blkrestr, &lsize); CeedChk(ierr);
+  CeedInt nblks = (nelem/blksize) + !!(nelem%blksize);
+  ierr = CeedMalloc(2*nblks, range); CeedChk(ierr);
+
+  bool strided;
+  ierr = CeedElemRestrictionIsStrided(blkrestr, &strided); CeedChk(ierr);
+  if (strided) {
+    bool backendstrides;
+    CeedInt strides[3] = {1, elemsize, elemsize*ncomp};
+    ierr = CeedElemRestrictionHasBackendStrides(blkrestr, &backendstrides);
+    CeedChk(ierr);
+    if (!backendstrides) {
+      ierr = CeedElemRestrictionGetStrides(blkrestr, &strides); CeedChk(ierr);
+    }
+    for (CeedInt b=0; b<nblks; b++) {
+      CeedInt last = CeedIntMin((b+1)*blksize, nelem) - 1;
+      (*range)[2*b+0] = b*blksize*strides[2];
+      (*range)[2*b+1] = last*strides[2] + (elemsize-1)*strides[0] +
+                        (ncomp-1)*strides[1];
+    }
+  } else {
+    const CeedInt *offsets;
+    CeedInt compstride;
+    ierr = CeedElemRestrictionGetCompStride(blkrestr, &compstride);
+    CeedChk(ierr);
+    ierr = CeedElemRestrictionGetOffsets(blkrestr, CEED_MEM_HOST, &offsets);
+    CeedChk(ierr);
+    for (CeedInt b=0; b<nblks; b++) {
+      const CeedInt *blkoffsets = &offsets[b*blksize*elemsize];
+      CeedInt lo = blkoffsets[0], hi = blkoffsets[0];
+      for (CeedInt k=1; k<blksize*elemsize; k++) {
+        lo = CeedIntMin(lo, blkoffsets[k]);
+        hi = CeedIntMax(hi, blkoffsets[k]);
+      }
+      (*range)[2*b+0] = lo;
+      (*range)[2*b+1] = hi + (ncomp-1)*compstride;
+    }
+    ierr = CeedElemRestrictionRestoreOffsets(blkrestr, &offsets);
+    CeedChk(ierr);
+  }
+  for (CeedInt b=0; b<nblks; b++) {
+    (*range)[2*b+0] = CeedIntMax((*range)[2*b+0], 0);
+    (*range)[2*b+1] = CeedIntMin((*range)[2*b+1], lsize-1);
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Setup Partial Last Block
+//   Creates restrictions over only the elements of the partial last block, with
+//   that many elements per block, and matching E- and Q-vectors, so the last
+//   block is applied without computing on padding elements.
+//------------------------------------------------------------------------------
+static int CeedOperatorSetupTail_Opt(CeedQFunction qf, CeedOperator op,
+                                     CeedInt numelements, CeedInt Q,
+                                     CeedOperator_Opt *impl) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  const CeedInt tailsize = impl->tailsize;
+  const CeedInt start = numelements - tailsize;
+  const CeedInt numin = impl->numein, numout = impl->numeout;
+  CeedOperatorField *opinputfields, *opoutputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, &opoutputfields);
+  CeedChk(ierr);
+  CeedQFunctionField *qfinputfields, *qfoutputfields;
+  ierr = CeedQFunctionGetFields(qf, &qfinputfields, &qfoutputfields);
+  CeedChk(ierr);
+
+  ierr = CeedCalloc(numin + numout, &impl->tailrestr); CeedChk(ierr);
+  ierr = CeedCalloc(numin + numout, &impl->tailevecs); CeedChk(ierr);
+  ierr = CeedCalloc(numin, &impl->tailqvecsin); CeedChk(ierr);
+  ierr = CeedCalloc(numout, &impl->tailqvecsout); CeedChk(ierr);
+
+  for (CeedInt i=0; i<numin + numout; i++) {
+    const bool isin = i < numin;
+    CeedOperatorField opfield = isin ? opinputfields[i] :
+                                opoutputfields[i-numin];
+    CeedQFunctionField qffield = isin ? qfinputfields[i] :
+                                 qfoutputfields[i-numin];
+    CeedVector *qvec = isin ? &impl->tailqvecsin[i] :
+                       &impl->tailqvecsout[i-numin];
+    CeedEvalMode emode;
+    CeedInt size;
+    ierr = CeedQFunctionFieldGetEvalMode(qffield, &emode); CeedChk(ierr);
+    ierr = CeedQFunctionFieldGetSize(qffield, &size); CeedChk(ierr);
+
+    // Weights
+    if (emode == CEED_EVAL_WEIGHT) {
+      CeedBasis basis;
+      ierr = CeedOperatorFieldGetBasis(opfield, &basis); CeedChk(ierr);
+      ierr = CeedVectorCreate(ceed, Q*tailsize, qvec); CeedChk(ierr);
+      ierr = CeedBasisApply(basis, tailsize, CEED_NOTRANSPOSE,
+                            CEED_EVAL_WEIGHT, CEED_VECTOR_NONE, *qvec);
+      CeedChk(ierr);
+      continue;
+    }
+
+    // Restriction of the last elements
+    CeedElemRestriction r;
+    CeedInt elemsize, ncomp, compstride, lsize, gsize = 0;
+    ierr = CeedOperatorFieldGetElemRestriction(opfield, &r); CeedChk(ierr);
+    ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+    ierr = CeedElemRestrictionGetNumComponents(r, &ncomp); CeedChk(ierr);
+    ierr = CeedElemRestrictionGetLVectorSize(r, &lsize); CeedChk(ierr);
+    bool strided;
+    ierr = CeedElemRestrictionIsStrided(r, &strided); CeedChk(ierr);
+    CeedInt *offsets;
+    ierr = CeedMalloc(tailsize*elemsize, &offsets); CeedChk(ierr);
+    if (strided) {
+      CeedInt strides[3] = {1, elemsize, elemsize*ncomp};
+      bool backendstrides;
+      ierr = CeedElemRestrictionHasBackendStrides(r, &backendstrides);
+      CeedChk(ierr);
+      if (!backendstrides) {
+        ierr = CeedElemRestrictionGetStrides(r, &strides); CeedChk(ierr);
+      }
+      for (CeedInt e=0; e<tailsize; e++)
+        for (CeedInt k=0; k<elemsize; k++)
+          offsets[e*elemsize + k] = k*strides[0] + (start + e)*strides[2];
+      compstride = strides[1];
+    } else {
+      const CeedInt *roffsets;
+      ierr = CeedElemRestrictionGetCompStride(r, &compstride); CeedChk(ierr);
+      ierr = CeedElemRestrictionGetGhostSize(r, &gsize); CeedChk(ierr);
+      ierr = CeedElemRestrictionGetOffsets(r, CEED_MEM_HOST, &roffsets);
+      CeedChk(ierr);
+      memcpy(offsets, &roffsets[start*elemsize],
+             tailsize*elemsize*sizeof(CeedInt));
+      ierr = CeedElemRestrictionRestoreOffsets(r, &roffsets); CeedChk(ierr);
+    }
+    ierr = CeedElemRestrictionCreateBlockedGhosted(ceed, tailsize, elemsize,
+           tailsize, ncomp, compstride, lsize, gsize, CEED_MEM_HOST,
+           CEED_OWN_POINTER, offsets, &impl->tailrestr[i]); CeedChk(ierr);
+    if (gsize) {
+      CeedVector ghostin, ghostout;
+      ierr = CeedElemRestrictionGetGhostVectors(r, &ghostin, &ghostout);
+      CeedChk(ierr);
+      ierr = CeedElemRestrictionSetGhostVectors(impl->tailrestr[i], ghostin,
+             ghostout); CeedChk(ierr);
+    }
+    ierr = CeedElemRestrictionCreateVector(impl->tailrestr[i], NULL,
+                                           &impl->tailevecs[i]); CeedChk(ierr);
+
+    // Q-vector, the E-vector itself for CEED_EVAL_NONE
+    if (emode == CEED_EVAL_NONE) {
+      *qvec = impl->tailevecs[i];
+      ierr = CeedVectorAddReference(*qvec); CeedChk(ierr);
+    } else {
+      ierr = CeedVectorCreate(ceed, Q*size*tailsize, qvec); CeedChk(ierr);
+    }
+  }
+
+  // Identity QFunctions pass the input Q-vectors through
+  if (impl->identityqf) {
+    for (CeedInt i=0; i<numin; i++) {
+      CeedEvalMode outmode;
+      ierr = CeedQFunctionFieldGetEvalMode(qfoutputfields[i], &outmode);
+      CeedChk(ierr);
+      ierr = CeedVectorDestroy(&impl->tailqvecsout[i]); CeedChk(ierr);
+      impl->tailqvecsout[i] = impl->tailqvecsin[i];
+      ierr = CeedVectorAddReference(impl->tailqvecsin[i]); CeedChk(ierr);
+      if (outmode == CEED_EVAL_NONE) {
+        ierr = CeedVectorDestroy(&impl->tailevecs[numin+i]); CeedChk(ierr);
+        impl->tailevecs[numin+i] = impl->tailqvecsin[i];
+        ierr = CeedVectorAddReference(impl->tailqvecsin[i]); CeedChk(ierr);
+      }
+    }
+  }
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Setup Scratch Vectors
+//   Lists the block E- and Q-vectors that only hold data during an
+//   application, so they can share the scratch pool of the Ceed with other
+//   operators. Q-vectors for CEED_EVAL_NONE point into E-vectors and
+//   quadrature weights are kept.
+//------------------------------------------------------------------------------
+static int CeedOperatorSetupScratch_Opt(CeedQFunctionField *qfinputfields,
+                                        CeedQFunctionField *qfoutputfields,
+                                        CeedOperator_Opt *impl) {
+  int ierr;
+  const CeedInt numin = impl->numein, numout = impl->numeout;
+  CeedInt n = 0;
+
+  ierr = CeedCalloc(4*(numin + numout), &impl->scratchvecs); CeedChk(ierr);
+  for (CeedInt i=0; i<numin + numout; i++) {
+    const bool isin = i < numin;
+    CeedEvalMode emode;
+    ierr = CeedQFunctionFieldGetEvalMode(isin ? qfinputfields[i] :
+                                         qfoutputfields[i-numin], &emode);
+    CeedChk(ierr);
+    if (emode == CEED_EVAL_WEIGHT)
+      continue;
+    impl->scratchvecs[n++] = isin ? impl->evecsin[i] : impl->evecsout[i-numin];
+    if (impl->tailsize)
+      impl->scratchvecs[n++] = impl->tailevecs[i];
+    if (emode == CEED_EVAL_INTERP || emode == CEED_EVAL_GRAD) {
+      impl->scratchvecs[n++] = isin ? impl->qvecsin[i] :
+                               impl->qvecsout[i-numin];
+      if (impl->tailsize)
+        impl->scratchvecs[n++] = isin ? impl->tailqvecsin[i] :
+                                 impl->tailqvecsout[i-numin];
+    }
+  }
+  impl->numscratch = n;
+
+  return 0;
+}
+
 //------------------------------------------------------------------------------
 // Setup Operator
 //------------------------------------------------------------------------------
@@ -164,6 +414,7 @@ static int CeedOperatorSetup_Opt(CeedOperator op) {
   CeedChk(ierr);
 
   ierr = CeedCalloc(16, &impl->inputstate); CeedChk(ierr);
+  ierr = CeedCalloc(16, &impl->ghoststate); CeedChk(ierr);
   ierr = CeedCalloc(16, &impl->evecsin); CeedChk(ierr);
   ierr = CeedCalloc(16, &impl->evecsout); CeedChk(ierr);
   ierr = CeedCalloc(16, &impl->qvecsin); CeedChk(ierr);
@@ -174,17 +425,112 @@ static int CeedOperatorSetup_Opt(CeedOperator op) {
   // Set up infield and outfield pointer arrays
   // Infields
   ierr = CeedOperatorSetupFields_Opt(qf, op, 0, blksize, impl->blkrestr,
-                                     impl->evecs, impl->evecsin,
-                                     impl->qvecsin, 0,
+                                     impl->evecsin, impl->qvecsin, 0,
                                      numinputfields, Q);
   CeedChk(ierr);
   // Outfields
   ierr = CeedOperatorSetupFields_Opt(qf, op, 1, blksize, impl->blkrestr,
-                                     impl->evecs, impl->evecsout,
-                                     impl->qvecsout, numinputfields,
-                                     numoutputfields, Q);
+                                     impl->evecsout, impl->qvecsout,
+                                     numinputfields, numoutputfields, Q);
   CeedChk(ierr);
 
+  // Partial last block, so no full block holds padding elements; the
+  //   QFunction pads its quadrature points to a multiple of its vector length
+  CeedInt numelements;
+  ierr = CeedOperatorGetNumElements(op, &numelements); CeedChk(ierr);
+  impl->tailsize = numelements % blksize;
+  if (impl->tailsize) {
+    ierr = CeedOperatorSetupTail_Opt(qf, op, numelements, Q, impl);
+    CeedChk(ierr);
+  }
+
+  // Constant passive inputs are broadcast into the block E-vector, like
+  //   streamed inputs, and need no full E-vector
+  ierr = CeedCalloc(numinputfields, &impl->constin); CeedChk(ierr);
+  for (CeedInt i=0; i<numinputfields; i++) {
+    CeedEvalMode emode;
+    CeedVector vec;
+    ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
+    CeedChk(ierr);
+    ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+    if (emode == CEED_EVAL_NONE && vec != CEED_VECTOR_ACTIVE) {
+      ierr = CeedElemRestrictionIsConstant(impl->blkrestr[i],
+                                           &impl->constin[i]); CeedChk(ierr);
+    }
+  }
+
+  // Compressible passive inputs
+  bool compress;
+  ierr = CeedOperatorGetCompressPassiveFields(op, &compress); CeedChk(ierr);
+  if (compress) {
+    ierr = CeedCalloc(numinputfields, &impl->cdata); CeedChk(ierr);
+    ierr = CeedCalloc(numinputfields, &impl->cmode); CeedChk(ierr);
+    ierr = CeedCalloc(numinputfields, &impl->coffset); CeedChk(ierr);
+    ierr = CeedCalloc(numinputfields, &impl->cexpand); CeedChk(ierr);
+    for (CeedInt i=0; i<numinputfields; i++) {
+      CeedEvalMode emode;
+      CeedVector vec;
+      CeedInt size;
+      ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
+      CeedChk(ierr);
+      ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+      if (emode == CEED_EVAL_NONE && vec != CEED_VECTOR_ACTIVE &&
+          !impl->constin[i]) {
+        ierr = CeedQFunctionFieldGetSize(qfinputfields[i], &size);
+        CeedChk(ierr);
+        ierr = CeedMalloc(Q*size*blksize, &impl->cexpand[i]); CeedChk(ierr);
+      }
+    }
+
+    // Quadrature weights, from any basis with matching quadrature
+    for (CeedInt i=0; i<numinputfields + numoutputfields && !impl->qweight;
+         i++) {
+      CeedBasis basis;
+      CeedInt nqpts;
+      ierr = CeedOperatorFieldGetBasis(i < numinputfields ? opinputfields[i] :
+                                       opoutputfields[i-numinputfields],
+                                       &basis); CeedChk(ierr);
+      if (basis == CEED_BASIS_COLLOCATED)
+        continue;
+      ierr = CeedBasisGetNumQuadraturePoints(basis, &nqpts); CeedChk(ierr);
+      if (nqpts == Q) {
+        CeedVector weight;
+        const CeedScalar *w;
+        ierr = CeedVectorCreate(ceed, Q, &weight); CeedChk(ierr);
+        ierr = CeedBasisApply(basis, 1, CEED_NOTRANSPOSE, CEED_EVAL_WEIGHT,
+                              CEED_VECTOR_NONE, weight); CeedChk(ierr);
+        ierr = CeedMalloc(Q, &impl->qweight); CeedChk(ierr);
+        ierr = CeedVectorGetArrayRead(weight, CEED_MEM_HOST, &w); CeedChk(ierr);
+        memcpy(impl->qweight, w, Q*sizeof(CeedScalar));
+        ierr = CeedVectorRestoreArrayRead(weight, &w); CeedChk(ierr);
+        ierr = CeedVectorDestroy(&weight); CeedChk(ierr);
+      }
+    }
+  }
+
+  // Streamed passive inputs, other than those selected for compression, are
+  //   restricted block by block and need no full E-vector
+  bool stream;
+  ierr = CeedOperatorGetStreamPassiveFields(op, &stream); CeedChk(ierr);
+  if (stream) {
+    ierr = CeedCalloc(numinputfields, &impl->srange); CeedChk(ierr);
+    ierr = CeedCalloc(numinputfields, &impl->sdata); CeedChk(ierr);
+    ierr = CeedCalloc(numinputfields, &impl->sahead); CeedChk(ierr);
+    for (CeedInt i=0; i<numinputfields; i++) {
+      CeedEvalMode emode;
+      CeedVector vec;
+      ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
+      CeedChk(ierr);
+      ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+      if (emode == CEED_EVAL_WEIGHT || vec == CEED_VECTOR_ACTIVE ||
+          impl->constin[i] || (impl->cexpand && impl->cexpand[i]))
+        continue;
+      ierr = CeedVectorDestroy(&impl->evecs[i]); CeedChk(ierr);
+      ierr = CeedOperatorSetupStreamRange_Opt(impl->blkrestr[i], blksize,
+                                              &impl->srange[i]); CeedChk(ierr);
+    }
+  }
+
   // Identity QFunctions
   if (impl->identityqf) {
     CeedEvalMode inmode, outmode;
@@ -203,17 +549,160 @@ static int CeedOperatorSetup_Opt(CeedOperator op) {
     }
   }
 
+  // Restrict passive inputs sharing E-vectors with other operators now, so
+  //   CeedOperatorSetupAll() also takes this out of the first application;
+  //   vectors holding a batch are left for apply
+  for (CeedInt i=0; i<numinputfields; i++) {
+    CeedEvalMode emode;
+    CeedVector vec;
+    CeedInt lsize, length;
+    ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
+    CeedChk(ierr);
+    ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+    if (emode == CEED_EVAL_WEIGHT || vec == CEED_VECTOR_ACTIVE ||
+        impl->constin[i] || (impl->srange && impl->srange[i]) ||
+        (impl->cexpand && impl->cexpand[i]))
+      continue;
+    ierr = CeedElemRestrictionGetLVectorSize(impl->blkrestr[i], &lsize);
+    CeedChk(ierr);
+    ierr = CeedVectorGetLength(vec, &length); CeedChk(ierr);
+    if (length != lsize)
+      continue;
+    CeedElemRestriction r;
+    Ceed ceedrstr;
+    ierr = CeedOperatorFieldGetElemRestriction(opinputfields[i], &r);
+    CeedChk(ierr);
+    ierr = CeedElemRestrictionGetCeed(impl->blkrestr[i], &ceedrstr);
+    CeedChk(ierr);
+    ierr = CeedGetCachedEVector(ceedrstr, r, blksize, vec, impl->blkrestr[i],
+                                &impl->evecs[i]); CeedChk(ierr);
+    ierr = CeedUpdateCachedEVector(ceedrstr, impl->blkrestr[i], vec,
+                                   impl->evecs[i], CEED_REQUEST_IMMEDIATE);
+    CeedChk(ierr);
+  }
+
+  // Scratch vectors
+  ierr = CeedOperatorSetupScratch_Opt(qfinputfields, qfoutputfields, impl);
+  CeedChk(ierr);
+
   ierr = CeedOperatorSetSetupDone(op); CeedChk(ierr);
 
   return 0;
 }
 
+//------------------------------------------------------------------------------
+// Compress Passive Input
+//   Packs the blocked E-vector of a passive input, storing one value per
+//   component and element for blocks that are constant, or a constant times
+//   the quadrature weights, at all quadrature points. The E-vector is released
+//   if any block was compressed.
+//------------------------------------------------------------------------------
+static int CeedOperatorCompressInput_Opt(CeedInt i, CeedInt Q, CeedInt size,
+    CeedInt blksize, CeedInt nblks, CeedOperator_Opt *impl) {
+  CeedInt ierr;
+  const CeedInt blkQsize = Q*size*blksize;
+  const CeedScalar *e;
+  const CeedScalar *w = impl->qweight;
+
+  ierr = CeedFree(&impl->cdata[i]); CeedChk(ierr);
+  if (!impl->cmode[i]) {
+    ierr = CeedMalloc(nblks, &impl->cmode[i]); CeedChk(ierr);
+    ierr = CeedMalloc(nblks, &impl->coffset[i]); CeedChk(ierr);
+  }
+  ierr = CeedVectorGetArrayRead(impl->evecs[i], CEED_MEM_HOST, &e);
+  CeedChk(ierr);
+
+  // Detect compressible blocks
+  CeedInt length = 0;
+  bool compressed = false;
+  for (CeedInt b=0; b<nblks; b++) {
+    const CeedScalar *eb = &e[b*blkQsize];
+    bool constant = true, weighted = !!w;
+    for (CeedInt k=0; k<size; k++)
+      for (CeedInt j=0; j<blksize; j++) {
+        const CeedScalar v0 = eb[k*Q*blksize + j];
+        const CeedScalar c = w ? v0 / w[0] : 0;
+        for (CeedInt q=1; q<Q; q++) {
+          const CeedScalar v = eb[(k*Q + q)*blksize + j];
+          constant = constant && fabs(v - v0) <= CEED_OPT_COMPRESS_TOL*fabs(v0);
+          weighted = weighted &&
+                     fabs(v - c*w[q]) <= CEED_OPT_COMPRESS_TOL*fabs(c*w[q]);
+        }
+      }
+    impl->cmode[i][b] = constant ? CEED_OPT_COMPRESS_CONSTANT :
+                        weighted ? CEED_OPT_COMPRESS_WEIGHTED :
+                        CEED_OPT_COMPRESS_NONE;
+    impl->coffset[i][b] = length;
+    length += impl->cmode[i][b] ? size*blksize : blkQsize;
+    compressed = compressed || impl->cmode[i][b];
+  }
+  if (!compressed) {
+    ierr = CeedVectorRestoreArrayRead(impl->evecs[i], &e); CeedChk(ierr);
+    return 0;
+  }
+
+  // Pack
+  ierr = CeedMalloc(length, &impl->cdata[i]); CeedChk(ierr);
+  for (CeedInt b=0; b<nblks; b++) {
+    const CeedScalar *eb = &e[b*blkQsize];
+    CeedScalar *cb = &impl->cdata[i][impl->coffset[i][b]];
+    switch (impl->cmode[i][b]) {
+    case CEED_OPT_COMPRESS_NONE:
+      memcpy(cb, eb, blkQsize*sizeof(CeedScalar));
+      break;
+    case CEED_OPT_COMPRESS_CONSTANT:
+      for (CeedInt k=0; k<size; k++)
+        for (CeedInt j=0; j<blksize; j++)
+          cb[k*blksize + j] = eb[k*Q*blksize + j];
+      break;
+    case CEED_OPT_COMPRESS_WEIGHTED:
+      for (CeedInt k=0; k<size; k++)
+        for (CeedInt j=0; j<blksize; j++)
+          cb[k*blksize + j] = eb[k*Q*blksize + j] / w[0];
+      break;
+    }
+  }
+  ierr = CeedVectorRestoreArrayRead(impl->evecs[i], &e); CeedChk(ierr);
+  ierr = CeedVectorDestroy(&impl->evecs[i]); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Expand Compressed Passive Input Block
+//------------------------------------------------------------------------------
+static inline CeedScalar *CeedOperatorExpandInput_Opt(CeedInt i, CeedInt b,
+    CeedInt Q, CeedInt size, CeedInt blksize, CeedOperator_Opt *impl) {
+  CeedScalar *cb = &impl->cdata[i][impl->coffset[i][b]];
+  CeedScalar *out = impl->cexpand[i];
+  const CeedScalar *w = impl->qweight;
+
+  switch (impl->cmode[i][b]) {
+  case CEED_OPT_COMPRESS_CONSTANT:
+    for (CeedInt k=0; k<size; k++)
+      for (CeedInt q=0; q<Q; q++)
+        for (CeedInt j=0; j<blksize; j++)
+          out[(k*Q + q)*blksize + j] = cb[k*blksize + j];
+    return out;
+  case CEED_OPT_COMPRESS_WEIGHTED:
+    for (CeedInt k=0; k<size; k++)
+      for (CeedInt q=0; q<Q; q++)
+        for (CeedInt j=0; j<blksize; j++)
+          out[(k*Q + q)*blksize + j] = w[q] * cb[k*blksize + j];
+    return out;
+  default:
+    return cb;
+  }
+}
+
 //------------------------------------------------------------------------------
 // Setup Input Fields
 //------------------------------------------------------------------------------
 static inline int CeedOperatorSetupInputs_Opt(CeedInt numinputfields,
+    CeedInt Q, CeedInt blksize, CeedInt nblks,
     CeedQFunctionField *qfinputfields, CeedOperatorField *opinputfields,
-    CeedVector invec, CeedOperator_Opt *impl, CeedRequest *request) {
+    CeedVector invec, CeedVector *batchvecs, CeedOperator_Opt *impl,
+    CeedRequest *request) {
   CeedInt ierr;
   CeedEvalMode emode;
   CeedVector vec;
@@ -226,16 +715,76 @@ static inline int CeedOperatorSetupInputs_Opt(CeedInt numinputfields,
     } else {
       // Get input vector
       ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
-      if (vec != CEED_VECTOR_ACTIVE) {
-        // Restrict
+      // Batched and streamed passive inputs are restricted per block, like
+      //   active inputs
+      bool batched = batchvecs && batchvecs[i];
+      bool streamed = impl->srange && impl->srange[i];
+      bool compressed = impl->cexpand && impl->cexpand[i];
+      bool constant = impl->constin[i] && !batched;
+      if (vec != CEED_VECTOR_ACTIVE && !batched && !streamed && !compressed &&
+          !constant) {
+        // Restrict if changed, sharing the E-vector with other operators
+        Ceed ceed;
+        ierr = CeedElemRestrictionGetCeed(impl->blkrestr[i], &ceed);
+        CeedChk(ierr);
+        if (!impl->evecs[i]) {
+          CeedElemRestriction r;
+          ierr = CeedOperatorFieldGetElemRestriction(opinputfields[i], &r);
+          CeedChk(ierr);
+          ierr = CeedGetCachedEVector(ceed, r, blksize, vec, impl->blkrestr[i],
+                                      &impl->evecs[i]); CeedChk(ierr);
+        }
+        CeedPerfStart(impl->perf, CEED_PERF_RESTRICTION);
+        ierr = CeedUpdateCachedEVector(ceed, impl->blkrestr[i], vec,
+                                       impl->evecs[i], request); CeedChk(ierr);
+        CeedPerfStop(impl->perf, CEED_PERF_RESTRICTION);
+      } else if (vec != CEED_VECTOR_ACTIVE && !batched && !streamed &&
+                 !constant) {
+        // Restrict if the L-vector or the ghost input vector changed
+        CeedVector ghostin;
+        uint64_t ghoststate = 0;
         ierr = CeedVectorGetState(vec, &state); CeedChk(ierr);
-        if (state != impl->inputstate[i]) {
+        ierr = CeedElemRestrictionGetGhostVectors(impl->blkrestr[i], &ghostin,
+               NULL); CeedChk(ierr);
+        if (ghostin) {
+          ierr = CeedVectorGetState(ghostin, &ghoststate); CeedChk(ierr);
+        }
+        if (state != impl->inputstate[i] ||
+            ghoststate != impl->ghoststate[i]) {
+          if (!impl->evecs[i]) {
+            ierr = CeedElemRestrictionCreateVector(impl->blkrestr[i], NULL,
+                                                   &impl->evecs[i]);
+            CeedChk(ierr);
+          }
+          CeedPerfStart(impl->perf, CEED_PERF_RESTRICTION);
           ierr = CeedElemRestrictionApply(impl->blkrestr[i], CEED_NOTRANSPOSE,
                                           vec, impl->evecs[i], request);
           CeedChk(ierr);
+          CeedPerfStop(impl->perf, CEED_PERF_RESTRICTION);
           impl->inputstate[i] = state;
+          impl->ghoststate[i] = ghoststate;
+          // Compress element-wise constant data
+          CeedInt size;
+          ierr = CeedQFunctionFieldGetSize(qfinputfields[i], &size);
+          CeedChk(ierr);
+          ierr = CeedOperatorCompressInput_Opt(i, Q, size, blksize, nblks,
+                                               impl); CeedChk(ierr);
         }
       } else {
+        // Get L-vector array of streamed input for prefetching
+        if (streamed && !batched) {
+          ierr = CeedVectorGetArrayRead(vec, CEED_MEM_HOST, &impl->sdata[i]);
+          CeedChk(ierr);
+          impl->sahead[i] = 0;
+        }
+        // Broadcast constant input once for all blocks
+        if (constant) {
+          CeedPerfStart(impl->perf, CEED_PERF_RESTRICTION);
+          ierr = CeedElemRestrictionApplyConstant(impl->blkrestr[i], blksize,
+                                                  vec, impl->evecsin[i]);
+          CeedChk(ierr);
+          CeedPerfStop(impl->perf, CEED_PERF_RESTRICTION);
+        }
         // Set Qvec for CEED_EVAL_NONE
         if (emode == CEED_EVAL_NONE) {
           ierr = CeedVectorGetArray(impl->evecsin[i], CEED_MEM_HOST,
@@ -247,10 +796,12 @@ static inline int CeedOperatorSetupInputs_Opt(CeedInt numinputfields,
                                         &impl->edata[i]); CeedChk(ierr);
         }
       }
-      // Get evec
-      ierr = CeedVectorGetArrayRead(impl->evecs[i], CEED_MEM_HOST,
-                                    (const CeedScalar **) &impl->edata[i]);
-      CeedChk(ierr);
+      // Get evec, unless released after compression
+      if (impl->evecs[i]) {
+        ierr = CeedVectorGetArrayRead(impl->evecs[i], CEED_MEM_HOST,
+                                      (const CeedScalar **) &impl->edata[i]);
+        CeedChk(ierr);
+      }
     }
   }
   return 0;
@@ -261,8 +812,9 @@ static inline int CeedOperatorSetupInputs_Opt(CeedInt numinputfields,
 //------------------------------------------------------------------------------
 static inline int CeedOperatorInputBasis_Opt(CeedInt e, CeedInt Q,
     CeedQFunctionField *qfinputfields, CeedOperatorField *opinputfields,
-    CeedInt numinputfields, CeedInt blksize, CeedVector invec, bool skipactive,
-    CeedOperator_Opt *impl, CeedRequest *request) {
+    CeedInt numinputfields, CeedInt blksize, CeedVector invec,
+    CeedVector *batchvecs, bool skipactive, CeedOperator_Opt *impl,
+    CeedRequest *request) {
   CeedInt ierr;
   CeedInt dim, elemsize, size;
   CeedElemRestriction Erestrict;
@@ -287,21 +839,28 @@ static inline int CeedOperatorInputBasis_Opt(CeedInt e, CeedInt Q,
     ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
     CeedChk(ierr);
     ierr = CeedQFunctionFieldGetSize(qfinputfields[i], &size); CeedChk(ierr);
-    // Restrict block active input
-    if (vec == CEED_VECTOR_ACTIVE) {
+    // Restrict block active, batched, or streamed input
+    if (vec == CEED_VECTOR_ACTIVE || (batchvecs && batchvecs[i]) ||
+        (impl->srange && impl->srange[i])) {
+      CeedVector src = vec == CEED_VECTOR_ACTIVE ? invec :
+                       batchvecs && batchvecs[i] ? batchvecs[i] : vec;
+      CeedPerfStart(impl->perf, CEED_PERF_RESTRICTION);
       ierr = CeedElemRestrictionApplyBlock(impl->blkrestr[i], e/blksize,
-                                           CEED_NOTRANSPOSE, invec,
+                                           CEED_NOTRANSPOSE, src,
                                            impl->evecsin[i], request);
       CeedChk(ierr);
+      CeedPerfStop(impl->perf, CEED_PERF_RESTRICTION);
       activein = 1;
     }
     // Basis action
     switch(emode) {
     case CEED_EVAL_NONE:
-      if (!activein) {
+      if (!activein && !impl->constin[i]) {
+        CeedScalar *qdata = impl->cdata && impl->cdata[i] ?
+                            CeedOperatorExpandInput_Opt(i, e/blksize, Q, size,
+                                blksize, impl) : &impl->edata[i][e*Q*size];
         ierr = CeedVectorSetArray(impl->qvecsin[i], CEED_MEM_HOST,
-                                  CEED_USE_POINTER,
-                                  &impl->edata[i][e*Q*size]); CeedChk(ierr);
+                                  CEED_USE_POINTER, qdata); CeedChk(ierr);
       }
       break;
     case CEED_EVAL_INTERP:
@@ -313,9 +872,11 @@ static inline int CeedOperatorInputBasis_Opt(CeedInt e, CeedInt Q,
                                   &impl->edata[i][e*elemsize*size]);
         CeedChk(ierr);
       }
+      CeedPerfStart(impl->perf, CEED_PERF_BASIS);
       ierr = CeedBasisApply(basis, blksize, CEED_NOTRANSPOSE,
                             CEED_EVAL_INTERP, impl->evecsin[i],
                             impl->qvecsin[i]); CeedChk(ierr);
+      CeedPerfStop(impl->perf, CEED_PERF_BASIS);
       break;
     case CEED_EVAL_GRAD:
       ierr = CeedOperatorFieldGetBasis(opinputfields[i], &basis);
@@ -327,9 +888,11 @@ static inline int CeedOperatorInputBasis_Opt(CeedInt e, CeedInt Q,
                                   &impl->edata[i][e*elemsize*size/dim]);
         CeedChk(ierr);
       }
+      CeedPerfStart(impl->perf, CEED_PERF_BASIS);
       ierr = CeedBasisApply(basis, blksize, CEED_NOTRANSPOSE,
                             CEED_EVAL_GRAD, impl->evecsin[i],
                             impl->qvecsin[i]); CeedChk(ierr);
+      CeedPerfStop(impl->perf, CEED_PERF_BASIS);
       break;
     case CEED_EVAL_WEIGHT:
       break;  // No action
@@ -354,8 +917,8 @@ static inline int CeedOperatorInputBasis_Opt(CeedInt e, CeedInt Q,
 static inline int CeedOperatorOutputBasis_Opt(CeedInt e, CeedInt Q,
     CeedQFunctionField *qfoutputfields, CeedOperatorField *opoutputfields,
     CeedInt blksize, CeedInt numinputfields, CeedInt numoutputfields,
-    CeedOperator op, CeedVector outvec, CeedOperator_Opt *impl,
-    CeedRequest *request) {
+    CeedOperator op, CeedVector outvec, CeedVector *batchvecs,
+    CeedOperator_Opt *impl, CeedRequest *request) {
   CeedInt ierr;
   CeedElemRestriction Erestrict;
   CeedEvalMode emode;
@@ -375,16 +938,20 @@ static inline int CeedOperatorOutputBasis_Opt(CeedInt e, CeedInt Q,
     case CEED_EVAL_INTERP:
       ierr = CeedOperatorFieldGetBasis(opoutputfields[i], &basis);
       CeedChk(ierr);
+      CeedPerfStart(impl->perf, CEED_PERF_BASIS);
       ierr = CeedBasisApply(basis, blksize, CEED_TRANSPOSE,
                             CEED_EVAL_INTERP, impl->qvecsout[i],
                             impl->evecsout[i]); CeedChk(ierr);
+      CeedPerfStop(impl->perf, CEED_PERF_BASIS);
       break;
     case CEED_EVAL_GRAD:
       ierr = CeedOperatorFieldGetBasis(opoutputfields[i], &basis);
       CeedChk(ierr);
+      CeedPerfStart(impl->perf, CEED_PERF_BASIS);
       ierr = CeedBasisApply(basis, blksize, CEED_TRANSPOSE,
                             CEED_EVAL_GRAD, impl->qvecsout[i],
                             impl->evecsout[i]); CeedChk(ierr);
+      CeedPerfStop(impl->perf, CEED_PERF_BASIS);
       break;
     // LCOV_EXCL_START
     case CEED_EVAL_WEIGHT: {
@@ -406,12 +973,49 @@ static inline int CeedOperatorOutputBasis_Opt(CeedInt e, CeedInt Q,
     ierr = CeedOperatorFieldGetVector(opoutputfields[i], &vec); CeedChk(ierr);
     if (vec == CEED_VECTOR_ACTIVE)
       vec = outvec;
+    else if (batchvecs && batchvecs[i+numinputfields])
+      vec = batchvecs[i+numinputfields];
     // Restrict
+    CeedPerfStart(impl->perf, CEED_PERF_RESTRICTION);
     ierr = CeedElemRestrictionApplyBlock(impl->blkrestr[i+impl->numein],
                                          e/blksize, CEED_TRANSPOSE,
                                          impl->evecsout[i], vec, request);
     CeedChk(ierr);
+    CeedPerfStop(impl->perf, CEED_PERF_RESTRICTION);
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Prefetch Streamed Inputs
+//   Advises the operating system to read ahead the L-vector data of streamed
+//   passive inputs for the following element blocks, such as when these
+//   L-vectors are memory-mapped files. Each call covers several blocks.
+//------------------------------------------------------------------------------
+static inline int CeedOperatorPrefetchInputs_Opt(CeedInt numinputfields,
+    CeedInt blk, CeedInt nblks, CeedOperator_Opt *impl) {
+#ifdef POSIX_MADV_WILLNEED
+  const uintptr_t pagesize = sysconf(_SC_PAGESIZE);
+
+  for (CeedInt i=0; i<numinputfields; i++) {
+    const CeedInt *range = impl->srange[i];
+    if (!impl->sdata[i] ||
+        impl->sahead[i] >= CeedIntMin(blk + CEED_OPT_STREAM_AHEAD/2, nblks))
+      continue;
+    const CeedInt first = CeedIntMax(impl->sahead[i], blk);
+    const CeedInt last = CeedIntMin(blk + CEED_OPT_STREAM_AHEAD, nblks);
+    CeedInt lo = range[2*first], hi = range[2*first+1];
+    for (CeedInt b=first+1; b<last; b++) {
+      lo = CeedIntMin(lo, range[2*b]);
+      hi = CeedIntMax(hi, range[2*b+1]);
+    }
+    uintptr_t start = (uintptr_t)&impl->sdata[i][lo] & ~(pagesize-1);
+    uintptr_t end = (uintptr_t)&impl->sdata[i][hi+1];
+    // Only advice; failure does not affect the result
+    posix_madvise((void *)start, end - start, POSIX_MADV_WILLNEED);
+    impl->sahead[i] = last;
   }
+#endif
   return 0;
 }
 
@@ -425,9 +1029,14 @@ static inline int CeedOperatorRestoreInputs_Opt(CeedInt numinputfields,
   CeedEvalMode emode;
 
   for (CeedInt i=0; i<numinputfields; i++) {
+    if (impl->sdata && impl->sdata[i]) {
+      CeedVector vec;
+      ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+      ierr = CeedVectorRestoreArrayRead(vec, &impl->sdata[i]); CeedChk(ierr);
+    }
     ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
     CeedChk(ierr);
-    if (emode == CEED_EVAL_WEIGHT) { // Skip
+    if (emode == CEED_EVAL_WEIGHT || !impl->evecs[i]) { // Skip
     } else {
       ierr = CeedVectorRestoreArrayRead(impl->evecs[i],
                                         (const CeedScalar **) &impl->edata[i]);
@@ -438,10 +1047,144 @@ static inline int CeedOperatorRestoreInputs_Opt(CeedInt numinputfields,
 }
 
 //------------------------------------------------------------------------------
-// Operator Apply
+// Accumulate Block Inner Product
+//   Sums the inner product of an active input and output E-vector of a block
+//   into dot.
 //------------------------------------------------------------------------------
-static int CeedOperatorApplyAdd_Opt(CeedOperator op, CeedVector invec,
-                                    CeedVector outvec, CeedRequest *request) {
+static inline int CeedOperatorDotBlock_Opt(CeedVector ein, CeedVector eout,
+    CeedScalar *dot) {
+  CeedInt ierr, length;
+  const CeedScalar *x, *y;
+  ierr = CeedVectorGetLength(ein, &length); CeedChk(ierr);
+  ierr = CeedVectorGetArrayRead(ein, CEED_MEM_HOST, &x); CeedChk(ierr);
+  ierr = CeedVectorGetArrayRead(eout, CEED_MEM_HOST, &y); CeedChk(ierr);
+  CeedScalar sum = 0;
+  for (CeedInt k=0; k<length; k++)
+    sum += x[k] * y[k];
+  *dot += sum;
+  ierr = CeedVectorRestoreArrayRead(ein, &x); CeedChk(ierr);
+  ierr = CeedVectorRestoreArrayRead(eout, &y); CeedChk(ierr);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Apply Partial Last Block
+//   All inputs, active or passive, are restricted directly from their L-vectors
+//   with the restrictions of the partial last block. With dot non-NULL, the
+//   inner product of the active input and output E-vectors is summed into it.
+//------------------------------------------------------------------------------
+static int CeedOperatorApplyTail_Opt(CeedOperator op, CeedInt nbatch,
+                                     CeedVector *invecs, CeedVector *outvecs,
+                                     CeedVector *batchvecs, CeedScalar *dot,
+                                     CeedOperator_Opt *impl,
+                                     CeedRequest *request) {
+  int ierr;
+  const CeedInt tailsize = impl->tailsize;
+  const CeedInt numin = impl->numein, numout = impl->numeout;
+  CeedInt Q;
+  ierr = CeedOperatorGetNumQuadraturePoints(op, &Q); CeedChk(ierr);
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  CeedOperatorField *opinputfields, *opoutputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, &opoutputfields);
+  CeedChk(ierr);
+  CeedQFunctionField *qfinputfields, *qfoutputfields;
+  ierr = CeedQFunctionGetFields(qf, &qfinputfields, &qfoutputfields);
+  CeedChk(ierr);
+  CeedEvalMode emode;
+  CeedBasis basis;
+  CeedVector vec, ein = NULL;
+
+  for (CeedInt b=0; b<nbatch; b++) {
+    CeedVector *memberbatchvecs = batchvecs ? &batchvecs[b*(numin+numout)] :
+                                  NULL;
+
+    // Input restriction and basis action
+    for (CeedInt i=0; i<numin; i++) {
+      ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
+      CeedChk(ierr);
+      if (emode == CEED_EVAL_WEIGHT)
+        continue;
+      ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+      if (vec == CEED_VECTOR_ACTIVE) {
+        vec = invecs[b];
+        ein = ein ? ein : impl->tailevecs[i];
+      } else if (memberbatchvecs && memberbatchvecs[i]) {
+        vec = memberbatchvecs[i];
+      }
+      CeedPerfStart(impl->perf, CEED_PERF_RESTRICTION);
+      ierr = CeedElemRestrictionApplyBlock(impl->tailrestr[i], 0,
+                                           CEED_NOTRANSPOSE, vec,
+                                           impl->tailevecs[i], request);
+      CeedChk(ierr);
+      CeedPerfStop(impl->perf, CEED_PERF_RESTRICTION);
+      if (emode == CEED_EVAL_INTERP || emode == CEED_EVAL_GRAD) {
+        ierr = CeedOperatorFieldGetBasis(opinputfields[i], &basis);
+        CeedChk(ierr);
+        CeedPerfStart(impl->perf, CEED_PERF_BASIS);
+        ierr = CeedBasisApply(basis, tailsize, CEED_NOTRANSPOSE, emode,
+                              impl->tailevecs[i], impl->tailqvecsin[i]);
+        CeedChk(ierr);
+        CeedPerfStop(impl->perf, CEED_PERF_BASIS);
+      }
+    }
+
+    // Q function on the points of the partial block only
+    if (!impl->identityqf) {
+      CeedPerfStart(impl->perf, CEED_PERF_QFUNCTION);
+      ierr = CeedQFunctionApply(qf, Q*tailsize, impl->tailqvecsin,
+                                impl->tailqvecsout); CeedChk(ierr);
+      CeedPerfStop(impl->perf, CEED_PERF_QFUNCTION);
+    }
+
+    // Output basis action and restriction
+    for (CeedInt i=0; i<numout; i++) {
+      ierr = CeedQFunctionFieldGetEvalMode(qfoutputfields[i], &emode);
+      CeedChk(ierr);
+      if (emode == CEED_EVAL_INTERP || emode == CEED_EVAL_GRAD) {
+        ierr = CeedOperatorFieldGetBasis(opoutputfields[i], &basis);
+        CeedChk(ierr);
+        CeedPerfStart(impl->perf, CEED_PERF_BASIS);
+        ierr = CeedBasisApply(basis, tailsize, CEED_TRANSPOSE, emode,
+                              impl->tailqvecsout[i], impl->tailevecs[numin+i]);
+        CeedChk(ierr);
+        CeedPerfStop(impl->perf, CEED_PERF_BASIS);
+      }
+      ierr = CeedOperatorFieldGetVector(opoutputfields[i], &vec); CeedChk(ierr);
+      if (vec == CEED_VECTOR_ACTIVE) {
+        vec = outvecs[b];
+        if (dot) {
+          ierr = CeedOperatorDotBlock_Opt(ein, impl->tailevecs[numin+i], dot);
+          CeedChk(ierr);
+        }
+      } else if (memberbatchvecs && memberbatchvecs[numin+i]) {
+        vec = memberbatchvecs[numin+i];
+      }
+      CeedPerfStart(impl->perf, CEED_PERF_RESTRICTION);
+      ierr = CeedElemRestrictionApplyBlock(impl->tailrestr[numin+i], 0,
+                                           CEED_TRANSPOSE,
+                                           impl->tailevecs[numin+i], vec,
+                                           request); CeedChk(ierr);
+      CeedPerfStop(impl->perf, CEED_PERF_RESTRICTION);
+    }
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Operator Apply Core
+//   Applies the operator to nbatch members; invecs and outvecs hold one active
+//   vector per member and batchvecs holds, per member, the member views of
+//   batched passive fields (NULL entries for shared fields). Members are looped
+//   inside the element block loop so restriction offsets and basis data are
+//   reused while in cache. With dot non-NULL, for a single member, the inner
+//   product of the active input E-vector with the active output E-vectors,
+//   which share its restriction, is accumulated block by block.
+//------------------------------------------------------------------------------
+static int CeedOperatorApplyAddCore_Opt(CeedOperator op, CeedInt nbatch,
+                                        CeedVector *invecs, CeedVector *outvecs,
+                                        CeedVector *batchvecs, CeedScalar *dot,
+                                        CeedRequest *request) {
   int ierr;
   Ceed ceed;
   ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
@@ -468,11 +1211,15 @@ static int CeedOperatorApplyAdd_Opt(CeedOperator op, CeedVector invec,
 
   // Setup
   ierr = CeedOperatorSetup_Opt(op); CeedChk(ierr);
+  ierr = CeedOperatorGetPerf(op, &impl->perf); CeedChk(ierr);
+  CeedScalar *scratch;
+  ierr = CeedGetScratchVectors(ceed, impl->numscratch, impl->scratchvecs,
+                               &scratch); CeedChk(ierr);
 
   // Input Evecs and Restriction
-  ierr = CeedOperatorSetupInputs_Opt(numinputfields, qfinputfields,
-                                     opinputfields, invec, impl, request);
-  CeedChk(ierr);
+  ierr = CeedOperatorSetupInputs_Opt(numinputfields, Q, blksize, nblks,
+                                     qfinputfields, opinputfields, invecs[0],
+                                     batchvecs, impl, request); CeedChk(ierr);
 
   // Output Lvecs, Evecs, and Qvecs
   for (CeedInt i=0; i<numoutputfields; i++) {
@@ -493,30 +1240,186 @@ static int CeedOperatorApplyAdd_Opt(CeedOperator op, CeedVector invec,
     }
   }
 
-  // Loop through elements
-  for (CeedInt e=0; e<nblks*blksize; e+=blksize) {
-    // Input basis apply
-    ierr = CeedOperatorInputBasis_Opt(e, Q, qfinputfields, opinputfields,
-                                      numinputfields, blksize, invec, false,
-                                      impl, request); CeedChk(ierr);
+  // Active input E-vector for the inner product
+  CeedVector ein = NULL;
+  if (dot) {
+    CeedVector vec;
+    *dot = 0;
+    for (CeedInt i=0; i<numinputfields && !ein; i++) {
+      ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+      if (vec == CEED_VECTOR_ACTIVE)
+        ein = impl->evecsin[i];
+    }
+  }
 
-    // Q function
-    if (!impl->identityqf) {
-      ierr = CeedQFunctionApply(qf, Q*blksize, impl->qvecsin, impl->qvecsout);
+  // Loop through full element blocks
+  CeedInt numfields = numinputfields + numoutputfields;
+  for (CeedInt e=0; e<numelements-impl->tailsize; e+=blksize) {
+    // Prefetch streamed inputs
+    if (impl->srange) {
+      ierr = CeedOperatorPrefetchInputs_Opt(numinputfields, e/blksize, nblks,
+                                            impl); CeedChk(ierr);
+    }
+
+    for (CeedInt b=0; b<nbatch; b++) {
+      CeedVector *memberbatchvecs = batchvecs ? &batchvecs[b*numfields] : NULL;
+
+      // Input basis apply
+      ierr = CeedOperatorInputBasis_Opt(e, Q, qfinputfields, opinputfields,
+                                        numinputfields, blksize, invecs[b],
+                                        memberbatchvecs, false, impl, request);
+      CeedChk(ierr);
+
+      // Q function
+      if (!impl->identityqf) {
+        CeedPerfStart(impl->perf, CEED_PERF_QFUNCTION);
+        ierr = CeedQFunctionApply(qf, Q*blksize, impl->qvecsin, impl->qvecsout);
+        CeedChk(ierr);
+        CeedPerfStop(impl->perf, CEED_PERF_QFUNCTION);
+      }
+
+      // Output basis apply and restrict
+      ierr = CeedOperatorOutputBasis_Opt(e, Q, qfoutputfields, opoutputfields,
+                                         blksize, numinputfields,
+                                         numoutputfields, op, outvecs[b],
+                                         memberbatchvecs, impl, request);
       CeedChk(ierr);
+
+      // Inner product, over every lane as this loop only visits full blocks;
+      //   the partial last block is summed by the tail path
+      for (CeedInt i=0; dot && i<numoutputfields; i++) {
+        CeedVector vec;
+        ierr = CeedOperatorFieldGetVector(opoutputfields[i], &vec);
+        CeedChk(ierr);
+        if (vec == CEED_VECTOR_ACTIVE) {
+          ierr = CeedOperatorDotBlock_Opt(ein, impl->evecsout[i], dot);
+          CeedChk(ierr);
+        }
+      }
     }
+  }
 
-    // Output basis apply and restrict
-    ierr = CeedOperatorOutputBasis_Opt(e, Q, qfoutputfields, opoutputfields,
-                                       blksize, numinputfields, numoutputfields,
-                                       op, outvec, impl, request);
-    CeedChk(ierr);
+  // Partial last block
+  if (impl->tailsize) {
+    ierr = CeedOperatorApplyTail_Opt(op, nbatch, invecs, outvecs, batchvecs,
+                                     dot, impl, request); CeedChk(ierr);
   }
 
   // Restore input arrays
   ierr = CeedOperatorRestoreInputs_Opt(numinputfields, qfinputfields,
                                        opinputfields, impl);
   CeedChk(ierr);
+  ierr = CeedRestoreScratchVectors(ceed, impl->numscratch, impl->scratchvecs,
+                                   &scratch); CeedChk(ierr);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Operator Apply
+//------------------------------------------------------------------------------
+static int CeedOperatorApplyAdd_Opt(CeedOperator op, CeedVector invec,
+                                    CeedVector outvec, CeedRequest *request) {
+  int ierr;
+  CeedOperator_Opt *impl;
+  ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
+
+  // Fused kernel for gallery operators, unless phases are being timed
+  if (!impl->fusedchecked) {
+    ierr = CeedOperatorSetupFused_Opt(op); CeedChk(ierr);
+  }
+  CeedPerf perf;
+  ierr = CeedOperatorGetPerf(op, &perf); CeedChk(ierr);
+  if (impl->fused && !perf)
+    return CeedOperatorApplyAddFused_Opt(op, invec, outvec);
+
+  return CeedOperatorApplyAddCore_Opt(op, 1, &invec, &outvec, NULL, NULL,
+                                      request);
+}
+
+//------------------------------------------------------------------------------
+// Operator Apply with Inner Product
+//   The fused kernels are not used, as they do not form E-vectors
+//------------------------------------------------------------------------------
+static int CeedOperatorApplyAddDot_Opt(CeedOperator op, CeedVector invec,
+                                       CeedVector outvec, CeedScalar *dot,
+                                       CeedRequest *request) {
+  return CeedOperatorApplyAddCore_Opt(op, 1, &invec, &outvec, NULL, dot,
+                                      request);
+}
+
+//------------------------------------------------------------------------------
+// Operator Apply Batch
+//------------------------------------------------------------------------------
+static int CeedOperatorApplyAddBatch_Opt(CeedOperator op, CeedInt nbatch,
+    CeedVector invec, CeedVector outvec, CeedRequest *request) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  CeedInt numinputfields, numoutputfields;
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  ierr= CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
+  CeedChk(ierr);
+  CeedOperatorField *opinputfields, *opoutputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, &opoutputfields);
+  CeedChk(ierr);
+  CeedInt numfields = numinputfields + numoutputfields;
+  CeedVector *invecs, *outvecs, *batchvecs;
+  ierr = CeedCalloc(nbatch, &invecs); CeedChk(ierr);
+  ierr = CeedCalloc(nbatch, &outvecs); CeedChk(ierr);
+  ierr = CeedCalloc(nbatch*numfields, &batchvecs); CeedChk(ierr);
+
+  // Member views of active and batched passive vectors
+  for (CeedInt b=0; b<nbatch; b++) {
+    CeedInt length;
+    invecs[b] = invec;
+    if (invec && invec != CEED_VECTOR_NONE) {
+      ierr = CeedVectorGetLength(invec, &length); CeedChk(ierr);
+      ierr = CeedVectorCreateView(invec, b*(length/nbatch), length/nbatch,
+                                  &invecs[b]); CeedChk(ierr);
+    }
+    outvecs[b] = outvec;
+    if (outvec && outvec != CEED_VECTOR_NONE) {
+      ierr = CeedVectorGetLength(outvec, &length); CeedChk(ierr);
+      ierr = CeedVectorCreateView(outvec, b*(length/nbatch), length/nbatch,
+                                  &outvecs[b]); CeedChk(ierr);
+    }
+    for (CeedInt i=0; i<numfields; i++) {
+      CeedOperatorField field = i < numinputfields ? opinputfields[i] :
+                                opoutputfields[i-numinputfields];
+      bool isbatched;
+      ierr = CeedOperatorFieldIsBatched(field, nbatch, &isbatched);
+      CeedChk(ierr);
+      if (isbatched) {
+        CeedVector vec;
+        ierr = CeedOperatorFieldGetVector(field, &vec); CeedChk(ierr);
+        ierr = CeedVectorGetLength(vec, &length); CeedChk(ierr);
+        ierr = CeedVectorCreateView(vec, b*(length/nbatch), length/nbatch,
+                                    &batchvecs[b*numfields+i]); CeedChk(ierr);
+      }
+    }
+  }
+
+  // Apply
+  ierr = CeedOperatorApplyAddCore_Opt(op, nbatch, invecs, outvecs, batchvecs,
+                                      NULL, request); CeedChk(ierr);
+
+  // Cleanup
+  for (CeedInt b=0; b<nbatch; b++) {
+    if (invecs[b] != invec) {
+      ierr = CeedVectorDestroy(&invecs[b]); CeedChk(ierr);
+    }
+    if (outvecs[b] != outvec) {
+      ierr = CeedVectorDestroy(&outvecs[b]); CeedChk(ierr);
+    }
+  }
+  for (CeedInt i=0; i<nbatch*numfields; i++) {
+    ierr = CeedVectorDestroy(&batchvecs[i]); CeedChk(ierr);
+  }
+  ierr = CeedFree(&invecs); CeedChk(ierr);
+  ierr = CeedFree(&outvecs); CeedChk(ierr);
+  ierr = CeedFree(&batchvecs); CeedChk(ierr);
 
   return 0;
 }
@@ -555,17 +1458,21 @@ static int CeedOperatorLinearAssembleQFunction_Opt(CeedOperator op,
 
   // Setup
   ierr = CeedOperatorSetup_Opt(op); CeedChk(ierr);
+  ierr = CeedOperatorGetPerf(op, &impl->perf); CeedChk(ierr);
 
   // Check for identity
   if (impl->identityqf)
     // LCOV_EXCL_START
     return CeedError(ceed, 1, "Assembling identity qfunctions not supported");
   // LCOV_EXCL_STOP
+  CeedScalar *scratch;
+  ierr = CeedGetScratchVectors(ceed, impl->numscratch, impl->scratchvecs,
+                               &scratch); CeedChk(ierr);
 
   // Input Evecs and Restriction
-  ierr = CeedOperatorSetupInputs_Opt(numinputfields, qfinputfields,
-                                     opinputfields, NULL, impl, request);
-  CeedChk(ierr);
+  ierr = CeedOperatorSetupInputs_Opt(numinputfields, Q, blksize, nblks,
+                                     qfinputfields, opinputfields, NULL, NULL,
+                                     impl, request); CeedChk(ierr);
 
   // Count number of active input fields
   for (CeedInt i=0; i<numinputfields; i++) {
@@ -627,8 +1534,8 @@ static int CeedOperatorLinearAssembleQFunction_Opt(CeedOperator op,
   for (CeedInt e=0; e<nblks*blksize; e+=blksize) {
     // Input basis apply
     ierr = CeedOperatorInputBasis_Opt(e, Q, qfinputfields, opinputfields,
-                                      numinputfields, blksize, NULL, true,
-                                      impl, request); CeedChk(ierr);
+                                      numinputfields, blksize, NULL, NULL,
+                                      true, impl, request); CeedChk(ierr);
 
     // Assemble QFunction
     for (CeedInt in=0; in<numactivein; in++) {
@@ -674,6 +1581,8 @@ static int CeedOperatorLinearAssembleQFunction_Opt(CeedOperator op,
   ierr = CeedOperatorRestoreInputs_Opt(numinputfields, qfinputfields,
                                        opinputfields, impl);
   CeedChk(ierr);
+  ierr = CeedRestoreScratchVectors(ceed, impl->numscratch, impl->scratchvecs,
+                                   &scratch); CeedChk(ierr);
 
   // Output blocked restriction
   ierr = CeedVectorRestoreArray(lvec, &a); CeedChk(ierr);
@@ -705,13 +1614,23 @@ static int CeedOperatorDestroy_Opt(CeedOperator op) {
   ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
 
   for (CeedInt i=0; i<impl->numein+impl->numeout; i++) {
+    // Only passive inputs have E-vectors, shared unless compressed
+    if (impl->evecs[i] && !(impl->cexpand && impl->cexpand[i])) {
+      Ceed ceed;
+      ierr = CeedElemRestrictionGetCeed(impl->blkrestr[i], &ceed);
+      CeedChk(ierr);
+      ierr = CeedRestoreCachedEVector(ceed, &impl->evecs[i]); CeedChk(ierr);
+    } else {
+      ierr = CeedVectorDestroy(&impl->evecs[i]); CeedChk(ierr);
+    }
     ierr = CeedElemRestrictionDestroy(&impl->blkrestr[i]); CeedChk(ierr);
-    ierr = CeedVectorDestroy(&impl->evecs[i]); CeedChk(ierr);
   }
   ierr = CeedFree(&impl->blkrestr); CeedChk(ierr);
   ierr = CeedFree(&impl->evecs); CeedChk(ierr);
   ierr = CeedFree(&impl->edata); CeedChk(ierr);
   ierr = CeedFree(&impl->inputstate); CeedChk(ierr);
+  ierr = CeedFree(&impl->ghoststate); CeedChk(ierr);
+  ierr = CeedFree(&impl->constin); CeedChk(ierr);
 
   for (CeedInt i=0; i<impl->numein; i++) {
     ierr = CeedVectorDestroy(&impl->evecsin[i]); CeedChk(ierr);
@@ -727,6 +1646,47 @@ static int CeedOperatorDestroy_Opt(CeedOperator op) {
   ierr = CeedFree(&impl->evecsout); CeedChk(ierr);
   ierr = CeedFree(&impl->qvecsout); CeedChk(ierr);
 
+  if (impl->tailsize) {
+    for (CeedInt i=0; i<impl->numein+impl->numeout; i++) {
+      ierr = CeedElemRestrictionDestroy(&impl->tailrestr[i]); CeedChk(ierr);
+      ierr = CeedVectorDestroy(&impl->tailevecs[i]); CeedChk(ierr);
+    }
+    for (CeedInt i=0; i<impl->numein; i++) {
+      ierr = CeedVectorDestroy(&impl->tailqvecsin[i]); CeedChk(ierr);
+    }
+    for (CeedInt i=0; i<impl->numeout; i++) {
+      ierr = CeedVectorDestroy(&impl->tailqvecsout[i]); CeedChk(ierr);
+    }
+    ierr = CeedFree(&impl->tailrestr); CeedChk(ierr);
+    ierr = CeedFree(&impl->tailevecs); CeedChk(ierr);
+    ierr = CeedFree(&impl->tailqvecsin); CeedChk(ierr);
+    ierr = CeedFree(&impl->tailqvecsout); CeedChk(ierr);
+  }
+  ierr = CeedFree(&impl->scratchvecs); CeedChk(ierr);
+
+  if (impl->cexpand) {
+    for (CeedInt i=0; i<impl->numein; i++) {
+      ierr = CeedFree(&impl->cdata[i]); CeedChk(ierr);
+      ierr = CeedFree(&impl->cmode[i]); CeedChk(ierr);
+      ierr = CeedFree(&impl->coffset[i]); CeedChk(ierr);
+      ierr = CeedFree(&impl->cexpand[i]); CeedChk(ierr);
+    }
+    ierr = CeedFree(&impl->cdata); CeedChk(ierr);
+    ierr = CeedFree(&impl->cmode); CeedChk(ierr);
+    ierr = CeedFree(&impl->coffset); CeedChk(ierr);
+    ierr = CeedFree(&impl->cexpand); CeedChk(ierr);
+    ierr = CeedFree(&impl->qweight); CeedChk(ierr);
+  }
+
+  if (impl->srange) {
+    for (CeedInt i=0; i<impl->numein; i++) {
+      ierr = CeedFree(&impl->srange[i]); CeedChk(ierr);
+    }
+    ierr = CeedFree(&impl->srange); CeedChk(ierr);
+    ierr = CeedFree(&impl->sdata); CeedChk(ierr);
+    ierr = CeedFree(&impl->sahead); CeedChk(ierr);
+  }
+
   ierr = CeedFree(&impl); CeedChk(ierr);
   return 0;
 }
@@ -746,7 +1706,7 @@ int CeedOperatorCreate_Opt(CeedOperator op) {
   ierr = CeedCalloc(1, &impl); CeedChk(ierr);
   ierr = CeedOperatorSetData(op, impl); CeedChk(ierr);
 
-  if (blksize != 1 && blksize != 8)
+  if (blksize < 1 || blksize > CEED_OPT_MAX_BLKSIZE)
     // LCOV_EXCL_START
     return CeedError(ceed, 1, "Opt backend cannot use blocksize: %d", blksize);
   // LCOV_EXCL_STOP
@@ -756,6 +1716,12 @@ int CeedOperatorCreate_Opt(CeedOperator op) {
   CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "Operator", op, "ApplyAdd",
                                 CeedOperatorApplyAdd_Opt); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "ApplyAddBatch",
+                                CeedOperatorApplyAddBatch_Opt); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "ApplyAddDot",
+                                CeedOperatorApplyAddDot_Opt); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "Setup",
+                                CeedOperatorSetup_Opt); CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "Operator", op, "Destroy",
                                 CeedOperatorDestroy_Opt); CeedChk(ierr);
   return 0;
@@ -17,6 +17,9 @@
 #include <ceed-backend.h>
 #include <string.h>
 
+// Largest number of elements interlaced in a block
+#define CEED_OPT_MAX_BLKSIZE 64
+
 typedef struct {
   CeedInt blksize;
 } Ceed_Opt;
@@ -25,6 +28,12 @@ typedef struct {
   CeedScalar *colograd1d;
 } CeedBasis_Opt;
 
+// Fused restriction, basis, gallery QFunction, and transpose for all elements
+typedef int (*CeedOperatorFusedKernel_Opt)(CeedInt nelem,
+    const CeedInt *offsets, const CeedScalar *B, const CeedScalar *G,
+    const CeedScalar *qd, const CeedInt *qdstrides, const CeedScalar *u,
+    CeedScalar *v);
+
 typedef struct {
   bool identityqf;
   CeedElemRestriction *blkrestr; /// Blocked versions of restrictions
@@ -32,12 +41,40 @@ typedef struct {
   *evecs;   /// E-vectors needed to apply operator (input followed by outputs)
   CeedScalar **edata;
   uint64_t *inputstate;  /// State counter of inputs
+  uint64_t *ghoststate;  /// State counter of ghost inputs of restrictions
   CeedVector *evecsin;   /// Input E-vectors needed to apply operator
   CeedVector *evecsout;  /// Output E-vectors needed to apply operator
   CeedVector *qvecsin;   /// Input Q-vectors needed to apply operator
   CeedVector *qvecsout;  /// Output Q-vectors needed to apply operator
   CeedInt    numein;
   CeedInt    numeout;
+  bool       *constin;  /// Passive inputs with a constant restriction,
+  ///                        broadcast into the block E-vector
+  CeedScalar **cdata;   /// Compressed passive inputs, packed by block
+  CeedInt    **cmode;   /// Compression mode of each block of a passive input
+  CeedInt    **coffset; /// Offset of each block in compressed data
+  CeedScalar **cexpand; /// Block of a compressed input expanded to all points
+  CeedScalar *qweight;  /// Quadrature weights of a single element
+  CeedInt    **srange;  /// L-vector index range of each block of a streamed
+  ///                        passive input, NULL if not streamed
+  const CeedScalar **sdata; /// L-vector arrays of streamed inputs
+  CeedInt    *sahead;   /// First block of a streamed input not yet prefetched
+  CeedInt    tailsize;  /// Elements in the partial last block, 0 if none
+  CeedElemRestriction *tailrestr; /// Restrictions of the partial last block
+  CeedVector *tailevecs; /// E-vectors of the partial last block
+  CeedVector *tailqvecsin;  /// Input Q-vectors of the partial last block
+  CeedVector *tailqvecsout; /// Output Q-vectors of the partial last block
+  CeedVector *scratchvecs; /// Block vectors backed by the scratch pool of the
+  ///                           Ceed while the operator is applied
+  CeedInt    numscratch;
+  CeedPerf   perf;      /// Performance counters of current application
+  bool       fusedchecked; /// Fused kernel selection done
+  CeedOperatorFusedKernel_Opt fused; /// Fused kernel, NULL if not applicable
 } CeedOperator_Opt;
 
 CEED_INTERN int CeedOperatorCreate_Opt(CeedOperator op);
+
+CEED_INTERN int CeedOperatorSetupFused_Opt(CeedOperator op);
+
+CEED_INTERN int CeedOperatorApplyAddFused_Opt(CeedOperator op,
+    CeedVector invec, CeedVector outvec);
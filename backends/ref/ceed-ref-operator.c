@@ -47,9 +47,39 @@ static int CeedOperatorSetupFields_Ref(CeedQFunction qf, CeedOperator op,
     if (emode != CEED_EVAL_WEIGHT) {
       ierr = CeedOperatorFieldGetElemRestriction(opfields[i], &Erestrict);
       CeedChk(ierr);
-      ierr = CeedElemRestrictionCreateVector(Erestrict, NULL,
-                                             &fullevecs[i+starte]);
+      CeedVector vec;
+      ierr = CeedOperatorFieldGetVector(opfields[i], &vec); CeedChk(ierr);
+      bool isconstant;
+      ierr = CeedElemRestrictionIsConstant(Erestrict, &isconstant);
       CeedChk(ierr);
+      if (!inOrOut && vec != CEED_VECTOR_ACTIVE && emode == CEED_EVAL_NONE &&
+          isconstant) {
+        // Constant passive inputs are broadcast into the Q-vector and need no
+        //   E-vector
+      } else if (!inOrOut && vec != CEED_VECTOR_ACTIVE) {
+        // Passive inputs share E-vectors with other operators of the Ceed of
+        //   the restriction
+        Ceed ceedrstr;
+        ierr = CeedElemRestrictionGetCeed(Erestrict, &ceedrstr); CeedChk(ierr);
+        ierr = CeedGetCachedEVector(ceedrstr, Erestrict, 1, vec, Erestrict,
+                                    &fullevecs[i+starte]); CeedChk(ierr);
+        // Restrict now, so CeedOperatorSetupAll() also takes this out of the
+        //   first application; vectors holding a batch are left for apply
+        CeedInt lsize, length;
+        ierr = CeedElemRestrictionGetLVectorSize(Erestrict, &lsize);
+        CeedChk(ierr);
+        ierr = CeedVectorGetLength(vec, &length); CeedChk(ierr);
+        if (length == lsize) {
+          ierr = CeedUpdateCachedEVector(ceedrstr, Erestrict, vec,
+                                         fullevecs[i+starte],
+                                         CEED_REQUEST_IMMEDIATE);
+          CeedChk(ierr);
+        }
+      } else {
+        ierr = CeedElemRestrictionCreateVector(Erestrict, NULL,
+                                               &fullevecs[i+starte]);
+        CeedChk(ierr);
+      }
     }
 
     switch(emode) {
@@ -88,6 +118,48 @@ static int CeedOperatorSetupFields_Ref(CeedQFunction qf, CeedOperator op,
   return 0;
 }
 
+//------------------------------------------------------------------------------
+// Setup Scratch Vectors
+//   Lists the active input and the output E-vectors and the Q-vectors, which
+//   only hold data during an application, so they can share the scratch pool
+//   of the Ceed with other operators. Passive input E-vectors stay cached and
+//   Q-vectors for CEED_EVAL_NONE point into E-vectors.
+//------------------------------------------------------------------------------
+static int CeedOperatorSetupScratch_Ref(CeedOperator op, CeedQFunction qf,
+    CeedOperator_Ref *impl) {
+  int ierr;
+  const CeedInt numin = impl->numein, numout = impl->numeout;
+  CeedInt n = 0;
+  CeedOperatorField *opinputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, NULL); CeedChk(ierr);
+  CeedQFunctionField *qfinputfields, *qfoutputfields;
+  ierr = CeedQFunctionGetFields(qf, &qfinputfields, &qfoutputfields);
+  CeedChk(ierr);
+
+  ierr = CeedCalloc(2*(numin + numout), &impl->scratchvecs); CeedChk(ierr);
+  for (CeedInt i=0; i<numin + numout; i++) {
+    const bool isin = i < numin;
+    CeedEvalMode emode;
+    ierr = CeedQFunctionFieldGetEvalMode(isin ? qfinputfields[i] :
+                                         qfoutputfields[i-numin], &emode);
+    CeedChk(ierr);
+    if (emode == CEED_EVAL_WEIGHT)
+      continue;
+    CeedVector vec = CEED_VECTOR_ACTIVE;
+    if (isin) {
+      ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+    }
+    if (vec == CEED_VECTOR_ACTIVE)
+      impl->scratchvecs[n++] = impl->evecs[i];
+    if (emode == CEED_EVAL_INTERP || emode == CEED_EVAL_GRAD)
+      impl->scratchvecs[n++] = isin ? impl->qvecsin[i] :
+                               impl->qvecsout[i-numin];
+  }
+  impl->numscratch = n;
+
+  return 0;
+}
+
 //------------------------------------------------------------------------------
 // Setup Operator
 //------------------------------------------------------------------------------/*
@@ -120,7 +192,6 @@ static int CeedOperatorSetup_Ref(CeedOperator op) {
   ierr = CeedCalloc(numinputfields + numoutputfields, &impl->edata);
   CeedChk(ierr);
 
-  ierr = CeedCalloc(16, &impl->inputstate); CeedChk(ierr);
   ierr = CeedCalloc(16, &impl->evecsin); CeedChk(ierr);
   ierr = CeedCalloc(16, &impl->evecsout); CeedChk(ierr);
   ierr = CeedCalloc(16, &impl->qvecsin); CeedChk(ierr);
@@ -158,6 +229,9 @@ static int CeedOperatorSetup_Ref(CeedOperator op) {
     }
   }
 
+  // Scratch vectors
+  ierr = CeedOperatorSetupScratch_Ref(op, qf, impl); CeedChk(ierr);
+
   ierr = CeedOperatorSetSetupDone(op); CeedChk(ierr);
 
   return 0;
@@ -174,7 +248,6 @@ static inline int CeedOperatorSetupInputs_Ref(CeedInt numinputfields,
   CeedEvalMode emode;
   CeedVector vec;
   CeedElemRestriction Erestrict;
-  uint64_t state;
 
   for (CeedInt i=0; i<numinputfields; i++) {
     // Get input vector
@@ -191,15 +264,23 @@ static inline int CeedOperatorSetupInputs_Ref(CeedInt numinputfields,
     // Restrict and Evec
     if (emode == CEED_EVAL_WEIGHT) { // Skip
     } else {
-      // Restrict
-      ierr = CeedVectorGetState(vec, &state); CeedChk(ierr);
-      // Skip restriction if input is unchanged
-      if (state != impl->inputstate[i] || vec == invec) {
-        ierr = CeedOperatorFieldGetElemRestriction(opinputfields[i], &Erestrict);
-        CeedChk(ierr);
+      // Restrict active input; passive inputs are only restricted when
+      //   changed, sharing the E-vector with other operators
+      ierr = CeedOperatorFieldGetElemRestriction(opinputfields[i], &Erestrict);
+      CeedChk(ierr);
+      if (!impl->evecs[i]) {
+        // Constant input, broadcast into the Q-vector
+        ierr = CeedElemRestrictionApplyConstant(Erestrict, 1, vec,
+                                                impl->qvecsin[i]); CeedChk(ierr);
+        continue;
+      } else if (vec == invec) {
         ierr = CeedElemRestrictionApply(Erestrict, CEED_NOTRANSPOSE, vec,
                                         impl->evecs[i], request); CeedChk(ierr);
-        impl->inputstate[i] = state;
+      } else {
+        Ceed ceed;
+        ierr = CeedElemRestrictionGetCeed(Erestrict, &ceed); CeedChk(ierr);
+        ierr = CeedUpdateCachedEVector(ceed, Erestrict, vec, impl->evecs[i],
+                                       request); CeedChk(ierr);
       }
       // Get evec
       ierr = CeedVectorGetArrayRead(impl->evecs[i], CEED_MEM_HOST,
@@ -241,6 +322,8 @@ static inline int CeedOperatorInputBasis_Ref(CeedInt e, CeedInt Q,
     // Basis action
     switch(emode) {
     case CEED_EVAL_NONE:
+      if (!impl->evecs[i]) // Constant input, already broadcast
+        break;
       ierr = CeedVectorSetArray(impl->qvecsin[i], CEED_MEM_HOST,
                                 CEED_USE_POINTER,
                                 &impl->edata[i][e*Q*size]); CeedChk(ierr);
@@ -371,7 +454,7 @@ static inline int CeedOperatorRestoreInputs_Ref(CeedInt numinputfields,
     // Restore input
     ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
     CeedChk(ierr);
-    if (emode == CEED_EVAL_WEIGHT) { // Skip
+    if (emode == CEED_EVAL_WEIGHT || !impl->evecs[i]) { // Skip
     } else {
       ierr = CeedVectorRestoreArrayRead(impl->evecs[i],
                                         (const CeedScalar **) &impl->edata[i]);
@@ -382,10 +465,13 @@ static inline int CeedOperatorRestoreInputs_Ref(CeedInt numinputfields,
 }
 
 //------------------------------------------------------------------------------
-// Operator Apply
+// Operator Apply Core
+//   With dot non-NULL, also computes the inner product of the active input
+//   E-vector with the active output E-vectors, which share its restriction.
 //------------------------------------------------------------------------------
-static int CeedOperatorApplyAdd_Ref(CeedOperator op, CeedVector invec,
-                                    CeedVector outvec, CeedRequest *request) {
+static int CeedOperatorApplyAddCore_Ref(CeedOperator op, CeedVector invec,
+                                        CeedVector outvec, CeedScalar *dot,
+                                        CeedRequest *request) {
   int ierr;
   CeedOperator_Ref *impl;
   ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
@@ -405,14 +491,23 @@ static int CeedOperatorApplyAdd_Ref(CeedOperator op, CeedVector invec,
   CeedEvalMode emode;
   CeedVector vec;
   CeedElemRestriction Erestrict;
+  CeedPerf perf;
+  ierr = CeedOperatorGetPerf(op, &perf); CeedChk(ierr);
 
   // Setup
   ierr = CeedOperatorSetup_Ref(op); CeedChk(ierr);
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  CeedScalar *scratch;
+  ierr = CeedGetScratchVectors(ceed, impl->numscratch, impl->scratchvecs,
+                               &scratch); CeedChk(ierr);
 
   // Input Evecs and Restriction
+  CeedPerfStart(perf, CEED_PERF_RESTRICTION);
   ierr = CeedOperatorSetupInputs_Ref(numinputfields, qfinputfields,
                                      opinputfields, invec, false, impl,
                                      request); CeedChk(ierr);
+  CeedPerfStop(perf, CEED_PERF_RESTRICTION);
 
   // Output Evecs
   for (CeedInt i=0; i<numoutputfields; i++) {
@@ -437,20 +532,48 @@ static int CeedOperatorApplyAdd_Ref(CeedOperator op, CeedVector invec,
     }
 
     // Input basis apply
+    CeedPerfStart(perf, CEED_PERF_BASIS);
     ierr = CeedOperatorInputBasis_Ref(e, Q, qfinputfields, opinputfields,
                                       numinputfields, false, impl);
     CeedChk(ierr);
+    CeedPerfStop(perf, CEED_PERF_BASIS);
 
     // Q function
     if (!impl->identityqf) {
+      CeedPerfStart(perf, CEED_PERF_QFUNCTION);
       ierr = CeedQFunctionApply(qf, Q, impl->qvecsin, impl->qvecsout);
       CeedChk(ierr);
+      CeedPerfStop(perf, CEED_PERF_QFUNCTION);
     }
 
     // Output basis apply
+    CeedPerfStart(perf, CEED_PERF_BASIS);
     ierr = CeedOperatorOutputBasis_Ref(e, Q, qfoutputfields, opoutputfields,
                                        numinputfields, numoutputfields, op, impl);
     CeedChk(ierr);
+    CeedPerfStop(perf, CEED_PERF_BASIS);
+  }
+
+  // Inner product of active input and output E-vectors
+  if (dot) {
+    CeedInt activein = -1, length;
+    for (CeedInt i=0; i<numinputfields && activein < 0; i++) {
+      ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+      if (vec == CEED_VECTOR_ACTIVE)
+        activein = i;
+    }
+    ierr = CeedVectorGetLength(impl->evecs[activein], &length); CeedChk(ierr);
+    const CeedScalar *ein = impl->edata[activein];
+    CeedScalar sum = 0;
+    for (CeedInt i=0; i<numoutputfields; i++) {
+      ierr = CeedOperatorFieldGetVector(opoutputfields[i], &vec); CeedChk(ierr);
+      if (vec != CEED_VECTOR_ACTIVE)
+        continue;
+      const CeedScalar *eout = impl->edata[i + numinputfields];
+      for (CeedInt k=0; k<length; k++)
+        sum += ein[k] * eout[k];
+    }
+    *dot = sum;
   }
 
   // Output restriction
@@ -467,9 +590,11 @@ static int CeedOperatorApplyAdd_Ref(CeedOperator op, CeedVector invec,
     // Restrict
     ierr = CeedOperatorFieldGetElemRestriction(opoutputfields[i], &Erestrict);
     CeedChk(ierr);
+    CeedPerfStart(perf, CEED_PERF_RESTRICTION);
     ierr = CeedElemRestrictionApply(Erestrict, CEED_TRANSPOSE,
                                     impl->evecs[i+impl->numein], vec, request);
     CeedChk(ierr);
+    CeedPerfStop(perf, CEED_PERF_RESTRICTION);
   }
 
   // Restore input arrays
@@ -477,9 +602,29 @@ static int CeedOperatorApplyAdd_Ref(CeedOperator op, CeedVector invec,
                                        opinputfields, false, impl);
   CeedChk(ierr);
 
+  ierr = CeedRestoreScratchVectors(ceed, impl->numscratch, impl->scratchvecs,
+                                   &scratch); CeedChk(ierr);
+
   return 0;
 }
 
+//------------------------------------------------------------------------------
+// Operator Apply
+//------------------------------------------------------------------------------
+static int CeedOperatorApplyAdd_Ref(CeedOperator op, CeedVector invec,
+                                    CeedVector outvec, CeedRequest *request) {
+  return CeedOperatorApplyAddCore_Ref(op, invec, outvec, NULL, request);
+}
+
+//------------------------------------------------------------------------------
+// Operator Apply with Inner Product
+//------------------------------------------------------------------------------
+static int CeedOperatorApplyAddDot_Ref(CeedOperator op, CeedVector invec,
+                                       CeedVector outvec, CeedScalar *dot,
+                                       CeedRequest *request) {
+  return CeedOperatorApplyAddCore_Ref(op, invec, outvec, dot, request);
+}
+
 //------------------------------------------------------------------------------
 // Assemble Linear QFunction
 //------------------------------------------------------------------------------
@@ -518,6 +663,9 @@ static int CeedOperatorLinearAssembleQFunction_Ref(CeedOperator op,
     // LCOV_EXCL_START
     return CeedError(ceed, 1, "Assembling identity QFunctions not supported");
   // LCOV_EXCL_STOP
+  CeedScalar *scratch;
+  ierr = CeedGetScratchVectors(ceed, impl->numscratch, impl->scratchvecs,
+                               &scratch); CeedChk(ierr);
 
   // Input Evecs and Restriction
   ierr = CeedOperatorSetupInputs_Ref(numinputfields, qfinputfields,
@@ -628,6 +776,8 @@ static int CeedOperatorLinearAssembleQFunction_Ref(CeedOperator op,
   ierr = CeedOperatorRestoreInputs_Ref(numinputfields, qfinputfields,
                                        opinputfields, true, impl);
   CeedChk(ierr);
+  ierr = CeedRestoreScratchVectors(ceed, impl->numscratch, impl->scratchvecs,
+                                   &scratch); CeedChk(ierr);
 
   // Restore output
   ierr = CeedVectorRestoreArray(*assembled, &a); CeedChk(ierr);
@@ -976,208 +1126,6 @@ static int CeedOperatorLinearAssembleAddPointBlockDiagonal_Ref(CeedOperator op,
   }
 }
 
-//------------------------------------------------------------------------------
-// Create FDM Element Inverse
-//------------------------------------------------------------------------------
-int CeedOperatorCreateFDMElementInverse_Ref(CeedOperator op,
-    CeedOperator *fdminv, CeedRequest *request) {
-  int ierr;
-  Ceed ceed, ceedparent;
-  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
-  ierr = CeedGetOperatorFallbackParentCeed(ceed, &ceedparent); CeedChk(ierr);
-  ceedparent = ceedparent ? ceedparent : ceed;
-  CeedQFunction qf;
-  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
-
-  // Determine active input basis
-  bool interp = false, grad = false;
-  CeedBasis basis = NULL;
-  CeedElemRestriction rstr = NULL;
-  CeedOperatorField *opfields;
-  CeedQFunctionField *qffields;
-  ierr = CeedOperatorGetFields(op, &opfields, NULL); CeedChk(ierr);
-  ierr = CeedQFunctionGetFields(qf, &qffields, NULL); CeedChk(ierr);
-  CeedInt numinputfields;
-  ierr = CeedQFunctionGetNumArgs(qf, &numinputfields, NULL); CeedChk(ierr);
-  for (CeedInt i=0; i<numinputfields; i++) {
-    CeedVector vec;
-    ierr = CeedOperatorFieldGetVector(opfields[i], &vec); CeedChk(ierr);
-    if (vec == CEED_VECTOR_ACTIVE) {
-      CeedEvalMode emode;
-      ierr = CeedQFunctionFieldGetEvalMode(qffields[i], &emode); CeedChk(ierr);
-      interp = interp || emode == CEED_EVAL_INTERP;
-      grad = grad || emode == CEED_EVAL_GRAD;
-      ierr = CeedOperatorFieldGetBasis(opfields[i], &basis); CeedChk(ierr);
-      ierr = CeedOperatorFieldGetElemRestriction(opfields[i], &rstr);
-      CeedChk(ierr);
-    }
-  }
-  if (!basis)
-    // LCOV_EXCL_START
-    return CeedError(ceed, 1, "No active field set");
-  // LCOV_EXCL_STOP
-  CeedInt P1d, Q1d, elemsize, nqpts, dim, ncomp = 1, nelem = 1, lsize = 1;
-  ierr = CeedBasisGetNumNodes1D(basis, &P1d); CeedChk(ierr);
-  ierr = CeedBasisGetNumNodes(basis, &elemsize); CeedChk(ierr);
-  ierr = CeedBasisGetNumQuadraturePoints1D(basis, &Q1d); CeedChk(ierr);
-  ierr = CeedBasisGetNumQuadraturePoints(basis, &nqpts); CeedChk(ierr);
-  ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
-  ierr = CeedBasisGetNumComponents(basis, &ncomp); CeedChk(ierr);
-  ierr = CeedElemRestrictionGetNumElements(rstr, &nelem); CeedChk(ierr);
-  ierr = CeedElemRestrictionGetLVectorSize(rstr, &lsize); CeedChk(ierr);
-
-  // Build and diagonalize 1D Mass and Laplacian
-  bool tensorbasis;
-  ierr = CeedBasisIsTensor(basis, &tensorbasis); CeedChk(ierr);
-  if (!tensorbasis)
-    // LCOV_EXCL_START
-    return CeedError(ceed, 1, "FDMElementInverse only supported for tensor "
-                     "bases");
-  // LCOV_EXCL_STOP
-  CeedScalar *work, *mass, *laplace, *x, *x2, *lambda;
-  ierr = CeedMalloc(Q1d*P1d, &work); CeedChk(ierr);
-  ierr = CeedMalloc(P1d*P1d, &mass); CeedChk(ierr);
-  ierr = CeedMalloc(P1d*P1d, &laplace); CeedChk(ierr);
-  ierr = CeedMalloc(P1d*P1d, &x); CeedChk(ierr);
-  ierr = CeedMalloc(P1d*P1d, &x2); CeedChk(ierr);
-  ierr = CeedMalloc(P1d, &lambda); CeedChk(ierr);
-  // -- Mass
-  const CeedScalar *interp1d, *grad1d, *qweight1d;
-  ierr = CeedBasisGetInterp1D(basis, &interp1d); CeedChk(ierr);
-  ierr = CeedBasisGetGrad1D(basis, &grad1d); CeedChk(ierr);
-  ierr = CeedBasisGetQWeights(basis, &qweight1d); CeedChk(ierr);
-  for (CeedInt i=0; i<Q1d; i++)
-    for (CeedInt j=0; j<P1d; j++)
-      work[i+j*Q1d] = interp1d[i*P1d+j]*qweight1d[i];
-  ierr = CeedMatrixMultiply(ceed, (const CeedScalar *)work,
-                            (const CeedScalar *)interp1d, mass, P1d, P1d, Q1d);
-  CeedChk(ierr);
-  // -- Laplacian
-  for (CeedInt i=0; i<Q1d; i++)
-    for (CeedInt j=0; j<P1d; j++)
-      work[i+j*Q1d] = grad1d[i*P1d+j]*qweight1d[i];
-  ierr = CeedMatrixMultiply(ceed, (const CeedScalar *)work,
-                            (const CeedScalar *)grad1d, laplace, P1d, P1d, Q1d);
-  CeedChk(ierr);
-  // -- Diagonalize
-  ierr = CeedSimultaneousDiagonalization(ceed, laplace, mass, x, lambda, P1d);
-  CeedChk(ierr);
-  ierr = CeedFree(&work); CeedChk(ierr);
-  ierr = CeedFree(&mass); CeedChk(ierr);
-  ierr = CeedFree(&laplace); CeedChk(ierr);
-  for (CeedInt i=0; i<P1d; i++)
-    for (CeedInt j=0; j<P1d; j++)
-      x2[i+j*P1d] = x[j+i*P1d];
-  ierr = CeedFree(&x); CeedChk(ierr);
-
-  // Assemble QFunction
-  CeedVector assembled;
-  CeedElemRestriction rstr_qf;
-  ierr =  CeedOperatorLinearAssembleQFunction(op, &assembled, &rstr_qf,
-          request); CeedChk(ierr);
-  ierr = CeedElemRestrictionDestroy(&rstr_qf); CeedChk(ierr);
-  CeedScalar maxnorm = 0;
-  ierr = CeedVectorNorm(assembled, CEED_NORM_MAX, &maxnorm); CeedChk(ierr);
-
-  // Calculate element averages
-  CeedInt nfields = ((interp?1:0) + (grad?dim:0))*((interp?1:0) + (grad?dim:0));
-  CeedScalar *elemavg;
-  const CeedScalar *assembledarray, *qweightsarray;
-  CeedVector qweights;
-  ierr = CeedVectorCreate(ceedparent, nqpts, &qweights); CeedChk(ierr);
-  ierr = CeedBasisApply(basis, 1, CEED_NOTRANSPOSE, CEED_EVAL_WEIGHT,
-                        CEED_VECTOR_NONE, qweights); CeedChk(ierr);
-  ierr = CeedVectorGetArrayRead(assembled, CEED_MEM_HOST, &assembledarray);
-  CeedChk(ierr);
-  ierr = CeedVectorGetArrayRead(qweights, CEED_MEM_HOST, &qweightsarray);
-  CeedChk(ierr);
-  ierr = CeedCalloc(nelem, &elemavg); CeedChk(ierr);
-  for (CeedInt e=0; e<nelem; e++) {
-    CeedInt count = 0;
-    for (CeedInt q=0; q<nqpts; q++)
-      for (CeedInt i=0; i<ncomp*ncomp*nfields; i++)
-        if (fabs(assembledarray[e*nelem*nqpts*ncomp*ncomp*nfields +
-                                                                  i*nqpts + q]) > maxnorm*1e-12) {
-          elemavg[e] += assembledarray[e*nelem*nqpts*ncomp*ncomp*nfields +
-                                       i*nqpts + q] / qweightsarray[q];
-          count++;
-        }
-    if (count)
-      elemavg[e] /= count;
-  }
-  ierr = CeedVectorRestoreArrayRead(assembled, &assembledarray); CeedChk(ierr);
-  ierr = CeedVectorDestroy(&assembled); CeedChk(ierr);
-  ierr = CeedVectorRestoreArrayRead(qweights, &qweightsarray); CeedChk(ierr);
-  ierr = CeedVectorDestroy(&qweights); CeedChk(ierr);
-
-  // Build FDM diagonal
-  CeedVector qdata;
-  CeedScalar *qdataarray;
-  ierr = CeedVectorCreate(ceedparent, nelem*ncomp*lsize, &qdata); CeedChk(ierr);
-  ierr = CeedVectorSetArray(qdata, CEED_MEM_HOST, CEED_COPY_VALUES, NULL);
-  CeedChk(ierr);
-  ierr = CeedVectorGetArray(qdata, CEED_MEM_HOST, &qdataarray); CeedChk(ierr);
-  for (CeedInt e=0; e<nelem; e++)
-    for (CeedInt c=0; c<ncomp; c++)
-      for (CeedInt n=0; n<lsize; n++) {
-        if (interp)
-          qdataarray[(e*ncomp+c)*lsize+n] = 1;
-        if (grad)
-          for (CeedInt d=0; d<dim; d++) {
-            CeedInt i = (n / CeedIntPow(P1d, d)) % P1d;
-            qdataarray[(e*ncomp+c)*lsize+n] += lambda[i];
-          }
-        qdataarray[(e*ncomp+c)*lsize+n] = 1 / (elemavg[e] *
-                                               qdataarray[(e*ncomp+c)*lsize+n]);
-      }
-  ierr = CeedFree(&elemavg); CeedChk(ierr);
-  ierr = CeedVectorRestoreArray(qdata, &qdataarray); CeedChk(ierr);
-
-  // Setup FDM operator
-  // -- Basis
-  CeedBasis fdm_basis;
-  CeedScalar *graddummy, *qrefdummy, *qweightdummy;
-  ierr = CeedCalloc(P1d*P1d, &graddummy); CeedChk(ierr);
-  ierr = CeedCalloc(P1d, &qrefdummy); CeedChk(ierr);
-  ierr = CeedCalloc(P1d, &qweightdummy); CeedChk(ierr);
-  ierr = CeedBasisCreateTensorH1(ceedparent, dim, ncomp, P1d, P1d, x2,
-                                 graddummy, qrefdummy, qweightdummy,
-                                 &fdm_basis); CeedChk(ierr);
-  ierr = CeedFree(&graddummy); CeedChk(ierr);
-  ierr = CeedFree(&qrefdummy); CeedChk(ierr);
-  ierr = CeedFree(&qweightdummy); CeedChk(ierr);
-  ierr = CeedFree(&x2); CeedChk(ierr);
-  ierr = CeedFree(&lambda); CeedChk(ierr);
-
-  // -- Restriction
-  CeedElemRestriction rstr_i;
-  CeedInt strides[3] = {1, lsize, lsize*ncomp};
-  ierr = CeedElemRestrictionCreateStrided(ceedparent, nelem, lsize, ncomp,
-                                          lsize*nelem*ncomp, strides, &rstr_i);
-  CeedChk(ierr);
-  // -- QFunction
-  CeedQFunction mass_qf;
-  ierr = CeedQFunctionCreateInteriorByName(ceedparent, "MassApply", &mass_qf);
-  CeedChk(ierr);
-  // -- Operator
-  ierr = CeedOperatorCreate(ceedparent, mass_qf, NULL, NULL, fdminv);
-  CeedChk(ierr);
-  CeedOperatorSetField(*fdminv, "u", rstr_i, fdm_basis, CEED_VECTOR_ACTIVE);
-  CeedChk(ierr);
-  CeedOperatorSetField(*fdminv, "qdata", rstr_i, CEED_BASIS_COLLOCATED, qdata);
-  CeedChk(ierr);
-  CeedOperatorSetField(*fdminv, "v", rstr_i, fdm_basis, CEED_VECTOR_ACTIVE);
-  CeedChk(ierr);
-
-  // Cleanup
-  ierr = CeedVectorDestroy(&qdata); CeedChk(ierr);
-  ierr = CeedBasisDestroy(&fdm_basis); CeedChk(ierr);
-  ierr = CeedElemRestrictionDestroy(&rstr_i); CeedChk(ierr);
-  ierr = CeedQFunctionDestroy(&mass_qf); CeedChk(ierr);
-
-  return 0;
-}
-
 //------------------------------------------------------------------------------
 // Operator Destroy
 //------------------------------------------------------------------------------
@@ -1186,12 +1134,27 @@ static int CeedOperatorDestroy_Ref(CeedOperator op) {
   CeedOperator_Ref *impl;
   ierr = CeedOperatorGetData(op, &impl); CeedChk(ierr);
 
+  CeedOperatorField *opinputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, NULL); CeedChk(ierr);
+
   for (CeedInt i=0; i<impl->numein+impl->numeout; i++) {
-    ierr = CeedVectorDestroy(&impl->evecs[i]); CeedChk(ierr);
+    CeedVector vec = CEED_VECTOR_ACTIVE;
+    if (i < impl->numein) {
+      ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+    }
+    if (vec != CEED_VECTOR_ACTIVE && impl->evecs[i]) {
+      Ceed ceed;
+      CeedElemRestriction Erestrict;
+      ierr = CeedOperatorFieldGetElemRestriction(opinputfields[i], &Erestrict);
+      CeedChk(ierr);
+      ierr = CeedElemRestrictionGetCeed(Erestrict, &ceed); CeedChk(ierr);
+      ierr = CeedRestoreCachedEVector(ceed, &impl->evecs[i]); CeedChk(ierr);
+    } else {
+      ierr = CeedVectorDestroy(&impl->evecs[i]); CeedChk(ierr);
+    }
   }
   ierr = CeedFree(&impl->evecs); CeedChk(ierr);
   ierr = CeedFree(&impl->edata); CeedChk(ierr);
-  ierr = CeedFree(&impl->inputstate); CeedChk(ierr);
 
   for (CeedInt i=0; i<impl->numein; i++) {
     ierr = CeedVectorDestroy(&impl->evecsin[i]); CeedChk(ierr);
@@ -1206,6 +1169,7 @@ static int CeedOperatorDestroy_Ref(CeedOperator op) {
   }
   ierr = CeedFree(&impl->evecsout); CeedChk(ierr);
   ierr = CeedFree(&impl->qvecsout); CeedChk(ierr);
+  ierr = CeedFree(&impl->scratchvecs); CeedChk(ierr);
 
   ierr = CeedFree(&impl); CeedChk(ierr);
   return 0;
@@ -1233,11 +1197,12 @@ int CeedOperatorCreate_Ref(CeedOperator op) {
                                 "LinearAssembleAddPointBlockDiagonal",
                                 CeedOperatorLinearAssembleAddPointBlockDiagonal_Ref);
   CeedChk(ierr);
-  ierr = CeedSetBackendFunction(ceed, "Operator", op, "CreateFDMElementInverse",
-                                CeedOperatorCreateFDMElementInverse_Ref);
-  CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "Operator", op, "ApplyAdd",
                                 CeedOperatorApplyAdd_Ref); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "ApplyAddDot",
+                                CeedOperatorApplyAddDot_Ref); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "Setup",
+                                CeedOperatorSetup_Ref); CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "Operator", op, "Destroy",
                                 CeedOperatorDestroy_Ref); CeedChk(ierr);
   return 0;
@@ -16,6 +16,67 @@
 
 #include "ceed-ref.h"
 
+//------------------------------------------------------------------------------
+// Setup Transpose Overwrite
+//------------------------------------------------------------------------------
+static int CeedElemRestrictionSetupOverwrite_Ref(CeedElemRestriction r,
+    const CeedInt ncomp, const CeedInt blksize, const CeedInt compstride) {
+  int ierr;
+  CeedElemRestriction_Ref *impl;
+  ierr = CeedElemRestrictionGetData(r, &impl); CeedChk(ierr);
+  CeedInt nelem, elemsize, numblk, lsize;
+  ierr = CeedElemRestrictionGetNumElements(r, &nelem); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumBlocks(r, &numblk); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetLVectorSize(r, &lsize); CeedChk(ierr);
+
+  // The tables are built once, by the first thread to need them
+  while (__sync_lock_test_and_set(&impl->overwritelock, 1));
+  if (impl->firsttouch) {
+    __sync_lock_release(&impl->overwritelock);
+    return 0;
+  }
+
+  // Flag the E-vector entries that contribute to an L-vector entry first,
+  //   in the order of the transpose loop
+  bool *touched = NULL, *firsttouch = NULL;
+  CeedInt *untouched = NULL, nuntouched = 0;
+  ierr = CeedCalloc(lsize, &touched);
+  if (!ierr)
+    ierr = CeedCalloc(numblk*blksize*elemsize*ncomp, &firsttouch);
+  if (!ierr) {
+    for (CeedInt e = 0; e < numblk*blksize; e+=blksize)
+      for (CeedInt k = 0; k < ncomp; k++)
+        for (CeedInt i = 0; i < elemsize*blksize; i+=blksize)
+          for (CeedInt j = i; j < i+CeedIntMin(blksize, nelem-e); j++) {
+            const CeedInt ind = impl->offsets[j+e*elemsize] + k*compstride;
+            firsttouch[elemsize*(k*blksize+ncomp*e) + j] = !touched[ind];
+            touched[ind] = true;
+          }
+
+    // L-vector entries without contributions still need to be zeroed
+    for (CeedInt i = 0; i < lsize; i++)
+      nuntouched += !touched[i];
+    ierr = CeedMalloc(nuntouched, &untouched);
+  }
+  if (!ierr) {
+    for (CeedInt i = 0, n = 0; i < lsize; i++)
+      if (!touched[i])
+        untouched[n++] = i;
+    impl->nuntouched = nuntouched;
+    impl->untouched = untouched;
+    // Publish the flags last, readers without the lock check them first
+    __atomic_store_n(&impl->firsttouch, firsttouch, __ATOMIC_RELEASE);
+  } else {
+    CeedFree(&firsttouch);
+  }
+  CeedFree(&touched);
+  __sync_lock_release(&impl->overwritelock);
+  CeedChk(ierr);
+
+  return 0;
+}
+
 //------------------------------------------------------------------------------
 // Core ElemRestriction Apply Code
 //------------------------------------------------------------------------------
@@ -28,13 +89,43 @@ static inline int CeedElemRestrictionApply_Ref_Core(CeedElemRestriction r,
   ierr = CeedElemRestrictionGetData(r, &impl); CeedChk(ierr);
   const CeedScalar *uu;
   CeedScalar *vv;
-  CeedInt nelem, elemsize, voffset;
+  CeedInt nelem, elemsize, voffset, gsize;
   ierr = CeedElemRestrictionGetNumElements(r, &nelem); CeedChk(ierr);
   ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetGhostSize(r, &gsize); CeedChk(ierr);
   voffset = start*blksize*elemsize*ncomp;
 
+  // A full transpose into a known zero L-vector assigns the first
+  //   contribution to each entry rather than summing into explicit zeros
+  bool overwrite = false;
+  if (tmode == CEED_TRANSPOSE && !gsize) {
+    CeedInt numblk;
+    ierr = CeedElemRestrictionGetNumBlocks(r, &numblk); CeedChk(ierr);
+    if (start == 0 && stop == numblk) {
+      ierr = CeedVectorIsZero(v, &overwrite); CeedChk(ierr);
+    }
+  }
+  if (overwrite && !impl->offsets) {
+    // Only backend strides covering the whole L-vector are handled
+    bool backendstrides;
+    CeedInt lsize;
+    ierr = CeedElemRestrictionHasBackendStrides(r, &backendstrides);
+    CeedChk(ierr);
+    ierr = CeedElemRestrictionGetLVectorSize(r, &lsize); CeedChk(ierr);
+    overwrite = backendstrides && lsize == nelem*elemsize*ncomp;
+  }
+  if (overwrite && impl->offsets &&
+      !__atomic_load_n(&impl->firsttouch, __ATOMIC_ACQUIRE)) {
+    ierr = CeedElemRestrictionSetupOverwrite_Ref(r, ncomp, blksize,
+           compstride); CeedChk(ierr);
+  }
+
   ierr = CeedVectorGetArrayRead(u, CEED_MEM_HOST, &uu); CeedChk(ierr);
-  ierr = CeedVectorGetArray(v, CEED_MEM_HOST, &vv); CeedChk(ierr);
+  if (overwrite) {
+    ierr = CeedVectorGetArrayWrite(v, CEED_MEM_HOST, &vv); CeedChk(ierr);
+  } else {
+    ierr = CeedVectorGetArray(v, CEED_MEM_HOST, &vv); CeedChk(ierr);
+  }
   // Restriction from L-vector to E-vector
   // Perform: v = r * u
   if (tmode == CEED_NOTRANSPOSE) {
@@ -71,6 +162,32 @@ static inline int CeedElemRestrictionApply_Ref_Core(CeedElemRestriction r,
                   = uu[n*strides[0] + k*strides[1] +
                                     CeedIntMin(e+j, nelem-1)*strides[2]];
       }
+    } else if (gsize) {
+      // Offsets provided, owned and ghost storage
+      // Offsets past the owned L-vector index the ghost vector
+      CeedInt lsize;
+      CeedVector ghostin;
+      const CeedScalar *gg;
+      ierr = CeedElemRestrictionGetLVectorSize(r, &lsize); CeedChk(ierr);
+      ierr = CeedElemRestrictionGetGhostVectors(r, &ghostin, NULL);
+      CeedChk(ierr);
+      if (!ghostin) {
+        // LCOV_EXCL_START
+        Ceed ceed;
+        ierr = CeedElemRestrictionGetCeed(r, &ceed); CeedChk(ierr);
+        return CeedError(ceed, 1, "Ghost input vector not set");
+        // LCOV_EXCL_STOP
+      }
+      ierr = CeedVectorGetArrayRead(ghostin, CEED_MEM_HOST, &gg); CeedChk(ierr);
+      for (CeedInt e = start*blksize; e < stop*blksize; e+=blksize)
+        for (CeedInt k = 0; k < ncomp; k++)
+          for (CeedInt i = 0; i < elemsize*blksize; i++) {
+            const CeedInt ind = impl->offsets[i+elemsize*e];
+            vv[elemsize*(k*blksize+ncomp*e) + i - voffset]
+              = ind < lsize ? uu[ind + k*compstride]
+                : gg[ind - lsize + k*compstride];
+          }
+      ierr = CeedVectorRestoreArrayRead(ghostin, &gg); CeedChk(ierr);
     } else {
       // Offsets provided, standard or blocked restriction
       // vv has shape [elemsize, ncomp, nelem], row-major
@@ -91,7 +208,18 @@ static inline int CeedElemRestrictionApply_Ref_Core(CeedElemRestriction r,
       bool backendstrides;
       ierr = CeedElemRestrictionHasBackendStrides(r, &backendstrides);
       CeedChk(ierr);
-      if (backendstrides) {
+      if (overwrite) {
+        // Backend strides, each L-vector entry is set exactly once
+        for (CeedInt e = start*blksize; e < stop*blksize; e+=blksize)
+          CeedPragmaSIMD
+          for (CeedInt k = 0; k < ncomp; k++)
+            CeedPragmaSIMD
+            for (CeedInt n = 0; n < elemsize; n++)
+              CeedPragmaSIMD
+              for (CeedInt j = 0; j < CeedIntMin(blksize, nelem-e); j++)
+                vv[n + k*elemsize + (e+j)*elemsize*ncomp]
+                  = uu[e*elemsize*ncomp + (k*elemsize+n)*blksize + j - voffset];
+      } else if (backendstrides) {
         // CPU backend strides are {1, elemsize, elemsize*ncomp}
         // This if brach is left separate to allow better inlining
         for (CeedInt e = start*blksize; e < stop*blksize; e+=blksize)
@@ -117,6 +245,50 @@ static inline int CeedElemRestrictionApply_Ref_Core(CeedElemRestriction r,
                 vv[n*strides[0] + k*strides[1] + (e+j)*strides[2]]
                 += uu[e*elemsize*ncomp + (k*elemsize+n)*blksize + j - voffset];
       }
+    } else if (overwrite) {
+      // Offsets provided, known zero L-vector
+      // First contributions are assigned, the rest are summed
+      for (CeedInt i = 0; i < impl->nuntouched; i++)
+        vv[impl->untouched[i]] = 0.0;
+      for (CeedInt e = start*blksize; e < stop*blksize; e+=blksize)
+        for (CeedInt k = 0; k < ncomp; k++)
+          for (CeedInt i = 0; i < elemsize*blksize; i+=blksize)
+            // Iteration bound set to discard padding elements
+            for (CeedInt j = i; j < i+CeedIntMin(blksize, nelem-e); j++) {
+              const CeedInt ind = elemsize*(k*blksize+ncomp*e) + j - voffset;
+              if (impl->firsttouch[ind])
+                vv[impl->offsets[j+e*elemsize] + k*compstride] = uu[ind];
+              else
+                vv[impl->offsets[j+e*elemsize] + k*compstride] += uu[ind];
+            }
+    } else if (gsize) {
+      // Offsets provided, owned and ghost storage
+      // Ghost contributions are discarded without a ghost output vector
+      CeedInt lsize;
+      CeedVector ghostout;
+      CeedScalar *gg = NULL;
+      ierr = CeedElemRestrictionGetLVectorSize(r, &lsize); CeedChk(ierr);
+      ierr = CeedElemRestrictionGetGhostVectors(r, NULL, &ghostout);
+      CeedChk(ierr);
+      if (ghostout) {
+        ierr = CeedVectorGetArray(ghostout, CEED_MEM_HOST, &gg); CeedChk(ierr);
+      }
+      for (CeedInt e = start*blksize; e < stop*blksize; e+=blksize)
+        for (CeedInt k = 0; k < ncomp; k++)
+          for (CeedInt i = 0; i < elemsize*blksize; i+=blksize)
+            // Iteration bound set to discard padding elements
+            for (CeedInt j = i; j < i+CeedIntMin(blksize, nelem-e); j++) {
+              const CeedInt ind = impl->offsets[j+e*elemsize];
+              if (ind < lsize)
+                vv[ind + k*compstride]
+                += uu[elemsize*(k*blksize+ncomp*e) + j - voffset];
+              else if (gg)
+                gg[ind - lsize + k*compstride]
+                += uu[elemsize*(k*blksize+ncomp*e) + j - voffset];
+            }
+      if (ghostout) {
+        ierr = CeedVectorRestoreArray(ghostout, &gg); CeedChk(ierr);
+      }
     } else {
       // Offsets provided, standard or blocked restriction
       // uu has shape [elemsize, ncomp, nelem]
@@ -306,6 +478,8 @@ static int CeedElemRestrictionDestroy_Ref(CeedElemRestriction r) {
   ierr = CeedElemRestrictionGetData(r, &impl); CeedChk(ierr);
 
   ierr = CeedFree(&impl->offsets_allocated); CeedChk(ierr);
+  ierr = CeedFree(&impl->firsttouch); CeedChk(ierr);
+  ierr = CeedFree(&impl->untouched); CeedChk(ierr);
   ierr = CeedFree(&impl); CeedChk(ierr);
   return 0;
 }
@@ -350,14 +524,18 @@ int CeedElemRestrictionCreate_Ref(CeedMemType mtype, CeedCopyMode cmode,
         || !strcmp(resource, "/cpu/self/ref/blocked")
         || !strcmp(resource, "/cpu/self/memcheck/serial")
         || !strcmp(resource, "/cpu/self/memcheck/blocked")) {
-      CeedInt lsize;
+      CeedInt lsize, gsize;
       ierr = CeedElemRestrictionGetLVectorSize(r, &lsize); CeedChk(ierr);
+      ierr = CeedElemRestrictionGetGhostSize(r, &gsize); CeedChk(ierr);
 
+      // Ghost offsets are checked against the ghost vector size
       for (CeedInt i = 0; i < nelem*elemsize; i++)
-        if (offsets[i] < 0 || lsize <= offsets[i] + (ncomp - 1) * compstride)
+        if (offsets[i] < 0 || (offsets[i] < lsize ?
+                               lsize <= offsets[i] + (ncomp - 1) * compstride :
+                               lsize + gsize <= offsets[i] + (ncomp - 1) * compstride))
           // LCOV_EXCL_START
           return CeedError(ceed, 1, "Restriction offset %d (%d) out of range "
-                           "[0, %d]", i, offsets[i], lsize);
+                           "[0, %d]", i, offsets[i], lsize + gsize);
       // LCOV_EXCL_STOP
     }
 
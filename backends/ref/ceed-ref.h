@@ -31,14 +31,16 @@ typedef struct {
 typedef struct {
   const CeedInt *offsets;
   CeedInt *offsets_allocated;
+  bool *firsttouch;   /// E-vector entries giving first L-vector contributions
+  CeedInt *untouched; /// L-vector entries without contributions
+  CeedInt nuntouched;
+  int overwritelock;  /// Guards the lazy build of the tables above
   int (*Apply)(CeedElemRestriction, const CeedInt, const CeedInt,
                const CeedInt, CeedInt, CeedInt, CeedTransposeMode, CeedVector,
                CeedVector, CeedRequest *);
 } CeedElemRestriction_Ref;
 
 typedef struct {
-  const CeedScalar **inputs;
-  CeedScalar **outputs;
   bool setupdone;
 } CeedQFunction_Ref;
 
@@ -52,13 +54,15 @@ typedef struct {
   CeedVector
   *evecs;   /// E-vectors needed to apply operator (input followed by outputs)
   CeedScalar **edata;
-  uint64_t *inputstate;  /// State counter of inputs
   CeedVector *evecsin;   /// Input E-vectors needed to apply operator
   CeedVector *evecsout;  /// Output E-vectors needed to apply operator
   CeedVector *qvecsin;   /// Input Q-vectors needed to apply operator
   CeedVector *qvecsout;  /// Output Q-vectors needed to apply operator
   CeedInt    numein;
   CeedInt    numeout;
+  CeedVector *scratchvecs; /// Vectors backed by the scratch pool of the Ceed
+  ///                           while the operator is applied
+  CeedInt    numscratch;
 } CeedOperator_Ref;
 
 CEED_INTERN int CeedVectorCreate_Ref(CeedInt n, CeedVector vec);
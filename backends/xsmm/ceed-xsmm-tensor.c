@@ -16,6 +16,31 @@
 
 #include "ceed-xsmm.h"
 
+//------------------------------------------------------------------------------
+// Get Kernel C=1
+//   With C=1 the contraction is a single GEMM over all A, v = u t^T, so one
+//   kernel of shape J x A x B is built per A and cached. A NULL kernel is
+//   cached if LIBXSMM cannot build the shape, such as for large A.
+//------------------------------------------------------------------------------
+static int CeedTensorContractGetKernelC1_Xsmm(CeedTensorContract_Xsmm *impl,
+    CeedInt A, CeedInt B, CeedInt J, CeedTransposeMode tmode,
+    const CeedInt add, libxsmm_dmmfunction *kernel) {
+  CeedHashIJKLMKey key = {B, A, J, tmode, add};
+  int new_item;
+  khint_t k = kh_put(m32, impl->lookupC1, key, &new_item);
+  if (new_item) {
+    // Build kernel
+    const int flags = LIBXSMM_GEMM_FLAGS(tmode == CEED_NOTRANSPOSE ? 'T' : 'N',
+                                         'N');
+    CeedScalar alpha = 1.0, beta = 1.0;
+    if (!add) beta = 0.0;
+    kh_value(impl->lookupC1, k) = libxsmm_dmmdispatch(J, A, B, NULL, NULL, NULL,
+                                  &alpha, &beta, &flags, NULL);
+  }
+  *kernel = kh_value(impl->lookupC1, k);
+  return 0;
+}
+
 //------------------------------------------------------------------------------
 // Tensor Contract C=1
 //------------------------------------------------------------------------------
@@ -26,6 +51,20 @@ static int CeedTensorContract_Xsmm_C1(CeedTensorContract contract,
                                       const CeedInt add,
                                       const CeedScalar *restrict u,
                                       CeedScalar *restrict v) {
+  int ierr;
+  CeedTensorContract_Xsmm *impl;
+  ierr = CeedTensorContractGetData(contract, &impl); CeedChk(ierr);
+
+  // Get cached kernel
+  libxsmm_dmmfunction kernel;
+  ierr = CeedTensorContractGetKernelC1_Xsmm(impl, A, B, J, tmode, add,
+         &kernel); CeedChk(ierr);
+  if (kernel) {
+    kernel(&t[0], &u[0], &v[0], NULL, NULL, NULL);
+    return 0;
+  }
+
+  // Fallback to libXSMM GEMM dispatcher
   CeedScalar alpha = 1.0, beta = 1.0;
   char transu = 'N', transt = 'N';
   if ((tmode == CEED_TRANSPOSE && C != 1)
@@ -35,7 +74,6 @@ static int CeedTensorContract_Xsmm_C1(CeedTensorContract contract,
   if (!add)
     beta = 0.0;
 
-  // libXSMM GEMM
   libxsmm_dgemm(&transt, &transu, &J, &A, &B,
                 &alpha, &t[0], NULL, &u[0], NULL,
                 &beta, &v[0], NULL);
@@ -85,6 +123,9 @@ static int CeedTensorContractDestroy_Xsmm(CeedTensorContract contract) {
   // Free kernels
   kh_foreach_value(impl->lookup, kernel, libxsmm_release_kernel(&kernel));
   kh_destroy(m32, impl->lookup);
+  kh_foreach_value(impl->lookupC1, kernel,
+                   if (kernel) libxsmm_release_kernel(&kernel));
+  kh_destroy(m32, impl->lookupC1);
   ierr = CeedFree(&impl); CeedChk(ierr);
   return 0;
 }
@@ -102,6 +143,7 @@ int CeedTensorContractCreate_Xsmm(CeedBasis basis,
 
   // Setup kernels hash table
   impl->lookup = kh_init(m32);
+  impl->lookupC1 = kh_init(m32);
 
   // Set up pointers to kernels
   ierr = CeedBasisIsTensor(basis, &impl->isTensor); CeedChk(ierr);
@@ -137,6 +179,17 @@ int CeedTensorContractCreate_Xsmm(CeedBasis basis,
                 kh_value(impl->lookup, k) = kernel;
               }
             }
+    // Build kernels for the C=1 first sweep of serial interpolation
+    CeedInt ncomp;
+    ierr = CeedBasisGetNumComponents(basis, &ncomp); CeedChk(ierr);
+    for (CeedInt add = 0; add <= 1; add++)
+      for (CeedInt tmode = 0; tmode <= 1; tmode++) {
+        libxsmm_dmmfunction kernel;
+        CeedInt B = tmode ? impl->Q : impl->P, J = tmode ? impl->P : impl->Q,
+                A = ncomp*CeedIntPow(B, impl->dim-1);
+        ierr = CeedTensorContractGetKernelC1_Xsmm(impl, A, B, J, tmode, add,
+               &kernel); CeedChk(ierr);
+      }
   } else {
     ierr = CeedBasisGetNumNodes(basis, &impl->P); CeedChk(ierr);
     ierr = CeedBasisGetNumQuadraturePoints(basis, &impl->Q); CeedChk(ierr);
@@ -27,6 +27,7 @@ typedef struct {
   bool isTensor;
   CeedInt P, Q, dim;
   khash_t(m32) *lookup;
+  khash_t(m32) *lookupC1; /// Kernels for C=1, keyed with A in place of C
 } CeedTensorContract_Xsmm;
 
 CEED_INTERN int CeedTensorContractCreate_Xsmm(CeedBasis basis,
@@ -0,0 +1,60 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+/**
+  @brief  Ceed QFunction for applying a dense matrix stored at each point,
+            as used for the element matrices of static condensation
+**/
+
+#ifndef denseapply_h
+#define denseapply_h
+
+CEED_QFUNCTION(DenseApply)(void *ctx, const CeedInt Q,
+                           const CeedScalar *const *in,
+                           CeedScalar *const *out) {
+  // Ctx holds number of rows, columns acting on u, and columns acting on b
+  const CeedInt *sizes = (CeedInt *)ctx;
+  const CeedInt nrows = sizes[0], nu = sizes[1], nb = sizes[2];
+  const CeedInt ncols = nu + nb;
+
+  // in[0] is row-major matrix, size (Q*nrows*ncols)
+  // in[1] is u, size (Q*nu)
+  // in[2] is b, if present, size (Q*nb)
+  const CeedScalar *mat = in[0], *u = in[1], *b = nb ? in[2] : NULL;
+  // out[0] is v, size (Q*nrows)
+  CeedScalar *v = out[0];
+
+  // Quadrature point loop
+  for (CeedInt r=0; r<nrows; r++) {
+    CeedPragmaSIMD
+    for (CeedInt i=0; i<Q; i++)
+      v[i+r*Q] = 0;
+    for (CeedInt c=0; c<nu; c++) {
+      CeedPragmaSIMD
+      for (CeedInt i=0; i<Q; i++)
+        v[i+r*Q] += mat[i+(r*ncols+c)*Q] * u[i+c*Q];
+    }
+    for (CeedInt c=0; c<nb; c++) {
+      CeedPragmaSIMD
+      for (CeedInt i=0; i<Q; i++)
+        v[i+r*Q] += mat[i+(r*ncols+nu+c)*Q] * b[i+c*Q];
+    }
+  } // End of Quadrature Point Loop
+
+  return 0;
+}
+
+#endif // denseapply_h
@@ -0,0 +1,49 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+/**
+  @brief  Ceed QFunction for applying the diagonal of a fast diagonalization
+            inverse, the product of a diagonal shared by all elements and a
+            scaling for each element
+**/
+
+#ifndef fdmapply_h
+#define fdmapply_h
+
+CEED_QFUNCTION(FDMApply)(void *ctx, const CeedInt Q,
+                         const CeedScalar *const *in, CeedScalar *const *out) {
+  // Ctx holds number of components
+  const CeedInt ncomp = *(CeedInt *)ctx;
+
+  // in[0] is u, size (Q*ncomp)
+  // in[1] is diagonal shared by all elements, size (Q)
+  // in[2] is element scaling, size (Q)
+  const CeedScalar *u = in[0], *diag = in[1], *scale = in[2];
+  // out[0] is v, size (Q*ncomp)
+  CeedScalar *v = out[0];
+
+  // Quadrature point loop
+  for (CeedInt c=0; c<ncomp; c++) {
+    CeedPragmaSIMD
+    for (CeedInt i=0; i<Q; i++) {
+      v[i+c*Q] = u[i+c*Q] * diag[i] * scale[i];
+    }
+  } // End of Quadrature Point Loop
+
+  return 0;
+}
+
+#endif // fdmapply_h
@@ -0,0 +1,50 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <string.h>
+#include "ceed-backend.h"
+#include "ceed-vectormassapply.h"
+
+/**
+  @brief Set fields for Ceed QFunction applying the mass matrix to a vector
+           field
+**/
+static int CeedQFunctionInit_VectorMassApply(Ceed ceed,
+    const char *requested, CeedQFunction qf) {
+  // Check QFunction name
+  const char *name = "VectorMassApply";
+  if (strcmp(name, requested))
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "QFunction '%s' does not match requested name: %s",
+                     name, requested);
+  // LCOV_EXCL_STOP
+
+  // QFunction fields with the requested number of components added by
+  //   CeedQFunctionCreateVectorByName() rather than here
+
+  return 0;
+}
+
+/**
+  @brief Register Ceed QFunction for applying the mass matrix to a vector
+           field
+**/
+__attribute__((constructor))
+static void Register(void) {
+  CeedQFunctionRegister("VectorMassApply", VectorMassApply_loc, 1,
+                        VectorMassApply,
+                        CeedQFunctionInit_VectorMassApply);
+}
@@ -25,7 +25,6 @@
 #define CEED_INTERN CEED_EXTERN __attribute__((visibility ("hidden")))
 
 #define CEED_MAX_RESOURCE_LEN 1024
-#define CEED_ALIGN 64
 #define CEED_COMPOSITE_MAX 16
 #define CEED_EPSILON 1E-16
 
@@ -66,9 +65,14 @@ typedef struct CeedQFunctionField_private *CeedQFunctionField;
 /// @ingroup CeedOperatorBackend
 typedef struct CeedOperatorField_private *CeedOperatorField;
 
+/// Handle for performance counters of a CeedOperator
+/// @ingroup CeedOperatorBackend
+typedef struct CeedPerf_private *CeedPerf;
+
 CEED_EXTERN int CeedRegister(const char *prefix,
                              int (*init)(const char *, Ceed),
                              unsigned int priority);
+CEED_EXTERN int CeedIsRegistered(const char *prefix, bool *isregistered);
 
 CEED_EXTERN int CeedIsDebug(Ceed ceed, bool *isDebug);
 CEED_EXTERN int CeedGetParent(Ceed ceed, Ceed *parent);
@@ -89,9 +93,24 @@ CEED_EXTERN int CeedSetBackendFunction(Ceed ceed,
                                        const char *fname, int (*f)());
 CEED_EXTERN int CeedGetData(Ceed ceed, void *data);
 CEED_EXTERN int CeedSetData(Ceed ceed, void *data);
+CEED_EXTERN int CeedGetScratch(Ceed ceed, size_t size, void *p);
+CEED_EXTERN int CeedRestoreScratch(Ceed ceed, void *p);
+CEED_EXTERN int CeedGetScratchVectors(Ceed ceed, CeedInt numvecs,
+                                      CeedVector *vecs, void *scratch);
+CEED_EXTERN int CeedRestoreScratchVectors(Ceed ceed, CeedInt numvecs,
+    CeedVector *vecs, void *scratch);
+CEED_EXTERN int CeedGetCachedEVector(Ceed ceed, CeedElemRestriction rstr,
+                                     CeedInt blksize, CeedVector lvec,
+                                     CeedElemRestriction blkrstr,
+                                     CeedVector *evec);
+CEED_EXTERN int CeedUpdateCachedEVector(Ceed ceed, CeedElemRestriction blkrstr,
+                                        CeedVector lvec, CeedVector evec,
+                                        CeedRequest *request);
+CEED_EXTERN int CeedRestoreCachedEVector(Ceed ceed, CeedVector *evec);
 
 CEED_EXTERN int CeedVectorGetCeed(CeedVector vec, Ceed *ceed);
 CEED_EXTERN int CeedVectorGetState(CeedVector vec, uint64_t *state);
+CEED_EXTERN int CeedVectorIsZero(CeedVector vec, bool *iszero);
 CEED_EXTERN int CeedVectorAddReference(CeedVector vec);
 CEED_EXTERN int CeedVectorGetData(CeedVector vec, void *data);
 CEED_EXTERN int CeedVectorSetData(CeedVector vec, void *data);
@@ -104,10 +123,18 @@ CEED_EXTERN int CeedElemRestrictionGetOffsets(CeedElemRestriction rstr,
     CeedMemType mtype, const CeedInt **offsets);
 CEED_EXTERN int CeedElemRestrictionRestoreOffsets(CeedElemRestriction rstr,
     const CeedInt **offsets);
+CEED_EXTERN int CeedElemRestrictionGetGhostSize(CeedElemRestriction rstr,
+    CeedInt *gsize);
+CEED_EXTERN int CeedElemRestrictionGetGhostVectors(CeedElemRestriction rstr,
+    CeedVector *ghostin, CeedVector *ghostout);
 CEED_EXTERN int CeedElemRestrictionIsStrided(CeedElemRestriction rstr,
     bool *isstrided);
 CEED_EXTERN int CeedElemRestrictionHasBackendStrides( CeedElemRestriction rstr,
     bool *hasbackendstrides);
+CEED_EXTERN int CeedElemRestrictionIsConstant(CeedElemRestriction rstr,
+    bool *isconstant);
+CEED_EXTERN int CeedElemRestrictionApplyConstant(CeedElemRestriction rstr,
+    CeedInt blksize, CeedVector u, CeedVector ru);
 CEED_EXTERN int CeedElemRestrictionGetELayout(CeedElemRestriction rstr,
     CeedInt (*layout)[3]);
 CEED_EXTERN int CeedElemRestrictionSetELayout(CeedElemRestriction rstr,
@@ -154,6 +181,7 @@ CEED_EXTERN int CeedTensorContractDestroy(CeedTensorContract *contract);
 CEED_EXTERN int CeedQFunctionRegister(const char *, const char *, CeedInt,
                                       CeedQFunctionUser, int (*init)(Ceed, const char *, CeedQFunction));
 CEED_EXTERN int CeedQFunctionSetFortranStatus(CeedQFunction qf, bool status);
+CEED_EXTERN int CeedQFunctionSetPadded(CeedQFunction qf, bool padded);
 CEED_EXTERN int CeedQFunctionGetCeed(CeedQFunction qf, Ceed *ceed);
 CEED_EXTERN int CeedQFunctionGetVectorLength(CeedQFunction qf,
     CeedInt *vlength);
@@ -161,13 +189,23 @@ CEED_EXTERN int CeedQFunctionGetNumArgs(CeedQFunction qf,
                                         CeedInt *numinputfields,
                                         CeedInt *numoutputfields);
 CEED_EXTERN int CeedQFunctionGetSourcePath(CeedQFunction qf, char **source);
+CEED_EXTERN int CeedQFunctionGetGalleryName(CeedQFunction qf,
+    const char **name);
 CEED_EXTERN int CeedQFunctionGetUserFunction(CeedQFunction qf,
     CeedQFunctionUser *f);
+CEED_EXTERN int CeedQFunctionCallUser(CeedQFunction qf, void *ctxdata,
+                                      CeedInt Q,
+                                      const CeedScalar *const *inputs,
+                                      CeedScalar *const *outputs);
+CEED_EXTERN int CeedQFunctionCreateCopy(CeedQFunction qf, Ceed ceed,
+                                        CeedQFunction *copy);
 CEED_EXTERN int CeedQFunctionGetContext(CeedQFunction qf,
                                         CeedQFunctionContext *ctx);
 CEED_EXTERN int CeedQFunctionGetInnerContext(CeedQFunction qf,
     CeedQFunctionContext *ctx);
 CEED_EXTERN int CeedQFunctionIsIdentity(CeedQFunction qf, bool *isidentity);
+CEED_EXTERN int CeedQFunctionGetFortranStatus(CeedQFunction qf,
+    bool *status);
 CEED_EXTERN int CeedQFunctionGetData(CeedQFunction qf, void *data);
 CEED_EXTERN int CeedQFunctionSetData(CeedQFunction qf, void *data);
 CEED_EXTERN int CeedQFunctionGetFields(CeedQFunction qf,
@@ -197,6 +235,11 @@ CEED_EXTERN int CeedOperatorGetNumQuadraturePoints(CeedOperator op,
     CeedInt *numqpts);
 CEED_EXTERN int CeedOperatorGetNumArgs(CeedOperator op, CeedInt *numargs);
 CEED_EXTERN int CeedOperatorIsSetupDone(CeedOperator op, bool *issetupdone);
+CEED_EXTERN int CeedOperatorGetCompressPassiveFields(CeedOperator op,
+    bool *compress);
+CEED_EXTERN int CeedOperatorGetStreamPassiveFields(CeedOperator op,
+    bool *stream);
+CEED_EXTERN int CeedOperatorGetPerf(CeedOperator op, CeedPerf *perf);
 CEED_EXTERN int CeedOperatorGetQFunction(CeedOperator op, CeedQFunction *qf);
 CEED_EXTERN int CeedOperatorIsComposite(CeedOperator op, bool *iscomposite);
 CEED_EXTERN int CeedOperatorGetNumSub(CeedOperator op, CeedInt *numsub);
@@ -215,6 +258,21 @@ CEED_EXTERN int CeedOperatorFieldGetBasis(CeedOperatorField opfield,
     CeedBasis *basis);
 CEED_EXTERN int CeedOperatorFieldGetVector(CeedOperatorField opfield,
     CeedVector *vec);
+CEED_EXTERN int CeedOperatorFieldIsBatched(CeedOperatorField opfield,
+    CeedInt nbatch, bool *isbatched);
+
+CEED_EXTERN int CeedPerfStartPhase(CeedPerf perf, CeedPerfPhase phase);
+CEED_EXTERN int CeedPerfStopPhase(CeedPerf perf, CeedPerfPhase phase);
+CEED_EXTERN int CeedPerfAddCounters(CeedPerf perf, CeedPerfPhase phase,
+                                    const CeedPerfCounters *counters);
+/// Measure a phase of CeedOperator application; no cost beyond a branch when
+///   performance counters are disabled and perf is NULL
+#define CeedPerfStart(perf, phase) do { if (perf) { \
+      int perfierr = CeedPerfStartPhase(perf, phase); CeedChk(perfierr); } \
+  } while (0)
+#define CeedPerfStop(perf, phase) do { if (perf) { \
+      int perfierr = CeedPerfStopPhase(perf, phase); CeedChk(perfierr); } \
+  } while (0)
 
 CEED_INTERN int CeedMatrixMultiply(Ceed ceed, const CeedScalar *matA,
                                    const CeedScalar *matB, CeedScalar *matC,
@@ -78,6 +78,16 @@
     @ingroup CeedOperator
 */
 
+// Reference and reader counts and zero flags of objects shared between
+//   operators are updated atomically so operators may be set up concurrently, see
+//   CeedOperatorSetupAll()
+#define CeedAtomicIncrement(x) __sync_add_and_fetch(&(x), 1)
+#define CeedAtomicDecrement(x) __sync_sub_and_fetch(&(x), 1)
+#define CeedAtomicLoad(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define CeedAtomicStore(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#define CeedAtomicCompareAndSwap(x, old, new) \
+  __sync_bool_compare_and_swap(&(x), (old), (new))
+
 // Lookup table field for backend functions
 typedef struct {
   const char *fname;
@@ -90,6 +100,26 @@ typedef struct {
   Ceed delegate;
 } objdelegate;
 
+// Scratch buffer shared by the operators of a Ceed, see CeedGetScratch()
+typedef struct {
+  void *array;
+  size_t size;
+  bool inuse;
+} CeedScratch;
+
+// E-vector of a passive operator input shared between operators, see
+//   CeedGetCachedEVector()
+typedef struct {
+  CeedElemRestriction rstr;
+  CeedInt blksize;
+  CeedVector lvec, evec;
+  uint64_t state;
+  CeedVector ghostin;
+  uint64_t ghoststate;
+  int numusers;
+  int lock;
+} CeedEVectorCacheEntry;
+
 struct Ceed_private {
   const char *resource;
   Ceed delegate;
@@ -125,6 +155,13 @@ struct Ceed_private {
   bool debug;
   char errmsg[CEED_MAX_RESOURCE_LEN];
   foffset *foffsets;
+  CeedScratch *scratch; /// Pool of scratch buffers, grown to the largest demand
+  int numscratch;
+  int scratchlock;
+  CeedEVectorCacheEntry **evcache; /// E-vectors of passive inputs shared
+  ///                                   between operators
+  int numevcache;
+  int evcachelock;
 };
 
 struct CeedVector_private {
@@ -135,6 +172,7 @@ struct CeedVector_private {
   int (*TakeArray)(CeedVector, CeedMemType, CeedScalar **);
   int (*GetArray)(CeedVector, CeedMemType, CeedScalar **);
   int (*GetArrayRead)(CeedVector, CeedMemType, const CeedScalar **);
+  int (*GetArrayWrite)(CeedVector, CeedMemType, CeedScalar **);
   int (*RestoreArray)(CeedVector);
   int (*RestoreArrayRead)(CeedVector);
   int (*Norm)(CeedVector, CeedNormType, CeedScalar *);
@@ -144,6 +182,11 @@ struct CeedVector_private {
   CeedInt length;
   uint64_t state;
   uint64_t numreaders;
+  bool iszero;        /// Values are known to be zero, but not yet written
+  bool isborrowed;    /// Array was provided with CEED_USE_POINTER
+  CeedVector parent;  /// Vector aliased by a view, NULL otherwise
+  CeedInt offset;     /// Offset of a view into the parent array
+  uint64_t numviewaccess; /// Array accesses held through views of the vector
   void *data;
 };
 
@@ -162,6 +205,10 @@ struct CeedElemRestriction_private {
   CeedInt compstride;       /* Component stride for L-vector ordering */
   CeedInt lsize;            /* size of the L-vector, can be used for checking
                                  for correct vector sizes */
+  CeedInt gsize;            /* size of the ghost vectors addressed by offsets
+                                 in [lsize, lsize + gsize) */
+  CeedVector ghostin;       /* ghost values read by the restriction */
+  CeedVector ghostout;      /* ghost values summed into by the transpose */
   CeedInt blksize;          /* number of elements in a batch */
   CeedInt nblk;             /* number of blocks of elements */
   CeedInt *strides;         /* strides between [nodes, components, elements] */
@@ -239,6 +286,8 @@ struct CeedQFunction_private {
   bool identity;
   bool fortranstatus;
   CeedQFunctionContext ctx; /* user context for function */
+  bool padded;         /* backend pads the number of quadrature points, see
+                          CeedQFunctionCallUser() */
   void *data;          /* place for the backend to store any data */
 };
 
@@ -276,6 +325,21 @@ struct CeedFortranContext_private {
 };
 typedef struct CeedFortranContext_private *CeedFortranContext;
 
+// Number of hardware events sampled by CeedPerf, and number of phases
+#define CEED_PERF_NUM_EVENTS 4
+#define CEED_PERF_NUM_PHASES 3
+
+struct CeedPerf_private {
+  bool enabled;
+  int fd[CEED_PERF_NUM_EVENTS]; /* perf_event file descriptors, or -1 */
+  int64_t start[CEED_PERF_NUM_EVENTS];
+  double starttime;
+  CeedPerfCounters counters[CEED_PERF_NUM_PHASES];
+};
+
+CEED_INTERN int CeedPerfCreate(CeedPerf *perf);
+CEED_INTERN int CeedPerfDestroy(CeedPerf *perf);
+
 struct CeedOperatorField_private {
   CeedElemRestriction Erestrict; /* Restriction from L-vector */
   CeedBasis basis;               /* Basis or CEED_BASIS_COLLOCATED for
@@ -303,8 +367,13 @@ struct CeedOperator_private {
   int (*ApplyComposite)(CeedOperator, CeedVector, CeedVector, CeedRequest *);
   int (*ApplyAdd)(CeedOperator, CeedVector, CeedVector, CeedRequest *);
   int (*ApplyAddComposite)(CeedOperator, CeedVector, CeedVector, CeedRequest *);
+  int (*ApplyAddBatch)(CeedOperator, CeedInt, CeedVector, CeedVector,
+                       CeedRequest *);
+  int (*ApplyAddDot)(CeedOperator, CeedVector, CeedVector, CeedScalar *,
+                     CeedRequest *);
   int (*ApplyJacobian)(CeedOperator, CeedVector, CeedVector, CeedVector,
                        CeedVector, CeedRequest *);
+  int (*Setup)(CeedOperator);
   int (*Destroy)(CeedOperator);
   CeedOperatorField *inputfields;
   CeedOperatorField *outputfields;
@@ -317,9 +386,41 @@ struct CeedOperator_private {
   bool setupdone;
   bool composite;
   bool hasrestriction;
+  bool compresspassive; /// Compress element-wise constant passive inputs
+  bool streampassive;   /// Restrict passive inputs block by block
+  CeedPerf perf;        /// Performance counters, if enabled
+  CeedVector inscale;   /// L-vector scaling of the active input, if any
+  CeedVector outscale;  /// L-vector scaling of the active output, if any
+  CeedVector scalework; /// Work vector for active input or output scaling
+  CeedElemRestriction inrstr;  /// Restriction of the active input L-vector to
+                               ///   the E-vector the operator acts on, if any
+  CeedElemRestriction outrstr; /// Restriction of the active output L-vector
+                               ///   to the E-vector the operator acts on
+  CeedElemRestriction auxrstr; /// Restriction of an auxiliary L-vector read
+                               ///   by a passive field, if any
+  CeedVector auxvec;           /// Auxiliary L-vector, restricted on each apply
+  CeedVector auxework;         /// E-vector of the auxiliary passive field
+  CeedVector inework;          /// Work E-vector for the active input
+  CeedVector outework;         /// Work E-vector for the active output
   CeedOperator *suboperators;
   CeedInt numsub;
+  CeedInt numthreads;     /// Threads applying the suboperators concurrently
+  CeedVector *threadouts; /// Private active outputs of the spawned threads
   void *data;
 };
 
+CEED_INTERN int CeedOperatorApplyAddBatchFallback(CeedOperator op,
+    CeedInt nbatch, CeedVector in, CeedVector out, CeedRequest *request);
+CEED_INTERN int CeedOperatorCreateFDMElementInverse_Core(CeedOperator op,
+    CeedOperator *fdminv, CeedRequest *request);
+CEED_INTERN int CeedOperatorStaticCondensation_Core(CeedOperator op,
+    CeedVector rhs, CeedElemRestriction *rstrSkeleton, CeedOperator *opSchur,
+    CeedOperator *opRHS, CeedOperator *opBackSolve, CeedRequest *request);
+CEED_INTERN int CeedOperatorSetupConcurrent(CeedInt numops, CeedOperator *ops,
+    CeedInt numthreads);
+CEED_INTERN int CeedOperatorTouchVector(CeedVector vec);
+CEED_INTERN int CeedOperatorTouchInputs(CeedOperator op);
+CEED_INTERN int CeedCompositeOperatorApplyAddSubs(CeedOperator op,
+    CeedVector in, CeedVector out, CeedRequest *request);
+
 #endif
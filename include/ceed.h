@@ -105,6 +105,26 @@
 #  endif
 #endif
 
+/// Alignment in bytes of host arrays allocated by libCEED
+/// @ingroup Ceed
+#define CEED_ALIGN 64
+
+/**
+  @ingroup CeedQFunction
+  This macro tells the compiler that a QFunction input or output array is
+    aligned at CEED_ALIGN bytes. The CPU backends guarantee this alignment,
+    and a number of quadrature points that is a multiple of the vector length,
+    for QFunctions created with a vector length greater than 1. Code
+    generation backends may redefine this macro, as needed.
+**/
+#ifndef CeedAssumeAligned
+#  if defined(__GNUC__)
+#    define CeedAssumeAligned(ptr) __builtin_assume_aligned((ptr), CEED_ALIGN)
+#  else
+#    define CeedAssumeAligned(ptr) (ptr)
+#  endif
+#endif
+
 #include <assert.h>
 #include <stdint.h>
 #include <stddef.h>
@@ -239,6 +259,8 @@ typedef enum {
 CEED_EXTERN const char *const CeedCopyModes[];
 
 CEED_EXTERN int CeedVectorCreate(Ceed ceed, CeedInt len, CeedVector *vec);
+CEED_EXTERN int CeedVectorCreateView(CeedVector parent, CeedInt offset,
+                                     CeedInt len, CeedVector *view);
 CEED_EXTERN int CeedVectorSetArray(CeedVector vec, CeedMemType mtype,
                                    CeedCopyMode cmode, CeedScalar *array);
 CEED_EXTERN int CeedVectorSetValue(CeedVector vec, CeedScalar value);
@@ -249,6 +271,8 @@ CEED_EXTERN int CeedVectorGetArray(CeedVector vec, CeedMemType mtype,
                                    CeedScalar **array);
 CEED_EXTERN int CeedVectorGetArrayRead(CeedVector vec, CeedMemType mtype,
                                        const CeedScalar **array);
+CEED_EXTERN int CeedVectorGetArrayWrite(CeedVector vec, CeedMemType mtype,
+                                        CeedScalar **array);
 CEED_EXTERN int CeedVectorRestoreArray(CeedVector vec, CeedScalar **array);
 CEED_EXTERN int CeedVectorRestoreArrayRead(CeedVector vec,
     const CeedScalar **array);
@@ -311,6 +335,10 @@ CEED_EXTERN int CeedElemRestrictionCreate(Ceed ceed, CeedInt nelem,
     CeedInt elemsize, CeedInt ncomp, CeedInt compstride, CeedInt lsize,
     CeedMemType mtype, CeedCopyMode cmode, const CeedInt *offsets,
     CeedElemRestriction *rstr);
+CEED_EXTERN int CeedElemRestrictionCreateGhosted(Ceed ceed, CeedInt nelem,
+    CeedInt elemsize, CeedInt ncomp, CeedInt compstride, CeedInt lsize,
+    CeedInt gsize, CeedMemType mtype, CeedCopyMode cmode,
+    const CeedInt *offsets, CeedElemRestriction *rstr);
 CEED_EXTERN int CeedElemRestrictionCreateStrided(Ceed ceed,
     CeedInt nelem, CeedInt elemsize, CeedInt ncomp, CeedInt lsize,
     const CeedInt strides[3], CeedElemRestriction *rstr);
@@ -318,11 +346,17 @@ CEED_EXTERN int CeedElemRestrictionCreateBlocked(Ceed ceed, CeedInt nelem,
     CeedInt elemsize, CeedInt blksize, CeedInt ncomp, CeedInt compstride,
     CeedInt lsize, CeedMemType mtype, CeedCopyMode cmode,
     const CeedInt *offsets, CeedElemRestriction *rstr);
+CEED_EXTERN int CeedElemRestrictionCreateBlockedGhosted(Ceed ceed,
+    CeedInt nelem, CeedInt elemsize, CeedInt blksize, CeedInt ncomp,
+    CeedInt compstride, CeedInt lsize, CeedInt gsize, CeedMemType mtype,
+    CeedCopyMode cmode, const CeedInt *offsets, CeedElemRestriction *rstr);
 CEED_EXTERN int CeedElemRestrictionCreateBlockedStrided(Ceed ceed,
     CeedInt nelem, CeedInt elemsize, CeedInt blksize, CeedInt ncomp,
     CeedInt lsize, const CeedInt strides[3], CeedElemRestriction *rstr);
 CEED_EXTERN int CeedElemRestrictionCreateVector(CeedElemRestriction rstr,
     CeedVector *lvec, CeedVector *evec);
+CEED_EXTERN int CeedElemRestrictionSetGhostVectors(CeedElemRestriction rstr,
+    CeedVector ghostin, CeedVector ghostout);
 CEED_EXTERN int CeedElemRestrictionApply(CeedElemRestriction rstr,
     CeedTransposeMode tmode, CeedVector u, CeedVector ru, CeedRequest *request);
 CEED_EXTERN int CeedElemRestrictionApplyBlock(CeedElemRestriction rstr,
@@ -489,6 +523,8 @@ CEED_EXTERN int CeedQFunctionCreateInteriorByName(Ceed ceed, const char *name,
     CeedQFunction *qf);
 CEED_EXTERN int CeedQFunctionCreateIdentity(Ceed ceed, CeedInt size,
     CeedEvalMode inmode, CeedEvalMode outmode, CeedQFunction *qf);
+CEED_EXTERN int CeedQFunctionCreateVectorByName(Ceed ceed, const char *name,
+    CeedInt ncomp, CeedQFunction *qf);
 CEED_EXTERN int CeedQFunctionAddInput(CeedQFunction qf, const char *fieldname,
                                       CeedInt size, CeedEvalMode emode);
 CEED_EXTERN int CeedQFunctionAddOutput(CeedQFunction qf, const char *fieldname,
@@ -513,6 +549,38 @@ CEED_EXTERN int CeedQFunctionContextView(CeedQFunctionContext ctx,
     FILE *stream);
 CEED_EXTERN int CeedQFunctionContextDestroy(CeedQFunctionContext *ctx);
 
+/// Phases of CeedOperator application measured by performance counters
+/// @ingroup CeedOperator
+typedef enum {
+  /// Application of CeedElemRestrictions
+  CEED_PERF_RESTRICTION,
+  /// Application of CeedBases
+  CEED_PERF_BASIS,
+  /// Application of the CeedQFunction
+  CEED_PERF_QFUNCTION,
+} CeedPerfPhase;
+
+CEED_EXTERN const char *const CeedPerfPhases[];
+
+/// Performance counters accumulated over one phase of CeedOperator application.
+/// Hardware counts are -1 if the counter is not available.
+/// @ingroup CeedOperator
+typedef struct {
+  /// Number of measured intervals
+  int64_t calls;
+  /// Wall clock time in seconds
+  double time;
+  /// CPU cycles
+  int64_t cycles;
+  /// Instructions retired
+  int64_t instructions;
+  /// Last level cache misses
+  int64_t llcmisses;
+  /// Floating point vector operations, counted with the raw event given in
+  ///   hexadecimal by the environment variable CEED_PERF_FP_EVENT
+  int64_t fpops;
+} CeedPerfCounters;
+
 CEED_EXTERN int CeedOperatorCreate(Ceed ceed, CeedQFunction qf,
                                    CeedQFunction dqf, CeedQFunction dqfT,
                                    CeedOperator *op);
@@ -520,8 +588,19 @@ CEED_EXTERN int CeedCompositeOperatorCreate(Ceed ceed, CeedOperator *op);
 CEED_EXTERN int CeedOperatorSetField(CeedOperator op, const char *fieldname,
                                      CeedElemRestriction r, CeedBasis b,
                                      CeedVector v);
+CEED_EXTERN int CeedOperatorSetFieldConstant(CeedOperator op,
+    const char *fieldname, const CeedScalar *values);
 CEED_EXTERN int CeedCompositeOperatorAddSub(CeedOperator compositeop,
     CeedOperator subop);
+CEED_EXTERN int CeedCompositeOperatorSetNumThreads(CeedOperator op,
+    CeedInt numthreads);
+CEED_EXTERN int CeedOperatorSetCompressPassiveFields(CeedOperator op,
+    bool compress);
+CEED_EXTERN int CeedOperatorSetStreamPassiveFields(CeedOperator op,
+    bool stream);
+CEED_EXTERN int CeedOperatorSetPerfCounters(CeedOperator op, bool enable);
+CEED_EXTERN int CeedOperatorGetPerfCounters(CeedOperator op,
+    CeedPerfPhase phase, CeedPerfCounters *counters);
 CEED_EXTERN int CeedOperatorLinearAssembleQFunction(CeedOperator op,
     CeedVector *assembled, CeedElemRestriction *rstr, CeedRequest *request);
 CEED_EXTERN int CeedOperatorLinearAssembleDiagonal(CeedOperator op,
@@ -543,13 +622,31 @@ CEED_EXTERN int CeedOperatorMultigridLevelCreateH1(CeedOperator opFine,
     CeedVector PMultFine, CeedElemRestriction rstrCoarse, CeedBasis basisCoarse,
     const CeedScalar *interpCtoF, CeedOperator *opCoarse,
     CeedOperator *opProlong, CeedOperator *opRestrict);
+CEED_EXTERN int CeedOperatorMultigridLevelCreateRediscretized(
+  CeedOperator opFine, CeedElemRestriction rstrCoarse, CeedBasis basisCoarse,
+  const char *fieldname, CeedOperator opSetupCoarse, CeedVector setupInput,
+  CeedOperator *opCoarse);
 CEED_EXTERN int CeedOperatorCreateFDMElementInverse(CeedOperator op,
     CeedOperator *fdminv, CeedRequest *request);
+CEED_EXTERN int CeedOperatorCreateStaticCondensation(CeedOperator op,
+    CeedVector rhs, CeedElemRestriction *rstrSkeleton, CeedOperator *opSchur,
+    CeedOperator *opRHS, CeedOperator *opBackSolve, CeedRequest *request);
 CEED_EXTERN int CeedOperatorView(CeedOperator op, FILE *stream);
+CEED_EXTERN int CeedOperatorSetupAll(CeedInt numops, CeedOperator *ops,
+                                     CeedInt numthreads);
 CEED_EXTERN int CeedOperatorApply(CeedOperator op, CeedVector in,
                                   CeedVector out, CeedRequest *request);
 CEED_EXTERN int CeedOperatorApplyAdd(CeedOperator op, CeedVector in,
                                      CeedVector out, CeedRequest *request);
+CEED_EXTERN int CeedOperatorApplyBatch(CeedOperator op, CeedInt nbatch,
+                                       CeedVector in, CeedVector out,
+                                       CeedRequest *request);
+CEED_EXTERN int CeedOperatorApplyAddBatch(CeedOperator op, CeedInt nbatch,
+    CeedVector in, CeedVector out, CeedRequest *request);
+CEED_EXTERN int CeedOperatorApplyWithDot(CeedOperator op, CeedVector in,
+    CeedVector out, CeedScalar *dot, CeedRequest *request);
+CEED_EXTERN int CeedOperatorApplyAddWithDot(CeedOperator op, CeedVector in,
+    CeedVector out, CeedScalar *dot, CeedRequest *request);
 CEED_EXTERN int CeedOperatorDestroy(CeedOperator *op);
 
 /**
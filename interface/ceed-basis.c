@@ -428,7 +428,7 @@ int CeedBasisCreateTensorH1(Ceed ceed, CeedInt dim, CeedInt ncomp, CeedInt P1d,
   }
   ierr = CeedCalloc(1,basis); CeedChk(ierr);
   (*basis)->ceed = ceed;
-  ceed->refcount++;
+  CeedAtomicIncrement(ceed->refcount);
   (*basis)->refcount = 1;
   (*basis)->tensorbasis = 1;
   (*basis)->dim = dim;
@@ -580,7 +580,7 @@ int CeedBasisCreateH1(Ceed ceed, CeedElemTopology topo, CeedInt ncomp,
   ierr = CeedBasisGetTopologyDimension(topo, &dim); CeedChk(ierr);
 
   (*basis)->ceed = ceed;
-  ceed->refcount++;
+  CeedAtomicIncrement(ceed->refcount);
   (*basis)->refcount = 1;
   (*basis)->tensorbasis = 0;
   (*basis)->dim = dim;
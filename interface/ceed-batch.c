@@ -0,0 +1,148 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-734707. All Rights
+// reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <ceed-impl.h>
+#include <ceed-backend.h>
+
+/// @file
+/// Implementation of batched CeedOperator application
+
+/// ----------------------------------------------------------------------------
+/// CeedOperator Library Internal Functions
+/// ----------------------------------------------------------------------------
+/// @addtogroup CeedOperatorDeveloper
+/// @{
+
+/**
+  @brief Apply a CeedOperator to a batch one member at a time, for backends
+           without a batched implementation
+
+  Members of the active vectors and batched passive fields are aliased with
+    CeedVector views, which temporarily replace the passive vectors of the
+    operator fields; the fields are restored before returning, also on error.
+    The operator must therefore not be applied concurrently from other
+    threads while a batch is applied. The state of batched passive vectors is
+    advanced before each member, as if they had been written, so that backends
+    do not reuse E-vectors cached for another member. Members are not
+    vectorized across; each is an ordinary application.
+
+  @param op        CeedOperator to apply
+  @param nbatch    Number of batch members
+  @param[in] in    CeedVector with nbatch consecutive input L-vectors
+  @param[out] out  CeedVector with nbatch consecutive output L-vectors
+  @param request   Address of CeedRequest for non-blocking completion, else
+                     @ref CEED_REQUEST_IMMEDIATE
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+int CeedOperatorApplyAddBatchFallback(CeedOperator op, CeedInt nbatch,
+    CeedVector in, CeedVector out, CeedRequest *request) {
+  int ierr, ierrapply = 0;
+  CeedInt numin = op->qf->numinputfields, numout = op->qf->numoutputfields;
+  CeedOperatorField *fields;
+  CeedVector *parents;
+  ierr = CeedCalloc(numin + numout, &fields); CeedChk(ierr);
+  ierr = CeedCalloc(numin + numout, &parents); CeedChk(ierr);
+  for (CeedInt i=0; i<numin + numout; i++) {
+    bool isbatched;
+    fields[i] = i < numin ? op->inputfields[i] : op->outputfields[i-numin];
+    ierr = CeedOperatorFieldIsBatched(fields[i], nbatch, &isbatched);
+    CeedChk(ierr);
+    if (isbatched)
+      parents[i] = fields[i]->vec;
+  }
+
+  for (CeedInt b=0; b<nbatch && !ierrapply; b++) {
+    CeedVector inview = in, outview = out;
+    if (in && in != CEED_VECTOR_NONE)
+      ierrapply = CeedVectorCreateView(in, b*(in->length/nbatch),
+                                       in->length/nbatch, &inview);
+    if (!ierrapply && out && out != CEED_VECTOR_NONE)
+      ierrapply = CeedVectorCreateView(out, b*(out->length/nbatch),
+                                       out->length/nbatch, &outview);
+    for (CeedInt i=0; i<numin + numout && !ierrapply; i++)
+      if (parents[i]) {
+        CeedInt length = parents[i]->length/nbatch;
+        CeedVector view;
+        parents[i]->state += 2;
+        ierrapply = CeedVectorCreateView(parents[i], b*length, length, &view);
+        if (!ierrapply)
+          fields[i]->vec = view;
+      }
+
+    if (!ierrapply)
+      ierrapply = op->ApplyAdd(op, inview, outview, request);
+
+    // Restore the passive vectors of the fields before handling any error
+    for (CeedInt i=0; i<numin + numout; i++)
+      if (parents[i] && fields[i]->vec != parents[i]) {
+        ierr = CeedVectorDestroy(&fields[i]->vec); CeedChk(ierr);
+        fields[i]->vec = parents[i];
+      }
+    if (inview != in) {
+      ierr = CeedVectorDestroy(&inview); CeedChk(ierr);
+    }
+    if (outview != out) {
+      ierr = CeedVectorDestroy(&outview); CeedChk(ierr);
+    }
+  }
+
+  ierr = CeedFree(&fields); CeedChk(ierr);
+  ierr = CeedFree(&parents); CeedChk(ierr);
+  CeedChk(ierrapply);
+  return 0;
+}
+
+/// @}
+
+/// ----------------------------------------------------------------------------
+/// CeedOperator Backend API
+/// ----------------------------------------------------------------------------
+/// @addtogroup CeedOperatorBackend
+/// @{
+
+/**
+  @brief Check if the passive CeedVector of a CeedOperatorField holds one
+           L-vector per member for @ref CeedOperatorApplyBatch(), stored
+           consecutively, rather than one L-vector shared by all members
+
+  @param opfield         CeedOperatorField
+  @param nbatch          Number of batch members
+  @param[out] isbatched  Variable to store batched status
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedOperatorFieldIsBatched(CeedOperatorField opfield, CeedInt nbatch,
+                               bool *isbatched) {
+  int ierr;
+  *isbatched = false;
+  if (nbatch < 2 || opfield->vec == CEED_VECTOR_ACTIVE ||
+      opfield->vec == CEED_VECTOR_NONE ||
+      opfield->Erestrict == CEED_ELEMRESTRICTION_NONE)
+    return 0;
+
+  CeedInt lsize;
+  ierr = CeedElemRestrictionGetLVectorSize(opfield->Erestrict, &lsize);
+  CeedChk(ierr);
+  *isbatched = opfield->vec->length == nbatch*lsize;
+  return 0;
+}
+
+/// @}
@@ -0,0 +1,223 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-734707. All Rights
+// reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <ceed-impl.h>
+#include <ceed-backend.h>
+#include <pthread.h>
+
+/// @file
+/// Implementation of concurrent application of composite CeedOperators
+
+/// ----------------------------------------------------------------------------
+/// CeedOperator Library Internal Functions
+/// ----------------------------------------------------------------------------
+/// @addtogroup CeedOperatorDeveloper
+/// @{
+
+/**
+  @brief Shared work list for concurrent application of suboperators
+**/
+typedef struct {
+  CeedOperator *subs;   /// Suboperators to apply
+  CeedInt numsub;       /// Number of suboperators
+  CeedVector in;        /// Active input shared by all suboperators
+  CeedRequest *request; /// Request passed to each application
+  CeedInt next;         /// Index of the next suboperator to claim
+  int ierr;             /// First error code returned by an application
+} CeedCompositeApplyQueue;
+
+/**
+  @brief Work list and private active output of one applying thread
+**/
+typedef struct {
+  CeedCompositeApplyQueue *queue;
+  CeedVector out;
+} CeedCompositeApplyWorker;
+
+/**
+  @brief Apply suboperators from the shared work list until it is exhausted
+
+  @param arg  CeedCompositeApplyWorker of the thread
+
+  @return NULL
+
+  @ref Developer
+**/
+static void *CeedCompositeOperatorApplyWorker(void *arg) {
+  CeedCompositeApplyWorker *worker = arg;
+  CeedCompositeApplyQueue *queue = worker->queue;
+
+  for (;;) {
+    CeedInt i = __sync_fetch_and_add(&queue->next, 1);
+    if (i >= queue->numsub || queue->ierr) break;
+    int ierr = CeedOperatorApplyAdd(queue->subs[i], queue->in, worker->out,
+                                    queue->request);
+    if (ierr)
+      __sync_bool_compare_and_swap(&queue->ierr, 0, ierr);
+  }
+  return NULL;
+}
+
+/**
+  @brief Check whether the suboperators of a composite CeedOperator may be
+           applied concurrently
+
+  @param op             Composite CeedOperator
+  @param[out] parallel  Boolean flag, true if every suboperator is a distinct
+                          non-composite operator without passive outputs and
+                          no two suboperators share a CeedQFunctionContext
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+static int CeedCompositeOperatorIsParallel(CeedOperator op, bool *parallel) {
+  *parallel = op->numthreads > 1 && op->numsub > 1;
+  for (CeedInt i=0; i<op->numsub && *parallel; i++) {
+    CeedOperator sub = op->suboperators[i];
+
+    if (sub->composite) {
+      *parallel = false;
+      break;
+    }
+    // Context data is held exclusively while a QFunction is applied
+    for (CeedInt j=0; j<i; j++)
+      if (op->suboperators[j] == sub ||
+          (sub->qf->ctx && op->suboperators[j]->qf->ctx == sub->qf->ctx))
+        *parallel = false;
+    for (CeedInt j=0; j<sub->qf->numoutputfields; j++) {
+      CeedVector vec = sub->outputfields[j]->vec;
+      if (vec != CEED_VECTOR_ACTIVE && vec != CEED_VECTOR_NONE)
+        *parallel = false;
+    }
+  }
+  return 0;
+}
+
+/**
+  @brief Apply the suboperators of a composite CeedOperator and add the
+           results to the output vector, concurrently if enabled
+
+  @param op        Composite CeedOperator
+  @param[in] in    CeedVector containing input state or @ref CEED_VECTOR_NONE
+  @param[out] out  CeedVector to sum in result or @ref CEED_VECTOR_NONE
+  @param request   Address of CeedRequest for non-blocking completion, else
+                     @ref CEED_REQUEST_IMMEDIATE
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+int CeedCompositeOperatorApplyAddSubs(CeedOperator op, CeedVector in,
+    CeedVector out, CeedRequest *request) {
+  int ierr;
+  bool parallel;
+  CeedInt numthreads, numstarted = 0;
+  CeedInt length = 0;
+  pthread_t *threads;
+  CeedCompositeApplyQueue queue;
+  CeedCompositeApplyWorker *workers;
+
+  ierr = CeedCompositeOperatorIsParallel(op, &parallel); CeedChk(ierr);
+  if (!parallel) {
+    for (CeedInt i=0; i<op->numsub; i++) {
+      ierr = CeedOperatorApplyAdd(op->suboperators[i], in, out, request);
+      CeedChk(ierr);
+    }
+    return 0;
+  }
+
+  // Set up the backends and read all shared inputs in this thread first
+  ierr = CeedOperatorSetupAll(op->numsub, op->suboperators, op->numthreads);
+  CeedChk(ierr);
+  ierr = CeedOperatorTouchVector(in); CeedChk(ierr);
+  for (CeedInt i=0; i<op->numsub; i++) {
+    ierr = CeedOperatorTouchInputs(op->suboperators[i]); CeedChk(ierr);
+  }
+
+  // Private outputs of the spawned threads, the calling thread sums into out
+  numthreads = op->numthreads < op->numsub ? op->numthreads : op->numsub;
+  if (!op->threadouts) {
+    ierr = CeedCalloc(op->numthreads - 1, &op->threadouts); CeedChk(ierr);
+  }
+  if (out != CEED_VECTOR_NONE) {
+    ierr = CeedVectorGetLength(out, &length); CeedChk(ierr);
+  }
+  ierr = CeedCalloc(numthreads, &workers); CeedChk(ierr);
+  ierr = CeedCalloc(numthreads - 1, &threads); CeedChk(ierr);
+  queue.subs = op->suboperators;
+  queue.numsub = op->numsub;
+  queue.in = in;
+  queue.request = request;
+  queue.next = 0;
+  queue.ierr = 0;
+  for (CeedInt t=0; t<numthreads; t++) {
+    workers[t].queue = &queue;
+    workers[t].out = out;
+    if (t == 0 || out == CEED_VECTOR_NONE)
+      continue;
+    CeedVector *tout = &op->threadouts[t-1];
+    if (*tout) {
+      CeedInt toutlength;
+      ierr = CeedVectorGetLength(*tout, &toutlength); CeedChk(ierr);
+      if (toutlength != length) {
+        ierr = CeedVectorDestroy(tout); CeedChk(ierr);
+      }
+    }
+    if (!*tout) {
+      ierr = CeedVectorCreate(op->ceed, length, tout); CeedChk(ierr);
+    }
+    ierr = CeedVectorSetValue(*tout, 0.0); CeedChk(ierr);
+    workers[t].out = *tout;
+  }
+
+  // Apply, the calling thread works alongside the spawned threads
+  while (numstarted < numthreads - 1 &&
+         !pthread_create(&threads[numstarted], NULL,
+                         CeedCompositeOperatorApplyWorker,
+                         &workers[numstarted+1]))
+    numstarted++;
+  CeedCompositeOperatorApplyWorker(&workers[0]);
+  for (CeedInt t=0; t<numstarted; t++)
+    pthread_join(threads[t], NULL);
+  ierr = CeedFree(&threads); CeedChk(ierr);
+
+  // Reduce the private outputs
+  if (!queue.ierr && out != CEED_VECTOR_NONE) {
+    CeedScalar *outarray;
+    ierr = CeedVectorGetArray(out, CEED_MEM_HOST, &outarray); CeedChk(ierr);
+    for (CeedInt t=1; t<=numstarted; t++) {
+      const CeedScalar *toutarray;
+      ierr = CeedVectorGetArrayRead(workers[t].out, CEED_MEM_HOST, &toutarray);
+      CeedChk(ierr);
+      for (CeedInt i=0; i<length; i++)
+        outarray[i] += toutarray[i];
+      ierr = CeedVectorRestoreArrayRead(workers[t].out, &toutarray);
+      CeedChk(ierr);
+    }
+    ierr = CeedVectorRestoreArray(out, &outarray); CeedChk(ierr);
+  }
+  ierr = CeedFree(&workers); CeedChk(ierr);
+
+  if (queue.ierr)
+    // LCOV_EXCL_START
+    return CeedError(op->ceed, queue.ierr, "Suboperator application failed");
+  // LCOV_EXCL_STOP
+
+  return 0;
+}
+
+/// @}
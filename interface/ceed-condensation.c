@@ -0,0 +1,560 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-734707. All Rights
+// reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <ceed-impl.h>
+#include <ceed-backend.h>
+#include <math.h>
+
+/// @file
+/// Implementation of static condensation for CeedOperators
+
+/// ----------------------------------------------------------------------------
+/// CeedOperator Library Internal Functions
+/// ----------------------------------------------------------------------------
+/// @addtogroup CeedOperatorDeveloper
+/// @{
+
+/**
+  @brief Solve a dense linear system with several right hand sides by Gaussian
+           elimination with partial pivoting
+
+  @param ceed      Ceed object for error handling
+  @param[in,out] A Row-major matrix of size n x n, overwritten by its factors
+  @param[in,out] B Row-major right hand sides of size n x m, overwritten by
+                     the solution
+  @param n         Number of rows of A
+  @param m         Number of right hand sides
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+static int CeedOperatorDenseSolve(Ceed ceed, CeedScalar *A, CeedScalar *B,
+                                  CeedInt n, CeedInt m) {
+  // Forward elimination
+  for (CeedInt k=0; k<n; k++) {
+    CeedInt p = k;
+    for (CeedInt i=k+1; i<n; i++)
+      if (fabs(A[i*n+k]) > fabs(A[p*n+k]))
+        p = i;
+    if (A[p*n+k] == 0.0)
+      // LCOV_EXCL_START
+      return CeedError(ceed, 1, "Element interior matrix is singular");
+    // LCOV_EXCL_STOP
+    if (p != k) {
+      for (CeedInt j=0; j<n; j++) {
+        CeedScalar t = A[k*n+j]; A[k*n+j] = A[p*n+j]; A[p*n+j] = t;
+      }
+      for (CeedInt j=0; j<m; j++) {
+        CeedScalar t = B[k*m+j]; B[k*m+j] = B[p*m+j]; B[p*m+j] = t;
+      }
+    }
+    for (CeedInt i=k+1; i<n; i++) {
+      const CeedScalar f = A[i*n+k] / A[k*n+k];
+      for (CeedInt j=k+1; j<n; j++)
+        A[i*n+j] -= f*A[k*n+j];
+      for (CeedInt j=0; j<m; j++)
+        B[i*m+j] -= f*B[k*m+j];
+    }
+  }
+
+  // Back substitution
+  for (CeedInt k=n-1; k>=0; k--)
+    for (CeedInt j=0; j<m; j++) {
+      CeedScalar s = B[k*m+j];
+      for (CeedInt i=k+1; i<n; i++)
+        s -= A[k*n+i]*B[i*m+j];
+      B[k*m+j] = s / A[k*n+k];
+    }
+
+  return 0;
+}
+
+/**
+  @brief Assemble the dense element matrices of a CeedOperator from its
+           assembled QFunction and full basis matrices
+
+  The element matrix for element e is stored row-major at offset
+    e*(ncomp*elemsize)^2, with row and column index comp*elemsize + node,
+    matching the E-vector layout [1, elemsize, elemsize*ncomp].
+
+  @param op              CeedOperator to assemble
+  @param[out] rstr       CeedElemRestriction of the active fields
+  @param[out] basis      CeedBasis of the active fields
+  @param[out] elemmats   Host array of element matrices, to be freed by the
+                           caller
+  @param request         Address of CeedRequest for non-blocking completion,
+                           else @ref CEED_REQUEST_IMMEDIATE
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+static int CeedOperatorAssembleElementMatrices(CeedOperator op,
+    CeedElemRestriction *rstr, CeedBasis *basis, CeedScalar **elemmats,
+    CeedRequest *request) {
+  int ierr;
+  Ceed ceed = op->ceed;
+
+  // Determine active fields and their eval modes, inputs then outputs
+  CeedInt numemode[2] = {0, 0};
+  CeedEvalMode *emodes[2] = {NULL, NULL};
+  *rstr = NULL;
+  *basis = NULL;
+  for (CeedInt io=0; io<2; io++) {
+    CeedInt nfields = io ? op->qf->numoutputfields : op->qf->numinputfields;
+    CeedOperatorField *opfields = io ? op->outputfields : op->inputfields;
+    CeedQFunctionField *qffields = io ? op->qf->outputfields :
+                                   op->qf->inputfields;
+    for (CeedInt i=0; i<nfields; i++)
+      if (opfields[i]->vec == CEED_VECTOR_ACTIVE) {
+        if ((*rstr && *rstr != opfields[i]->Erestrict) ||
+            (*basis && *basis != opfields[i]->basis) ||
+            opfields[i]->basis == CEED_BASIS_COLLOCATED)
+          // LCOV_EXCL_START
+          return CeedError(ceed, 1, "Element matrices require all active "
+                           "fields to share one restriction and basis");
+        // LCOV_EXCL_STOP
+        *rstr = opfields[i]->Erestrict;
+        *basis = opfields[i]->basis;
+        CeedInt dim, neval = 1;
+        ierr = CeedBasisGetDimension(*basis, &dim); CeedChk(ierr);
+        if (qffields[i]->emode == CEED_EVAL_GRAD)
+          neval = dim;
+        ierr = CeedRealloc(numemode[io] + neval, &emodes[io]); CeedChk(ierr);
+        for (CeedInt d=0; d<neval; d++)
+          emodes[io][numemode[io]+d] = qffields[i]->emode;
+        numemode[io] += neval;
+      }
+  }
+  if (!*basis)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "No active field set");
+  // LCOV_EXCL_STOP
+
+  // Assemble QFunction
+  CeedVector assembledqf;
+  CeedElemRestriction rstrqf;
+  ierr = CeedOperatorLinearAssembleQFunction(op, &assembledqf, &rstrqf,
+         request); CeedChk(ierr);
+  ierr = CeedElemRestrictionDestroy(&rstrqf); CeedChk(ierr);
+
+  // Basis matrices
+  CeedInt nelem, nnodes, nqpts, ncomp;
+  ierr = CeedElemRestrictionGetNumElements(*rstr, &nelem); CeedChk(ierr);
+  ierr = CeedBasisGetNumNodes(*basis, &nnodes); CeedChk(ierr);
+  ierr = CeedBasisGetNumQuadraturePoints(*basis, &nqpts); CeedChk(ierr);
+  ierr = CeedBasisGetNumComponents(*basis, &ncomp); CeedChk(ierr);
+  const CeedScalar *interp, *grad;
+  CeedScalar *identity;
+  ierr = CeedBasisGetInterp(*basis, &interp); CeedChk(ierr);
+  ierr = CeedBasisGetGrad(*basis, &grad); CeedChk(ierr);
+  ierr = CeedCalloc(nqpts*nnodes, &identity); CeedChk(ierr);
+  for (CeedInt i=0; i<(nnodes<nqpts?nnodes:nqpts); i++)
+    identity[i*nnodes+i] = 1.0;
+
+  // Compute B_out^T D B_in for each element
+  CeedInt N = ncomp*nnodes;
+  const CeedScalar *qfarray;
+  ierr = CeedCalloc(nelem*N*N, elemmats); CeedChk(ierr);
+  ierr = CeedVectorGetArrayRead(assembledqf, CEED_MEM_HOST, &qfarray);
+  CeedChk(ierr);
+  for (CeedInt e=0; e<nelem; e++) {
+    CeedScalar *mat = &(*elemmats)[e*N*N];
+    for (CeedInt eout=0, dout=0; eout<numemode[1]; eout++) {
+      const CeedScalar *bt = emodes[1][eout] == CEED_EVAL_GRAD ?
+                             &grad[(dout++)*nqpts*nnodes] :
+                             emodes[1][eout] == CEED_EVAL_INTERP ? interp :
+                             identity;
+      for (CeedInt ein=0, din=0; ein<numemode[0]; ein++) {
+        const CeedScalar *b = emodes[0][ein] == CEED_EVAL_GRAD ?
+                              &grad[(din++)*nqpts*nnodes] :
+                              emodes[0][ein] == CEED_EVAL_INTERP ? interp :
+                              identity;
+        for (CeedInt compin=0; compin<ncomp; compin++)
+          for (CeedInt compout=0; compout<ncomp; compout++)
+            for (CeedInt q=0; q<nqpts; q++) {
+              const CeedScalar qfvalue =
+                qfarray[((((e*numemode[0]+ein)*ncomp+compin)*
+                          numemode[1]+eout)*ncomp+compout)*nqpts+q];
+              if (qfvalue == 0.0)
+                continue;
+              for (CeedInt i=0; i<nnodes; i++) {
+                const CeedScalar t = bt[q*nnodes+i] * qfvalue;
+                for (CeedInt j=0; j<nnodes; j++)
+                  mat[(compout*nnodes+i)*N + compin*nnodes+j] +=
+                    t * b[q*nnodes+j];
+              }
+            }
+      }
+    }
+  }
+  ierr = CeedVectorRestoreArrayRead(assembledqf, &qfarray); CeedChk(ierr);
+
+  // Cleanup
+  ierr = CeedVectorDestroy(&assembledqf); CeedChk(ierr);
+  ierr = CeedFree(&identity); CeedChk(ierr);
+  ierr = CeedFree(&emodes[0]); CeedChk(ierr);
+  ierr = CeedFree(&emodes[1]); CeedChk(ierr);
+
+  return 0;
+}
+
+/**
+  @brief Create a CeedOperator applying a dense matrix on each element
+
+  The operator acts on the E-vectors of @a rstrin and @a rstrout, which must
+    have the layout [1, elemsize, elemsize*ncomp]; the library restricts its
+    active input and output L-vectors on each application. An optional
+    auxiliary L-vector is restricted with @a rstraux and multiplied by the
+    trailing @a nb columns of each matrix.
+
+  @param ceed           Ceed object where the CeedOperator will be created
+  @param nelem          Number of elements
+  @param nrows          Number of rows of each element matrix
+  @param nu             Number of columns acting on the active input
+  @param nb             Number of columns acting on the auxiliary input, or 0
+  @param mats           Row-major element matrices of size nrows x (nu + nb)
+  @param rstrin         CeedElemRestriction of the active input
+  @param rstrout        CeedElemRestriction of the active output
+  @param rstraux        CeedElemRestriction of the auxiliary input, or NULL
+  @param aux            Auxiliary L-vector, or NULL
+  @param[out] op        Address of the variable where the newly created
+                          CeedOperator will be stored
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+static int CeedOperatorCreateDense(Ceed ceed, CeedInt nelem, CeedInt nrows,
+                                   CeedInt nu, CeedInt nb,
+                                   const CeedScalar *mats,
+                                   CeedElemRestriction rstrin,
+                                   CeedElemRestriction rstrout,
+                                   CeedElemRestriction rstraux,
+                                   CeedVector aux, CeedOperator *op) {
+  int ierr;
+  CeedInt ncols = nu + nb;
+
+  // -- Matrices
+  CeedVector matvec;
+  ierr = CeedVectorCreate(ceed, nelem*nrows*ncols, &matvec); CeedChk(ierr);
+  ierr = CeedVectorSetArray(matvec, CEED_MEM_HOST, CEED_COPY_VALUES,
+                            (CeedScalar *)mats); CeedChk(ierr);
+
+  // -- Restrictions, one point per element
+  CeedElemRestriction rstrmat, rstru, rstrv, rstrb = NULL;
+  CeedInt stridesmat[3] = {1, 1, nrows*ncols};
+  CeedInt stridesu[3] = {1, 1, nu}, stridesv[3] = {1, 1, nrows};
+  CeedInt stridesb[3] = {1, 1, nb};
+  ierr = CeedElemRestrictionCreateStrided(ceed, nelem, 1, nrows*ncols,
+                                          nelem*nrows*ncols, stridesmat,
+                                          &rstrmat); CeedChk(ierr);
+  ierr = CeedElemRestrictionCreateStrided(ceed, nelem, 1, nu, nelem*nu,
+                                          stridesu, &rstru); CeedChk(ierr);
+  ierr = CeedElemRestrictionCreateStrided(ceed, nelem, 1, nrows, nelem*nrows,
+                                          stridesv, &rstrv); CeedChk(ierr);
+  if (nb) {
+    ierr = CeedElemRestrictionCreateStrided(ceed, nelem, 1, nb, nelem*nb,
+                                            stridesb, &rstrb); CeedChk(ierr);
+  }
+
+  // -- Basis, the identity at the single point of each element
+  CeedBasis basisu;
+  const CeedScalar one = 1.0, zero = 0.0;
+  ierr = CeedBasisCreateTensorH1(ceed, 1, nu, 1, 1, &one, &zero, &zero, &one,
+                                 &basisu); CeedChk(ierr);
+
+  // -- QFunction
+  CeedQFunction qf;
+  ierr = CeedQFunctionCreateInteriorByName(ceed, "DenseApply", &qf);
+  CeedChk(ierr);
+  CeedInt *sizes;
+  ierr = CeedCalloc(3, &sizes); CeedChk(ierr);
+  sizes[0] = nrows;
+  sizes[1] = nu;
+  sizes[2] = nb;
+  CeedQFunctionContext ctx;
+  ierr = CeedQFunctionContextCreate(ceed, &ctx); CeedChk(ierr);
+  ierr = CeedQFunctionContextSetData(ctx, CEED_MEM_HOST, CEED_OWN_POINTER,
+                                     3*sizeof(*sizes), sizes); CeedChk(ierr);
+  ierr = CeedQFunctionSetContext(qf, ctx); CeedChk(ierr);
+  ierr = CeedQFunctionContextDestroy(&ctx); CeedChk(ierr);
+  ierr = CeedQFunctionAddInput(qf, "matrix", nrows*ncols, CEED_EVAL_NONE);
+  CeedChk(ierr);
+  ierr = CeedQFunctionAddInput(qf, "u", nu, CEED_EVAL_INTERP); CeedChk(ierr);
+  if (nb) {
+    ierr = CeedQFunctionAddInput(qf, "b", nb, CEED_EVAL_NONE); CeedChk(ierr);
+  }
+  ierr = CeedQFunctionAddOutput(qf, "v", nrows, CEED_EVAL_NONE); CeedChk(ierr);
+
+  // -- Operator
+  ierr = CeedOperatorCreate(ceed, qf, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                            op); CeedChk(ierr);
+  ierr = CeedOperatorSetField(*op, "matrix", rstrmat, CEED_BASIS_COLLOCATED,
+                              matvec); CeedChk(ierr);
+  ierr = CeedOperatorSetField(*op, "u", rstru, basisu, CEED_VECTOR_ACTIVE);
+  CeedChk(ierr);
+  if (nb) {
+    ierr = CeedElemRestrictionCreateVector(rstraux, NULL, &(*op)->auxework);
+    CeedChk(ierr);
+    ierr = CeedOperatorSetField(*op, "b", rstrb, CEED_BASIS_COLLOCATED,
+                                (*op)->auxework); CeedChk(ierr);
+    rstraux->refcount++;
+    (*op)->auxrstr = rstraux;
+    ierr = CeedVectorAddReference(aux); CeedChk(ierr);
+    (*op)->auxvec = aux;
+  }
+  ierr = CeedOperatorSetField(*op, "v", rstrv, CEED_BASIS_COLLOCATED,
+                              CEED_VECTOR_ACTIVE); CeedChk(ierr);
+  ierr = CeedOperatorSetStreamPassiveFields(*op, true); CeedChk(ierr);
+  rstrin->refcount++;
+  (*op)->inrstr = rstrin;
+  rstrout->refcount++;
+  (*op)->outrstr = rstrout;
+
+  // Cleanup
+  ierr = CeedVectorDestroy(&matvec); CeedChk(ierr);
+  ierr = CeedElemRestrictionDestroy(&rstrmat); CeedChk(ierr);
+  ierr = CeedElemRestrictionDestroy(&rstru); CeedChk(ierr);
+  ierr = CeedElemRestrictionDestroy(&rstrv); CeedChk(ierr);
+  ierr = CeedElemRestrictionDestroy(&rstrb); CeedChk(ierr);
+  ierr = CeedBasisDestroy(&basisu); CeedChk(ierr);
+  ierr = CeedQFunctionDestroy(&qf); CeedChk(ierr);
+
+  return 0;
+}
+
+/**
+  @brief Common code for static condensation of the element-interior nodes of
+           a CeedOperator
+
+  @param op                  CeedOperator to condense
+  @param rhs                 L-vector read by the back-solve operator, or
+                               @ref CEED_VECTOR_NONE
+  @param[out] rstrSkeleton   CeedElemRestriction onto the skeleton nodes
+  @param[out] opSchur        Condensed CeedOperator on the skeleton
+  @param[out] opRHS          CeedOperator condensing a right hand side
+  @param[out] opBackSolve    CeedOperator recovering the full solution
+  @param request             Address of CeedRequest for non-blocking
+                               completion, else @ref CEED_REQUEST_IMMEDIATE
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+int CeedOperatorStaticCondensation_Core(CeedOperator op,
+    CeedVector rhs, CeedElemRestriction *rstrSkeleton, CeedOperator *opSchur,
+    CeedOperator *opRHS, CeedOperator *opBackSolve, CeedRequest *request) {
+  int ierr;
+  Ceed ceed = op->ceed;
+
+  // Element matrices
+  CeedElemRestriction rstr;
+  CeedBasis basis;
+  CeedScalar *elemmats;
+  ierr = CeedOperatorAssembleElementMatrices(op, &rstr, &basis, &elemmats,
+         request); CeedChk(ierr);
+
+  // Check restriction and basis
+  bool tensorbasis, isstrided;
+  ierr = CeedBasisIsTensor(basis, &tensorbasis); CeedChk(ierr);
+  ierr = CeedElemRestrictionIsStrided(rstr, &isstrided); CeedChk(ierr);
+  CeedInt P1d, dim, nnodes, ncomp, nelem, lsize, compstride, layout[3];
+  ierr = CeedBasisGetNumNodes1D(basis, &P1d); CeedChk(ierr);
+  ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
+  ierr = CeedBasisGetNumNodes(basis, &nnodes); CeedChk(ierr);
+  ierr = CeedBasisGetNumComponents(basis, &ncomp); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumElements(rstr, &nelem); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetLVectorSize(rstr, &lsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetELayout(rstr, &layout); CeedChk(ierr);
+  const char *unsupported = NULL;
+  if (!tensorbasis)
+    unsupported = "Static condensation only supported for tensor bases";
+  else if (isstrided || rstr->gsize)
+    unsupported = "Static condensation requires a restriction with offsets "
+                  "and no ghost nodes";
+  else if (layout[0] != 1 || layout[1] != nnodes || layout[2] != nnodes*ncomp)
+    unsupported = "Static condensation requires the E-vector layout "
+                  "[1, elemsize, elemsize*ncomp]";
+  if (unsupported) {
+    // LCOV_EXCL_START
+    ierr = CeedFree(&elemmats); CeedChk(ierr);
+    return CeedError(ceed, 1, "%s", unsupported);
+    // LCOV_EXCL_STOP
+  }
+  ierr = CeedElemRestrictionGetCompStride(rstr, &compstride); CeedChk(ierr);
+
+  // Split element nodes into skeleton and interior nodes
+  CeedInt nb = 0, ni = 0, *bnodes, *inodes;
+  ierr = CeedMalloc(nnodes, &bnodes); CeedChk(ierr);
+  ierr = CeedMalloc(nnodes, &inodes); CeedChk(ierr);
+  for (CeedInt n=0; n<nnodes; n++) {
+    bool interior = true;
+    for (CeedInt d=0; d<dim; d++) {
+      CeedInt i = (n / CeedIntPow(P1d, d)) % P1d;
+      interior = interior && i > 0 && i < P1d-1;
+    }
+    if (interior)
+      inodes[ni++] = n;
+    else
+      bnodes[nb++] = n;
+  }
+  CeedInt N = ncomp*nnodes, Nb = ncomp*nb, Ni = ncomp*ni;
+  CeedInt *fb, *fi;
+  ierr = CeedMalloc(Nb, &fb); CeedChk(ierr);
+  ierr = CeedMalloc(Ni, &fi); CeedChk(ierr);
+  for (CeedInt c=0; c<ncomp; c++) {
+    for (CeedInt k=0; k<nb; k++)
+      fb[c*nb+k] = c*nnodes + bnodes[k];
+    for (CeedInt k=0; k<ni; k++)
+      fi[c*ni+k] = c*nnodes + inodes[k];
+  }
+
+  // Node multiplicity and skeleton numbering; interior nodes must belong to
+  //   a single element. Errors from here on are held in ierrcore until the
+  //   offsets are restored and the buffers freed.
+  int ierrcore = 0;
+  const CeedInt *offsets;
+  CeedInt *count, *skelnum, *skeloffsets, nskel = 0;
+  ierr = CeedElemRestrictionGetOffsets(rstr, CEED_MEM_HOST, &offsets);
+  CeedChk(ierr);
+  ierr = CeedCalloc(lsize, &count); CeedChk(ierr);
+  ierr = CeedMalloc(lsize, &skelnum); CeedChk(ierr);
+  ierr = CeedMalloc(nelem*nb, &skeloffsets); CeedChk(ierr);
+  for (CeedInt i=0; i<nelem*nnodes; i++)
+    count[offsets[i]]++;
+  for (CeedInt i=0; i<lsize; i++)
+    skelnum[i] = -1;
+  for (CeedInt e=0; e<nelem && !ierrcore; e++) {
+    for (CeedInt k=0; k<ni && !ierrcore; k++)
+      if (count[offsets[e*nnodes+inodes[k]]] != 1)
+        // LCOV_EXCL_START
+        ierrcore = CeedError(ceed, 1, "Static condensation requires interior "
+                             "nodes to belong to a single element");
+    // LCOV_EXCL_STOP
+    for (CeedInt k=0; k<nb; k++) {
+      CeedInt ind = offsets[e*nnodes+bnodes[k]];
+      if (skelnum[ind] < 0)
+        skelnum[ind] = nskel++;
+      skeloffsets[e*nb+k] = skelnum[ind];
+    }
+  }
+
+  // Condensed element matrices
+  //   X = A_ii^-1 [A_ib | I]
+  //   S = A_bb - A_bi A_ii^-1 A_ib
+  //   G = [W_b | -A_bi A_ii^-1]
+  //   U = [W_b 0; -A_ii^-1 A_ib A_ii^-1]
+  //   with W_b the inverse multiplicity of the skeleton nodes
+  bool hasrhs = rhs && rhs != CEED_VECTOR_NONE;
+  CeedInt nX = Nb + Ni, nU = Nb + (hasrhs ? N : 0);
+  CeedScalar *Aii, *X, *schur, *G, *U;
+  ierr = CeedMalloc(Ni*Ni, &Aii); CeedChk(ierr);
+  ierr = CeedMalloc(Ni*nX, &X); CeedChk(ierr);
+  ierr = CeedMalloc(nelem*Nb*Nb, &schur); CeedChk(ierr);
+  ierr = CeedCalloc(nelem*Nb*N, &G); CeedChk(ierr);
+  ierr = CeedCalloc(nelem*N*nU, &U); CeedChk(ierr);
+  for (CeedInt e=0; e<nelem && !ierrcore; e++) {
+    const CeedScalar *A = &elemmats[e*N*N];
+    CeedScalar *S = &schur[e*Nb*Nb], *Ge = &G[e*Nb*N], *Ue = &U[e*N*nU];
+    for (CeedInt a=0; a<Ni; a++) {
+      for (CeedInt c=0; c<Ni; c++)
+        Aii[a*Ni+c] = A[fi[a]*N+fi[c]];
+      for (CeedInt c=0; c<nX; c++)
+        X[a*nX+c] = c < Nb ? A[fi[a]*N+fb[c]] : (c-Nb == a);
+    }
+    ierrcore = CeedOperatorDenseSolve(ceed, Aii, X, Ni, nX);
+    if (ierrcore)
+      break;
+    for (CeedInt r=0; r<Nb; r++) {
+      CeedScalar w = 1.0 / count[offsets[e*nnodes+bnodes[r%nb]]];
+      for (CeedInt c=0; c<Nb; c++) {
+        CeedScalar s = A[fb[r]*N+fb[c]];
+        for (CeedInt a=0; a<Ni; a++)
+          s -= A[fb[r]*N+fi[a]] * X[a*nX+c];
+        S[r*Nb+c] = s;
+      }
+      Ge[r*N+fb[r]] = w;
+      for (CeedInt c=0; c<Ni; c++) {
+        CeedScalar s = 0;
+        for (CeedInt a=0; a<Ni; a++)
+          s -= A[fb[r]*N+fi[a]] * X[a*nX+Nb+c];
+        Ge[r*N+fi[c]] = s;
+      }
+      Ue[fb[r]*nU+r] = w;
+    }
+    for (CeedInt a=0; a<Ni; a++) {
+      for (CeedInt c=0; c<Nb; c++)
+        Ue[fi[a]*nU+c] = -X[a*nX+c];
+      if (hasrhs)
+        for (CeedInt c=0; c<Ni; c++)
+          Ue[fi[a]*nU+Nb+fi[c]] = X[a*nX+Nb+c];
+    }
+  }
+  ierr = CeedElemRestrictionRestoreOffsets(rstr, &offsets);
+  ierrcore = ierrcore ? ierrcore : ierr;
+
+  // Skeleton restriction
+  *rstrSkeleton = NULL;
+  *opSchur = *opRHS = *opBackSolve = NULL;
+  if (!ierrcore)
+    ierrcore = CeedElemRestrictionCreate(ceed, nelem, nb, ncomp, nskel,
+                                         ncomp*nskel, CEED_MEM_HOST,
+                                         CEED_COPY_VALUES, skeloffsets,
+                                         rstrSkeleton);
+
+  // Operators
+  if (!ierrcore)
+    ierrcore = CeedOperatorCreateDense(ceed, nelem, Nb, Nb, 0, schur,
+                                       *rstrSkeleton, *rstrSkeleton, NULL,
+                                       NULL, opSchur);
+  if (!ierrcore)
+    ierrcore = CeedOperatorCreateDense(ceed, nelem, Nb, N, 0, G, rstr,
+                                       *rstrSkeleton, NULL, NULL, opRHS);
+  if (!ierrcore)
+    ierrcore = CeedOperatorCreateDense(ceed, nelem, N, Nb, hasrhs ? N : 0, U,
+                                       *rstrSkeleton, rstr, rstr, rhs,
+                                       opBackSolve);
+
+  // Cleanup, also on error
+  ierr = CeedFree(&elemmats); CeedChk(ierr);
+  ierr = CeedFree(&bnodes); CeedChk(ierr);
+  ierr = CeedFree(&inodes); CeedChk(ierr);
+  ierr = CeedFree(&fb); CeedChk(ierr);
+  ierr = CeedFree(&fi); CeedChk(ierr);
+  ierr = CeedFree(&count); CeedChk(ierr);
+  ierr = CeedFree(&skelnum); CeedChk(ierr);
+  ierr = CeedFree(&skeloffsets); CeedChk(ierr);
+  ierr = CeedFree(&Aii); CeedChk(ierr);
+  ierr = CeedFree(&X); CeedChk(ierr);
+  ierr = CeedFree(&schur); CeedChk(ierr);
+  ierr = CeedFree(&G); CeedChk(ierr);
+  ierr = CeedFree(&U); CeedChk(ierr);
+  if (ierrcore) {
+    // LCOV_EXCL_START
+    ierr = CeedOperatorDestroy(opSchur); CeedChk(ierr);
+    ierr = CeedOperatorDestroy(opRHS); CeedChk(ierr);
+    ierr = CeedOperatorDestroy(opBackSolve); CeedChk(ierr);
+    ierr = CeedElemRestrictionDestroy(rstrSkeleton); CeedChk(ierr);
+    return ierrcore;
+    // LCOV_EXCL_STOP
+  }
+
+  return 0;
+}
+
+/// @}
@@ -125,7 +125,7 @@ int CeedElemRestrictionGetOffsets(CeedElemRestriction rstr, CeedMemType mtype,
   // LCOV_EXCL_STOP
 
   ierr = rstr->GetOffsets(rstr, mtype, offsets); CeedChk(ierr);
-  rstr->numreaders++;
+  CeedAtomicIncrement(rstr->numreaders);
   return 0;
 }
 
@@ -142,7 +142,42 @@ int CeedElemRestrictionGetOffsets(CeedElemRestriction rstr, CeedMemType mtype,
 int CeedElemRestrictionRestoreOffsets(CeedElemRestriction rstr,
                                       const CeedInt **offsets) {
   *offsets = NULL;
-  rstr->numreaders--;
+  CeedAtomicDecrement(rstr->numreaders);
+  return 0;
+}
+
+/**
+  @brief Get the size of the ghost vectors addressed by a CeedElemRestriction
+
+  @param rstr        CeedElemRestriction
+  @param[out] gsize  Variable to store ghost vector size, 0 if offsets do not
+                       address ghost values
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedElemRestrictionGetGhostSize(CeedElemRestriction rstr, CeedInt *gsize) {
+  *gsize = rstr->gsize;
+  return 0;
+}
+
+/**
+  @brief Get the ghost vectors of a CeedElemRestriction
+
+  @param rstr           CeedElemRestriction
+  @param[out] ghostin   Variable to store ghost input vector, or NULL
+  @param[out] ghostout  Variable to store ghost output vector, or NULL
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedElemRestrictionGetGhostVectors(CeedElemRestriction rstr,
+                                       CeedVector *ghostin,
+                                       CeedVector *ghostout) {
+  if (ghostin) *ghostin = rstr->ghostin;
+  if (ghostout) *ghostout = rstr->ghostout;
   return 0;
 }
 
@@ -184,6 +219,71 @@ int CeedElemRestrictionHasBackendStrides(CeedElemRestriction rstr,
   return 0;
 }
 
+/**
+  @brief Get the constant status of a CeedElemRestriction
+
+  A strided CeedElemRestriction with zero node and element strides reads the
+    same value of each component at every node of every element, so its
+    L-vector holds only one value per component.
+
+  @param rstr             CeedElemRestriction
+  @param[out] isconstant  Variable to store constant status
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedElemRestrictionIsConstant(CeedElemRestriction rstr, bool *isconstant) {
+  *isconstant = rstr->strides && rstr->strides[0] == 0 &&
+                rstr->strides[1] != 0 && rstr->strides[2] == 0;
+  return 0;
+}
+
+/**
+  @brief Broadcast the L-vector of a constant CeedElemRestriction into the
+           E-vector of one block of elements
+
+  @param rstr     Constant CeedElemRestriction, see
+                    CeedElemRestrictionIsConstant()
+  @param blksize  Number of elements in the block
+  @param u        Input L-vector with one value per component
+  @param ru       Output E-vector of length blksize*elemsize*ncomp, with the
+                    layout of a block of a blocked restriction
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedElemRestrictionApplyConstant(CeedElemRestriction rstr,
+                                     CeedInt blksize, CeedVector u,
+                                     CeedVector ru) {
+  int ierr;
+  bool isconstant;
+  ierr = CeedElemRestrictionIsConstant(rstr, &isconstant); CeedChk(ierr);
+  if (!isconstant)
+    // LCOV_EXCL_START
+    return CeedError(rstr->ceed, 1, "ElemRestriction is not constant");
+  // LCOV_EXCL_STOP
+  const CeedInt n = blksize*rstr->elemsize;
+  if (ru->length != n*rstr->ncomp)
+    // LCOV_EXCL_START
+    return CeedError(rstr->ceed, 1, "Output vector size %d not compatible "
+                     "with block of %d elements of size %d", ru->length,
+                     blksize, rstr->elemsize);
+  // LCOV_EXCL_STOP
+
+  const CeedScalar *uu;
+  CeedScalar *vv;
+  ierr = CeedVectorGetArrayRead(u, CEED_MEM_HOST, &uu); CeedChk(ierr);
+  ierr = CeedVectorGetArrayWrite(ru, CEED_MEM_HOST, &vv); CeedChk(ierr);
+  for (CeedInt k=0; k<rstr->ncomp; k++)
+    for (CeedInt i=0; i<n; i++)
+      vv[k*n + i] = uu[k*rstr->strides[1]];
+  ierr = CeedVectorRestoreArrayRead(u, &uu); CeedChk(ierr);
+  ierr = CeedVectorRestoreArray(ru, &vv); CeedChk(ierr);
+  return 0;
+}
+
 /**
 
   @brief Get the E-vector layout of a CeedElemRestriction
@@ -315,6 +415,49 @@ int CeedElemRestrictionCreate(Ceed ceed, CeedInt nelem, CeedInt elemsize,
                               CeedInt lsize, CeedMemType mtype,
                               CeedCopyMode cmode, const CeedInt *offsets,
                               CeedElemRestriction *rstr) {
+  return CeedElemRestrictionCreateGhosted(ceed, nelem, elemsize, ncomp,
+                                          compstride, lsize, 0, mtype, cmode,
+                                          offsets, rstr);
+}
+
+/**
+  @brief Create a CeedElemRestriction that gathers from owned and ghost storage
+
+  Offsets in the range [@a lsize, @a lsize + @a gsize) address entry
+    offset - @a lsize of a separate ghost vector, so an owned L-vector and its
+    ghost values need not be copied into one contiguous local vector. The
+    ghost vectors are provided with CeedElemRestrictionSetGhostVectors().
+    Ghost values are supported by the CPU backends.
+
+  @param ceed       A Ceed object where the CeedElemRestriction will be created
+  @param nelem      Number of elements described in the @a offsets array
+  @param elemsize   Size (number of "nodes") per element
+  @param ncomp      Number of field components per interpolation node
+                      (1 for scalar fields)
+  @param compstride Stride between components for the same "node", in both
+                      the L-vector and the ghost vectors
+  @param lsize      The size of the owned L-vector
+  @param gsize      The size of the ghost vectors
+  @param mtype      Memory type of the @a offsets array, see CeedMemType
+  @param cmode      Copy mode for the @a offsets array, see CeedCopyMode
+  @param offsets    Array of shape [@a nelem, @a elemsize]. Row i holds the
+                      ordered list of the offsets for the unknowns
+                      corresponding to element i, where 0 <= i < @a nelem.
+                      All offsets must be in the range
+                      [0, @a lsize + @a gsize - 1].
+  @param[out] rstr  Address of the variable where the newly created
+                      CeedElemRestriction will be stored
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedElemRestrictionCreateGhosted(Ceed ceed, CeedInt nelem,
+                                     CeedInt elemsize, CeedInt ncomp,
+                                     CeedInt compstride, CeedInt lsize,
+                                     CeedInt gsize, CeedMemType mtype,
+                                     CeedCopyMode cmode, const CeedInt *offsets,
+                                     CeedElemRestriction *rstr) {
   int ierr;
 
   if (!ceed->ElemRestrictionCreate) {
@@ -327,21 +470,23 @@ int CeedElemRestrictionCreate(Ceed ceed, CeedInt nelem, CeedInt elemsize,
       return CeedError(ceed, 1, "Backend does not support ElemRestrictionCreate");
     // LCOV_EXCL_STOP
 
-    ierr = CeedElemRestrictionCreate(delegate, nelem, elemsize, ncomp,
-                                     compstride, lsize, mtype, cmode,
-                                     offsets, rstr); CeedChk(ierr);
+    ierr = CeedElemRestrictionCreateGhosted(delegate, nelem, elemsize, ncomp,
+                                            compstride, lsize, gsize, mtype,
+                                            cmode, offsets, rstr);
+    CeedChk(ierr);
     return 0;
   }
 
   ierr = CeedCalloc(1, rstr); CeedChk(ierr);
   (*rstr)->ceed = ceed;
-  ceed->refcount++;
+  CeedAtomicIncrement(ceed->refcount);
   (*rstr)->refcount = 1;
   (*rstr)->nelem = nelem;
   (*rstr)->elemsize = elemsize;
   (*rstr)->ncomp = ncomp;
   (*rstr)->compstride = compstride;
   (*rstr)->lsize = lsize;
+  (*rstr)->gsize = gsize;
   (*rstr)->nblk = nelem;
   (*rstr)->blksize = 1;
   ierr = ceed->ElemRestrictionCreate(mtype, cmode, offsets, *rstr);
@@ -396,7 +541,7 @@ int CeedElemRestrictionCreateStrided(Ceed ceed, CeedInt nelem, CeedInt elemsize,
 
   ierr = CeedCalloc(1, rstr); CeedChk(ierr);
   (*rstr)->ceed = ceed;
-  ceed->refcount++;
+  CeedAtomicIncrement(ceed->refcount);
   (*rstr)->refcount = 1;
   (*rstr)->nelem = nelem;
   (*rstr)->elemsize = elemsize;
@@ -451,6 +596,41 @@ int CeedElemRestrictionCreateBlocked(Ceed ceed, CeedInt nelem, CeedInt elemsize,
                                      CeedMemType mtype, CeedCopyMode cmode,
                                      const CeedInt *offsets,
                                      CeedElemRestriction *rstr) {
+  return CeedElemRestrictionCreateBlockedGhosted(ceed, nelem, elemsize,
+         blksize, ncomp, compstride, lsize, 0, mtype, cmode, offsets, rstr);
+}
+
+/**
+  @brief Create a blocked CeedElemRestriction that gathers from owned and
+           ghost storage, typically only called by backends
+
+  See CeedElemRestrictionCreateGhosted() for the meaning of @a gsize and
+    CeedElemRestrictionCreateBlocked() for the remaining arguments.
+
+  @param ceed       A Ceed object where the CeedElemRestriction will be created.
+  @param nelem      Number of elements described in the @a offsets array.
+  @param elemsize   Size (number of unknowns) per element
+  @param blksize    Number of elements in a block
+  @param ncomp      Number of field components per interpolation node
+                      (1 for scalar fields)
+  @param compstride Stride between components for the same "node"
+  @param lsize      The size of the owned L-vector
+  @param gsize      The size of the ghost vectors
+  @param mtype      Memory type of the @a offsets array, see CeedMemType
+  @param cmode      Copy mode for the @a offsets array, see CeedCopyMode
+  @param offsets    Array of shape [@a nelem, @a elemsize] with offsets in the
+                      range [0, @a lsize + @a gsize - 1]
+  @param rstr       Address of the variable where the newly created
+                      CeedElemRestriction will be stored
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+ **/
+int CeedElemRestrictionCreateBlockedGhosted(Ceed ceed, CeedInt nelem,
+    CeedInt elemsize, CeedInt blksize, CeedInt ncomp, CeedInt compstride,
+    CeedInt lsize, CeedInt gsize, CeedMemType mtype, CeedCopyMode cmode,
+    const CeedInt *offsets, CeedElemRestriction *rstr) {
   int ierr;
   CeedInt *blkoffsets;
   CeedInt nblk = (nelem / blksize) + !!(nelem % blksize);
@@ -466,10 +646,9 @@ int CeedElemRestrictionCreateBlocked(Ceed ceed, CeedInt nelem, CeedInt elemsize,
                        "ElemRestrictionCreateBlocked");
     // LCOV_EXCL_STOP
 
-    ierr = CeedElemRestrictionCreateBlocked(delegate, nelem, elemsize, blksize,
-                                            ncomp, compstride, lsize, mtype,
-                                            cmode, offsets, rstr);
-    CeedChk(ierr);
+    ierr = CeedElemRestrictionCreateBlockedGhosted(delegate, nelem, elemsize,
+           blksize, ncomp, compstride, lsize, gsize, mtype, cmode, offsets,
+           rstr); CeedChk(ierr);
     return 0;
   }
 
@@ -481,13 +660,14 @@ int CeedElemRestrictionCreateBlocked(Ceed ceed, CeedInt nelem, CeedInt elemsize,
   CeedChk(ierr);
 
   (*rstr)->ceed = ceed;
-  ceed->refcount++;
+  CeedAtomicIncrement(ceed->refcount);
   (*rstr)->refcount = 1;
   (*rstr)->nelem = nelem;
   (*rstr)->elemsize = elemsize;
   (*rstr)->ncomp = ncomp;
   (*rstr)->compstride = compstride;
   (*rstr)->lsize = lsize;
+  (*rstr)->gsize = gsize;
   (*rstr)->nblk = nblk;
   (*rstr)->blksize = blksize;
   ierr = ceed->ElemRestrictionCreateBlocked(CEED_MEM_HOST, CEED_OWN_POINTER,
@@ -550,7 +730,7 @@ int CeedElemRestrictionCreateBlockedStrided(Ceed ceed, CeedInt nelem,
   ierr = CeedCalloc(1, rstr); CeedChk(ierr);
 
   (*rstr)->ceed = ceed;
-  ceed->refcount++;
+  CeedAtomicIncrement(ceed->refcount);
   (*rstr)->refcount = 1;
   (*rstr)->nelem = nelem;
   (*rstr)->elemsize = elemsize;
@@ -593,6 +773,49 @@ int CeedElemRestrictionCreateVector(CeedElemRestriction rstr, CeedVector *lvec,
   return 0;
 }
 
+/**
+  @brief Set the ghost vectors addressed by a ghosted CeedElemRestriction
+
+  With @ref CEED_NOTRANSPOSE, offsets in [@a lsize, @a lsize + @a gsize) read
+    from @a ghostin. With @ref CEED_TRANSPOSE, contributions to these offsets
+    are summed into @a ghostout, which is not zeroed by the restriction or by
+    CeedOperatorApply(). Ghost contributions are discarded if @a ghostout is
+    NULL. Vectors used by a CeedOperator must be set before its first apply.
+
+  @param rstr      CeedElemRestriction created with
+                     CeedElemRestrictionCreateGhosted()
+  @param ghostin   Ghost input vector of size @a gsize, or NULL
+  @param ghostout  Ghost output vector of size @a gsize, or NULL
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedElemRestrictionSetGhostVectors(CeedElemRestriction rstr,
+                                       CeedVector ghostin,
+                                       CeedVector ghostout) {
+  int ierr;
+
+  if ((ghostin && ghostin->length != rstr->gsize) ||
+      (ghostout && ghostout->length != rstr->gsize))
+    // LCOV_EXCL_START
+    return CeedError(rstr->ceed, 1, "Ghost vector size not compatible with "
+                     "element restriction ghost size %d", rstr->gsize);
+  // LCOV_EXCL_STOP
+
+  if (ghostin) {
+    ierr = CeedVectorAddReference(ghostin); CeedChk(ierr);
+  }
+  if (ghostout) {
+    ierr = CeedVectorAddReference(ghostout); CeedChk(ierr);
+  }
+  ierr = CeedVectorDestroy(&rstr->ghostin); CeedChk(ierr);
+  ierr = CeedVectorDestroy(&rstr->ghostout); CeedChk(ierr);
+  rstr->ghostin = ghostin;
+  rstr->ghostout = ghostout;
+  return 0;
+}
+
 /**
   @brief Restrict an L-vector to an E-vector or apply its transpose
 
@@ -877,6 +1100,8 @@ int CeedElemRestrictionDestroy(CeedElemRestriction *rstr) {
     ierr = (*rstr)->Destroy(*rstr); CeedChk(ierr);
   }
   ierr = CeedFree(&(*rstr)->strides); CeedChk(ierr);
+  ierr = CeedVectorDestroy(&(*rstr)->ghostin); CeedChk(ierr);
+  ierr = CeedVectorDestroy(&(*rstr)->ghostout); CeedChk(ierr);
   ierr = CeedDestroy(&(*rstr)->ceed); CeedChk(ierr);
   ierr = CeedFree(rstr); CeedChk(ierr);
   return 0;
@@ -0,0 +1,263 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-734707. All Rights
+// reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <ceed-impl.h>
+#include <ceed-backend.h>
+#include <math.h>
+
+/// @file
+/// Implementation of FDM element inverses for CeedOperators
+
+/// ----------------------------------------------------------------------------
+/// CeedOperator Library Internal Functions
+/// ----------------------------------------------------------------------------
+/// @addtogroup CeedOperatorDeveloper
+/// @{
+
+/**
+  @brief Build a FDM based approximate inverse for each element of a
+           CeedOperator on the Ceed of the operator, for backends without
+           their own implementation
+
+  The diagonal S^hat of the inverse is stored as the product of a diagonal
+    shared by all elements and a scaling for each element, read through
+    strided restrictions with zero strides. Both passive fields are streamed
+    so that backends supporting it never expand them to E-vectors.
+
+  @param op             CeedOperator to create element inverses
+  @param[out] fdminv    CeedOperator to apply the action of a FDM based inverse
+                          for each element
+  @param request        Address of CeedRequest for non-blocking completion, else
+                          @ref CEED_REQUEST_IMMEDIATE
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+int CeedOperatorCreateFDMElementInverse_Core(CeedOperator op,
+    CeedOperator *fdminv, CeedRequest *request) {
+  int ierr;
+  Ceed ceed = op->ceed;
+
+  // Determine active input basis
+  bool interp = false, grad = false;
+  CeedBasis basis = NULL;
+  CeedElemRestriction rstr = NULL;
+  for (CeedInt i=0; i<op->qf->numinputfields; i++)
+    if (op->inputfields[i]->vec == CEED_VECTOR_ACTIVE) {
+      CeedEvalMode emode = op->qf->inputfields[i]->emode;
+      interp = interp || emode == CEED_EVAL_INTERP;
+      grad = grad || emode == CEED_EVAL_GRAD;
+      basis = op->inputfields[i]->basis;
+      rstr = op->inputfields[i]->Erestrict;
+    }
+  if (!basis)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "No active field set");
+  // LCOV_EXCL_STOP
+  CeedInt P1d, Q1d, elemsize, nqpts, dim, ncomp = 1, nelem = 1;
+  ierr = CeedBasisGetNumNodes1D(basis, &P1d); CeedChk(ierr);
+  ierr = CeedBasisGetNumNodes(basis, &elemsize); CeedChk(ierr);
+  ierr = CeedBasisGetNumQuadraturePoints1D(basis, &Q1d); CeedChk(ierr);
+  ierr = CeedBasisGetNumQuadraturePoints(basis, &nqpts); CeedChk(ierr);
+  ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
+  ierr = CeedBasisGetNumComponents(basis, &ncomp); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumElements(rstr, &nelem); CeedChk(ierr);
+
+  // Build and diagonalize 1D Mass and Laplacian
+  bool tensorbasis;
+  ierr = CeedBasisIsTensor(basis, &tensorbasis); CeedChk(ierr);
+  if (!tensorbasis)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "FDMElementInverse only supported for tensor "
+                     "bases");
+  // LCOV_EXCL_STOP
+  CeedScalar *work, *mass, *laplace, *x, *x2, *lambda;
+  ierr = CeedMalloc(Q1d*P1d, &work); CeedChk(ierr);
+  ierr = CeedMalloc(P1d*P1d, &mass); CeedChk(ierr);
+  ierr = CeedMalloc(P1d*P1d, &laplace); CeedChk(ierr);
+  ierr = CeedMalloc(P1d*P1d, &x); CeedChk(ierr);
+  ierr = CeedMalloc(P1d*P1d, &x2); CeedChk(ierr);
+  ierr = CeedMalloc(P1d, &lambda); CeedChk(ierr);
+  // -- Mass
+  const CeedScalar *interp1d, *grad1d, *qweight1d;
+  ierr = CeedBasisGetInterp1D(basis, &interp1d); CeedChk(ierr);
+  ierr = CeedBasisGetGrad1D(basis, &grad1d); CeedChk(ierr);
+  ierr = CeedBasisGetQWeights(basis, &qweight1d); CeedChk(ierr);
+  for (CeedInt i=0; i<Q1d; i++)
+    for (CeedInt j=0; j<P1d; j++)
+      work[i+j*Q1d] = interp1d[i*P1d+j]*qweight1d[i];
+  ierr = CeedMatrixMultiply(ceed, (const CeedScalar *)work,
+                            (const CeedScalar *)interp1d, mass, P1d, P1d, Q1d);
+  CeedChk(ierr);
+  // -- Laplacian
+  for (CeedInt i=0; i<Q1d; i++)
+    for (CeedInt j=0; j<P1d; j++)
+      work[i+j*Q1d] = grad1d[i*P1d+j]*qweight1d[i];
+  ierr = CeedMatrixMultiply(ceed, (const CeedScalar *)work,
+                            (const CeedScalar *)grad1d, laplace, P1d, P1d, Q1d);
+  CeedChk(ierr);
+  // -- Diagonalize
+  ierr = CeedSimultaneousDiagonalization(ceed, laplace, mass, x, lambda, P1d);
+  CeedChk(ierr);
+  ierr = CeedFree(&work); CeedChk(ierr);
+  ierr = CeedFree(&mass); CeedChk(ierr);
+  ierr = CeedFree(&laplace); CeedChk(ierr);
+  for (CeedInt i=0; i<P1d; i++)
+    for (CeedInt j=0; j<P1d; j++)
+      x2[i+j*P1d] = x[j+i*P1d];
+  ierr = CeedFree(&x); CeedChk(ierr);
+
+  // Assemble QFunction
+  CeedVector assembled;
+  CeedElemRestriction rstr_qf;
+  ierr =  CeedOperatorLinearAssembleQFunction(op, &assembled, &rstr_qf,
+          request); CeedChk(ierr);
+  ierr = CeedElemRestrictionDestroy(&rstr_qf); CeedChk(ierr);
+  CeedScalar maxnorm = 0;
+  ierr = CeedVectorNorm(assembled, CEED_NORM_MAX, &maxnorm); CeedChk(ierr);
+
+  // Calculate element averages
+  CeedInt nfields = ((interp?1:0) + (grad?dim:0))*((interp?1:0) + (grad?dim:0));
+  CeedInt qfsize = nqpts*ncomp*ncomp*nfields;
+  CeedVector scale;
+  CeedScalar *scalearray;
+  const CeedScalar *assembledarray, *qweightsarray;
+  CeedVector qweights;
+  ierr = CeedVectorCreate(ceed, nqpts, &qweights); CeedChk(ierr);
+  ierr = CeedBasisApply(basis, 1, CEED_NOTRANSPOSE, CEED_EVAL_WEIGHT,
+                        CEED_VECTOR_NONE, qweights); CeedChk(ierr);
+  ierr = CeedVectorGetArrayRead(assembled, CEED_MEM_HOST, &assembledarray);
+  CeedChk(ierr);
+  ierr = CeedVectorGetArrayRead(qweights, CEED_MEM_HOST, &qweightsarray);
+  CeedChk(ierr);
+  ierr = CeedVectorCreate(ceed, nelem, &scale); CeedChk(ierr);
+  ierr = CeedVectorGetArray(scale, CEED_MEM_HOST, &scalearray); CeedChk(ierr);
+  for (CeedInt e=0; e<nelem; e++) {
+    CeedScalar elemavg = 0;
+    CeedInt count = 0;
+    for (CeedInt q=0; q<nqpts; q++)
+      for (CeedInt i=0; i<ncomp*ncomp*nfields; i++)
+        if (fabs(assembledarray[e*qfsize + i*nqpts + q]) > maxnorm*1e-12) {
+          elemavg += assembledarray[e*qfsize + i*nqpts + q] / qweightsarray[q];
+          count++;
+        }
+    if (count)
+      elemavg /= count;
+    scalearray[e] = 1 / elemavg;
+  }
+  ierr = CeedVectorRestoreArray(scale, &scalearray); CeedChk(ierr);
+  ierr = CeedVectorRestoreArrayRead(assembled, &assembledarray); CeedChk(ierr);
+  ierr = CeedVectorDestroy(&assembled); CeedChk(ierr);
+  ierr = CeedVectorRestoreArrayRead(qweights, &qweightsarray); CeedChk(ierr);
+  ierr = CeedVectorDestroy(&qweights); CeedChk(ierr);
+
+  // Build FDM diagonal shared by all elements
+  CeedVector diag;
+  CeedScalar *diagarray;
+  ierr = CeedVectorCreate(ceed, elemsize, &diag); CeedChk(ierr);
+  ierr = CeedVectorGetArray(diag, CEED_MEM_HOST, &diagarray); CeedChk(ierr);
+  for (CeedInt n=0; n<elemsize; n++) {
+    diagarray[n] = 0;
+    if (interp)
+      diagarray[n] = 1;
+    if (grad)
+      for (CeedInt d=0; d<dim; d++) {
+        CeedInt i = (n / CeedIntPow(P1d, d)) % P1d;
+        diagarray[n] += lambda[i];
+      }
+    diagarray[n] = 1 / diagarray[n];
+  }
+  ierr = CeedVectorRestoreArray(diag, &diagarray); CeedChk(ierr);
+
+  // Setup FDM operator
+  // -- Basis
+  CeedBasis fdm_basis;
+  CeedScalar *graddummy, *qrefdummy, *qweightdummy;
+  ierr = CeedCalloc(P1d*P1d, &graddummy); CeedChk(ierr);
+  ierr = CeedCalloc(P1d, &qrefdummy); CeedChk(ierr);
+  ierr = CeedCalloc(P1d, &qweightdummy); CeedChk(ierr);
+  ierr = CeedBasisCreateTensorH1(ceed, dim, ncomp, P1d, P1d, x2, graddummy,
+                                 qrefdummy, qweightdummy, &fdm_basis);
+  CeedChk(ierr);
+  ierr = CeedFree(&graddummy); CeedChk(ierr);
+  ierr = CeedFree(&qrefdummy); CeedChk(ierr);
+  ierr = CeedFree(&qweightdummy); CeedChk(ierr);
+  ierr = CeedFree(&x2); CeedChk(ierr);
+  ierr = CeedFree(&lambda); CeedChk(ierr);
+
+  // -- Restrictions
+  CeedElemRestriction rstr_i, rstr_diag, rstr_scale;
+  CeedInt strides[3] = {1, elemsize, elemsize*ncomp};
+  ierr = CeedElemRestrictionCreateStrided(ceed, nelem, elemsize, ncomp,
+                                          elemsize*nelem*ncomp, strides, &rstr_i);
+  CeedChk(ierr);
+  CeedInt stridesdiag[3] = {1, 0, 0};
+  ierr = CeedElemRestrictionCreateStrided(ceed, nelem, elemsize, 1, elemsize,
+                                          stridesdiag, &rstr_diag);
+  CeedChk(ierr);
+  CeedInt stridesscale[3] = {0, 0, 1};
+  ierr = CeedElemRestrictionCreateStrided(ceed, nelem, elemsize, 1, nelem,
+                                          stridesscale, &rstr_scale);
+  CeedChk(ierr);
+  // -- QFunction
+  CeedQFunction fdm_qf;
+  ierr = CeedQFunctionCreateInteriorByName(ceed, "FDMApply", &fdm_qf);
+  CeedChk(ierr);
+  CeedInt *ncompdata;
+  ierr = CeedCalloc(1, &ncompdata); CeedChk(ierr);
+  ncompdata[0] = ncomp;
+  CeedQFunctionContext ctx;
+  ierr = CeedQFunctionContextCreate(ceed, &ctx); CeedChk(ierr);
+  ierr = CeedQFunctionContextSetData(ctx, CEED_MEM_HOST, CEED_OWN_POINTER,
+                                     sizeof(*ncompdata), ncompdata);
+  CeedChk(ierr);
+  ierr = CeedQFunctionSetContext(fdm_qf, ctx); CeedChk(ierr);
+  ierr = CeedQFunctionContextDestroy(&ctx); CeedChk(ierr);
+  ierr = CeedQFunctionAddInput(fdm_qf, "u", ncomp, CEED_EVAL_INTERP);
+  CeedChk(ierr);
+  ierr = CeedQFunctionAddInput(fdm_qf, "diag", 1, CEED_EVAL_NONE);
+  CeedChk(ierr);
+  ierr = CeedQFunctionAddInput(fdm_qf, "scale", 1, CEED_EVAL_NONE);
+  CeedChk(ierr);
+  ierr = CeedQFunctionAddOutput(fdm_qf, "v", ncomp, CEED_EVAL_INTERP);
+  CeedChk(ierr);
+  // -- Operator
+  ierr = CeedOperatorCreate(ceed, fdm_qf, CEED_QFUNCTION_NONE,
+                            CEED_QFUNCTION_NONE, fdminv); CeedChk(ierr);
+  ierr = CeedOperatorSetField(*fdminv, "u", rstr_i, fdm_basis,
+                              CEED_VECTOR_ACTIVE); CeedChk(ierr);
+  ierr = CeedOperatorSetField(*fdminv, "diag", rstr_diag,
+                              CEED_BASIS_COLLOCATED, diag); CeedChk(ierr);
+  ierr = CeedOperatorSetField(*fdminv, "scale", rstr_scale,
+                              CEED_BASIS_COLLOCATED, scale); CeedChk(ierr);
+  ierr = CeedOperatorSetField(*fdminv, "v", rstr_i, fdm_basis,
+                              CEED_VECTOR_ACTIVE); CeedChk(ierr);
+  ierr = CeedOperatorSetStreamPassiveFields(*fdminv, true); CeedChk(ierr);
+
+  // Cleanup
+  ierr = CeedVectorDestroy(&diag); CeedChk(ierr);
+  ierr = CeedVectorDestroy(&scale); CeedChk(ierr);
+  ierr = CeedBasisDestroy(&fdm_basis); CeedChk(ierr);
+  ierr = CeedElemRestrictionDestroy(&rstr_i); CeedChk(ierr);
+  ierr = CeedElemRestrictionDestroy(&rstr_diag); CeedChk(ierr);
+  ierr = CeedElemRestrictionDestroy(&rstr_scale); CeedChk(ierr);
+  ierr = CeedQFunctionDestroy(&fdm_qf); CeedChk(ierr);
+
+  return 0;
+}
+
+/// @}
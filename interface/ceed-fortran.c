@@ -143,6 +143,25 @@ void fCeedVectorCreate(int *ceed, int *length, int *vec, int *err) {
   }
 }
 
+#define fCeedVectorCreateView \
+    FORTRAN_NAME(ceedvectorcreateview,CEEDVECTORCREATEVIEW)
+void fCeedVectorCreateView(int *parent, int *offset, int *length, int *vec,
+                           int *err) {
+  if (CeedVector_count == CeedVector_count_max) {
+    CeedVector_count_max += CeedVector_count_max/2 + 1;
+    CeedRealloc(CeedVector_count_max, &CeedVector_dict);
+  }
+
+  CeedVector *vec_ = &CeedVector_dict[CeedVector_count];
+  *err = CeedVectorCreateView(CeedVector_dict[*parent], *offset, *length,
+                              vec_);
+
+  if (*err == 0) {
+    *vec = CeedVector_count++;
+    CeedVector_n++;
+  }
+}
+
 #define fCeedVectorSetArray FORTRAN_NAME(ceedvectorsetarray,CEEDVECTORSETARRAY)
 void fCeedVectorSetArray(int *vec, int *memtype, int *copymode,
                          CeedScalar *array, int64_t *offset, int *err) {
@@ -189,6 +208,16 @@ void fCeedVectorGetArrayRead(int *vec, int *memtype, CeedScalar *array,
   *offset = b - array;
 }
 
+#define fCeedVectorGetArrayWrite \
+    FORTRAN_NAME(ceedvectorgetarraywrite,CEEDVECTORGETARRAYWRITE)
+void fCeedVectorGetArrayWrite(int *vec, int *memtype, CeedScalar *array,
+                              int64_t *offset, int *err) {
+  CeedScalar *b;
+  CeedVector vec_ = CeedVector_dict[*vec];
+  *err = CeedVectorGetArrayWrite(vec_, (CeedMemType)*memtype, &b);
+  *offset = b - array;
+}
+
 #define fCeedVectorRestoreArray \
     FORTRAN_NAME(ceedvectorrestorearray,CEEDVECTORRESTOREARRAY)
 void fCeedVectorRestoreArray(int *vec, CeedScalar *array,
@@ -16,7 +16,9 @@
 
 #include <ceed-impl.h>
 #include <ceed-backend.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #include <math.h>
 
 /// @file
@@ -194,6 +196,18 @@ int CeedOperatorSingleView(CeedOperator op, bool sub, FILE *stream) {
                                  i, sub, 0, stream); CeedChk(ierr);
   }
 
+  if (op->perf) {
+    fprintf(stream, "%s  Performance Counters:\n", pre);
+    for (CeedInt p=0; p<CEED_PERF_NUM_PHASES; p++) {
+      const CeedPerfCounters *c = &op->perf->counters[p];
+      fprintf(stream, "%s    %s: %lld calls, %g s, %lld cycles, "
+              "%lld instructions, %lld LLC misses, %lld FP vector ops\n",
+              pre, CeedPerfPhases[p], (long long)c->calls, c->time,
+              (long long)c->cycles, (long long)c->instructions,
+              (long long)c->llcmisses, (long long)c->fpops);
+    }
+  }
+
   return 0;
 }
 
@@ -308,73 +322,42 @@ static int CeedOperatorMultigridLevel_Core(CeedOperator opFine,
   ierr = CeedVectorDestroy(&multE); CeedChk(ierr);
   ierr = CeedVectorReciprocal(multVec); CeedChk(ierr);
 
-  // Restriction
+  // Transfer operators only interpolate; the multiplicity is applied to the
+  //   fine L-vector, as R^T (R m .* y) = m .* R^T y
   CeedInt ncomp;
   ierr = CeedBasisGetNumComponents(basisCoarse, &ncomp); CeedChk(ierr);
+
+  // Restriction
   CeedQFunction qfRestrict;
-  ierr = CeedQFunctionCreateInteriorByName(ceed, "Scale", &qfRestrict);
-  CeedChk(ierr);
-  CeedInt *ncompRData;
-  ierr = CeedCalloc(1, &ncompRData); CeedChk(ierr);
-  ncompRData[0] = ncomp;
-  CeedQFunctionContext ctxR;
-  ierr = CeedQFunctionContextCreate(ceed, &ctxR); CeedChk(ierr);
-  ierr = CeedQFunctionContextSetData(ctxR, CEED_MEM_HOST, CEED_OWN_POINTER,
-                                     sizeof(*ncompRData), ncompRData);
-  CeedChk(ierr);
-  ierr = CeedQFunctionSetContext(qfRestrict, ctxR); CeedChk(ierr);
-  ierr = CeedQFunctionContextDestroy(&ctxR); CeedChk(ierr);
-  ierr = CeedQFunctionAddInput(qfRestrict, "input", ncomp, CEED_EVAL_NONE);
-  CeedChk(ierr);
-  ierr = CeedQFunctionAddInput(qfRestrict, "scale", ncomp, CEED_EVAL_NONE);
+  ierr = CeedQFunctionCreateIdentity(ceed, ncomp, CEED_EVAL_NONE,
+                                     CEED_EVAL_INTERP, &qfRestrict);
   CeedChk(ierr);
-  ierr = CeedQFunctionAddOutput(qfRestrict, "output", ncomp, CEED_EVAL_INTERP);
-  CeedChk(ierr);
-
   ierr = CeedOperatorCreate(ceed, qfRestrict, CEED_QFUNCTION_NONE,
                             CEED_QFUNCTION_NONE, opRestrict);
   CeedChk(ierr);
   ierr = CeedOperatorSetField(*opRestrict, "input", rstrFine,
                               CEED_BASIS_COLLOCATED, CEED_VECTOR_ACTIVE);
   CeedChk(ierr);
-  ierr = CeedOperatorSetField(*opRestrict, "scale", rstrFine,
-                              CEED_BASIS_COLLOCATED, multVec);
-  CeedChk(ierr);
   ierr = CeedOperatorSetField(*opRestrict, "output", rstrCoarse, basisCtoF,
                               CEED_VECTOR_ACTIVE); CeedChk(ierr);
+  ierr = CeedVectorAddReference(multVec); CeedChk(ierr);
+  (*opRestrict)->inscale = multVec;
 
   // Prolongation
   CeedQFunction qfProlong;
-  ierr = CeedQFunctionCreateInteriorByName(ceed, "Scale", &qfProlong);
-  CeedChk(ierr);
-  CeedInt *ncompPData;
-  ierr = CeedCalloc(1, &ncompPData); CeedChk(ierr);
-  ncompPData[0] = ncomp;
-  CeedQFunctionContext ctxP;
-  ierr = CeedQFunctionContextCreate(ceed, &ctxP); CeedChk(ierr);
-  ierr = CeedQFunctionContextSetData(ctxP, CEED_MEM_HOST, CEED_OWN_POINTER,
-                                     sizeof(*ncompPData), ncompPData);
+  ierr = CeedQFunctionCreateIdentity(ceed, ncomp, CEED_EVAL_INTERP,
+                                     CEED_EVAL_NONE, &qfProlong);
   CeedChk(ierr);
-  ierr = CeedQFunctionSetContext(qfProlong, ctxP); CeedChk(ierr);
-  ierr = CeedQFunctionContextDestroy(&ctxP); CeedChk(ierr);
-  ierr = CeedQFunctionAddInput(qfProlong, "input", ncomp, CEED_EVAL_INTERP);
-  CeedChk(ierr);
-  ierr = CeedQFunctionAddInput(qfProlong, "scale", ncomp, CEED_EVAL_NONE);
-  CeedChk(ierr);
-  ierr = CeedQFunctionAddOutput(qfProlong, "output", ncomp, CEED_EVAL_NONE);
-  CeedChk(ierr);
-
   ierr = CeedOperatorCreate(ceed, qfProlong, CEED_QFUNCTION_NONE,
                             CEED_QFUNCTION_NONE, opProlong);
   CeedChk(ierr);
   ierr = CeedOperatorSetField(*opProlong, "input", rstrCoarse, basisCtoF,
                               CEED_VECTOR_ACTIVE); CeedChk(ierr);
-  ierr = CeedOperatorSetField(*opProlong, "scale", rstrFine,
-                              CEED_BASIS_COLLOCATED, multVec);
-  CeedChk(ierr);
   ierr = CeedOperatorSetField(*opProlong, "output", rstrFine,
                               CEED_BASIS_COLLOCATED, CEED_VECTOR_ACTIVE);
   CeedChk(ierr);
+  ierr = CeedVectorAddReference(multVec); CeedChk(ierr);
+  (*opProlong)->outscale = multVec;
 
   // Cleanup
   ierr = CeedVectorDestroy(&multVec); CeedChk(ierr);
@@ -385,6 +368,233 @@ static int CeedOperatorMultigridLevel_Core(CeedOperator opFine,
   return 0;
 }
 
+/**
+  @brief Scale an L-vector pointwise, y = s .* x or y += s .* x
+
+  @param scale   CeedVector of scaling factors
+  @param x       CeedVector to scale, may be the same as @a y
+  @param[out] y  CeedVector to store or sum in the result
+  @param add     Boolean flag to sum into @a y
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+static int CeedOperatorScaleVector(CeedVector scale, CeedVector x,
+                                   CeedVector y, bool add) {
+  int ierr;
+  const CeedScalar *s, *xx;
+  CeedScalar *yy;
+  ierr = CeedVectorGetArrayRead(scale, CEED_MEM_HOST, &s); CeedChk(ierr);
+  ierr = CeedVectorGetArray(y, CEED_MEM_HOST, &yy); CeedChk(ierr);
+  if (x == y) {
+    xx = yy;
+  } else {
+    ierr = CeedVectorGetArrayRead(x, CEED_MEM_HOST, &xx); CeedChk(ierr);
+  }
+  if (add) {
+    for (CeedInt i=0; i<y->length; i++)
+      yy[i] += s[i] * xx[i];
+  } else {
+    for (CeedInt i=0; i<y->length; i++)
+      yy[i] = s[i] * xx[i];
+  }
+  if (x != y) {
+    ierr = CeedVectorRestoreArrayRead(x, &xx); CeedChk(ierr);
+  }
+  ierr = CeedVectorRestoreArray(y, &yy); CeedChk(ierr);
+  ierr = CeedVectorRestoreArrayRead(scale, &s); CeedChk(ierr);
+  return 0;
+}
+
+/**
+  @brief Apply a CeedOperator with an L-vector scaling of its active input or
+           output, as used by multigrid transfer operators
+
+  Only one of the active input and output may be scaled, and the operator may
+    have no passive outputs.
+
+  @param op        CeedOperator to apply
+  @param[in] in    CeedVector containing input state
+  @param[out] out  CeedVector to store or sum in result
+  @param add       Boolean flag to sum into @a out
+  @param request   Address of CeedRequest for non-blocking completion, else
+                     @ref CEED_REQUEST_IMMEDIATE
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+static int CeedOperatorApplyScaled(CeedOperator op, CeedVector in,
+                                   CeedVector out, bool add,
+                                   CeedRequest *request) {
+  int ierr;
+  CeedVector scale = op->inscale ? op->inscale : op->outscale;
+  if (!op->scalework) {
+    ierr = CeedVectorCreate(op->ceed, scale->length, &op->scalework);
+    CeedChk(ierr);
+  }
+
+  if (op->inscale) {
+    // Scale input, then apply
+    ierr = CeedOperatorScaleVector(op->inscale, in, op->scalework, false);
+    CeedChk(ierr);
+    if (!add) {
+      ierr = CeedVectorSetValue(out, 0.0); CeedChk(ierr);
+    }
+    ierr = op->ApplyAdd(op, op->scalework, out, request); CeedChk(ierr);
+  } else if (add) {
+    // Apply to work vector, then sum scaled result
+    ierr = CeedVectorSetValue(op->scalework, 0.0); CeedChk(ierr);
+    ierr = op->ApplyAdd(op, in, op->scalework, request); CeedChk(ierr);
+    ierr = CeedOperatorScaleVector(op->outscale, op->scalework, out, true);
+    CeedChk(ierr);
+  } else {
+    // Apply, then scale result in place
+    ierr = CeedVectorSetValue(out, 0.0); CeedChk(ierr);
+    ierr = op->ApplyAdd(op, in, out, request); CeedChk(ierr);
+    ierr = CeedOperatorScaleVector(op->outscale, out, out, false);
+    CeedChk(ierr);
+  }
+  return 0;
+}
+
+/**
+  @brief Apply a CeedOperator acting on E-vectors to L-vectors, restricting
+           its active input and output and any auxiliary passive input
+
+  @param op        CeedOperator to apply
+  @param[in] in    CeedVector containing input state
+  @param[out] out  CeedVector to store or sum in result
+  @param add       Boolean flag to sum into @a out
+  @param request   Address of CeedRequest for non-blocking completion, else
+                     @ref CEED_REQUEST_IMMEDIATE
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+static int CeedOperatorApplyRestricted(CeedOperator op, CeedVector in,
+                                       CeedVector out, bool add,
+                                       CeedRequest *request) {
+  int ierr;
+
+  // Restrict auxiliary passive input
+  if (op->auxrstr) {
+    ierr = CeedElemRestrictionApply(op->auxrstr, CEED_NOTRANSPOSE, op->auxvec,
+                                    op->auxework, request); CeedChk(ierr);
+  }
+
+  // Restrict active input
+  if (op->inrstr) {
+    if (!op->inework) {
+      ierr = CeedElemRestrictionCreateVector(op->inrstr, NULL, &op->inework);
+      CeedChk(ierr);
+    }
+    ierr = CeedElemRestrictionApply(op->inrstr, CEED_NOTRANSPOSE, in,
+                                    op->inework, request); CeedChk(ierr);
+    in = op->inework;
+  }
+
+  // Apply, summing the output E-vector into the output L-vector
+  if (!add) {
+    ierr = CeedVectorSetValue(out, 0.0); CeedChk(ierr);
+  }
+  if (op->outrstr) {
+    if (!op->outework) {
+      ierr = CeedElemRestrictionCreateVector(op->outrstr, NULL, &op->outework);
+      CeedChk(ierr);
+    }
+    ierr = CeedVectorSetValue(op->outework, 0.0); CeedChk(ierr);
+    ierr = op->ApplyAdd(op, in, op->outework, request); CeedChk(ierr);
+    ierr = CeedElemRestrictionApply(op->outrstr, CEED_TRANSPOSE, op->outework,
+                                    out, request); CeedChk(ierr);
+  } else {
+    ierr = op->ApplyAdd(op, in, out, request); CeedChk(ierr);
+  }
+  return 0;
+}
+
+/**
+  @brief Check if a CeedOperator accumulates the energy inner product of its
+           active input and output while it is applied
+
+  This requires a backend implementation and, for each (sub)operator, active
+    input and output fields that all use the same CeedElemRestriction, without
+    ghost nodes, so that the inner product of the L-vectors equals the sum over
+    elements of the inner products of the E-vectors.
+
+  @param op            CeedOperator
+  @param[out] hasdot   Variable to store the result
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+static int CeedOperatorHasApplyAddDot(CeedOperator op, bool *hasdot) {
+  int ierr;
+
+  *hasdot = false;
+  if (op->composite) {
+    if (op->ApplyAddComposite)
+      return 0;
+    for (CeedInt i=0; i<op->numsub; i++) {
+      ierr = CeedOperatorHasApplyAddDot(op->suboperators[i], hasdot);
+      CeedChk(ierr);
+      if (!*hasdot)
+        return 0;
+    }
+    *hasdot = op->numsub > 0;
+    return 0;
+  }
+  if (!op->ApplyAddDot || !op->numelements || op->qf->identity ||
+      op->inscale || op->outscale || op->inrstr || op->outrstr)
+    return 0;
+
+  CeedElemRestriction rstr = NULL;
+  bool hasin = false, hasout = false;
+  for (CeedInt i=0; i<op->qf->numinputfields + op->qf->numoutputfields; i++) {
+    bool isin = i < op->qf->numinputfields;
+    CeedOperatorField field = isin ? op->inputfields[i] :
+                              op->outputfields[i-op->qf->numinputfields];
+    if (field->vec != CEED_VECTOR_ACTIVE)
+      continue;
+    if (rstr && field->Erestrict != rstr)
+      return 0;
+    rstr = field->Erestrict;
+    hasin = hasin || isin;
+    hasout = hasout || !isin;
+  }
+  *hasdot = hasin && hasout && !rstr->gsize;
+  return 0;
+}
+
+/**
+  @brief Compute the inner product of two L-vectors
+
+  @param x         First CeedVector
+  @param y         Second CeedVector, of the same length
+  @param[out] dot  Variable to store the inner product
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+static int CeedOperatorVectorDot(CeedVector x, CeedVector y,
+                                 CeedScalar *dot) {
+  int ierr;
+  const CeedScalar *xx, *yy;
+  ierr = CeedVectorGetArrayRead(x, CEED_MEM_HOST, &xx); CeedChk(ierr);
+  ierr = CeedVectorGetArrayRead(y, CEED_MEM_HOST, &yy); CeedChk(ierr);
+  CeedScalar sum = 0;
+  for (CeedInt i=0; i<x->length; i++)
+    sum += xx[i] * yy[i];
+  *dot = sum;
+  ierr = CeedVectorRestoreArrayRead(x, &xx); CeedChk(ierr);
+  ierr = CeedVectorRestoreArrayRead(y, &yy); CeedChk(ierr);
+  return 0;
+}
+
 /// @}
 
 /// ----------------------------------------------------------------------------
@@ -488,6 +698,59 @@ int CeedOperatorIsSetupDone(CeedOperator op, bool *issetupdone) {
   return 0;
 }
 
+/**
+  @brief Get whether a CeedOperator should compress element-wise constant
+           passive input fields
+
+  @param op             CeedOperator
+  @param[out] compress  Variable to store compression flag
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+
+int CeedOperatorGetCompressPassiveFields(CeedOperator op, bool *compress) {
+  *compress = op->compresspassive;
+  return 0;
+}
+
+/**
+  @brief Get whether a CeedOperator should stream passive input fields block
+           by block rather than restricting them to full E-vectors
+
+  @param op           CeedOperator
+  @param[out] stream  Variable to store streaming flag
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+
+int CeedOperatorGetStreamPassiveFields(CeedOperator op, bool *stream) {
+  *stream = op->streampassive;
+  return 0;
+}
+
+/**
+  @brief Get the performance counters of a CeedOperator for backends to
+           measure phases of application with CeedPerfStart() and
+           CeedPerfStop()
+
+  @param op         CeedOperator
+  @param[out] perf  Variable to store CeedPerf, or NULL if performance
+                      counters are disabled
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+
+int CeedOperatorGetPerf(CeedOperator op, CeedPerf *perf) {
+  *perf = op->perf && op->perf->enabled ? op->perf : NULL;
+  return 0;
+}
+
 /**
   @brief Get the QFunction associated with a CeedOperator
 
@@ -736,7 +999,7 @@ int CeedOperatorCreate(Ceed ceed, CeedQFunction qf, CeedQFunction dqf,
   // LCOV_EXCL_STOP
   ierr = CeedCalloc(1, op); CeedChk(ierr);
   (*op)->ceed = ceed;
-  ceed->refcount++;
+  CeedAtomicIncrement(ceed->refcount);
   (*op)->refcount = 1;
   (*op)->qf = qf;
   qf->refcount++;
@@ -750,6 +1013,9 @@ int CeedOperatorCreate(Ceed ceed, CeedQFunction qf, CeedQFunction dqf,
   }
   ierr = CeedCalloc(16, &(*op)->inputfields); CeedChk(ierr);
   ierr = CeedCalloc(16, &(*op)->outputfields); CeedChk(ierr);
+  if (getenv("CEED_PERF_COUNTERS")) {
+    ierr = CeedPerfCreate(&(*op)->perf); CeedChk(ierr);
+  }
   ierr = ceed->OperatorCreate(*op); CeedChk(ierr);
   return 0;
 }
@@ -780,8 +1046,9 @@ int CeedCompositeOperatorCreate(Ceed ceed, CeedOperator *op) {
 
   ierr = CeedCalloc(1, op); CeedChk(ierr);
   (*op)->ceed = ceed;
-  ceed->refcount++;
+  CeedAtomicIncrement(ceed->refcount);
   (*op)->composite = true;
+  (*op)->numthreads = 1;
   ierr = CeedCalloc(16, &(*op)->suboperators); CeedChk(ierr);
 
   if (ceed->CompositeOperatorCreate) {
@@ -909,6 +1176,231 @@ found:
   return 0;
 }
 
+/**
+  @brief Provide a passive input field of a CeedOperator with the same value at
+           all quadrature points of all elements
+
+  The field is held as a CeedVector with one value per component and a strided
+    CeedElemRestriction with zero node and element strides, so no E-vector
+    over all elements is needed. The CPU backends broadcast the values into the
+    Q-vector of the field once per application.
+
+  @param op         CeedOperator on which to provide the field
+  @param fieldname  Name of the CeedQFunction input field, which must have eval
+                      mode @ref CEED_EVAL_NONE
+  @param values     Value of each component of the field, copied
+
+  @note A field with a CeedElemRestriction and a CeedBasis must be set first,
+          giving the number of elements and quadrature points.
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedOperatorSetFieldConstant(CeedOperator op, const char *fieldname,
+                                 const CeedScalar *values) {
+  int ierr;
+  if (op->composite)
+    // LCOV_EXCL_START
+    return CeedError(op->ceed, 1, "Cannot add field to composite operator.");
+  // LCOV_EXCL_STOP
+  if (!op->hasrestriction || !op->numqpoints)
+    // LCOV_EXCL_START
+    return CeedError(op->ceed, 1, "Constant field \"%s\" requires a prior "
+                     "field with an ElemRestriction and a Basis", fieldname);
+  // LCOV_EXCL_STOP
+
+  CeedQFunctionField qfield = NULL;
+  for (CeedInt i=0; i<op->qf->numinputfields; i++)
+    if (!strcmp(fieldname, op->qf->inputfields[i]->fieldname))
+      qfield = op->qf->inputfields[i];
+  if (!qfield)
+    // LCOV_EXCL_START
+    return CeedError(op->ceed, 1, "QFunction has no input field '%s'",
+                     fieldname);
+  // LCOV_EXCL_STOP
+  if (qfield->emode != CEED_EVAL_NONE)
+    // LCOV_EXCL_START
+    return CeedError(op->ceed, 1, "Constant field \"%s\" must have eval mode "
+                     "CEED_EVAL_NONE", fieldname);
+  // LCOV_EXCL_STOP
+
+  // Values broadcast by zero node and element strides
+  const CeedInt ncomp = qfield->size, strides[3] = {0, 1, 0};
+  CeedVector v;
+  CeedElemRestriction r;
+  ierr = CeedVectorCreate(op->ceed, ncomp, &v); CeedChk(ierr);
+  ierr = CeedVectorSetArray(v, CEED_MEM_HOST, CEED_COPY_VALUES,
+                            (CeedScalar *)values); CeedChk(ierr);
+  ierr = CeedElemRestrictionCreateStrided(op->ceed, op->numelements,
+                                          op->numqpoints, ncomp, ncomp, strides,
+                                          &r); CeedChk(ierr);
+  ierr = CeedOperatorSetField(op, fieldname, r, CEED_BASIS_COLLOCATED, v);
+  CeedChk(ierr);
+  ierr = CeedVectorDestroy(&v); CeedChk(ierr);
+  ierr = CeedElemRestrictionDestroy(&r); CeedChk(ierr);
+  return 0;
+}
+
+/**
+  @brief Allow a CeedOperator to compress passive input fields that are
+           constant, or a constant times the quadrature weights, on each
+           element
+
+  Such fields, like the quadrature data of affine elements, are stored once
+    per element by backends that support compression and expanded to all
+    quadrature points as each element block is applied, reducing storage and
+    memory traffic by up to a factor of the number of quadrature points.
+    Values are compared up to a small relative tolerance. Backends without
+    support ignore this option.
+
+  @param op        CeedOperator
+  @param compress  Boolean flag to enable compression
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedOperatorSetCompressPassiveFields(CeedOperator op, bool compress) {
+  int ierr;
+  if (op->composite) {
+    for (CeedInt i=0; i<op->numsub; i++) {
+      ierr = CeedOperatorSetCompressPassiveFields(op->suboperators[i], compress);
+      CeedChk(ierr);
+    }
+    return 0;
+  }
+  if (op->setupdone)
+    // LCOV_EXCL_START
+    return CeedError(op->ceed, 1, "Cannot change compression after the "
+                     "CeedOperator has been applied");
+  // LCOV_EXCL_STOP
+
+  op->compresspassive = compress;
+  return 0;
+}
+
+/**
+  @brief Stream passive input fields of a CeedOperator in element block order
+
+  Backends that support streaming restrict passive inputs one element block
+    at a time, as for active inputs, rather than storing a full E-vector for
+    each passive input. Only the L-vectors are then stored, so large passive
+    inputs, such as stored quadrature data, may be placed by the user in a
+    memory-mapped file, e.g. with CeedVectorSetArray() and CEED_USE_POINTER,
+    and are read in element block order. The library provides no out-of-core
+    store itself; backends only hint the operating system to prefetch the
+    following blocks of the user array while the current block is applied. Streamed inputs
+    are restricted on every application. Passive inputs selected for
+    compression with CeedOperatorSetCompressPassiveFields() are not streamed.
+    Backends without support ignore this option.
+
+  @param op      CeedOperator
+  @param stream  Boolean flag to enable streaming
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedOperatorSetStreamPassiveFields(CeedOperator op, bool stream) {
+  int ierr;
+  if (op->composite) {
+    for (CeedInt i=0; i<op->numsub; i++) {
+      ierr = CeedOperatorSetStreamPassiveFields(op->suboperators[i], stream);
+      CeedChk(ierr);
+    }
+    return 0;
+  }
+  if (op->setupdone)
+    // LCOV_EXCL_START
+    return CeedError(op->ceed, 1, "Cannot change streaming after the "
+                     "CeedOperator has been applied");
+  // LCOV_EXCL_STOP
+
+  op->streampassive = stream;
+  return 0;
+}
+
+/**
+  @brief Enable or disable performance counters for the restriction, basis,
+           and QFunction phases of CeedOperator application
+
+  Counters are disabled by default, unless the environment variable
+    CEED_PERF_COUNTERS is set. On Linux, CPU cycles, instructions, and last
+    level cache misses are counted with perf_event_open(2), and floating point
+    vector operations with the raw event given by CEED_PERF_FP_EVENT, if set.
+    Wall clock time is always measured. Counts accumulate while enabled.
+    Only backends that instrument their operators report counts.
+
+  @param op      CeedOperator
+  @param enable  Boolean flag to enable performance counters
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedOperatorSetPerfCounters(CeedOperator op, bool enable) {
+  int ierr;
+
+  if (op->composite) {
+    for (CeedInt i=0; i<op->numsub; i++) {
+      ierr = CeedOperatorSetPerfCounters(op->suboperators[i], enable);
+      CeedChk(ierr);
+    }
+    return 0;
+  }
+  if (enable && !op->perf) {
+    ierr = CeedPerfCreate(&op->perf); CeedChk(ierr);
+  }
+  if (op->perf)
+    op->perf->enabled = enable;
+  return 0;
+}
+
+/**
+  @brief Get performance counters accumulated over a phase of CeedOperator
+           application
+
+  Counts of composite CeedOperators are summed over the sub-operators.
+
+  @param op             CeedOperator
+  @param phase          Phase of application
+  @param[out] counters  Variable to store counters; all counts are zero if
+                          performance counters were never enabled
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedOperatorGetPerfCounters(CeedOperator op, CeedPerfPhase phase,
+                                CeedPerfCounters *counters) {
+  int ierr;
+  memset(counters, 0, sizeof(*counters));
+
+  if (op->composite) {
+    for (CeedInt i=0; i<op->numsub; i++) {
+      CeedPerfCounters sub;
+      ierr = CeedOperatorGetPerfCounters(op->suboperators[i], phase, &sub);
+      CeedChk(ierr);
+      counters->calls += sub.calls;
+      counters->time += sub.time;
+      counters->cycles = sub.cycles < 0 || counters->cycles < 0 ? -1 :
+                         counters->cycles + sub.cycles;
+      counters->instructions = sub.instructions < 0 ||
+                               counters->instructions < 0 ? -1 :
+                               counters->instructions + sub.instructions;
+      counters->llcmisses = sub.llcmisses < 0 || counters->llcmisses < 0 ? -1 :
+                            counters->llcmisses + sub.llcmisses;
+      counters->fpops = sub.fpops < 0 || counters->fpops < 0 ? -1 :
+                        counters->fpops + sub.fpops;
+    }
+    return 0;
+  }
+  if (op->perf)
+    *counters = op->perf->counters[phase];
+  return 0;
+}
+
 /**
   @brief Add a sub-operator to a composite CeedOperator
 
@@ -937,6 +1429,51 @@ int CeedCompositeOperatorAddSub(CeedOperator compositeop, CeedOperator subop) {
   return 0;
 }
 
+/**
+  @brief Set the number of threads applying the suboperators of a composite
+           CeedOperator concurrently
+
+  With more than one thread, the suboperators are distributed over a pool of
+    threads on each application. The calling thread sums into the output
+    vector while each spawned thread sums into a private output vector, and
+    the private outputs are added to the output after all suboperators have
+    been applied. This lets independent suboperators, e.g. volume and boundary
+    terms, overlap rather than run one after another. Suboperators may share
+    CeedQFunctions, CeedBases and CeedElemRestrictions. Suboperators are
+    applied one after another, as by default, if any suboperator has a passive
+    output field, is itself composite, or is added more than once, or if two
+    suboperators share a CeedQFunctionContext.
+
+  @param op          Composite CeedOperator
+  @param numthreads  Number of threads to use, 1 for serial application, or a
+                       value less than 1 for the number of online processors
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+ */
+int CeedCompositeOperatorSetNumThreads(CeedOperator op, CeedInt numthreads) {
+  int ierr;
+
+  if (!op->composite)
+    // LCOV_EXCL_START
+    return CeedError(op->ceed, 1, "CeedOperator is not a composite operator");
+  // LCOV_EXCL_STOP
+
+  if (numthreads < 1)
+    numthreads = sysconf(_SC_NPROCESSORS_ONLN);
+  if (numthreads < 1)
+    numthreads = 1;
+  if (op->threadouts) {
+    for (CeedInt i=0; i<op->numthreads-1; i++) {
+      ierr = CeedVectorDestroy(&op->threadouts[i]); CeedChk(ierr);
+    }
+    ierr = CeedFree(&op->threadouts); CeedChk(ierr);
+  }
+  op->numthreads = numthreads;
+  return 0;
+}
+
 /**
   @brief Assemble a linear CeedQFunction associated with a CeedOperator
 
@@ -1182,6 +1719,10 @@ int CeedOperatorLinearAssembleAddPointBlockDiagonal(CeedOperator op,
            for a CeedOperator, creating the prolongation basis from the
            fine and coarse grid interpolation
 
+  The transfer operators interpolate with the coarse to fine basis on the
+    backend of @a opFine and apply the inverse multiplicity to the fine
+    L-vector, so no fine grid E-vector of multiplicity data is stored.
+
   @param[in] opFine       Fine grid operator
   @param[in] PMultFine    L-vector multiplicity in parallel gather/scatter
   @param[in] rstrCoarse   Coarse grid restriction
@@ -1415,6 +1956,143 @@ int CeedOperatorMultigridLevelCreateH1(CeedOperator opFine,
   return 0;
 }
 
+/**
+  @brief Create a multigrid coarse operator for a CeedOperator on the
+           quadrature rule of the coarse basis, rediscretizing rather than
+           reusing the fine grid quadrature data
+
+  The coarse operator uses the CeedQFunction of @a opFine. The passive input
+    @a fieldname is replaced by the output of @a opSetupCoarse, which must be
+    set up on the quadrature rule of @a basisCoarse and is applied once to
+    @a setupInput. Quadrature weight inputs use @a basisCoarse. All other
+    passive inputs are kept and must already have as many quadrature points
+    as @a basisCoarse. A coarse basis with fewer quadrature points than the
+    fine basis makes coarse level applications cheaper in proportion to the
+    quadrature reduction.
+
+  The level transfer operators do not depend on the quadrature rule and are
+    created with @ref CeedOperatorMultigridLevelCreate() or its variants.
+
+  @param[in] opFine         Fine grid operator
+  @param[in] rstrCoarse     Coarse grid restriction
+  @param[in] basisCoarse    Coarse grid active vector basis with the coarse
+                              quadrature rule
+  @param[in] fieldname      Name of the passive input field of @a opFine to
+                              rediscretize
+  @param[in] opSetupCoarse  Operator with a single active output computing
+                              @a fieldname on the coarse quadrature rule
+  @param[in] setupInput     Active input of @a opSetupCoarse, or
+                              @ref CEED_VECTOR_NONE
+  @param[out] opCoarse      Coarse grid operator
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedOperatorMultigridLevelCreateRediscretized(CeedOperator opFine,
+    CeedElemRestriction rstrCoarse, CeedBasis basisCoarse,
+    const char *fieldname, CeedOperator opSetupCoarse, CeedVector setupInput,
+    CeedOperator *opCoarse) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(opFine, &ceed); CeedChk(ierr);
+  ierr = CeedOperatorCheckReady(ceed, opFine); CeedChk(ierr);
+  ierr = CeedOperatorCheckReady(ceed, opSetupCoarse); CeedChk(ierr);
+
+  // Check for composite operator
+  if (opFine->composite || opSetupCoarse->composite)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1,
+                     "Automatic multigrid setup for composite operators not supported");
+  // LCOV_EXCL_STOP
+
+  // Setup output on the coarse quadrature rule
+  CeedElemRestriction rstrQData = NULL;
+  for (CeedInt i=0; i<opSetupCoarse->qf->numoutputfields; i++)
+    if (opSetupCoarse->outputfields[i]->vec == CEED_VECTOR_ACTIVE)
+      rstrQData = opSetupCoarse->outputfields[i]->Erestrict;
+  if (!rstrQData)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "Setup operator must have an active output");
+  // LCOV_EXCL_STOP
+  CeedInt Qc, QData;
+  ierr = CeedBasisGetNumQuadraturePoints(basisCoarse, &Qc); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetElementSize(rstrQData, &QData); CeedChk(ierr);
+  if (QData != Qc)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "Setup operator output must use the quadrature "
+                     "rule of the coarse basis");
+  // LCOV_EXCL_STOP
+  CeedVector qdata;
+  ierr = CeedElemRestrictionCreateVector(rstrQData, &qdata, NULL);
+  CeedChk(ierr);
+  ierr = CeedOperatorApply(opSetupCoarse, setupInput, qdata,
+                           CEED_REQUEST_IMMEDIATE); CeedChk(ierr);
+
+  // Coarse grid
+  ierr = CeedOperatorCreate(ceed, opFine->qf, opFine->dqf, opFine->dqfT,
+                            opCoarse); CeedChk(ierr);
+  bool found = false;
+  // -- Input fields
+  for (CeedInt i=0; i<opFine->qf->numinputfields; i++) {
+    CeedOperatorField field = opFine->inputfields[i];
+    CeedEvalMode emode = opFine->qf->inputfields[i]->emode;
+    if (field->vec == CEED_VECTOR_ACTIVE) {
+      ierr = CeedOperatorSetField(*opCoarse, field->fieldname, rstrCoarse,
+                                  basisCoarse, CEED_VECTOR_ACTIVE);
+      CeedChk(ierr);
+    } else if (!strcmp(field->fieldname, fieldname)) {
+      ierr = CeedOperatorSetField(*opCoarse, field->fieldname, rstrQData,
+                                  CEED_BASIS_COLLOCATED, qdata); CeedChk(ierr);
+      found = true;
+    } else if (emode == CEED_EVAL_WEIGHT) {
+      ierr = CeedOperatorSetField(*opCoarse, field->fieldname,
+                                  CEED_ELEMRESTRICTION_NONE, basisCoarse,
+                                  CEED_VECTOR_NONE); CeedChk(ierr);
+    } else {
+      CeedInt Q = Qc;
+      if (field->basis == CEED_BASIS_COLLOCATED) {
+        ierr = CeedElemRestrictionGetElementSize(field->Erestrict, &Q);
+        CeedChk(ierr);
+      } else {
+        ierr = CeedBasisGetNumQuadraturePoints(field->basis, &Q); CeedChk(ierr);
+      }
+      if (Q != Qc)
+        // LCOV_EXCL_START
+        return CeedError(ceed, 1, "Passive input field '%s' does not use the "
+                         "coarse quadrature rule", field->fieldname);
+      // LCOV_EXCL_STOP
+      ierr = CeedOperatorSetField(*opCoarse, field->fieldname,
+                                  field->Erestrict, field->basis, field->vec);
+      CeedChk(ierr);
+    }
+  }
+  ierr = CeedVectorDestroy(&qdata); CeedChk(ierr);
+  if (!found)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "Passive input field '%s' not found", fieldname);
+  // LCOV_EXCL_STOP
+  // -- Output fields
+  for (CeedInt i=0; i<opFine->qf->numoutputfields; i++) {
+    CeedOperatorField field = opFine->outputfields[i];
+    if (field->vec == CEED_VECTOR_ACTIVE) {
+      ierr = CeedOperatorSetField(*opCoarse, field->fieldname, rstrCoarse,
+                                  basisCoarse, CEED_VECTOR_ACTIVE);
+      CeedChk(ierr);
+    } else {
+      ierr = CeedOperatorSetField(*opCoarse, field->fieldname,
+                                  field->Erestrict, field->basis, field->vec);
+      CeedChk(ierr);
+    }
+  }
+  ierr = CeedOperatorSetCompressPassiveFields(*opCoarse,
+         opFine->compresspassive); CeedChk(ierr);
+  ierr = CeedOperatorSetStreamPassiveFields(*opCoarse, opFine->streampassive);
+  CeedChk(ierr);
+
+  return 0;
+}
+
 /**
   @brief Build a FDM based approximate inverse for each element for a
            CeedOperator
@@ -1428,6 +2106,13 @@ int CeedOperatorMultigridLevelCreateH1(CeedOperator opFine,
       V^T S^hat V. The CeedOperator must be linear and non-composite. The
     associated CeedQFunction must therefore also be linear.
 
+  Unless the backend provides its own implementation, the inverse is built on
+    the Ceed of the CeedOperator, applying V with the tensor contraction of
+    that backend. S^hat is stored as a diagonal shared by all elements and a
+    scaling for each element rather than as a quadrature data E-vector. The
+    active input and output use the E-vector layout with strides
+    [1, elemsize, elemsize*ncomp].
+
   @param op             CeedOperator to create element inverses
   @param[out] fdminv    CeedOperator to apply the action of a FDM based inverse
                           for each element
@@ -1448,18 +2133,72 @@ int CeedOperatorCreateFDMElementInverse(CeedOperator op, CeedOperator *fdminv,
   if (op->CreateFDMElementInverse) {
     ierr = op->CreateFDMElementInverse(op, fdminv, request); CeedChk(ierr);
   } else {
-    // Fallback to reference Ceed
-    if (!op->opfallback) {
-      ierr = CeedOperatorCreateFallback(op); CeedChk(ierr);
-    }
-    // Assemble
-    ierr = op->opfallback->CreateFDMElementInverse(op->opfallback, fdminv,
-           request); CeedChk(ierr);
+    // Build on the Ceed of the operator
+    ierr = CeedOperatorCreateFDMElementInverse_Core(op, fdminv, request);
+    CeedChk(ierr);
   }
 
   return 0;
 }
 
+/**
+  @brief Statically condense the element-interior nodes of a CeedOperator
+
+  For high order tensor product bases, most nodes are interior to a single
+    element. This eliminates them element by element, building the Schur
+    complement
+      S_e = A_bb - A_bi A_ii^-1 A_ib
+    on the skeleton nodes, those on element boundaries. The element matrices
+    A_e are assembled from the assembled CeedQFunction and full basis
+    matrices, and the condensed matrices are stored densely for each element.
+    The CeedOperator must be linear and non-composite, with its active inputs
+    and outputs sharing one tensor product basis and one restriction with
+    offsets whose E-vector layout is [1, elemsize, elemsize*ncomp].
+
+  To solve A u = b, apply @a opRHS to b to obtain the condensed right hand
+    side g, solve S u_s = g on the skeleton, and apply @a opBackSolve to u_s
+    to recover u, with the interior nodes solved element by element from
+    @a rhs. The skeleton L-vector has component stride equal to its number
+    of nodes.
+
+  @param op                  CeedOperator to condense
+  @param rhs                 L-vector of the right hand side read by
+                               @a opBackSolve on each application, or
+                               @ref CEED_VECTOR_NONE for a zero right hand
+                               side on the interior nodes
+  @param[out] rstrSkeleton   CeedElemRestriction onto the skeleton nodes
+  @param[out] opSchur        CeedOperator applying the condensed operator S
+                               to skeleton L-vectors
+  @param[out] opRHS          CeedOperator mapping a right hand side L-vector
+                               to the condensed right hand side
+  @param[out] opBackSolve    CeedOperator mapping a skeleton solution to the
+                               full solution L-vector
+  @param request             Address of CeedRequest for non-blocking
+                               completion, else @ref CEED_REQUEST_IMMEDIATE
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedOperatorCreateStaticCondensation(CeedOperator op, CeedVector rhs,
+    CeedElemRestriction *rstrSkeleton, CeedOperator *opSchur,
+    CeedOperator *opRHS, CeedOperator *opBackSolve, CeedRequest *request) {
+  int ierr;
+  Ceed ceed = op->ceed;
+  ierr = CeedOperatorCheckReady(ceed, op); CeedChk(ierr);
+
+  if (op->composite)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "Static condensation not supported for "
+                     "composite operators");
+  // LCOV_EXCL_STOP
+
+  ierr = CeedOperatorStaticCondensation_Core(op, rhs, rstrSkeleton, opSchur,
+         opRHS, opBackSolve, request); CeedChk(ierr);
+
+  return 0;
+}
+
 /**
   @brief View a CeedOperator
 
@@ -1489,6 +2228,76 @@ int CeedOperatorView(CeedOperator op, FILE *stream) {
   return 0;
 }
 
+/**
+  @brief Set up the backend data of several CeedOperators concurrently
+
+  Backends otherwise set up an operator lazily on its first application. This
+    performs the setup of all operators in @a ops eagerly, distributing it over
+    @a numthreads threads. Composite operators contribute their suboperators and
+    operators listed more than once are set up once. Operators may share
+    CeedElemRestrictions, CeedBases, and passive CeedVectors. Operators whose
+    backend has no separate setup stage are set up on first application as
+    before.
+
+  The /cpu/self/ref, /cpu/self/opt, /cpu/self/avx, and /cpu/self/xsmm backends
+    also restrict passive inputs into their shared E-vectors during setup, so
+    passive vectors should hold their values before this is called; changed
+    values are restricted again on the next application. Passive inputs that
+    are compressed, streamed, constant, or hold a batch of L-vectors are
+    still handled on application.
+
+  @param numops      Number of operators
+  @param ops         Array of CeedOperators to set up
+  @param numthreads  Number of threads to use, or a value less than 1 for the
+                       number of online processors
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedOperatorSetupAll(CeedInt numops, CeedOperator *ops,
+                         CeedInt numthreads) {
+  int ierr, ierrsetup;
+  CeedInt count = 0, maxcount = 0;
+  CeedOperator *list;
+
+  if (numops < 1) return 0;
+  for (CeedInt i=0; i<numops; i++)
+    maxcount += ops[i]->composite ? ops[i]->numsub : 1;
+  ierr = CeedCalloc(maxcount, &list); CeedChk(ierr);
+
+  // Collect distinct operators with a pending backend setup
+  for (CeedInt i=0; i<numops; i++) {
+    CeedInt numsub = ops[i]->composite ? ops[i]->numsub : 1;
+    CeedOperator *subs = ops[i]->composite ? ops[i]->suboperators : &ops[i];
+
+    ierr = CeedOperatorCheckReady(ops[i]->ceed, ops[i]); CeedChk(ierr);
+    for (CeedInt j=0; j<numsub; j++) {
+      CeedOperator op = subs[j];
+      bool listed = op->setupdone || !op->Setup;
+
+      for (CeedInt k=0; k<count && !listed; k++)
+        listed = list[k] == op;
+      if (!listed) {
+        ierr = CeedOperatorCheckReady(op->ceed, op); CeedChk(ierr);
+        list[count++] = op;
+      }
+    }
+  }
+
+  // Backends restrict passive inputs during setup, read them here first
+  for (CeedInt i=0; i<count; i++) {
+    ierr = CeedOperatorTouchInputs(list[i]); CeedChk(ierr);
+  }
+
+  // Set up, the list is released also if a setup failed
+  ierrsetup = CeedOperatorSetupConcurrent(count, list, numthreads);
+  ierr = CeedFree(&list); CeedChk(ierr);
+  CeedChk(ierrsetup);
+
+  return 0;
+}
+
 /**
   @brief Apply CeedOperator to a vector
 
@@ -1515,7 +2324,14 @@ int CeedOperatorApply(CeedOperator op, CeedVector in, CeedVector out,
   Ceed ceed = op->ceed;
   ierr = CeedOperatorCheckReady(ceed, op); CeedChk(ierr);
 
-  if (op->numelements)  {
+  if (op->numelements && (op->inscale || op->outscale)) {
+    // Transfer operator
+    ierr = CeedOperatorApplyScaled(op, in, out, false, request); CeedChk(ierr);
+  } else if (op->numelements && (op->inrstr || op->outrstr)) {
+    // Operator acting on E-vectors
+    ierr = CeedOperatorApplyRestricted(op, in, out, false, request);
+    CeedChk(ierr);
+  } else if (op->numelements)  {
     // Standard Operator
     if (op->Apply) {
       ierr = op->Apply(op, in, out, request); CeedChk(ierr);
@@ -1556,10 +2372,8 @@ int CeedOperatorApply(CeedOperator op, CeedVector in, CeedVector out,
         }
       }
       // Apply
-      for (CeedInt i=0; i<op->numsub; i++) {
-        ierr = CeedOperatorApplyAdd(op->suboperators[i], in, out, request);
-        CeedChk(ierr);
-      }
+      ierr = CeedCompositeOperatorApplyAddSubs(op, in, out, request);
+      CeedChk(ierr);
     }
   }
 
@@ -1591,7 +2405,14 @@ int CeedOperatorApplyAdd(CeedOperator op, CeedVector in, CeedVector out,
   Ceed ceed = op->ceed;
   ierr = CeedOperatorCheckReady(ceed, op); CeedChk(ierr);
 
-  if (op->numelements)  {
+  if (op->numelements && (op->inscale || op->outscale)) {
+    // Transfer operator
+    ierr = CeedOperatorApplyScaled(op, in, out, true, request); CeedChk(ierr);
+  } else if (op->numelements && (op->inrstr || op->outrstr)) {
+    // Operator acting on E-vectors
+    ierr = CeedOperatorApplyRestricted(op, in, out, true, request);
+    CeedChk(ierr);
+  } else if (op->numelements)  {
     // Standard Operator
     ierr = op->ApplyAdd(op, in, out, request); CeedChk(ierr);
   } else if (op->composite) {
@@ -1599,18 +2420,276 @@ int CeedOperatorApplyAdd(CeedOperator op, CeedVector in, CeedVector out,
     if (op->ApplyAddComposite) {
       ierr = op->ApplyAddComposite(op, in, out, request); CeedChk(ierr);
     } else {
-      CeedInt numsub;
-      ierr = CeedOperatorGetNumSub(op, &numsub); CeedChk(ierr);
-      CeedOperator *suboperators;
-      ierr = CeedOperatorGetSubList(op, &suboperators); CeedChk(ierr);
+      ierr = CeedCompositeOperatorApplyAddSubs(op, in, out, request);
+      CeedChk(ierr);
+    }
+  }
 
-      for (CeedInt i=0; i<numsub; i++) {
-        ierr = CeedOperatorApplyAdd(suboperators[i], in, out, request);
+  return 0;
+}
+
+/**
+  @brief Apply a CeedOperator to a batch of independent data sets
+
+  The input and output vectors hold @a nbatch L-vectors stored consecutively,
+    one per batch member. Passive fields whose CeedVector has length
+    @a nbatch times the L-vector size of their CeedElemRestriction are also
+    treated as one L-vector per member; all other passive fields are shared by
+    every member. This is equivalent to applying the operator to each member
+    in turn. The /cpu/self/opt and /cpu/self/avx backends apply all
+    members to each element block before moving to the next, so element
+    restriction offsets and basis matrices are reused across members while in
+    cache; the members themselves are not vectorized across. Other backends
+    apply the members one after another.
+
+  Note: Calling this function asserts that setup is complete
+          and sets the CeedOperator as immutable.
+
+  @param op        CeedOperator to apply
+  @param nbatch    Number of batch members
+  @param[in] in    CeedVector containing input state or @ref CEED_VECTOR_NONE if
+                  there are no active inputs
+  @param[out] out  CeedVector to store result of applying operator (must be
+                     distinct from @a in) or @ref CEED_VECTOR_NONE if there are no
+                     active outputs
+  @param request   Address of CeedRequest for non-blocking completion, else
+                     @ref CEED_REQUEST_IMMEDIATE
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedOperatorApplyBatch(CeedOperator op, CeedInt nbatch, CeedVector in,
+                           CeedVector out, CeedRequest *request) {
+  int ierr;
+  Ceed ceed = op->ceed;
+  ierr = CeedOperatorCheckReady(ceed, op); CeedChk(ierr);
+
+  // Zero all output vectors
+  if (out != CEED_VECTOR_NONE) {
+    ierr = CeedVectorSetValue(out, 0.0); CeedChk(ierr);
+  }
+  CeedInt numsub = op->composite ? op->numsub : 1;
+  CeedOperator *suboperators = op->composite ? op->suboperators : &op;
+  for (CeedInt i=0; i<numsub; i++) {
+    for (CeedInt j=0; j<suboperators[i]->qf->numoutputfields; j++) {
+      CeedVector vec = suboperators[i]->outputfields[j]->vec;
+      if (vec != CEED_VECTOR_ACTIVE && vec != CEED_VECTOR_NONE) {
+        ierr = CeedVectorSetValue(vec, 0.0); CeedChk(ierr);
+      }
+    }
+  }
+
+  // Apply
+  ierr = CeedOperatorApplyAddBatch(op, nbatch, in, out, request);
+  CeedChk(ierr);
+
+  return 0;
+}
+
+/**
+  @brief Apply a CeedOperator to a batch of independent data sets, adding the
+           result to the output vectors
+
+  See @ref CeedOperatorApplyBatch() for the layout of batched vectors.
+
+  @param op        CeedOperator to apply
+  @param nbatch    Number of batch members
+  @param[in] in    CeedVector containing input state or NULL if there are no
+                     active inputs
+  @param[out] out  CeedVector to sum in result of applying operator (must be
+                     distinct from @a in) or NULL if there are no active outputs
+  @param request   Address of CeedRequest for non-blocking completion, else
+                     @ref CEED_REQUEST_IMMEDIATE
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedOperatorApplyAddBatch(CeedOperator op, CeedInt nbatch, CeedVector in,
+                              CeedVector out, CeedRequest *request) {
+  int ierr;
+  Ceed ceed = op->ceed;
+  ierr = CeedOperatorCheckReady(ceed, op); CeedChk(ierr);
+
+  // LCOV_EXCL_START
+  if (nbatch < 1)
+    return CeedError(ceed, 1, "Batch must have at least one member");
+  if ((in && in != CEED_VECTOR_NONE && in->length % nbatch) ||
+      (out && out != CEED_VECTOR_NONE && out->length % nbatch))
+    return CeedError(ceed, 1, "Active vector length must be a multiple of the "
+                     "number of batch members");
+  // LCOV_EXCL_STOP
+
+  if (nbatch == 1) {
+    ierr = CeedOperatorApplyAdd(op, in, out, request); CeedChk(ierr);
+  } else if (op->composite) {
+    // Composite Operator
+    for (CeedInt i=0; i<op->numsub; i++) {
+      ierr = CeedOperatorApplyAddBatch(op->suboperators[i], nbatch, in, out,
+                                       request); CeedChk(ierr);
+    }
+  } else if (op->inscale || op->outscale || op->inrstr || op->outrstr) {
+    // Transfer operator or operator acting on E-vectors, one member at a time
+    for (CeedInt b=0; b<nbatch; b++) {
+      CeedVector inview, outview;
+      ierr = CeedVectorCreateView(in, b*(in->length/nbatch), in->length/nbatch,
+                                  &inview); CeedChk(ierr);
+      ierr = CeedVectorCreateView(out, b*(out->length/nbatch),
+                                  out->length/nbatch, &outview); CeedChk(ierr);
+      if (op->inscale || op->outscale) {
+        ierr = CeedOperatorApplyScaled(op, inview, outview, true, request);
         CeedChk(ierr);
+      } else {
+        ierr = CeedOperatorApplyRestricted(op, inview, outview, true, request);
+        CeedChk(ierr);
+      }
+      ierr = CeedVectorDestroy(&inview); CeedChk(ierr);
+      ierr = CeedVectorDestroy(&outview); CeedChk(ierr);
+    }
+  } else if (op->numelements) {
+    // Standard Operator
+    if (op->ApplyAddBatch) {
+      ierr = op->ApplyAddBatch(op, nbatch, in, out, request); CeedChk(ierr);
+    } else {
+      ierr = CeedOperatorApplyAddBatchFallback(op, nbatch, in, out, request);
+      CeedChk(ierr);
+    }
+  }
+
+  return 0;
+}
+
+/**
+  @brief Apply a CeedOperator and compute the energy inner product of its
+           active input and output
+
+  This computes @a out = A @a in, as CeedOperatorApply(), together with
+    @a dot = @a in^T @a out, as needed by the conjugate gradient method. When
+    all active input and output fields use the same CeedElemRestriction, the
+    CPU backends accumulate the inner product
+    element by element from the restricted input and the output before its
+    transpose restriction, without another pass over the L-vectors. Otherwise
+    the inner product is computed from the L-vectors after application.
+
+  @param op        CeedOperator to apply
+  @param[in] in    CeedVector containing input state
+  @param[out] out  CeedVector to store result of applying operator (must be
+                     distinct from @a in and of the same length)
+  @param[out] dot  Variable to store the inner product of @a in and @a out
+  @param request   Address of CeedRequest for non-blocking completion, else
+                     @ref CEED_REQUEST_IMMEDIATE
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedOperatorApplyWithDot(CeedOperator op, CeedVector in, CeedVector out,
+                             CeedScalar *dot, CeedRequest *request) {
+  int ierr;
+  Ceed ceed = op->ceed;
+  ierr = CeedOperatorCheckReady(ceed, op); CeedChk(ierr);
+
+  // LCOV_EXCL_START
+  if (!in || in == CEED_VECTOR_NONE || !out || out == CEED_VECTOR_NONE ||
+      in->length != out->length)
+    return CeedError(ceed, 1, "Inner product requires active input and "
+                     "output vectors of the same length");
+  // LCOV_EXCL_STOP
+
+  bool hasdot;
+  ierr = CeedOperatorHasApplyAddDot(op, &hasdot); CeedChk(ierr);
+  if (!hasdot) {
+    ierr = CeedOperatorApply(op, in, out, request); CeedChk(ierr);
+    ierr = CeedOperatorVectorDot(in, out, dot); CeedChk(ierr);
+    return 0;
+  }
+
+  // Zero all output vectors
+  ierr = CeedVectorSetValue(out, 0.0); CeedChk(ierr);
+  CeedInt numsub = op->composite ? op->numsub : 1;
+  CeedOperator *suboperators = op->composite ? op->suboperators : &op;
+  for (CeedInt i=0; i<numsub; i++) {
+    for (CeedInt j=0; j<suboperators[i]->qf->numoutputfields; j++) {
+      CeedVector vec = suboperators[i]->outputfields[j]->vec;
+      if (vec != CEED_VECTOR_ACTIVE && vec != CEED_VECTOR_NONE) {
+        ierr = CeedVectorSetValue(vec, 0.0); CeedChk(ierr);
       }
     }
   }
 
+  // Apply
+  ierr = CeedOperatorApplyAddWithDot(op, in, out, dot, request); CeedChk(ierr);
+
+  return 0;
+}
+
+/**
+  @brief Apply a CeedOperator, adding the result to the output vector, and
+           compute the energy inner product of its active input and the added
+           result
+
+  This computes @a out += A @a in and @a dot = @a in^T A @a in. See
+    CeedOperatorApplyWithDot() for when the inner product is accumulated
+    during application; otherwise A @a in is computed in a work vector.
+
+  @param op        CeedOperator to apply
+  @param[in] in    CeedVector containing input state
+  @param[out] out  CeedVector to sum in result of applying operator (must be
+                     distinct from @a in and of the same length)
+  @param[out] dot  Variable to store the inner product of @a in and A @a in
+  @param request   Address of CeedRequest for non-blocking completion, else
+                     @ref CEED_REQUEST_IMMEDIATE
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedOperatorApplyAddWithDot(CeedOperator op, CeedVector in,
+                                CeedVector out, CeedScalar *dot,
+                                CeedRequest *request) {
+  int ierr;
+  Ceed ceed = op->ceed;
+  ierr = CeedOperatorCheckReady(ceed, op); CeedChk(ierr);
+
+  // LCOV_EXCL_START
+  if (!in || in == CEED_VECTOR_NONE || !out || out == CEED_VECTOR_NONE ||
+      in->length != out->length)
+    return CeedError(ceed, 1, "Inner product requires active input and "
+                     "output vectors of the same length");
+  // LCOV_EXCL_STOP
+
+  bool hasdot;
+  ierr = CeedOperatorHasApplyAddDot(op, &hasdot); CeedChk(ierr);
+  if (!hasdot) {
+    // Apply to work vector, then sum result
+    CeedVector work;
+    CeedScalar *o;
+    const CeedScalar *w;
+    ierr = CeedVectorCreate(ceed, out->length, &work); CeedChk(ierr);
+    ierr = CeedOperatorApply(op, in, work, request); CeedChk(ierr);
+    ierr = CeedOperatorVectorDot(in, work, dot); CeedChk(ierr);
+    ierr = CeedVectorGetArray(out, CEED_MEM_HOST, &o); CeedChk(ierr);
+    ierr = CeedVectorGetArrayRead(work, CEED_MEM_HOST, &w); CeedChk(ierr);
+    for (CeedInt i=0; i<out->length; i++)
+      o[i] += w[i];
+    ierr = CeedVectorRestoreArray(out, &o); CeedChk(ierr);
+    ierr = CeedVectorRestoreArrayRead(work, &w); CeedChk(ierr);
+    ierr = CeedVectorDestroy(&work); CeedChk(ierr);
+  } else if (op->composite) {
+    // Composite Operator
+    *dot = 0;
+    for (CeedInt i=0; i<op->numsub; i++) {
+      CeedScalar subdot;
+      ierr = CeedOperatorApplyAddWithDot(op->suboperators[i], in, out, &subdot,
+                                         request); CeedChk(ierr);
+      *dot += subdot;
+    }
+  } else {
+    // Standard Operator
+    ierr = op->ApplyAddDot(op, in, out, dot, request); CeedChk(ierr);
+  }
+
   return 0;
 }
 
@@ -1630,6 +2709,13 @@ int CeedOperatorDestroy(CeedOperator *op) {
   if ((*op)->Destroy) {
     ierr = (*op)->Destroy(*op); CeedChk(ierr);
   }
+  // Destroy fallback, which shares the fields of the operator
+  if ((*op)->opfallback) {
+    ierr = (*op)->qffallback->Destroy((*op)->qffallback); CeedChk(ierr);
+    ierr = CeedFree(&(*op)->qffallback); CeedChk(ierr);
+    ierr = (*op)->opfallback->Destroy((*op)->opfallback); CeedChk(ierr);
+    ierr = CeedFree(&(*op)->opfallback); CeedChk(ierr);
+  }
   ierr = CeedDestroy(&(*op)->ceed); CeedChk(ierr);
   // Free fields
   for (int i=0; i<(*op)->nfields; i++)
@@ -1667,21 +2753,30 @@ int CeedOperatorDestroy(CeedOperator *op) {
     if ((*op)->suboperators[i]) {
       ierr = CeedOperatorDestroy(&(*op)->suboperators[i]); CeedChk(ierr);
     }
+  if ((*op)->threadouts) {
+    for (CeedInt i=0; i<(*op)->numthreads-1; i++) {
+      ierr = CeedVectorDestroy(&(*op)->threadouts[i]); CeedChk(ierr);
+    }
+    ierr = CeedFree(&(*op)->threadouts); CeedChk(ierr);
+  }
   ierr = CeedQFunctionDestroy(&(*op)->qf); CeedChk(ierr);
   ierr = CeedQFunctionDestroy(&(*op)->dqf); CeedChk(ierr);
   ierr = CeedQFunctionDestroy(&(*op)->dqfT); CeedChk(ierr);
-
-  // Destroy fallback
-  if ((*op)->opfallback) {
-    ierr = (*op)->qffallback->Destroy((*op)->qffallback); CeedChk(ierr);
-    ierr = CeedFree(&(*op)->qffallback); CeedChk(ierr);
-    ierr = (*op)->opfallback->Destroy((*op)->opfallback); CeedChk(ierr);
-    ierr = CeedFree(&(*op)->opfallback); CeedChk(ierr);
-  }
+  ierr = CeedVectorDestroy(&(*op)->inscale); CeedChk(ierr);
+  ierr = CeedVectorDestroy(&(*op)->outscale); CeedChk(ierr);
+  ierr = CeedVectorDestroy(&(*op)->scalework); CeedChk(ierr);
+  ierr = CeedElemRestrictionDestroy(&(*op)->inrstr); CeedChk(ierr);
+  ierr = CeedElemRestrictionDestroy(&(*op)->outrstr); CeedChk(ierr);
+  ierr = CeedElemRestrictionDestroy(&(*op)->auxrstr); CeedChk(ierr);
+  ierr = CeedVectorDestroy(&(*op)->auxvec); CeedChk(ierr);
+  ierr = CeedVectorDestroy(&(*op)->auxework); CeedChk(ierr);
+  ierr = CeedVectorDestroy(&(*op)->inework); CeedChk(ierr);
+  ierr = CeedVectorDestroy(&(*op)->outework); CeedChk(ierr);
 
   ierr = CeedFree(&(*op)->inputfields); CeedChk(ierr);
   ierr = CeedFree(&(*op)->outputfields); CeedChk(ierr);
   ierr = CeedFree(&(*op)->suboperators); CeedChk(ierr);
+  ierr = CeedPerfDestroy(&(*op)->perf); CeedChk(ierr);
   ierr = CeedFree(op); CeedChk(ierr);
   return 0;
 }
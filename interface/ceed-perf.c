@@ -0,0 +1,250 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-734707. All Rights
+// reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#define _GNU_SOURCE
+#include <ceed-impl.h>
+#include <ceed-backend.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
+
+/// @file
+/// Implementation of performance counters for CeedOperator phases
+
+/// ----------------------------------------------------------------------------
+/// CeedPerf Library Internal Functions
+/// ----------------------------------------------------------------------------
+/// @addtogroup CeedOperatorDeveloper
+/// @{
+
+/**
+  @brief Open a hardware counter for the calling thread
+
+  @param type    perf_event type
+  @param config  perf_event config
+
+  @return File descriptor of the counter, or -1 if it is not available
+
+  @ref Developer
+**/
+static int CeedPerfOpenEvent(uint32_t type, uint64_t config) {
+#ifdef __linux__
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+  return -1;
+#endif
+}
+
+/**
+  @brief Read a hardware counter
+
+  @param fd  File descriptor of the counter
+
+  @return Counter value, or -1 if it is not available
+
+  @ref Developer
+**/
+static int64_t CeedPerfReadEvent(int fd) {
+  int64_t value;
+  if (fd < 0 || read(fd, &value, sizeof(value)) != sizeof(value))
+    return -1;
+  return value;
+}
+
+/**
+  @brief Wall clock time in seconds
+
+  @ref Developer
+**/
+static double CeedPerfGetTime(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9*ts.tv_nsec;
+}
+
+/**
+  @brief Create performance counters for a CeedOperator
+
+  Hardware counters that cannot be opened, such as when restricted by
+    /proc/sys/kernel/perf_event_paranoid or on systems other than Linux, are
+    reported as -1; wall clock time is always measured.
+
+  @param[out] perf  Address of the variable where the newly created CeedPerf
+                      will be stored
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+int CeedPerfCreate(CeedPerf *perf) {
+  int ierr;
+  ierr = CeedCalloc(1, perf); CeedChk(ierr);
+
+  for (CeedInt i=0; i<CEED_PERF_NUM_EVENTS; i++)
+    (*perf)->fd[i] = -1;
+#ifdef __linux__
+  (*perf)->fd[0] = CeedPerfOpenEvent(PERF_TYPE_HARDWARE,
+                                     PERF_COUNT_HW_CPU_CYCLES);
+  (*perf)->fd[1] = CeedPerfOpenEvent(PERF_TYPE_HARDWARE,
+                                     PERF_COUNT_HW_INSTRUCTIONS);
+  (*perf)->fd[2] = CeedPerfOpenEvent(PERF_TYPE_HARDWARE,
+                                     PERF_COUNT_HW_CACHE_MISSES);
+  // Floating point vector operations have no generic event
+  const char *fpevent = getenv("CEED_PERF_FP_EVENT");
+  if (fpevent)
+    (*perf)->fd[3] = CeedPerfOpenEvent(PERF_TYPE_RAW,
+                                       strtoull(fpevent, NULL, 16));
+#endif
+  for (CeedInt p=0; p<CEED_PERF_NUM_PHASES; p++) {
+    CeedPerfCounters *counters = &(*perf)->counters[p];
+    counters->cycles = (*perf)->fd[0] < 0 ? -1 : 0;
+    counters->instructions = (*perf)->fd[1] < 0 ? -1 : 0;
+    counters->llcmisses = (*perf)->fd[2] < 0 ? -1 : 0;
+    counters->fpops = (*perf)->fd[3] < 0 ? -1 : 0;
+  }
+  (*perf)->enabled = true;
+
+  return 0;
+}
+
+/**
+  @brief Destroy performance counters
+
+  @param perf  CeedPerf to destroy
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+int CeedPerfDestroy(CeedPerf *perf) {
+  int ierr;
+  if (!*perf) return 0;
+
+  for (CeedInt i=0; i<CEED_PERF_NUM_EVENTS; i++)
+    if ((*perf)->fd[i] >= 0)
+      close((*perf)->fd[i]);
+  ierr = CeedFree(perf); CeedChk(ierr);
+
+  return 0;
+}
+
+/// @}
+
+/// ----------------------------------------------------------------------------
+/// CeedPerf Backend API
+/// ----------------------------------------------------------------------------
+/// @addtogroup CeedOperatorBackend
+/// @{
+
+/**
+  @brief Start measuring a phase of CeedOperator application
+
+  Backends should use the macro CeedPerfStart(), which does nothing when the
+    CeedPerf is NULL.
+
+  @param perf   CeedPerf from CeedOperatorGetPerf()
+  @param phase  Phase to measure
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedPerfStartPhase(CeedPerf perf, CeedPerfPhase phase) {
+  for (CeedInt i=0; i<CEED_PERF_NUM_EVENTS; i++)
+    perf->start[i] = CeedPerfReadEvent(perf->fd[i]);
+  perf->starttime = CeedPerfGetTime();
+  return 0;
+}
+
+/**
+  @brief Stop measuring a phase of CeedOperator application and accumulate
+           the counts
+
+  Backends should use the macro CeedPerfStop(), which does nothing when the
+    CeedPerf is NULL.
+
+  @param perf   CeedPerf from CeedOperatorGetPerf()
+  @param phase  Phase to measure
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedPerfStopPhase(CeedPerf perf, CeedPerfPhase phase) {
+  CeedPerfCounters *counters = &perf->counters[phase];
+  int64_t *count[CEED_PERF_NUM_EVENTS] = {&counters->cycles,
+                                          &counters->instructions,
+                                          &counters->llcmisses,
+                                          &counters->fpops
+                                         };
+
+  counters->time += CeedPerfGetTime() - perf->starttime;
+  counters->calls++;
+  for (CeedInt i=0; i<CEED_PERF_NUM_EVENTS; i++)
+    if (*count[i] >= 0) {
+      int64_t value = CeedPerfReadEvent(perf->fd[i]);
+      if (value >= 0 && perf->start[i] >= 0)
+        *count[i] += value - perf->start[i];
+    }
+  return 0;
+}
+
+/**
+  @brief Add counts measured elsewhere to a phase of CeedOperator application
+
+  This is used by backends that delegate application to other CeedOperators.
+    Events unavailable in either set of counts are marked unavailable.
+
+  @param perf      CeedPerf from CeedOperatorGetPerf()
+  @param phase     Phase of application
+  @param counters  Counts to add
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedPerfAddCounters(CeedPerf perf, CeedPerfPhase phase,
+                        const CeedPerfCounters *counters) {
+  CeedPerfCounters *sum = &perf->counters[phase];
+  int64_t *count[CEED_PERF_NUM_EVENTS] = {&sum->cycles, &sum->instructions,
+                                          &sum->llcmisses, &sum->fpops
+                                         };
+  const int64_t add[CEED_PERF_NUM_EVENTS] = {counters->cycles,
+                                             counters->instructions,
+                                             counters->llcmisses,
+                                             counters->fpops
+                                            };
+
+  sum->calls += counters->calls;
+  sum->time += counters->time;
+  for (CeedInt i=0; i<CEED_PERF_NUM_EVENTS; i++)
+    *count[i] = *count[i] < 0 || add[i] < 0 ? -1 : *count[i] + add[i];
+  return 0;
+}
+
+/// @}
@@ -57,8 +57,9 @@ static size_t num_qfunctions;
   @param name     Name for this backend to respond to
   @param source   Absolute path to source of QFunction,
                     "\path\CEED_DIR\gallery\folder\file.h:function_name"
-  @param vlength  Vector length.  Caller must ensure that number of quadrature
-                    points is a multiple of vlength.
+  @param vlength  Vector length. The CPU backends pad the number of quadrature
+                    points to a multiple of vlength, see
+                    CeedQFunctionCreateInterior()
   @param f        Function pointer to evaluate action at quadrature points.
                     See \ref CeedQFunctionUser.
   @param init     Initialization function called by CeedQFunctionInit() when the
@@ -159,6 +160,26 @@ int CeedQFunctionSetFortranStatus(CeedQFunction qf, bool status) {
   return 0;
 }
 
+/**
+  @brief Declare that the backend calls the User Function of a CeedQFunction
+           through CeedQFunctionCallUser(), which pads the number of
+           quadrature points to a multiple of the vector length
+
+  CeedQFunctionApply() otherwise requires the number of quadrature points to
+    be a multiple of the vector length.
+
+  @param qf      CeedQFunction
+  @param padded  Boolean value to set as padded status
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedQFunctionSetPadded(CeedQFunction qf, bool padded) {
+  qf->padded = padded;
+  return 0;
+}
+
 /// @}
 
 /// ----------------------------------------------------------------------------
@@ -230,6 +251,22 @@ int CeedQFunctionGetSourcePath(CeedQFunction qf, char **source) {
   return 0;
 }
 
+/**
+  @brief Get the gallery name of a CeedQFunction
+
+  @param qf              CeedQFunction
+  @param[out] name       Variable to store gallery name, NULL if the
+                           CeedQFunction was not created from the gallery
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedQFunctionGetGalleryName(CeedQFunction qf, const char **name) {
+  *name = qf->qfname;
+  return 0;
+}
+
 /**
   @brief Get the User Function for a CeedQFunction
 
@@ -245,6 +282,148 @@ int CeedQFunctionGetUserFunction(CeedQFunction qf, CeedQFunctionUser *f) {
   return 0;
 }
 
+/**
+  @brief Call the User Function of a CeedQFunction on host arrays
+
+  For a vector length greater than 1, the User Function is called with a
+    number of quadrature points that is a multiple of the vector length and
+    with arrays aligned at CEED_ALIGN bytes. When @a Q or the arrays do not
+    satisfy this, the fields are copied into aligned arrays from the scratch
+    pool of the Ceed whose components are padded with zeros, and the outputs
+    are copied back. The blocked CPU backends provide such Q-vectors directly,
+    so this copy is only made by the serial backends. Concurrent calls, also
+    for the same CeedQFunction, use separate scratch arrays.
+
+  @param qf       CeedQFunction
+  @param ctxdata  User context data, or NULL
+  @param Q        Number of quadrature points
+  @param inputs   Array of input field arrays, with component stride Q
+  @param outputs  Array of output field arrays, with component stride Q
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedQFunctionCallUser(CeedQFunction qf, void *ctxdata, CeedInt Q,
+                          const CeedScalar *const *inputs,
+                          CeedScalar *const *outputs) {
+  int ierr;
+  CeedInt vlength = qf->vlength, nin = qf->numinputfields,
+          nout = qf->numoutputfields;
+  bool aligned = Q % vlength == 0;
+
+  for (CeedInt i=0; i<nin && vlength>1; i++)
+    aligned = aligned && (uintptr_t)inputs[i] % CEED_ALIGN == 0;
+  for (CeedInt i=0; i<nout && vlength>1; i++)
+    aligned = aligned && (uintptr_t)outputs[i] % CEED_ALIGN == 0;
+  if (vlength == 1 || aligned) {
+    ierr = qf->function(ctxdata, Q, inputs, outputs); CeedChk(ierr);
+    return 0;
+  }
+
+  // Pad Q to a multiple of vlength that keeps every component aligned
+  CeedInt pad = vlength, total = 0;
+  while ((pad*sizeof(CeedScalar)) % CEED_ALIGN)
+    pad += vlength;
+  const CeedInt Qpad = ((Q + pad - 1) / pad) * pad;
+  for (CeedInt i=0; i<nin; i++)
+    total += qf->inputfields[i]->size;
+  for (CeedInt i=0; i<nout; i++)
+    total += qf->outputfields[i]->size;
+  CeedScalar *scratch;
+  ierr = CeedGetScratch(qf->ceed, total*Qpad*sizeof(CeedScalar), &scratch);
+  CeedChk(ierr);
+
+  // Copy inputs, padding with zeros
+  const CeedScalar *padin[16];
+  CeedScalar *padout[16], *buffer = scratch;
+  for (CeedInt i=0; i<nin; i++) {
+    for (CeedInt c=0; c<qf->inputfields[i]->size; c++) {
+      memcpy(&buffer[c*Qpad], &inputs[i][c*Q], Q*sizeof(CeedScalar));
+      memset(&buffer[c*Qpad+Q], 0, (Qpad-Q)*sizeof(CeedScalar));
+    }
+    padin[i] = buffer;
+    buffer += qf->inputfields[i]->size*Qpad;
+  }
+  for (CeedInt i=0; i<nout; i++) {
+    padout[i] = buffer;
+    buffer += qf->outputfields[i]->size*Qpad;
+  }
+
+  int ierruser = qf->function(ctxdata, Qpad, padin, padout);
+
+  // Copy outputs, dropping the padding
+  for (CeedInt i=0; i<nout && !ierruser; i++)
+    for (CeedInt c=0; c<qf->outputfields[i]->size; c++)
+      memcpy(&outputs[i][c*Q], &padout[i][c*Qpad], Q*sizeof(CeedScalar));
+  ierr = CeedRestoreScratch(qf->ceed, &scratch); CeedChk(ierr);
+  CeedChk(ierruser);
+
+  return 0;
+}
+
+/**
+  @brief Create a copy of a CeedQFunction on another Ceed
+
+  The copy has the same user function, vector length, fields, and name. Its
+    context, if any, aliases the host data of the context of @a qf, so the
+    copy can be applied concurrently with @a qf or with other copies.
+
+  @param qf         CeedQFunction to copy
+  @param ceed       Ceed object where the copy will be created
+  @param[out] copy  Address of the variable where the copy will be stored
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedQFunctionCreateCopy(CeedQFunction qf, Ceed ceed, CeedQFunction *copy) {
+  int ierr;
+
+  if (qf->fortranstatus)
+    // LCOV_EXCL_START
+    return CeedError(qf->ceed, 1, "Cannot copy a Fortran QFunction");
+  // LCOV_EXCL_STOP
+
+  ierr = CeedQFunctionCreateInterior(ceed, qf->vlength, qf->function,
+                                     qf->sourcepath, copy); CeedChk(ierr);
+  for (CeedInt i=0; i<qf->numinputfields; i++) {
+    CeedQFunctionField f = qf->inputfields[i];
+    ierr = CeedQFunctionAddInput(*copy, f->fieldname, f->size, f->emode);
+    CeedChk(ierr);
+  }
+  for (CeedInt i=0; i<qf->numoutputfields; i++) {
+    CeedQFunctionField f = qf->outputfields[i];
+    ierr = CeedQFunctionAddOutput(*copy, f->fieldname, f->size, f->emode);
+    CeedChk(ierr);
+  }
+  (*copy)->identity = qf->identity;
+  if (qf->qfname) {
+    size_t slen = strlen(qf->qfname) + 1;
+    char *name_copy;
+    ierr = CeedMalloc(slen, &name_copy); CeedChk(ierr);
+    memcpy(name_copy, qf->qfname, slen);
+    (*copy)->qfname = name_copy;
+  }
+
+  // Context aliasing the host data
+  if (qf->ctx) {
+    void *data, *ctxdata;
+    CeedQFunctionContext ctx;
+    ierr = CeedQFunctionContextGetData(qf->ctx, CEED_MEM_HOST, &data);
+    CeedChk(ierr);
+    ctxdata = data;
+    ierr = CeedQFunctionContextRestoreData(qf->ctx, &data); CeedChk(ierr);
+    ierr = CeedQFunctionContextCreate(ceed, &ctx); CeedChk(ierr);
+    ierr = CeedQFunctionContextSetData(ctx, CEED_MEM_HOST, CEED_USE_POINTER,
+                                       qf->ctx->ctxsize, ctxdata); CeedChk(ierr);
+    ierr = CeedQFunctionSetContext(*copy, ctx); CeedChk(ierr);
+    ierr = CeedQFunctionContextDestroy(&ctx); CeedChk(ierr);
+  }
+
+  return 0;
+}
+
 /**
   @brief Get global context for a CeedQFunction.
          Note: For QFunctions from the Fortran interface, this
@@ -306,6 +485,21 @@ int CeedQFunctionIsIdentity(CeedQFunction qf, bool *isidentity) {
   return 0;
 }
 
+/**
+  @brief Determine if QFunction is from the Fortran interface
+
+  @param qf               CeedQFunction
+  @param[out] status      Variable to store Fortran status
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedQFunctionGetFortranStatus(CeedQFunction qf, bool *status) {
+  *status = qf->fortranstatus;
+  return 0;
+}
+
 /**
   @brief Get backend data of a CeedQFunction
 
@@ -414,8 +608,13 @@ int CeedQFunctionFieldGetEvalMode(CeedQFunctionField qffield,
   @brief Create a CeedQFunction for evaluating interior (volumetric) terms.
 
   @param ceed       A Ceed object where the CeedQFunction will be created
-  @param vlength    Vector length. Caller must ensure that number of quadrature
-                      points is a multiple of vlength.
+  @param vlength    Vector length. For vlength greater than 1, the CPU
+                      backends call @a f with a number of quadrature points
+                      that is a multiple of vlength and with input and output
+                      arrays aligned at CEED_ALIGN bytes, padding and copying
+                      the arrays when the operator does not provide them, see
+                      @ref CeedAssumeAligned. Other backends require the
+                      number of quadrature points to be a multiple of vlength.
   @param f          Function pointer to evaluate action at quadrature points.
                       See \ref CeedQFunctionUser.
   @param source     Absolute path to source of QFunction,
@@ -453,7 +652,7 @@ int CeedQFunctionCreateInterior(Ceed ceed, CeedInt vlength, CeedQFunctionUser f,
 
   ierr = CeedCalloc(1, qf); CeedChk(ierr);
   (*qf)->ceed = ceed;
-  ceed->refcount++;
+  CeedAtomicIncrement(ceed->refcount);
   (*qf)->refcount = 1;
   (*qf)->vlength = vlength;
   (*qf)->identity = 0;
@@ -569,6 +768,80 @@ int CeedQFunctionCreateIdentity(Ceed ceed, CeedInt size, CeedEvalMode inmode,
   return 0;
 }
 
+/**
+  @brief Create a vector-valued gallery CeedQFunction by name, with fields for
+           the given number of components sharing one set of quadrature data
+
+  Supported names are "VectorMassApply", with fields "u", "qdata", and "v",
+    and "VectorPoisson1DApply", "VectorPoisson2DApply", and
+    "VectorPoisson3DApply", with fields "du", "qdata", and "dv". The quadrature
+    data matches that of the scalar gallery QFunctions "Mass*DBuild" and
+    "Poisson*DBuild", so a vector field is applied with one CeedOperator
+    reading the quadrature data once per point.
+
+  @param ceed         A Ceed object where the CeedQFunction will be created
+  @param name         Name of QFunction to use from gallery
+  @param ncomp        Number of components of the vector field
+  @param[out] qf      Address of the variable where the newly created
+                        CeedQFunction will be stored
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedQFunctionCreateVectorByName(Ceed ceed, const char *name, CeedInt ncomp,
+                                    CeedQFunction *qf) {
+  int ierr;
+
+  // Determine dimension of gradient fields, zero for mass
+  CeedInt dim = -1;
+  if (!name) return CeedError(ceed, 1, "No QFunction name provided");
+  if (!strcmp(name, "VectorMassApply"))
+    dim = 0;
+  for (CeedInt d=1; d<=3; d++) {
+    char poissonname[32];
+    sprintf(poissonname, "VectorPoisson%dDApply", d);
+    if (!strcmp(name, poissonname))
+      dim = d;
+  }
+  if (dim < 0)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "No vector gallery QFunction named %s", name);
+  // LCOV_EXCL_STOP
+
+  // Create QFunction and add fields
+  ierr = CeedQFunctionCreateInteriorByName(ceed, name, qf); CeedChk(ierr);
+  if (dim == 0) {
+    ierr = CeedQFunctionAddInput(*qf, "u", ncomp, CEED_EVAL_INTERP);
+    CeedChk(ierr);
+    ierr = CeedQFunctionAddInput(*qf, "qdata", 1, CEED_EVAL_NONE);
+    CeedChk(ierr);
+    ierr = CeedQFunctionAddOutput(*qf, "v", ncomp, CEED_EVAL_INTERP);
+    CeedChk(ierr);
+  } else {
+    ierr = CeedQFunctionAddInput(*qf, "du", ncomp*dim, CEED_EVAL_GRAD);
+    CeedChk(ierr);
+    ierr = CeedQFunctionAddInput(*qf, "qdata", dim*(dim+1)/2, CEED_EVAL_NONE);
+    CeedChk(ierr);
+    ierr = CeedQFunctionAddOutput(*qf, "dv", ncomp*dim, CEED_EVAL_GRAD);
+    CeedChk(ierr);
+  }
+
+  // Context holds number of components
+  CeedInt *ncompdata;
+  ierr = CeedCalloc(1, &ncompdata); CeedChk(ierr);
+  ncompdata[0] = ncomp;
+  CeedQFunctionContext ctx;
+  ierr = CeedQFunctionContextCreate(ceed, &ctx); CeedChk(ierr);
+  ierr = CeedQFunctionContextSetData(ctx, CEED_MEM_HOST, CEED_OWN_POINTER,
+                                     sizeof(*ncompdata), (void *)ncompdata);
+  CeedChk(ierr);
+  ierr = CeedQFunctionSetContext(*qf, ctx); CeedChk(ierr);
+  ierr = CeedQFunctionContextDestroy(&ctx); CeedChk(ierr);
+
+  return 0;
+}
+
 /**
   @brief Add a CeedQFunction input
 
@@ -689,7 +962,7 @@ int CeedQFunctionApply(CeedQFunction qf, CeedInt Q,
     // LCOV_EXCL_START
     return CeedError(qf->ceed, 1, "Backend does not support QFunctionApply");
   // LCOV_EXCL_STOP
-  if (Q % qf->vlength)
+  if (!qf->padded && Q % qf->vlength)
     // LCOV_EXCL_START
     return CeedError(qf->ceed, 2, "Number of quadrature points %d must be a "
                      "multiple of %d", Q, qf->vlength);
@@ -140,7 +140,7 @@ int CeedQFunctionContextCreate(Ceed ceed, CeedQFunctionContext *ctx) {
 
   ierr = CeedCalloc(1, ctx); CeedChk(ierr);
   (*ctx)->ceed = ceed;
-  ceed->refcount++;
+  CeedAtomicIncrement(ceed->refcount);
   (*ctx)->refcount = 1;
   ierr = ceed->QFunctionContextCreate(*ctx); CeedChk(ierr);
   return 0;
@@ -0,0 +1,172 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-734707. All Rights
+// reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <ceed-impl.h>
+#include <ceed-backend.h>
+#include <pthread.h>
+#include <unistd.h>
+
+/// @file
+/// Implementation of concurrent CeedOperator setup
+
+/// ----------------------------------------------------------------------------
+/// CeedOperator Library Internal Functions
+/// ----------------------------------------------------------------------------
+/// @addtogroup CeedOperatorDeveloper
+/// @{
+
+/**
+  @brief Shared work list for concurrent operator setup
+**/
+typedef struct {
+  CeedOperator *ops; /// Operators to set up
+  CeedInt numops;    /// Number of operators
+  CeedInt next;      /// Index of the next operator to claim
+  int ierr;          /// First error code returned by a backend setup
+} CeedOperatorSetupQueue;
+
+/**
+  @brief Set up operators from a shared work list until it is exhausted
+
+  Each worker claims the next operator with an atomic increment, so every
+    operator is set up exactly once.
+
+  @param arg  CeedOperatorSetupQueue shared by all workers
+
+  @return NULL
+
+  @ref Developer
+**/
+static void *CeedOperatorSetupWorker(void *arg) {
+  CeedOperatorSetupQueue *queue = arg;
+
+  for (CeedInt i = __sync_fetch_and_add(&queue->next, 1); i < queue->numops;
+       i = __sync_fetch_and_add(&queue->next, 1)) {
+    int ierr = queue->ops[i]->Setup(queue->ops[i]);
+    if (ierr)
+      __sync_bool_compare_and_swap(&queue->ierr, 0, ierr);
+  }
+  return NULL;
+}
+
+/**
+  @brief Set up the backend data of distinct CeedOperators concurrently
+
+  The operators are claimed from a shared work list by up to @a numthreads
+    threads, the calling thread working alongside the spawned threads. Fewer
+    threads are used if they cannot be spawned.
+
+  @param numops      Number of operators
+  @param ops         Array of distinct non-composite CeedOperators with a
+                       pending backend setup
+  @param numthreads  Number of threads to use, or a value less than 1 for the
+                       number of online processors
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+int CeedOperatorSetupConcurrent(CeedInt numops, CeedOperator *ops,
+                                CeedInt numthreads) {
+  int ierr;
+  CeedOperatorSetupQueue queue;
+
+  if (numops < 1) return 0;
+  if (numthreads < 1)
+    numthreads = sysconf(_SC_NPROCESSORS_ONLN);
+  if (numthreads > numops)
+    numthreads = numops;
+  queue.ops = ops;
+  queue.numops = numops;
+  queue.next = 0;
+  queue.ierr = 0;
+  if (numthreads > 1) {
+    pthread_t *threads;
+    CeedInt numstarted = 0;
+
+    ierr = CeedCalloc(numthreads - 1, &threads); CeedChk(ierr);
+    while (numstarted < numthreads - 1 &&
+           !pthread_create(&threads[numstarted], NULL, CeedOperatorSetupWorker,
+                           &queue))
+      numstarted++;
+    CeedOperatorSetupWorker(&queue);
+    for (CeedInt i=0; i<numstarted; i++)
+      pthread_join(threads[i], NULL);
+    ierr = CeedFree(&threads); CeedChk(ierr);
+  } else {
+    CeedOperatorSetupWorker(&queue);
+  }
+
+  if (queue.ierr)
+    // LCOV_EXCL_START
+    return CeedError(ops[0]->ceed, queue.ierr, "Operator setup failed");
+  // LCOV_EXCL_STOP
+
+  return 0;
+}
+
+/**
+  @brief Read a CeedVector once so that later concurrent reads do not modify
+           it, e.g. by allocating or zeroing the array on first access
+
+  @param vec  CeedVector to read, or NULL
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+int CeedOperatorTouchVector(CeedVector vec) {
+  int ierr;
+  const CeedScalar *array;
+
+  if (!vec || vec == CEED_VECTOR_ACTIVE || vec == CEED_VECTOR_NONE)
+    return 0;
+  ierr = CeedVectorGetArrayRead(vec, CEED_MEM_HOST, &array); CeedChk(ierr);
+  ierr = CeedVectorRestoreArrayRead(vec, &array); CeedChk(ierr);
+  return 0;
+}
+
+/**
+  @brief Read the passive inputs of a CeedOperator once, before it is set up
+           or applied concurrently with operators sharing them
+
+  This covers the passive input vectors, the ghost input vectors of their
+    restrictions, and the vectors of transfer and auxiliary fields.
+
+  @param op  Non-composite CeedOperator
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+int CeedOperatorTouchInputs(CeedOperator op) {
+  int ierr;
+
+  for (CeedInt i=0; i<op->qf->numinputfields; i++) {
+    CeedOperatorField field = op->inputfields[i];
+    ierr = CeedOperatorTouchVector(field->vec); CeedChk(ierr);
+    if (field->vec != CEED_VECTOR_ACTIVE &&
+        field->Erestrict != CEED_ELEMRESTRICTION_NONE) {
+      ierr = CeedOperatorTouchVector(field->Erestrict->ghostin); CeedChk(ierr);
+    }
+  }
+  ierr = CeedOperatorTouchVector(op->inscale); CeedChk(ierr);
+  ierr = CeedOperatorTouchVector(op->outscale); CeedChk(ierr);
+  ierr = CeedOperatorTouchVector(op->auxvec); CeedChk(ierr);
+  return 0;
+}
+
+/// @}
@@ -60,7 +60,7 @@ int CeedTensorContractCreate(Ceed ceed, CeedBasis basis,
   ierr = CeedCalloc(1,contract); CeedChk(ierr);
 
   (*contract)->ceed = ceed;
-  ceed->refcount++;
+  CeedAtomicIncrement(ceed->refcount);
   ierr = ceed->TensorContractCreate(basis, *contract);
   CeedChk(ierr);
   return 0;
@@ -32,6 +32,12 @@ const char *const CeedTransposeModes[] = {
   [CEED_NOTRANSPOSE] = "no transpose",
 };
 
+const char *const CeedPerfPhases[] = {
+  [CEED_PERF_RESTRICTION] = "restriction",
+  [CEED_PERF_BASIS] = "basis",
+  [CEED_PERF_QFUNCTION] = "qfunction",
+};
+
 const char *const CeedEvalModes[] = {
   [CEED_EVAL_NONE] = "none",
   [CEED_EVAL_INTERP] = "interpolation",
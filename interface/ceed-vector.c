@@ -38,6 +38,85 @@ const CeedVector CEED_VECTOR_NONE = &ceed_vector_none;
 
 /// @}
 
+/// ----------------------------------------------------------------------------
+/// CeedVector Library Internal Functions
+/// ----------------------------------------------------------------------------
+/// @addtogroup CeedVectorDeveloper
+/// @{
+
+/**
+  @brief Write the zeros deferred by @ref CeedVectorSetValue() into the
+           backend array, if the CeedVector is known to be zero
+
+  @param vec  CeedVector to materialize
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+static int CeedVectorMaterializeZero(CeedVector vec) {
+  int ierr;
+
+  // Only the thread clearing the flag writes the zeros
+  if (!CeedAtomicCompareAndSwap(vec->iszero, true, false))
+    return 0;
+
+  if (vec->SetValue) {
+    ierr = vec->SetValue(vec, 0.0); CeedChk(ierr);
+  } else {
+    CeedScalar *array;
+    if (vec->GetArrayWrite) {
+      ierr = vec->GetArrayWrite(vec, CEED_MEM_HOST, &array); CeedChk(ierr);
+    } else {
+      ierr = vec->GetArray(vec, CEED_MEM_HOST, &array); CeedChk(ierr);
+    }
+    for (CeedInt i=0; i<vec->length; i++) array[i] = 0.0;
+    ierr = vec->RestoreArray(vec); CeedChk(ierr);
+  }
+
+  return 0;
+}
+
+/**
+  @brief Remove a reference to a CeedVector, destroying it with the last one
+
+  Unlike @ref CeedVectorDestroy(), this does not check for array access through
+    views, so that a view may release its parent while other views of the
+    parent hold arrays.
+
+  @param vec  CeedVector to release
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Developer
+**/
+static int CeedVectorRemoveReference(CeedVector *vec) {
+  int ierr;
+
+  if (!*vec || CeedAtomicDecrement((*vec)->refcount) > 0) return 0;
+
+  if (((*vec)->state % 2) == 1)
+    return CeedError((*vec)->ceed, 1,
+                     "Cannot destroy CeedVector, the writable access "
+                     "lock is in use");
+
+  if ((*vec)->numreaders > 0)
+    return CeedError((*vec)->ceed, 1, "Cannot destroy CeedVector, a process has "
+                     "read access");
+
+  if ((*vec)->Destroy) {
+    ierr = (*vec)->Destroy(*vec); CeedChk(ierr);
+  }
+  ierr = CeedVectorRemoveReference(&(*vec)->parent); CeedChk(ierr);
+
+  ierr = CeedDestroy(&(*vec)->ceed); CeedChk(ierr);
+  ierr = CeedFree(vec); CeedChk(ierr);
+
+  return 0;
+}
+
+/// @}
+
 /// ----------------------------------------------------------------------------
 /// CeedVector Backend API
 /// ----------------------------------------------------------------------------
@@ -70,7 +149,27 @@ int CeedVectorGetCeed(CeedVector vec, Ceed *ceed) {
   @ref Backend
 **/
 int CeedVectorGetState(CeedVector vec, uint64_t *state) {
-  *state = vec->state;
+  *state = vec->parent ? vec->parent->state : vec->state;
+  return 0;
+}
+
+/**
+  @brief Check if a CeedVector is known to be zero. This is the case after
+           @ref CeedVectorSetValue() with value 0.0 until the array is next
+           accessed, as the zeros are only written on demand.
+
+  Backends may use this to overwrite, rather than sum into, the vector via
+    @ref CeedVectorGetArrayWrite().
+
+  @param vec           CeedVector to check
+  @param[out] iszero   Variable to store zero status
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedVectorIsZero(CeedVector vec, bool *iszero) {
+  *iszero = CeedAtomicLoad(vec->iszero);
   return 0;
 }
 
@@ -84,7 +183,7 @@ int CeedVectorGetState(CeedVector vec, uint64_t *state) {
   @ref Backend
 **/
 int CeedVectorAddReference(CeedVector vec) {
-  vec->refcount++;
+  CeedAtomicIncrement(vec->refcount);
   return 0;
 }
 
@@ -156,7 +255,7 @@ int CeedVectorCreate(Ceed ceed, CeedInt length, CeedVector *vec) {
 
   ierr = CeedCalloc(1,vec); CeedChk(ierr);
   (*vec)->ceed = ceed;
-  ceed->refcount++;
+  CeedAtomicIncrement(ceed->refcount);
   (*vec)->refcount = 1;
   (*vec)->length = length;
   (*vec)->state = 0;
@@ -164,6 +263,52 @@ int CeedVectorCreate(Ceed ceed, CeedInt length, CeedVector *vec) {
   return 0;
 }
 
+/**
+  @brief Create a CeedVector aliasing a contiguous range of another CeedVector,
+           without copying. The view shares the access locks and state of the
+           parent, so array access to the view is access to the parent.
+
+  The view holds a reference to the parent. The parent cannot be destroyed
+    while a view has array access.
+
+  @param parent    CeedVector to alias
+  @param offset    Offset of the first entry of the view in the parent
+  @param length    Length of view
+  @param[out] view Address of the variable where the newly created
+                     CeedVector will be stored
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedVectorCreateView(CeedVector parent, CeedInt offset, CeedInt length,
+                         CeedVector *view) {
+  int ierr;
+
+  if (offset < 0 || length < 0 || offset + length > parent->length)
+    // LCOV_EXCL_START
+    return CeedError(parent->ceed, 1, "View range [%d, %d) out of range "
+                     "for CeedVector of length %d", offset, offset + length,
+                     parent->length);
+  // LCOV_EXCL_STOP
+
+  // Views of views alias the original parent
+  if (parent->parent) {
+    offset += parent->offset;
+    parent = parent->parent;
+  }
+
+  ierr = CeedCalloc(1, view); CeedChk(ierr);
+  (*view)->ceed = parent->ceed;
+  CeedAtomicIncrement(parent->ceed->refcount);
+  (*view)->refcount = 1;
+  (*view)->length = length;
+  (*view)->parent = parent;
+  (*view)->offset = offset;
+  ierr = CeedVectorAddReference(parent); CeedChk(ierr);
+  return 0;
+}
+
 /**
   @brief Set the array used by a CeedVector, freeing any previously allocated
            array if applicable. The backend may copy values to a different
@@ -184,6 +329,11 @@ int CeedVectorSetArray(CeedVector vec, CeedMemType mtype, CeedCopyMode cmode,
                        CeedScalar *array) {
   int ierr;
 
+  if (vec->parent)
+    // LCOV_EXCL_START
+    return CeedError(vec->ceed, 1, "Cannot set the array of a CeedVector view");
+  // LCOV_EXCL_STOP
+
   if (!vec->SetArray)
     // LCOV_EXCL_START
     return CeedError(vec->ceed, 1, "Backend does not support VectorSetArray");
@@ -198,6 +348,8 @@ int CeedVectorSetArray(CeedVector vec, CeedMemType mtype, CeedCopyMode cmode,
                      "process has read access");
 
   ierr = vec->SetArray(vec, mtype, cmode, array); CeedChk(ierr);
+  CeedAtomicStore(vec->iszero, false);
+  vec->isborrowed = cmode == CEED_USE_POINTER;
   vec->state += 2;
 
   return 0;
@@ -209,6 +361,10 @@ int CeedVectorSetArray(CeedVector vec, CeedMemType mtype, CeedCopyMode cmode,
   @param vec        CeedVector
   @param[in] value  Value to be used
 
+  @note Unless the array was provided with @ref CEED_USE_POINTER, setting the
+    value 0.0 is deferred; the zeros are written on the next access to the
+    array, or not at all if that access is @ref CeedVectorGetArrayWrite().
+
   @return An error code: 0 - success, otherwise - failure
 
   @ref User
@@ -216,10 +372,27 @@ int CeedVectorSetArray(CeedVector vec, CeedMemType mtype, CeedCopyMode cmode,
 int CeedVectorSetValue(CeedVector vec, CeedScalar value) {
   int ierr;
 
+  // Views only write their range of the parent
+  if (vec->parent) {
+    CeedScalar *array;
+    ierr = CeedVectorGetArray(vec, CEED_MEM_HOST, &array); CeedChk(ierr);
+    for (CeedInt i=0; i<vec->length; i++) array[i] = value;
+    ierr = CeedVectorRestoreArray(vec, &array); CeedChk(ierr);
+    return 0;
+  }
+
   if (vec->state % 2 == 1)
     return CeedError(vec->ceed, 1, "Cannot grant CeedVector array access, the "
                      "access lock is already in use");
 
+  // Zero values are only written on demand, unless the array may be aliased
+  bool iszero = value == 0.0 && !vec->isborrowed;
+  CeedAtomicStore(vec->iszero, iszero);
+  if (iszero) {
+    vec->state += 2;
+    return 0;
+  }
+
   if (vec->SetValue) {
     ierr = vec->SetValue(vec, value); CeedChk(ierr);
   } else {
@@ -250,10 +423,14 @@ int CeedVectorSetValue(CeedVector vec, CeedScalar value) {
 int CeedVectorSyncArray(CeedVector vec, CeedMemType mtype) {
   int ierr;
 
+  if (vec->parent)
+    return CeedVectorSyncArray(vec->parent, mtype);
+
   if (vec->state % 2 == 1)
     return CeedError(vec->ceed, 1, "Cannot sync CeedVector, the access lock is "
                      "already in use");
 
+  ierr = CeedVectorMaterializeZero(vec); CeedChk(ierr);
   if (vec->SyncArray) {
     ierr = vec->SyncArray(vec, mtype); CeedChk(ierr);
   } else {
@@ -283,6 +460,11 @@ int CeedVectorSyncArray(CeedVector vec, CeedMemType mtype) {
 int CeedVectorTakeArray(CeedVector vec, CeedMemType mtype, CeedScalar **array) {
   int ierr;
 
+  if (vec->parent)
+    // LCOV_EXCL_START
+    return CeedError(vec->ceed, 1, "Cannot take the array of a CeedVector view");
+  // LCOV_EXCL_STOP
+
   if (vec->state % 2 == 1)
     // LCOV_EXCL_START
     return CeedError(vec->ceed, 1, "Cannot take CeedVector array, the access "
@@ -294,8 +476,10 @@ int CeedVectorTakeArray(CeedVector vec, CeedMemType mtype, CeedScalar **array) {
                      "has read access");
   // LCOV_EXCL_STOP
 
+  ierr = CeedVectorMaterializeZero(vec); CeedChk(ierr);
   CeedScalar *tempArray = NULL;
   ierr = vec->TakeArray(vec, mtype, &tempArray); CeedChk(ierr);
+  vec->isborrowed = false;
   if (array)
     (*array) = tempArray;
   return 0;
@@ -322,6 +506,17 @@ int CeedVectorTakeArray(CeedVector vec, CeedMemType mtype, CeedScalar **array) {
 int CeedVectorGetArray(CeedVector vec, CeedMemType mtype, CeedScalar **array) {
   int ierr;
 
+  if (vec->parent) {
+    if (vec->state % 2 == 1)
+      return CeedError(vec->ceed, 1, "Cannot grant CeedVector array access, "
+                       "the access lock is already in use");
+    ierr = CeedVectorGetArray(vec->parent, mtype, array); CeedChk(ierr);
+    *array += vec->offset;
+    vec->state += 1;
+    CeedAtomicIncrement(vec->parent->numviewaccess);
+    return 0;
+  }
+
   if (!vec->GetArray)
     // LCOV_EXCL_START
     return CeedError(vec->ceed, 1, "Backend does not support GetArray");
@@ -335,6 +530,7 @@ int CeedVectorGetArray(CeedVector vec, CeedMemType mtype, CeedScalar **array) {
     return CeedError(vec->ceed, 1, "Cannot grant CeedVector array access, a "
                      "process has read access");
 
+  ierr = CeedVectorMaterializeZero(vec); CeedChk(ierr);
   ierr = vec->GetArray(vec, mtype, array); CeedChk(ierr);
   vec->state += 1;
 
@@ -359,6 +555,14 @@ int CeedVectorGetArrayRead(CeedVector vec, CeedMemType mtype,
                            const CeedScalar **array) {
   int ierr;
 
+  if (vec->parent) {
+    ierr = CeedVectorGetArrayRead(vec->parent, mtype, array); CeedChk(ierr);
+    *array += vec->offset;
+    CeedAtomicIncrement(vec->numreaders);
+    CeedAtomicIncrement(vec->parent->numviewaccess);
+    return 0;
+  }
+
   if (!vec->GetArrayRead)
     // LCOV_EXCL_START
     return CeedError(vec->ceed, 1, "Backend does not support GetArrayRead");
@@ -368,8 +572,58 @@ int CeedVectorGetArrayRead(CeedVector vec, CeedMemType mtype,
     return CeedError(vec->ceed, 1, "Cannot grant CeedVector read-only array "
                      "access, the access lock is already in use");
 
+  ierr = CeedVectorMaterializeZero(vec); CeedChk(ierr);
   ierr = vec->GetArrayRead(vec, mtype, array); CeedChk(ierr);
-  vec->numreaders++;
+  CeedAtomicIncrement(vec->numreaders);
+
+  return 0;
+}
+
+/**
+  @brief Get write-only access to a CeedVector via the specified memory type.
+           The current values are discarded and the caller must write every
+           entry of the array. Restore access with @ref CeedVectorRestoreArray().
+
+  @param vec        CeedVector to access
+  @param mtype      Memory type on which to access the array. No copy of the
+                      current values is performed.
+  @param[out] array Array on memory type mtype
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref User
+**/
+int CeedVectorGetArrayWrite(CeedVector vec, CeedMemType mtype,
+                            CeedScalar **array) {
+  int ierr;
+
+  // The rest of the parent array must be preserved
+  if (vec->parent)
+    return CeedVectorGetArray(vec, mtype, array);
+
+  if (!vec->GetArray)
+    // LCOV_EXCL_START
+    return CeedError(vec->ceed, 1, "Backend does not support GetArray");
+  // LCOV_EXCL_STOP
+
+  if (vec->state % 2 == 1)
+    return CeedError(vec->ceed, 1, "Cannot grant CeedVector array access, the "
+                     "access lock is already in use");
+
+  if (vec->numreaders > 0)
+    // LCOV_EXCL_START
+    return CeedError(vec->ceed, 1, "Cannot grant CeedVector array access, a "
+                     "process has read access");
+  // LCOV_EXCL_STOP
+
+  // Any deferred zeros are overwritten by the caller
+  CeedAtomicStore(vec->iszero, false);
+  if (vec->GetArrayWrite) {
+    ierr = vec->GetArrayWrite(vec, mtype, array); CeedChk(ierr);
+  } else {
+    ierr = vec->GetArray(vec, mtype, array); CeedChk(ierr);
+  }
+  vec->state += 1;
 
   return 0;
 }
@@ -387,6 +641,18 @@ int CeedVectorGetArrayRead(CeedVector vec, CeedMemType mtype,
 int CeedVectorRestoreArray(CeedVector vec, CeedScalar **array) {
   int ierr;
 
+  if (vec->parent) {
+    if (vec->state % 2 != 1)
+      return CeedError(vec->ceed, 1, "Cannot restore CeedVector array access, "
+                       "access was not granted");
+    CeedScalar *parentarray = *array - vec->offset;
+    ierr = CeedVectorRestoreArray(vec->parent, &parentarray); CeedChk(ierr);
+    *array = NULL;
+    vec->state += 1;
+    CeedAtomicDecrement(vec->parent->numviewaccess);
+    return 0;
+  }
+
   if (!vec->RestoreArray)
     // LCOV_EXCL_START
     return CeedError(vec->ceed, 1, "Backend does not support RestoreArray");
@@ -416,6 +682,15 @@ int CeedVectorRestoreArray(CeedVector vec, CeedScalar **array) {
 int CeedVectorRestoreArrayRead(CeedVector vec, const CeedScalar **array) {
   int ierr;
 
+  if (vec->parent) {
+    const CeedScalar *parentarray = *array - vec->offset;
+    ierr = CeedVectorRestoreArrayRead(vec->parent, &parentarray); CeedChk(ierr);
+    *array = NULL;
+    CeedAtomicDecrement(vec->numreaders);
+    CeedAtomicDecrement(vec->parent->numviewaccess);
+    return 0;
+  }
+
   if (!vec->RestoreArrayRead)
     // LCOV_EXCL_START
     return CeedError(vec->ceed, 1, "Backend does not support RestoreArrayRead");
@@ -423,7 +698,7 @@ int CeedVectorRestoreArrayRead(CeedVector vec, const CeedScalar **array) {
 
   ierr = vec->RestoreArrayRead(vec); CeedChk(ierr);
   *array = NULL;
-  vec->numreaders--;
+  CeedAtomicDecrement(vec->numreaders);
 
   return 0;
 }
@@ -446,8 +721,14 @@ int CeedVectorRestoreArrayRead(CeedVector vec, const CeedScalar **array) {
 int CeedVectorNorm(CeedVector vec, CeedNormType type, CeedScalar *norm) {
   int ierr;
 
+  // Known zero vector
+  if (CeedAtomicLoad(vec->iszero)) {
+    *norm = 0.;
+    return 0;
+  }
+
   // Backend impl for GPU, if added
-  if (vec->Norm) {
+  if (vec->Norm && !vec->parent) {
     ierr = vec->Norm(vec, type, norm); CeedChk(ierr);
     return 0;
   }
@@ -494,14 +775,20 @@ int CeedVectorReciprocal(CeedVector vec) {
   int ierr;
 
   // Check if vector data set
-  if (!vec->state)
+  uint64_t state;
+  ierr = CeedVectorGetState(vec, &state); CeedChk(ierr);
+  if (!state)
     // LCOV_EXCL_START
     return CeedError(vec->ceed, 1,
                      "CeedVector must have data set to take reciprocal");
   // LCOV_EXCL_STOP
 
+  // Known zero vector, reciprocal skips zero entries
+  if (CeedAtomicLoad(vec->iszero))
+    return 0;
+
   // Backend impl for GPU, if added
-  if (vec->Reciprocal) {
+  if (vec->Reciprocal && !vec->parent) {
     ierr = vec->Reciprocal(vec); CeedChk(ierr);
     return 0;
   }
@@ -570,27 +857,14 @@ int CeedVectorGetLength(CeedVector vec, CeedInt *length) {
   @ref User
 **/
 int CeedVectorDestroy(CeedVector *vec) {
-  int ierr;
+  if (!*vec) return 0;
 
-  if (!*vec || --(*vec)->refcount > 0) return 0;
+  // Views forward array access to this vector, which must outlive it
+  if (CeedAtomicLoad((*vec)->numviewaccess) > 0)
+    return CeedError((*vec)->ceed, 1, "Cannot destroy CeedVector, a view has "
+                     "array access");
 
-  if (((*vec)->state % 2) == 1)
-    return CeedError((*vec)->ceed, 1,
-                     "Cannot destroy CeedVector, the writable access "
-                     "lock is in use");
-
-  if ((*vec)->numreaders > 0)
-    return CeedError((*vec)->ceed, 1, "Cannot destroy CeedVector, a process has "
-                     "read access");
-
-  if ((*vec)->Destroy) {
-    ierr = (*vec)->Destroy(*vec); CeedChk(ierr);
-  }
-
-  ierr = CeedDestroy(&(*vec)->ceed); CeedChk(ierr);
-  ierr = CeedFree(vec); CeedChk(ierr);
-
-  return 0;
+  return CeedVectorRemoveReference(vec);
 }
 
 /// @}
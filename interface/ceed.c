@@ -119,6 +119,27 @@ int CeedRequestWait(CeedRequest *req) {
 /// @addtogroup CeedDeveloper
 /// @{
 
+/**
+  @brief Check whether a scratch vector is NULL or appears earlier in a list
+
+  @param numvecs Number of vectors
+  @param vecs    Vectors to back with scratch memory
+  @param i       Index of the vector to check
+
+  @return True if the vector does not need its own scratch slice
+
+  @ref Developer
+**/
+static bool CeedScratchIsRepeated(CeedInt numvecs, CeedVector *vecs,
+                                  CeedInt i) {
+  if (!vecs[i])
+    return true;
+  for (CeedInt j=0; j<i; j++)
+    if (vecs[j] == vecs[i])
+      return true;
+  return false;
+}
+
 /// @}
 
 /// ----------------------------------------------------------------------------
@@ -295,6 +316,24 @@ int CeedRegister(const char *prefix, int (*init)(const char *, Ceed),
   return 0;
 }
 
+/**
+  @brief Check if a Ceed backend is registered with an exact resource prefix
+
+  @param prefix             Prefix of resources for the backend
+  @param[out] isregistered  Variable to store registration status
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedIsRegistered(const char *prefix, bool *isregistered) {
+  *isregistered = false;
+  for (size_t i=0; i<num_backends; i++)
+    if (!strcmp(backends[i].prefix, prefix))
+      *isregistered = true;
+  return 0;
+}
+
 /**
   @brief Return debugging status flag
 
@@ -586,6 +625,314 @@ int CeedSetData(Ceed ceed, void *data) {
   return 0;
 }
 
+/**
+  @brief Check out a buffer from the scratch pool of a Ceed context
+
+  The pool is shared by all objects created from the same parent Ceed, so
+    operators that are not applied concurrently reuse the same memory. A
+    free buffer is grown to @a size bytes if needed; a new buffer is added
+    only when all buffers are checked out. Return the buffer with
+    @ref CeedRestoreScratch().
+
+  @param ceed   Ceed context owning the pool
+  @param size   Number of bytes needed
+  @param[out] p Address of pointer to hold the buffer, aligned at CEED_ALIGN
+                  bytes
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedGetScratch(Ceed ceed, size_t size, void *p) {
+  int ierr = 0, j = -1;
+  ierr = CeedGetParent(ceed, &ceed); CeedChk(ierr);
+  if (size < CEED_ALIGN)
+    size = CEED_ALIGN;
+
+  while (__sync_lock_test_and_set(&ceed->scratchlock, 1));
+  // Claim the largest free buffer, adding one if all are checked out
+  for (int i=0; i<ceed->numscratch; i++)
+    if (!ceed->scratch[i].inuse &&
+        (j < 0 || ceed->scratch[i].size > ceed->scratch[j].size))
+      j = i;
+  if (j < 0) {
+    ierr = CeedRealloc(ceed->numscratch + 1, &ceed->scratch);
+    if (!ierr) {
+      j = ceed->numscratch++;
+      ceed->scratch[j].array = NULL;
+      ceed->scratch[j].size = 0;
+      ceed->scratch[j].inuse = false;
+    }
+  }
+  // Grow to the largest demand seen so far
+  if (!ierr && ceed->scratch[j].size < size) {
+    ceed->scratch[j].size = 0;
+    ierr = CeedFree(&ceed->scratch[j].array);
+    if (!ierr)
+      ierr = CeedMallocArray(size, 1, &ceed->scratch[j].array);
+    if (!ierr)
+      ceed->scratch[j].size = size;
+  }
+  if (!ierr) {
+    ceed->scratch[j].inuse = true;
+    *(void **)p = ceed->scratch[j].array;
+  }
+  __sync_lock_release(&ceed->scratchlock);
+  CeedChk(ierr);
+
+  return 0;
+}
+
+/**
+  @brief Return a buffer checked out with @ref CeedGetScratch()
+
+  @param ceed Ceed context owning the pool
+  @param p    Address of pointer to the buffer, set to NULL
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedRestoreScratch(Ceed ceed, void *p) {
+  int ierr, i;
+  ierr = CeedGetParent(ceed, &ceed); CeedChk(ierr);
+
+  while (__sync_lock_test_and_set(&ceed->scratchlock, 1));
+  for (i=0; i<ceed->numscratch; i++)
+    if (ceed->scratch[i].inuse && ceed->scratch[i].array == *(void **)p) {
+      ceed->scratch[i].inuse = false;
+      break;
+    }
+  __sync_lock_release(&ceed->scratchlock);
+  if (i == ceed->numscratch)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "Buffer was not checked out from this Ceed");
+  // LCOV_EXCL_STOP
+
+  *(void **)p = NULL;
+  return 0;
+}
+
+/**
+  @brief Back a set of vectors with one buffer from the scratch pool
+
+  Each distinct vector in @a vecs is set with CEED_USE_POINTER to its own
+    slice of the buffer, aligned at CEED_ALIGN bytes.
+
+  @param ceed         Ceed context owning the pool
+  @param numvecs      Number of vectors
+  @param vecs         Vectors to back; NULL and repeated entries are skipped
+  @param[out] scratch Address of pointer to hold the buffer, to be returned
+                        with @ref CeedRestoreScratchVectors()
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedGetScratchVectors(Ceed ceed, CeedInt numvecs, CeedVector *vecs,
+                          void *scratch) {
+  int ierr;
+  const CeedInt pad = CEED_ALIGN / sizeof(CeedScalar);
+  size_t total = 0;
+  CeedScalar *array;
+
+  for (CeedInt i=0; i<numvecs; i++)
+    if (!CeedScratchIsRepeated(numvecs, vecs, i))
+      total += (vecs[i]->length + pad - 1) / pad * pad;
+  ierr = CeedGetScratch(ceed, total*sizeof(CeedScalar), &array); CeedChk(ierr);
+
+  *(CeedScalar **)scratch = array;
+  for (CeedInt i=0; i<numvecs; i++)
+    if (!CeedScratchIsRepeated(numvecs, vecs, i)) {
+      ierr = CeedVectorSetArray(vecs[i], CEED_MEM_HOST, CEED_USE_POINTER, array);
+      CeedChk(ierr);
+      array += (vecs[i]->length + pad - 1) / pad * pad;
+    }
+  return 0;
+}
+
+/**
+  @brief Detach a set of vectors from their scratch buffer and return it
+
+  Arrays the vectors were given after @ref CeedGetScratchVectors() are
+    released as well, so no vector keeps storage of its own.
+
+  @param ceed    Ceed context owning the pool
+  @param numvecs Number of vectors
+  @param vecs    Vectors passed to @ref CeedGetScratchVectors()
+  @param scratch Address of pointer to the buffer, set to NULL
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedRestoreScratchVectors(Ceed ceed, CeedInt numvecs, CeedVector *vecs,
+                              void *scratch) {
+  int ierr;
+
+  for (CeedInt i=0; i<numvecs; i++)
+    if (!CeedScratchIsRepeated(numvecs, vecs, i)) {
+      ierr = CeedVectorSetArray(vecs[i], CEED_MEM_HOST, CEED_USE_POINTER, NULL);
+      CeedChk(ierr);
+    }
+  ierr = CeedRestoreScratch(ceed, scratch); CeedChk(ierr);
+  return 0;
+}
+
+/**
+  @brief Get the E-vector of a passive operator input, shared with other
+           operators of the same parent Ceed that restrict the same L-vector
+           with the same restriction and block size
+
+  The E-vector is brought up to date with @ref CeedUpdateCachedEVector() and
+    released with @ref CeedRestoreCachedEVector(). It is destroyed once no
+    operator uses it.
+
+  @param ceed       Ceed context owning the cache
+  @param rstr       CeedElemRestriction of the operator field
+  @param blksize    Number of elements interlaced in the E-vector, 1 if not
+                      blocked
+  @param lvec       Passive L-vector of the operator field
+  @param blkrstr    Restriction producing the E-vector layout, such as a
+                      blocked version of @a rstr, or @a rstr itself
+  @param[out] evec  Address to save the shared E-vector to
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedGetCachedEVector(Ceed ceed, CeedElemRestriction rstr, CeedInt blksize,
+                         CeedVector lvec, CeedElemRestriction blkrstr,
+                         CeedVector *evec) {
+  int ierr = 0;
+  CeedEVectorCacheEntry *entry = NULL;
+  ierr = CeedGetParent(ceed, &ceed); CeedChk(ierr);
+
+  while (__sync_lock_test_and_set(&ceed->evcachelock, 1));
+  for (int i=0; i<ceed->numevcache && !entry; i++)
+    if (ceed->evcache[i]->rstr == rstr && ceed->evcache[i]->lvec == lvec &&
+        ceed->evcache[i]->blksize == blksize)
+      entry = ceed->evcache[i];
+  if (!entry) {
+    ierr = CeedCalloc(1, &entry);
+    if (!ierr)
+      ierr = CeedElemRestrictionCreateVector(blkrstr, NULL, &entry->evec);
+    if (!ierr)
+      ierr = CeedRealloc(ceed->numevcache + 1, &ceed->evcache);
+    if (!ierr) {
+      entry->rstr = rstr;
+      entry->lvec = lvec;
+      entry->blksize = blksize;
+      ceed->evcache[ceed->numevcache++] = entry;
+    }
+  }
+  if (!ierr) {
+    entry->numusers++;
+    *evec = entry->evec;
+  }
+  __sync_lock_release(&ceed->evcachelock);
+  CeedChk(ierr);
+
+  return 0;
+}
+
+/**
+  @brief Restrict the L-vector of a shared E-vector if it or the ghost input
+           vector of the restriction changed since the E-vector was last
+           restricted, by any of the operators sharing it
+
+  @param ceed     Ceed context owning the cache
+  @param blkrstr  Restriction producing the E-vector layout
+  @param lvec     Passive L-vector of the operator field
+  @param evec     E-vector from @ref CeedGetCachedEVector()
+  @param request  Request or @ref CEED_REQUEST_IMMEDIATE
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedUpdateCachedEVector(Ceed ceed, CeedElemRestriction blkrstr,
+                            CeedVector lvec, CeedVector evec,
+                            CeedRequest *request) {
+  int ierr;
+  CeedEVectorCacheEntry *entry = NULL;
+  uint64_t state, ghoststate = 0;
+  CeedVector ghostin;
+  ierr = CeedGetParent(ceed, &ceed); CeedChk(ierr);
+
+  while (__sync_lock_test_and_set(&ceed->evcachelock, 1));
+  for (int i=0; i<ceed->numevcache && !entry; i++)
+    if (ceed->evcache[i]->evec == evec)
+      entry = ceed->evcache[i];
+  __sync_lock_release(&ceed->evcachelock);
+  if (!entry)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "E-vector was not obtained from the cache");
+  // LCOV_EXCL_STOP
+
+  // Ghosted restrictions also read the ghost input vector
+  ierr = CeedVectorGetState(lvec, &state); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetGhostVectors(blkrstr, &ghostin, NULL);
+  CeedChk(ierr);
+  if (ghostin) {
+    ierr = CeedVectorGetState(ghostin, &ghoststate); CeedChk(ierr);
+  }
+
+  // Operators applied concurrently wait for the first to restrict
+  while (__sync_lock_test_and_set(&entry->lock, 1));
+  if (state != entry->state || ghostin != entry->ghostin ||
+      ghoststate != entry->ghoststate) {
+    ierr = CeedElemRestrictionApply(blkrstr, CEED_NOTRANSPOSE, lvec, evec,
+                                    request);
+    if (!ierr) {
+      entry->state = state;
+      entry->ghostin = ghostin;
+      entry->ghoststate = ghoststate;
+    }
+  }
+  __sync_lock_release(&entry->lock);
+  CeedChk(ierr);
+
+  return 0;
+}
+
+/**
+  @brief Release an E-vector obtained with @ref CeedGetCachedEVector()
+
+  @param ceed Ceed context owning the cache
+  @param evec E-vector to release, set to NULL
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Backend
+**/
+int CeedRestoreCachedEVector(Ceed ceed, CeedVector *evec) {
+  int ierr, i;
+  CeedEVectorCacheEntry *entry = NULL;
+  ierr = CeedGetParent(ceed, &ceed); CeedChk(ierr);
+
+  while (__sync_lock_test_and_set(&ceed->evcachelock, 1));
+  for (i=0; i<ceed->numevcache && !entry; i++)
+    if (ceed->evcache[i]->evec == *evec)
+      entry = ceed->evcache[i];
+  bool last = entry && --entry->numusers == 0;
+  if (last)
+    ceed->evcache[i-1] = ceed->evcache[--ceed->numevcache];
+  __sync_lock_release(&ceed->evcachelock);
+  if (!entry)
+    // LCOV_EXCL_START
+    return CeedError(ceed, 1, "E-vector was not obtained from the cache");
+  // LCOV_EXCL_STOP
+
+  // Last user
+  if (last) {
+    ierr = CeedVectorDestroy(&entry->evec); CeedChk(ierr);
+    ierr = CeedFree(&entry); CeedChk(ierr);
+  }
+  *evec = NULL;
+  return 0;
+}
+
 /// @}
 
 /// ----------------------------------------------------------------------------
@@ -666,6 +1013,7 @@ int CeedInit(const char *resource, Ceed *ceed) {
     CEED_FTABLE_ENTRY(CeedVector, SetValue),
     CEED_FTABLE_ENTRY(CeedVector, GetArray),
     CEED_FTABLE_ENTRY(CeedVector, GetArrayRead),
+    CEED_FTABLE_ENTRY(CeedVector, GetArrayWrite),
     CEED_FTABLE_ENTRY(CeedVector, RestoreArray),
     CEED_FTABLE_ENTRY(CeedVector, RestoreArrayRead),
     CEED_FTABLE_ENTRY(CeedVector, Norm),
@@ -697,7 +1045,10 @@ int CeedInit(const char *resource, Ceed *ceed) {
     CEED_FTABLE_ENTRY(CeedOperator, ApplyComposite),
     CEED_FTABLE_ENTRY(CeedOperator, ApplyAdd),
     CEED_FTABLE_ENTRY(CeedOperator, ApplyAddComposite),
+    CEED_FTABLE_ENTRY(CeedOperator, ApplyAddBatch),
+    CEED_FTABLE_ENTRY(CeedOperator, ApplyAddDot),
     CEED_FTABLE_ENTRY(CeedOperator, ApplyJacobian),
+    CEED_FTABLE_ENTRY(CeedOperator, Setup),
     CEED_FTABLE_ENTRY(CeedOperator, Destroy),
     {NULL, 0} // End of lookup table - used in SetBackendFunction loop
   };
@@ -821,7 +1172,7 @@ int CeedView(Ceed ceed, FILE *stream) {
 **/
 int CeedDestroy(Ceed *ceed) {
   int ierr;
-  if (!*ceed || --(*ceed)->refcount > 0) return 0;
+  if (!*ceed || CeedAtomicDecrement((*ceed)->refcount) > 0) return 0;
   if ((*ceed)->delegate) {
     ierr = CeedDestroy(&(*ceed)->delegate); CeedChk(ierr);
   }
@@ -838,6 +1189,15 @@ int CeedDestroy(Ceed *ceed) {
     ierr = (*ceed)->Destroy(*ceed); CeedChk(ierr);
   }
 
+  for (int i=0; i<(*ceed)->numscratch; i++) {
+    ierr = CeedFree(&(*ceed)->scratch[i].array); CeedChk(ierr);
+  }
+  ierr = CeedFree(&(*ceed)->scratch); CeedChk(ierr);
+  for (int i=0; i<(*ceed)->numevcache; i++) {
+    ierr = CeedVectorDestroy(&(*ceed)->evcache[i]->evec); CeedChk(ierr);
+    ierr = CeedFree(&(*ceed)->evcache[i]); CeedChk(ierr);
+  }
+  ierr = CeedFree(&(*ceed)->evcache); CeedChk(ierr);
   ierr = CeedFree(&(*ceed)->foffsets); CeedChk(ierr);
   ierr = CeedFree(&(*ceed)->resource); CeedChk(ierr);
   ierr = CeedDestroy(&(*ceed)->opfallbackceed); CeedChk(ierr);
@@ -0,0 +1,63 @@
+/// @file
+/// Test setting a vector to zero and overwriting it with write-only access
+/// \test Test setting a vector to zero and overwriting it with write-only access
+#include <ceed.h>
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedVector x;
+  CeedInt n;
+  CeedScalar a[10], *b, norm;
+  const CeedScalar *c;
+
+  CeedInit(argv[1], &ceed);
+
+  n = 10;
+  CeedVectorCreate(ceed, n, &x);
+  for (CeedInt i=0; i<n; i++)
+    a[i] = 10 + i;
+  CeedVectorSetArray(x, CEED_MEM_HOST, CEED_COPY_VALUES, a);
+
+  // Zero values are visible on read
+  CeedVectorSetValue(x, 0.0);
+  CeedVectorNorm(x, CEED_NORM_MAX, &norm);
+  if (norm != 0.0)
+    // LCOV_EXCL_START
+    printf("Error computing norm %f of zero vector", (double)norm);
+  // LCOV_EXCL_STOP
+  CeedVectorGetArrayRead(x, CEED_MEM_HOST, &c);
+  for (CeedInt i=0; i<n; i++)
+    if (c[i] != 0.0)
+      // LCOV_EXCL_START
+      printf("Error reading array c[%d] = %f", i, (double)c[i]);
+  // LCOV_EXCL_STOP
+  CeedVectorRestoreArrayRead(x, &c);
+
+  // Write-only access discards the zeros
+  CeedVectorSetValue(x, 0.0);
+  CeedVectorGetArrayWrite(x, CEED_MEM_HOST, &b);
+  for (CeedInt i=0; i<n; i++)
+    b[i] = 20 + i;
+  CeedVectorRestoreArray(x, &b);
+  CeedVectorGetArrayRead(x, CEED_MEM_HOST, &c);
+  for (CeedInt i=0; i<n; i++)
+    if (c[i] != 20+i)
+      // LCOV_EXCL_START
+      printf("Error reading array c[%d] = %f", i, (double)c[i]);
+  // LCOV_EXCL_STOP
+  CeedVectorRestoreArrayRead(x, &c);
+
+  // Zero values are written to a user array without deferral
+  CeedVectorSetArray(x, CEED_MEM_HOST, CEED_USE_POINTER, a);
+  CeedVectorSetValue(x, 0.0);
+  CeedVectorSyncArray(x, CEED_MEM_HOST);
+  for (CeedInt i=0; i<n; i++)
+    if (a[i] != 0.0)
+      // LCOV_EXCL_START
+      printf("Error reading array a[%d] = %f", i, (double)a[i]);
+  // LCOV_EXCL_STOP
+
+  CeedVectorDestroy(&x);
+  CeedDestroy(&ceed);
+  return 0;
+}
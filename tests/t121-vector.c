@@ -0,0 +1,75 @@
+/// @file
+/// Test creation, use, and destruction of a vector view
+/// \test Test creation, use, and destruction of a vector view
+#include <ceed.h>
+#include <math.h>
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedVector x, y, z;
+  CeedInt n = 10, offset = 3, m = 5;
+  CeedScalar a[10], *b, norm;
+  const CeedScalar *c;
+
+  CeedInit(argv[1], &ceed);
+
+  CeedVectorCreate(ceed, n, &x);
+  for (CeedInt i=0; i<n; i++)
+    a[i] = 10 + i;
+  CeedVectorSetArray(x, CEED_MEM_HOST, CEED_COPY_VALUES, a);
+  CeedVectorCreateView(x, offset, m, &y);
+  // View of a view aliases the original vector
+  CeedVectorCreateView(y, 1, 2, &z);
+
+  // Read through view
+  CeedVectorGetArrayRead(y, CEED_MEM_HOST, &c);
+  for (CeedInt i=0; i<m; i++)
+    if (c[i] != 10 + offset + i)
+      // LCOV_EXCL_START
+      printf("Error reading view c[%d] = %f", i, (double)c[i]);
+  // LCOV_EXCL_STOP
+  CeedVectorRestoreArrayRead(y, &c);
+
+  // Write through view
+  CeedVectorGetArray(y, CEED_MEM_HOST, &b);
+  for (CeedInt i=0; i<m; i++)
+    b[i] = -1 - i;
+  CeedVectorRestoreArray(y, &b);
+  CeedVectorSetValue(z, 100.0);
+
+  CeedVectorGetArrayRead(x, CEED_MEM_HOST, &c);
+  for (CeedInt i=0; i<n; i++) {
+    CeedScalar expected = 10 + i;
+    if (i >= offset && i < offset + m)
+      expected = -1 - (i - offset);
+    if (i >= offset + 1 && i < offset + 3)
+      expected = 100.0;
+    if (c[i] != expected)
+      // LCOV_EXCL_START
+      printf("Error reading parent c[%d] = %f != %f", i, (double)c[i],
+             (double)expected);
+    // LCOV_EXCL_STOP
+  }
+  CeedVectorRestoreArrayRead(x, &c);
+
+  // Norm of the view range only
+  CeedVectorNorm(y, CEED_NORM_1, &norm);
+  if (fabs(norm - 210.) > 1e-14)
+    // LCOV_EXCL_START
+    printf("Error computing view norm %f", (double)norm);
+  // LCOV_EXCL_STOP
+
+  // Views keep the parent alive
+  CeedVectorDestroy(&x);
+  CeedVectorDestroy(&z);
+  CeedVectorGetArrayRead(y, CEED_MEM_HOST, &c);
+  if (c[0] != -1)
+    // LCOV_EXCL_START
+    printf("Error reading view after parent destroy c[0] = %f", (double)c[0]);
+  // LCOV_EXCL_STOP
+  CeedVectorRestoreArrayRead(y, &c);
+
+  CeedVectorDestroy(&y);
+  CeedDestroy(&ceed);
+  return 0;
+}
@@ -0,0 +1,27 @@
+/// @file
+/// Test CeedVectorDestroy of a vector with a view holding array access
+/// \test Test CeedVectorDestroy of a vector with a view holding array access
+#include <ceed.h>
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedVector x, y;
+  CeedInt n;
+  CeedScalar *a;
+
+  CeedInit(argv[1], &ceed);
+
+  n = 10;
+  CeedVectorCreate(ceed, n, &x);
+  CeedVectorSetValue(x, 0.0);
+  CeedVectorCreateView(x, 2, 5, &y);
+  CeedVectorGetArray(y, CEED_MEM_HOST, &a);
+
+  // Write access through the view not restored should generate an error
+  CeedVectorDestroy(&x);
+
+  // LCOV_EXCL_START
+  CeedDestroy(&ceed);
+  return 0;
+  // LCOV_EXCL_STOP
+}
@@ -0,0 +1,69 @@
+/// @file
+/// Test element restriction transpose into a vector set to zero
+/// \test Test element restriction transpose into a vector set to zero
+#include <ceed.h>
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedVector x, y;
+  CeedInt ne = 5, blksize = 2;
+  CeedInt ind[2*ne];
+  CeedScalar a[2*ne];
+  const CeedScalar *xx;
+  CeedElemRestriction r, rblk;
+
+  CeedInit(argv[1], &ceed);
+
+  // Last node receives no contributions
+  CeedVectorCreate(ceed, ne+2, &x);
+  CeedVectorCreate(ceed, 2*ne, &y);
+  for (CeedInt i=0; i<2*ne; i++)
+    a[i] = 1;
+  CeedVectorSetArray(y, CEED_MEM_HOST, CEED_USE_POINTER, a);
+
+  for (CeedInt i=0; i<ne; i++) {
+    ind[2*i+0] = i;
+    ind[2*i+1] = i+1;
+  }
+  CeedElemRestrictionCreate(ceed, ne, 2, 1, 1, ne+2, CEED_MEM_HOST,
+                            CEED_USE_POINTER, ind, &r);
+  CeedElemRestrictionCreateBlocked(ceed, ne, 2, blksize, 1, 1, ne+2,
+                                   CEED_MEM_HOST, CEED_USE_POINTER, ind, &rblk);
+
+  // Repeated applications into a vector set to non-zero, then zero, values
+  for (CeedInt rep=0; rep<2; rep++) {
+    CeedVectorSetValue(x, 42.0);
+    CeedVectorSetValue(x, 0.0);
+    CeedElemRestrictionApply(r, CEED_TRANSPOSE, y, x, CEED_REQUEST_IMMEDIATE);
+
+    CeedVectorGetArrayRead(x, CEED_MEM_HOST, &xx);
+    for (CeedInt i=0; i<ne+2; i++)
+      if (xx[i] != (i == 0 || i == ne ? 1.0 : (i == ne+1 ? 0.0 : 2.0)))
+        // LCOV_EXCL_START
+        printf("Error in restricted array x[%d] = %f", i, (double)xx[i]);
+    // LCOV_EXCL_STOP
+    CeedVectorRestoreArrayRead(x, &xx);
+  }
+
+  // Blocked restriction, padded element
+  CeedVectorDestroy(&y);
+  CeedElemRestrictionCreateVector(rblk, NULL, &y);
+  CeedVectorSetValue(y, 1.0);
+  CeedVectorSetValue(x, 0.0);
+  CeedElemRestrictionApply(rblk, CEED_TRANSPOSE, y, x, CEED_REQUEST_IMMEDIATE);
+
+  CeedVectorGetArrayRead(x, CEED_MEM_HOST, &xx);
+  for (CeedInt i=0; i<ne+2; i++)
+    if (xx[i] != (i == 0 || i == ne ? 1.0 : (i == ne+1 ? 0.0 : 2.0)))
+      // LCOV_EXCL_START
+      printf("Error in blocked restricted array x[%d] = %f", i, (double)xx[i]);
+  // LCOV_EXCL_STOP
+  CeedVectorRestoreArrayRead(x, &xx);
+
+  CeedVectorDestroy(&x);
+  CeedVectorDestroy(&y);
+  CeedElemRestrictionDestroy(&r);
+  CeedElemRestrictionDestroy(&rblk);
+  CeedDestroy(&ceed);
+  return 0;
+}
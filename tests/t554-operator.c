@@ -0,0 +1,145 @@
+/// @file
+/// Test batched application of mass matrix operator with per-member coefficient
+/// \test Test batched application of mass matrix operator with per-member coefficient
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "t554-operator.h"
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedElemRestriction Erestrictx, Erestrictu, Erestrictui;
+  CeedBasis bx, bu;
+  CeedQFunction qf_setup, qf_mass;
+  CeedOperator op_setup, op_mass, op_mass_single;
+  CeedVector qdata, X, U, V, C, Usingle, Vsingle, Csingle;
+  const CeedScalar *hv, *hvsingle;
+  CeedInt nelem = 15, P = 5, Q = 8, nbatch = 3;
+  CeedInt Nx = nelem+1, Nu = nelem*(P-1)+1;
+  CeedInt indx[nelem*2], indu[nelem*P];
+  CeedScalar x[Nx], u[nbatch*Nu], c[nbatch*Nu];
+
+  CeedInit(argv[1], &ceed);
+
+  for (CeedInt i=0; i<Nx; i++)
+    x[i] = (CeedScalar) i / (Nx - 1);
+  for (CeedInt i=0; i<nelem; i++) {
+    indx[2*i+0] = i;
+    indx[2*i+1] = i+1;
+  }
+  CeedElemRestrictionCreate(ceed, nelem, 2, 1, 1, Nx, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indx, &Erestrictx);
+
+  for (CeedInt i=0; i<nelem; i++) {
+    for (CeedInt j=0; j<P; j++) {
+      indu[P*i+j] = i*(P-1) + j;
+    }
+  }
+  CeedElemRestrictionCreate(ceed, nelem, P, 1, 1, Nu, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indu, &Erestrictu);
+  CeedInt stridesu[3] = {1, Q, Q};
+  CeedElemRestrictionCreateStrided(ceed, nelem, Q, 1, Q*nelem, stridesu,
+                                   &Erestrictui);
+
+  CeedBasisCreateTensorH1Lagrange(ceed, 1, 1, 2, Q, CEED_GAUSS, &bx);
+  CeedBasisCreateTensorH1Lagrange(ceed, 1, 1, P, Q, CEED_GAUSS, &bu);
+
+  CeedQFunctionCreateInterior(ceed, 1, setup, setup_loc, &qf_setup);
+  CeedQFunctionAddInput(qf_setup, "_weight", 1, CEED_EVAL_WEIGHT);
+  CeedQFunctionAddInput(qf_setup, "dx", 1, CEED_EVAL_GRAD);
+  CeedQFunctionAddOutput(qf_setup, "rho", 1, CEED_EVAL_NONE);
+
+  CeedQFunctionCreateInterior(ceed, 1, mass, mass_loc, &qf_mass);
+  CeedQFunctionAddInput(qf_mass, "rho", 1, CEED_EVAL_NONE);
+  CeedQFunctionAddInput(qf_mass, "c", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddInput(qf_mass, "u", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddOutput(qf_mass, "v", 1, CEED_EVAL_INTERP);
+
+  CeedOperatorCreate(ceed, qf_setup, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_setup);
+  CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_mass);
+  CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_mass_single);
+
+  CeedVectorCreate(ceed, Nx, &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+  CeedVectorCreate(ceed, nelem*Q, &qdata);
+
+  // Batched coefficient and input, one L-vector per member
+  for (CeedInt b=0; b<nbatch; b++)
+    for (CeedInt i=0; i<Nu; i++) {
+      c[b*Nu+i] = 1.0 + b + sin((CeedScalar) i);
+      u[b*Nu+i] = (b + 1) * cos(0.5*i);
+    }
+  CeedVectorCreate(ceed, nbatch*Nu, &C);
+  CeedVectorSetArray(C, CEED_MEM_HOST, CEED_USE_POINTER, c);
+  CeedVectorCreate(ceed, nbatch*Nu, &U);
+  CeedVectorSetArray(U, CEED_MEM_HOST, CEED_USE_POINTER, u);
+  CeedVectorCreate(ceed, nbatch*Nu, &V);
+  CeedVectorCreate(ceed, Nu, &Csingle);
+  CeedVectorCreate(ceed, Nu, &Usingle);
+  CeedVectorCreate(ceed, Nu, &Vsingle);
+
+  CeedOperatorSetField(op_setup, "_weight", CEED_ELEMRESTRICTION_NONE, bx,
+                       CEED_VECTOR_NONE);
+  CeedOperatorSetField(op_setup, "dx", Erestrictx, bx, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_setup, "rho", Erestrictui, CEED_BASIS_COLLOCATED,
+                       CEED_VECTOR_ACTIVE);
+
+  CeedOperatorSetField(op_mass, "rho", Erestrictui, CEED_BASIS_COLLOCATED,
+                       qdata);
+  CeedOperatorSetField(op_mass, "c", Erestrictu, bu, C);
+  CeedOperatorSetField(op_mass, "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_mass, "v", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+
+  CeedOperatorSetField(op_mass_single, "rho", Erestrictui,
+                       CEED_BASIS_COLLOCATED, qdata);
+  CeedOperatorSetField(op_mass_single, "c", Erestrictu, bu, Csingle);
+  CeedOperatorSetField(op_mass_single, "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_mass_single, "v", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+
+  CeedOperatorApply(op_setup, X, qdata, CEED_REQUEST_IMMEDIATE);
+
+  // Batched apply
+  CeedOperatorApplyBatch(op_mass, nbatch, U, V, CEED_REQUEST_IMMEDIATE);
+
+  // Check against one member at a time
+  CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+  for (CeedInt b=0; b<nbatch; b++) {
+    CeedVectorSetArray(Csingle, CEED_MEM_HOST, CEED_COPY_VALUES, &c[b*Nu]);
+    CeedVectorSetArray(Usingle, CEED_MEM_HOST, CEED_COPY_VALUES, &u[b*Nu]);
+    CeedOperatorApply(op_mass_single, Usingle, Vsingle, CEED_REQUEST_IMMEDIATE);
+
+    CeedVectorGetArrayRead(Vsingle, CEED_MEM_HOST, &hvsingle);
+    for (CeedInt i=0; i<Nu; i++)
+      if (fabs(hv[b*Nu+i] - hvsingle[i]) > 1e-13)
+        // LCOV_EXCL_START
+        printf("[%d, %d] v %g != %g\n", b, i, hv[b*Nu+i], hvsingle[i]);
+    // LCOV_EXCL_STOP
+    CeedVectorRestoreArrayRead(Vsingle, &hvsingle);
+  }
+  CeedVectorRestoreArrayRead(V, &hv);
+
+  CeedQFunctionDestroy(&qf_setup);
+  CeedQFunctionDestroy(&qf_mass);
+  CeedOperatorDestroy(&op_setup);
+  CeedOperatorDestroy(&op_mass);
+  CeedOperatorDestroy(&op_mass_single);
+  CeedElemRestrictionDestroy(&Erestrictu);
+  CeedElemRestrictionDestroy(&Erestrictx);
+  CeedElemRestrictionDestroy(&Erestrictui);
+  CeedBasisDestroy(&bu);
+  CeedBasisDestroy(&bx);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedVectorDestroy(&C);
+  CeedVectorDestroy(&Usingle);
+  CeedVectorDestroy(&Vsingle);
+  CeedVectorDestroy(&Csingle);
+  CeedVectorDestroy(&qdata);
+  CeedDestroy(&ceed);
+  return 0;
+}
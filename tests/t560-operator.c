@@ -0,0 +1,131 @@
+/// @file
+/// Test FDM element inverse of a vector mass operator on elements of different sizes
+/// \test Test FDM element inverse of a vector mass operator on elements of different sizes
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+#include "t560-operator.h"
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedElemRestriction Erestrictxi, Erestrictui, Erestrictqi;
+  CeedBasis bx, bu;
+  CeedQFunction qf_setup_mass, qf_apply;
+  CeedOperator op_setup_mass, op_apply, op_inv;
+  CeedVector qdata_mass, X, U, V;
+  CeedInt nelem = 10, P = 4, Q = 5, dim = 2, ncomp = 2;
+  CeedInt ndofs = nelem*ncomp*P*P, nqpts = nelem*Q*Q;
+  CeedScalar x[dim*nelem*(2*2)];
+  const CeedScalar *u;
+
+  CeedInit(argv[1], &ceed);
+
+  // DoF Coordinates, each element scaled differently
+  for (CeedInt e=0; e<nelem; e++)
+    for (CeedInt i=0; i<2; i++)
+      for (CeedInt j=0; j<2; j++) {
+        x[i+j*2+0*4+e*dim*4] = e + i*(1. + e/4.);
+        x[i+j*2+1*4+e*dim*4] = j*(1. + e/2.);
+      }
+  CeedVectorCreate(ceed, dim*nelem*(2*2), &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+
+  // Qdata Vector
+  CeedVectorCreate(ceed, nqpts, &qdata_mass);
+
+  // Element Setup
+
+  // Restrictions
+  CeedInt stridesx[3] = {1, 2*2, 2*2*dim};
+  CeedElemRestrictionCreateStrided(ceed, nelem, 2*2, dim, dim*nelem*2*2,
+                                   stridesx, &Erestrictxi);
+
+  CeedInt stridesu[3] = {1, P*P, ncomp*P*P};
+  CeedElemRestrictionCreateStrided(ceed, nelem, P*P, ncomp, ndofs, stridesu,
+                                   &Erestrictui);
+
+  CeedInt stridesq[3] = {1, Q*Q, Q*Q};
+  CeedElemRestrictionCreateStrided(ceed, nelem, Q*Q, 1, nqpts, stridesq,
+                                   &Erestrictqi);
+
+  // Bases
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, dim, 2, Q, CEED_GAUSS, &bx);
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, ncomp, P, Q, CEED_GAUSS, &bu);
+
+  // QFunction - setup mass
+  CeedQFunctionCreateInterior(ceed, 1, setup_mass, setup_mass_loc,
+                              &qf_setup_mass);
+  CeedQFunctionAddInput(qf_setup_mass, "dx", dim*dim, CEED_EVAL_GRAD);
+  CeedQFunctionAddInput(qf_setup_mass, "_weight", 1, CEED_EVAL_WEIGHT);
+  CeedQFunctionAddOutput(qf_setup_mass, "qdata", 1, CEED_EVAL_NONE);
+
+  // Operator - setup mass
+  CeedOperatorCreate(ceed, qf_setup_mass, CEED_QFUNCTION_NONE,
+                     CEED_QFUNCTION_NONE, &op_setup_mass);
+  CeedOperatorSetField(op_setup_mass, "dx", Erestrictxi, bx,
+                       CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_setup_mass, "_weight", CEED_ELEMRESTRICTION_NONE, bx,
+                       CEED_VECTOR_NONE);
+  CeedOperatorSetField(op_setup_mass, "qdata", Erestrictqi,
+                       CEED_BASIS_COLLOCATED, CEED_VECTOR_ACTIVE);
+
+  // Apply Setup Operator
+  CeedOperatorApply(op_setup_mass, X, qdata_mass, CEED_REQUEST_IMMEDIATE);
+
+  // QFunction - apply
+  CeedQFunctionCreateInterior(ceed, 1, apply, apply_loc, &qf_apply);
+  CeedQFunctionAddInput(qf_apply, "u", ncomp, CEED_EVAL_INTERP);
+  CeedQFunctionAddInput(qf_apply, "qdata_mass", 1, CEED_EVAL_NONE);
+  CeedQFunctionAddOutput(qf_apply, "v", ncomp, CEED_EVAL_INTERP);
+
+  // Operator - apply
+  CeedOperatorCreate(ceed, qf_apply, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_apply);
+  CeedOperatorSetField(op_apply, "u", Erestrictui, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_apply, "qdata_mass", Erestrictqi,
+                       CEED_BASIS_COLLOCATED, qdata_mass);
+  CeedOperatorSetField(op_apply, "v", Erestrictui, bu, CEED_VECTOR_ACTIVE);
+
+  // Apply original operator
+  CeedVectorCreate(ceed, ndofs, &U);
+  CeedVectorSetValue(U, 1.0);
+  CeedVectorCreate(ceed, ndofs, &V);
+  CeedVectorSetValue(V, 0.0);
+  CeedOperatorApply(op_apply, U, V, CEED_REQUEST_IMMEDIATE);
+
+  // Create FDM element inverse
+  CeedOperatorCreateFDMElementInverse(op_apply, &op_inv, CEED_REQUEST_IMMEDIATE);
+
+  // Apply FDM element inverse twice, reusing its setup
+  for (CeedInt k=0; k<2; k++) {
+    CeedVectorSetValue(U, 0.0);
+    CeedOperatorApply(op_inv, V, U, CEED_REQUEST_IMMEDIATE);
+
+    // Check output
+    CeedVectorGetArrayRead(U, CEED_MEM_HOST, &u);
+    for (int i=0; i<ndofs; i++)
+      if (fabs(u[i] - 1.0) > 1e-13)
+        // LCOV_EXCL_START
+        printf("[%d] Error in inverse: %e - 1.0 = %e\n", i, u[i], u[i] - 1.);
+    // LCOV_EXCL_STOP
+    CeedVectorRestoreArrayRead(U, &u);
+  }
+
+  // Cleanup
+  CeedQFunctionDestroy(&qf_setup_mass);
+  CeedQFunctionDestroy(&qf_apply);
+  CeedOperatorDestroy(&op_setup_mass);
+  CeedOperatorDestroy(&op_apply);
+  CeedOperatorDestroy(&op_inv);
+  CeedElemRestrictionDestroy(&Erestrictui);
+  CeedElemRestrictionDestroy(&Erestrictxi);
+  CeedElemRestrictionDestroy(&Erestrictqi);
+  CeedBasisDestroy(&bu);
+  CeedBasisDestroy(&bx);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&qdata_mass);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedDestroy(&ceed);
+  return 0;
+}
@@ -0,0 +1,232 @@
+/// @file
+/// Test element restriction and mass operator gathering from owned and ghost storage
+/// \test Test element restriction and mass operator gathering from owned and ghost storage
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "t502-operator.h"
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedElemRestriction Erestrictx, Erestrictui, Erestrictu, ErestrictuGhost;
+  CeedBasis bx, bu;
+  CeedQFunction qf_setup, qf_mass;
+  CeedOperator op_setup, op_mass, op_massGhost, op_massPassive;
+  CeedVector qdata, X, U, Uown, Ughostin, V, Vown, Vghostout, W, E;
+  const CeedScalar *hv, *hvown, *hvghost, *hw;
+  CeedScalar *hu;
+  CeedInt nelem = 15, P = 5, Q = 8, ncomp = 2;
+  CeedInt Nx = nelem+1, Nu = nelem*(P-1)+1, Nown = 40, Nghost = Nu - Nown;
+  CeedInt indx[nelem*2], indu[nelem*P], induGhost[nelem*P];
+  CeedScalar x[Nx], u[ncomp*Nu], uown[ncomp*Nown], ughost[ncomp*Nghost];
+
+  CeedInit(argv[1], &ceed);
+
+  for (CeedInt i=0; i<Nx; i++)
+    x[i] = (CeedScalar) i / (Nx - 1);
+  for (CeedInt i=0; i<nelem; i++) {
+    indx[2*i+0] = i;
+    indx[2*i+1] = i+1;
+  }
+  CeedElemRestrictionCreate(ceed, nelem, 2, 1, 1, Nx, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indx, &Erestrictx);
+
+  // Contiguous restriction and owned plus ghost restriction, ghost nodes are
+  //   stored in reverse order
+  for (CeedInt i=0; i<nelem; i++)
+    for (CeedInt j=0; j<P; j++) {
+      CeedInt node = i*(P-1) + j;
+      indu[P*i+j] = ncomp*node;
+      induGhost[P*i+j] = node < Nown ? ncomp*node :
+                         ncomp*Nown + ncomp*(Nu-1-node);
+    }
+  CeedElemRestrictionCreate(ceed, nelem, P, ncomp, 1, ncomp*Nu, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indu, &Erestrictu);
+  CeedElemRestrictionCreateGhosted(ceed, nelem, P, ncomp, 1, ncomp*Nown,
+                                   ncomp*Nghost, CEED_MEM_HOST,
+                                   CEED_USE_POINTER, induGhost,
+                                   &ErestrictuGhost);
+  CeedInt stridesu[3] = {1, Q, Q};
+  CeedElemRestrictionCreateStrided(ceed, nelem, Q, 1, Q*nelem, stridesu,
+                                   &Erestrictui);
+
+  // Vectors
+  for (CeedInt i=0; i<Nu; i++)
+    for (CeedInt k=0; k<ncomp; k++) {
+      u[ncomp*i+k] = 1.0 + i + 0.5*k;
+      if (i < Nown)
+        uown[ncomp*i+k] = u[ncomp*i+k];
+      else
+        ughost[ncomp*(Nu-1-i)+k] = u[ncomp*i+k];
+    }
+  CeedVectorCreate(ceed, ncomp*Nu, &U);
+  CeedVectorSetArray(U, CEED_MEM_HOST, CEED_USE_POINTER, u);
+  CeedVectorCreate(ceed, ncomp*Nown, &Uown);
+  CeedVectorSetArray(Uown, CEED_MEM_HOST, CEED_USE_POINTER, uown);
+  CeedVectorCreate(ceed, ncomp*Nghost, &Ughostin);
+  CeedVectorSetArray(Ughostin, CEED_MEM_HOST, CEED_USE_POINTER, ughost);
+  CeedVectorCreate(ceed, ncomp*Nu, &V);
+  CeedVectorCreate(ceed, ncomp*Nown, &Vown);
+  CeedVectorCreate(ceed, ncomp*Nghost, &Vghostout);
+  CeedElemRestrictionSetGhostVectors(ErestrictuGhost, Ughostin, Vghostout);
+
+  // Restriction and transpose
+  CeedElemRestrictionCreateVector(Erestrictu, NULL, &E);
+  CeedElemRestrictionApply(Erestrictu, CEED_NOTRANSPOSE, U, E,
+                           CEED_REQUEST_IMMEDIATE);
+  CeedVectorSetValue(V, 0.0);
+  CeedElemRestrictionApply(Erestrictu, CEED_TRANSPOSE, E, V,
+                           CEED_REQUEST_IMMEDIATE);
+  CeedElemRestrictionApply(ErestrictuGhost, CEED_NOTRANSPOSE, Uown, E,
+                           CEED_REQUEST_IMMEDIATE);
+  CeedVectorSetValue(Vown, 0.0);
+  CeedVectorSetValue(Vghostout, 0.0);
+  CeedElemRestrictionApply(ErestrictuGhost, CEED_TRANSPOSE, E, Vown,
+                           CEED_REQUEST_IMMEDIATE);
+
+  CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+  CeedVectorGetArrayRead(Vown, CEED_MEM_HOST, &hvown);
+  CeedVectorGetArrayRead(Vghostout, CEED_MEM_HOST, &hvghost);
+  for (CeedInt i=0; i<Nu; i++)
+    for (CeedInt k=0; k<ncomp; k++) {
+      CeedScalar val = i < Nown ? hvown[ncomp*i+k] :
+                       hvghost[ncomp*(Nu-1-i)+k];
+      if (fabs(hv[ncomp*i+k] - val) > 1e-14)
+        // LCOV_EXCL_START
+        printf("Restriction transpose [%d, %d] %f != %f\n", i, k, val,
+               hv[ncomp*i+k]);
+      // LCOV_EXCL_STOP
+    }
+  CeedVectorRestoreArrayRead(V, &hv);
+  CeedVectorRestoreArrayRead(Vown, &hvown);
+  CeedVectorRestoreArrayRead(Vghostout, &hvghost);
+
+  // Bases
+  CeedBasisCreateTensorH1Lagrange(ceed, 1, 1, 2, Q, CEED_GAUSS, &bx);
+  CeedBasisCreateTensorH1Lagrange(ceed, 1, ncomp, P, Q, CEED_GAUSS, &bu);
+
+  // QFunctions
+  CeedQFunctionCreateInterior(ceed, 1, setup, setup_loc, &qf_setup);
+  CeedQFunctionAddInput(qf_setup, "weights", 1, CEED_EVAL_WEIGHT);
+  CeedQFunctionAddInput(qf_setup, "dx", 1*1, CEED_EVAL_GRAD);
+  CeedQFunctionAddOutput(qf_setup, "qdata", 1, CEED_EVAL_NONE);
+
+  CeedQFunctionCreateInterior(ceed, 1, mass, mass_loc, &qf_mass);
+  CeedQFunctionAddInput(qf_mass, "qdata", 1, CEED_EVAL_NONE);
+  CeedQFunctionAddInput(qf_mass, "u", ncomp, CEED_EVAL_INTERP);
+  CeedQFunctionAddOutput(qf_mass, "v", ncomp, CEED_EVAL_INTERP);
+
+  // Operators
+  CeedOperatorCreate(ceed, qf_setup, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_setup);
+  CeedOperatorSetField(op_setup, "weights", CEED_ELEMRESTRICTION_NONE, bx,
+                       CEED_VECTOR_NONE);
+  CeedOperatorSetField(op_setup, "dx", Erestrictx, bx, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_setup, "qdata", Erestrictui, CEED_BASIS_COLLOCATED,
+                       CEED_VECTOR_ACTIVE);
+
+  CeedVectorCreate(ceed, Nx, &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+  CeedVectorCreate(ceed, nelem*Q, &qdata);
+  CeedOperatorApply(op_setup, X, qdata, CEED_REQUEST_IMMEDIATE);
+
+  CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_mass);
+  CeedOperatorSetField(op_mass, "qdata", Erestrictui, CEED_BASIS_COLLOCATED,
+                       qdata);
+  CeedOperatorSetField(op_mass, "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_mass, "v", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+
+  CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_massGhost);
+  CeedOperatorSetField(op_massGhost, "qdata", Erestrictui,
+                       CEED_BASIS_COLLOCATED, qdata);
+  CeedOperatorSetField(op_massGhost, "u", ErestrictuGhost, bu,
+                       CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_massGhost, "v", ErestrictuGhost, bu,
+                       CEED_VECTOR_ACTIVE);
+
+  // Apply, the ghost output is summed into and applied twice
+  CeedOperatorApply(op_mass, U, V, CEED_REQUEST_IMMEDIATE);
+  CeedVectorSetValue(Vghostout, 0.0);
+  for (CeedInt i=0; i<2; i++)
+    CeedOperatorApply(op_massGhost, Uown, Vown, CEED_REQUEST_IMMEDIATE);
+
+  CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+  CeedVectorGetArrayRead(Vown, CEED_MEM_HOST, &hvown);
+  CeedVectorGetArrayRead(Vghostout, CEED_MEM_HOST, &hvghost);
+  for (CeedInt i=0; i<Nu; i++)
+    for (CeedInt k=0; k<ncomp; k++) {
+      CeedScalar val = i < Nown ? hvown[ncomp*i+k] :
+                       0.5*hvghost[ncomp*(Nu-1-i)+k];
+      if (fabs(hv[ncomp*i+k] - val) > 1e-14)
+        // LCOV_EXCL_START
+        printf("Operator [%d, %d] %f != %f\n", i, k, val, hv[ncomp*i+k]);
+      // LCOV_EXCL_STOP
+    }
+  CeedVectorRestoreArrayRead(V, &hv);
+  CeedVectorRestoreArrayRead(Vown, &hvown);
+  CeedVectorRestoreArrayRead(Vghostout, &hvghost);
+
+  // Ghosted passive input, the ghost values change between applications
+  CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_massPassive);
+  CeedOperatorSetField(op_massPassive, "qdata", Erestrictui,
+                       CEED_BASIS_COLLOCATED, qdata);
+  CeedOperatorSetField(op_massPassive, "u", ErestrictuGhost, bu, Uown);
+  CeedOperatorSetField(op_massPassive, "v", Erestrictu, bu,
+                       CEED_VECTOR_ACTIVE);
+  CeedVectorCreate(ceed, ncomp*Nu, &W);
+  for (CeedInt r=0; r<2; r++) {
+    if (r) {
+      CeedVectorGetArray(Ughostin, CEED_MEM_HOST, &hu);
+      for (CeedInt i=0; i<ncomp*Nghost; i++)
+        hu[i] *= 2.0;
+      CeedVectorRestoreArray(Ughostin, &hu);
+      CeedVectorGetArray(U, CEED_MEM_HOST, &hu);
+      for (CeedInt i=ncomp*Nown; i<ncomp*Nu; i++)
+        hu[i] *= 2.0;
+      CeedVectorRestoreArray(U, &hu);
+    }
+    CeedOperatorApply(op_mass, U, V, CEED_REQUEST_IMMEDIATE);
+    CeedOperatorApply(op_massPassive, CEED_VECTOR_NONE, W,
+                      CEED_REQUEST_IMMEDIATE);
+
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+    CeedVectorGetArrayRead(W, CEED_MEM_HOST, &hw);
+    for (CeedInt i=0; i<ncomp*Nu; i++)
+      if (fabs(hv[i] - hw[i]) > 1e-14)
+        // LCOV_EXCL_START
+        printf("Passive ghost input [%d] %f != %f\n", i, hw[i], hv[i]);
+    // LCOV_EXCL_STOP
+    CeedVectorRestoreArrayRead(V, &hv);
+    CeedVectorRestoreArrayRead(W, &hw);
+  }
+
+  // Cleanup
+  CeedQFunctionDestroy(&qf_setup);
+  CeedQFunctionDestroy(&qf_mass);
+  CeedOperatorDestroy(&op_setup);
+  CeedOperatorDestroy(&op_mass);
+  CeedOperatorDestroy(&op_massGhost);
+  CeedOperatorDestroy(&op_massPassive);
+  CeedElemRestrictionDestroy(&Erestrictx);
+  CeedElemRestrictionDestroy(&Erestrictui);
+  CeedElemRestrictionDestroy(&Erestrictu);
+  CeedElemRestrictionDestroy(&ErestrictuGhost);
+  CeedBasisDestroy(&bx);
+  CeedBasisDestroy(&bu);
+  CeedVectorDestroy(&qdata);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&Uown);
+  CeedVectorDestroy(&Ughostin);
+  CeedVectorDestroy(&V);
+  CeedVectorDestroy(&Vown);
+  CeedVectorDestroy(&Vghostout);
+  CeedVectorDestroy(&W);
+  CeedVectorDestroy(&E);
+  CeedDestroy(&ceed);
+  return 0;
+}
@@ -0,0 +1,178 @@
+/// @file
+/// Test gallery mass and Poisson operators in 3D against the unfused application
+/// \test Test gallery mass and Poisson operators in 3D against the unfused application
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+
+// Build restriction offsets for a box of nelem[0] x nelem[1] x nelem[2]
+//   elements with P nodes in each direction
+static void BuildOffsets(const CeedInt nelem[3], CeedInt P, CeedInt *offsets) {
+  CeedInt nnodes[3] = {nelem[0]*(P-1)+1, nelem[1]*(P-1)+1, nelem[2]*(P-1)+1};
+  for (CeedInt ez=0, e=0; ez<nelem[2]; ez++)
+    for (CeedInt ey=0; ey<nelem[1]; ey++)
+      for (CeedInt ex=0; ex<nelem[0]; ex++, e++)
+        for (CeedInt k=0; k<P; k++)
+          for (CeedInt j=0; j<P; j++)
+            for (CeedInt i=0; i<P; i++)
+              offsets[((e*P + k)*P + j)*P + i] =
+                ((ez*(P-1)+k)*nnodes[1] + ey*(P-1)+j)*nnodes[0] + ex*(P-1)+i;
+}
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  const CeedInt dim = 3, nelem[3] = {3, 2, 2}, ne = 12;
+  const CeedInt sizes[2][2] = {{3, 4}, {4, 4}};
+  CeedInt nx[3] = {nelem[0]+1, nelem[1]+1, nelem[2]+1};
+  CeedInt Nx = nx[0]*nx[1]*nx[2];
+  CeedInt indx[ne*8];
+  CeedScalar x[dim*Nx];
+
+  CeedInit(argv[1], &ceed);
+
+  // Mesh coordinates, vertices are perturbed so elements are not affine
+  for (CeedInt k=0; k<nx[2]; k++)
+    for (CeedInt j=0; j<nx[1]; j++)
+      for (CeedInt i=0; i<nx[0]; i++) {
+        CeedInt n = (k*nx[1] + j)*nx[0] + i;
+        CeedScalar shift = 0.05*((i+2*j+3*k)%3 - 1);
+        x[n+0*Nx] = (CeedScalar)i / nelem[0] + shift;
+        x[n+1*Nx] = (CeedScalar)j / nelem[1] - shift;
+        x[n+2*Nx] = (CeedScalar)k / nelem[2] + 0.5*shift;
+      }
+  BuildOffsets(nelem, 2, indx);
+
+  for (CeedInt s=0; s<2; s++) {
+    CeedInt P = sizes[s][0], Q = sizes[s][1], Q3 = Q*Q*Q;
+    CeedInt Nu = (nelem[0]*(P-1)+1)*(nelem[1]*(P-1)+1)*(nelem[2]*(P-1)+1);
+    CeedInt *indu = malloc(ne*P*P*P*sizeof(CeedInt));
+    CeedElemRestriction Erestrictx, Erestrictu, Erestrictqm, Erestrictqp;
+    CeedBasis bx, bu;
+    CeedQFunction qf_setupmass, qf_setuppoisson, qf_mass, qf_poisson;
+    CeedOperator op_setupmass, op_setuppoisson, op[2], op_unfused[2];
+    CeedVector X, qdatamass, qdatapoisson, U, V, Vunfused;
+    const CeedScalar *hv, *hvunfused;
+    CeedScalar *hu;
+
+    BuildOffsets(nelem, P, indu);
+    CeedElemRestrictionCreate(ceed, ne, 8, dim, Nx, dim*Nx, CEED_MEM_HOST,
+                              CEED_USE_POINTER, indx, &Erestrictx);
+    CeedElemRestrictionCreate(ceed, ne, P*P*P, 1, 1, Nu, CEED_MEM_HOST,
+                              CEED_USE_POINTER, indu, &Erestrictu);
+    CeedElemRestrictionCreateStrided(ceed, ne, Q3, 1, ne*Q3,
+                                     CEED_STRIDES_BACKEND, &Erestrictqm);
+    CeedElemRestrictionCreateStrided(ceed, ne, Q3, 6, 6*ne*Q3,
+                                     CEED_STRIDES_BACKEND, &Erestrictqp);
+    CeedBasisCreateTensorH1Lagrange(ceed, dim, dim, 2, Q, CEED_GAUSS, &bx);
+    CeedBasisCreateTensorH1Lagrange(ceed, dim, 1, P, Q, CEED_GAUSS, &bu);
+
+    // Quadrature data
+    CeedQFunctionCreateInteriorByName(ceed, "Mass3DBuild", &qf_setupmass);
+    CeedQFunctionCreateInteriorByName(ceed, "Poisson3DBuild", &qf_setuppoisson);
+    CeedOperatorCreate(ceed, qf_setupmass, CEED_QFUNCTION_NONE,
+                       CEED_QFUNCTION_NONE, &op_setupmass);
+    CeedOperatorSetField(op_setupmass, "dx", Erestrictx, bx, CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_setupmass, "weights", CEED_ELEMRESTRICTION_NONE, bx,
+                         CEED_VECTOR_NONE);
+    CeedOperatorSetField(op_setupmass, "qdata", Erestrictqm,
+                         CEED_BASIS_COLLOCATED, CEED_VECTOR_ACTIVE);
+    CeedOperatorCreate(ceed, qf_setuppoisson, CEED_QFUNCTION_NONE,
+                       CEED_QFUNCTION_NONE, &op_setuppoisson);
+    CeedOperatorSetField(op_setuppoisson, "dx", Erestrictx, bx,
+                         CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_setuppoisson, "weights", CEED_ELEMRESTRICTION_NONE,
+                         bx, CEED_VECTOR_NONE);
+    CeedOperatorSetField(op_setuppoisson, "qdata", Erestrictqp,
+                         CEED_BASIS_COLLOCATED, CEED_VECTOR_ACTIVE);
+
+    CeedVectorCreate(ceed, dim*Nx, &X);
+    CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+    CeedVectorCreate(ceed, ne*Q3, &qdatamass);
+    CeedVectorCreate(ceed, 6*ne*Q3, &qdatapoisson);
+    CeedOperatorApply(op_setupmass, X, qdatamass, CEED_REQUEST_IMMEDIATE);
+    CeedOperatorApply(op_setuppoisson, X, qdatapoisson, CEED_REQUEST_IMMEDIATE);
+
+    // Operators, timing the phases keeps the unfused application
+    CeedQFunctionCreateInteriorByName(ceed, "MassApply", &qf_mass);
+    CeedQFunctionCreateInteriorByName(ceed, "Poisson3DApply", &qf_poisson);
+    for (CeedInt i=0; i<2; i++) {
+      CeedOperator *ops[2] = {&op[i], &op_unfused[i]};
+      for (CeedInt j=0; j<2; j++) {
+        if (i == 0) {
+          CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE,
+                             CEED_QFUNCTION_NONE, ops[j]);
+          CeedOperatorSetField(*ops[j], "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+          CeedOperatorSetField(*ops[j], "qdata", Erestrictqm,
+                               CEED_BASIS_COLLOCATED, qdatamass);
+          CeedOperatorSetField(*ops[j], "v", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+        } else {
+          CeedOperatorCreate(ceed, qf_poisson, CEED_QFUNCTION_NONE,
+                             CEED_QFUNCTION_NONE, ops[j]);
+          CeedOperatorSetField(*ops[j], "du", Erestrictu, bu,
+                               CEED_VECTOR_ACTIVE);
+          CeedOperatorSetField(*ops[j], "qdata", Erestrictqp,
+                               CEED_BASIS_COLLOCATED, qdatapoisson);
+          CeedOperatorSetField(*ops[j], "dv", Erestrictu, bu,
+                               CEED_VECTOR_ACTIVE);
+        }
+      }
+      CeedOperatorSetPerfCounters(op_unfused[i], true);
+    }
+
+    // Apply and compare
+    CeedVectorCreate(ceed, Nu, &U);
+    CeedVectorCreate(ceed, Nu, &V);
+    CeedVectorCreate(ceed, Nu, &Vunfused);
+    CeedVectorGetArray(U, CEED_MEM_HOST, &hu);
+    for (CeedInt i=0; i<Nu; i++)
+      hu[i] = sin(0.37*i) + 0.5;
+    CeedVectorRestoreArray(U, &hu);
+    for (CeedInt i=0; i<2; i++) {
+      CeedOperatorApply(op[i], U, V, CEED_REQUEST_IMMEDIATE);
+      CeedOperatorApply(op_unfused[i], U, Vunfused, CEED_REQUEST_IMMEDIATE);
+
+      CeedScalar maxv = 0., maxdiff = 0.;
+      CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+      CeedVectorGetArrayRead(Vunfused, CEED_MEM_HOST, &hvunfused);
+      for (CeedInt j=0; j<Nu; j++) {
+        maxv = fmax(maxv, fabs(hvunfused[j]));
+        maxdiff = fmax(maxdiff, fabs(hv[j] - hvunfused[j]));
+      }
+      if (maxdiff > 1e-13*maxv)
+        // LCOV_EXCL_START
+        printf("P=%d Q=%d %s: max difference %g exceeds tolerance\n", P, Q,
+               i ? "Poisson" : "mass", maxdiff);
+      // LCOV_EXCL_STOP
+      CeedVectorRestoreArrayRead(V, &hv);
+      CeedVectorRestoreArrayRead(Vunfused, &hvunfused);
+    }
+
+    // Cleanup
+    for (CeedInt i=0; i<2; i++) {
+      CeedOperatorDestroy(&op[i]);
+      CeedOperatorDestroy(&op_unfused[i]);
+    }
+    CeedOperatorDestroy(&op_setupmass);
+    CeedOperatorDestroy(&op_setuppoisson);
+    CeedQFunctionDestroy(&qf_setupmass);
+    CeedQFunctionDestroy(&qf_setuppoisson);
+    CeedQFunctionDestroy(&qf_mass);
+    CeedQFunctionDestroy(&qf_poisson);
+    CeedElemRestrictionDestroy(&Erestrictx);
+    CeedElemRestrictionDestroy(&Erestrictu);
+    CeedElemRestrictionDestroy(&Erestrictqm);
+    CeedElemRestrictionDestroy(&Erestrictqp);
+    CeedBasisDestroy(&bx);
+    CeedBasisDestroy(&bu);
+    CeedVectorDestroy(&X);
+    CeedVectorDestroy(&qdatamass);
+    CeedVectorDestroy(&qdatapoisson);
+    CeedVectorDestroy(&U);
+    CeedVectorDestroy(&V);
+    CeedVectorDestroy(&Vunfused);
+    free(indu);
+  }
+
+  CeedDestroy(&ceed);
+  return 0;
+}
@@ -0,0 +1,210 @@
+/// @file
+/// Test static condensation of a mass plus diffusion operator in 2D
+/// \test Test static condensation of a mass plus diffusion operator in 2D
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+#include "t565-operator.h"
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedElemRestriction Erestrictx, Erestrictu, Erestrictqm, Erestrictqp,
+                      Erestrictskel;
+  CeedBasis bx, bu;
+  CeedQFunction qf_setupmass, qf_setuppoisson, qf_apply;
+  CeedOperator op_setupmass, op_setuppoisson, op_apply, op_schur, op_rhs,
+               op_backsolve;
+  CeedVector X, qdatamass, qdatapoisson, U, B, Usolve, G, Uskel, R, Pdir, AP;
+  CeedInt nelemx = 3, nelemy = 2, nelem = nelemx*nelemy, dim = 2, P = 5, Q = 6;
+  CeedInt nx = nelemx*(P-1)+1, ny = nelemy*(P-1)+1, Nu = nx*ny;
+  CeedInt Nx = (nelemx+1)*(nelemy+1), nskel;
+  CeedInt indx[nelem*4], indu[nelem*P*P];
+  CeedScalar x[dim*Nx];
+
+  CeedInit(argv[1], &ceed);
+
+  // Mesh coordinates, perturbed so elements are not affine
+  for (CeedInt j=0; j<nelemy+1; j++)
+    for (CeedInt i=0; i<nelemx+1; i++) {
+      CeedScalar shift = 0.05*((i+2*j)%3 - 1);
+      x[i+j*(nelemx+1)+0*Nx] = (CeedScalar) i / nelemx + shift;
+      x[i+j*(nelemx+1)+1*Nx] = (CeedScalar) j / nelemy - shift;
+    }
+  for (CeedInt e=0; e<nelem; e++) {
+    CeedInt ex = e % nelemx, ey = e / nelemx;
+    for (CeedInt j=0; j<2; j++)
+      for (CeedInt i=0; i<2; i++)
+        indx[e*4+j*2+i] = (ey+j)*(nelemx+1) + ex+i;
+    for (CeedInt j=0; j<P; j++)
+      for (CeedInt i=0; i<P; i++)
+        indu[e*P*P+j*P+i] = (ey*(P-1)+j)*nx + ex*(P-1)+i;
+  }
+  CeedElemRestrictionCreate(ceed, nelem, 4, dim, Nx, dim*Nx, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indx, &Erestrictx);
+  CeedElemRestrictionCreate(ceed, nelem, P*P, 1, 1, Nu, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indu, &Erestrictu);
+  CeedElemRestrictionCreateStrided(ceed, nelem, Q*Q, 1, nelem*Q*Q,
+                                   CEED_STRIDES_BACKEND, &Erestrictqm);
+  CeedElemRestrictionCreateStrided(ceed, nelem, Q*Q, 3, 3*nelem*Q*Q,
+                                   CEED_STRIDES_BACKEND, &Erestrictqp);
+
+  // Bases
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, dim, 2, Q, CEED_GAUSS, &bx);
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, 1, P, Q, CEED_GAUSS, &bu);
+
+  // Quadrature data
+  CeedQFunctionCreateInteriorByName(ceed, "Mass2DBuild", &qf_setupmass);
+  CeedQFunctionCreateInteriorByName(ceed, "Poisson2DBuild", &qf_setuppoisson);
+  CeedOperatorCreate(ceed, qf_setupmass, CEED_QFUNCTION_NONE,
+                     CEED_QFUNCTION_NONE, &op_setupmass);
+  CeedOperatorSetField(op_setupmass, "dx", Erestrictx, bx, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_setupmass, "weights", CEED_ELEMRESTRICTION_NONE, bx,
+                       CEED_VECTOR_NONE);
+  CeedOperatorSetField(op_setupmass, "qdata", Erestrictqm,
+                       CEED_BASIS_COLLOCATED, CEED_VECTOR_ACTIVE);
+  CeedOperatorCreate(ceed, qf_setuppoisson, CEED_QFUNCTION_NONE,
+                     CEED_QFUNCTION_NONE, &op_setuppoisson);
+  CeedOperatorSetField(op_setuppoisson, "dx", Erestrictx, bx,
+                       CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_setuppoisson, "weights", CEED_ELEMRESTRICTION_NONE,
+                       bx, CEED_VECTOR_NONE);
+  CeedOperatorSetField(op_setuppoisson, "qdata", Erestrictqp,
+                       CEED_BASIS_COLLOCATED, CEED_VECTOR_ACTIVE);
+
+  CeedVectorCreate(ceed, dim*Nx, &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+  CeedVectorCreate(ceed, nelem*Q*Q, &qdatamass);
+  CeedVectorCreate(ceed, 3*nelem*Q*Q, &qdatapoisson);
+  CeedOperatorApply(op_setupmass, X, qdatamass, CEED_REQUEST_IMMEDIATE);
+  CeedOperatorApply(op_setuppoisson, X, qdatapoisson, CEED_REQUEST_IMMEDIATE);
+
+  // Mass plus diffusion operator
+  CeedQFunctionCreateInterior(ceed, 1, apply, apply_loc, &qf_apply);
+  CeedQFunctionAddInput(qf_apply, "qdatamass", 1, CEED_EVAL_NONE);
+  CeedQFunctionAddInput(qf_apply, "qdatapoisson", 3, CEED_EVAL_NONE);
+  CeedQFunctionAddInput(qf_apply, "u", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddInput(qf_apply, "du", dim, CEED_EVAL_GRAD);
+  CeedQFunctionAddOutput(qf_apply, "v", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddOutput(qf_apply, "dv", dim, CEED_EVAL_GRAD);
+  CeedOperatorCreate(ceed, qf_apply, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_apply);
+  CeedOperatorSetField(op_apply, "qdatamass", Erestrictqm,
+                       CEED_BASIS_COLLOCATED, qdatamass);
+  CeedOperatorSetField(op_apply, "qdatapoisson", Erestrictqp,
+                       CEED_BASIS_COLLOCATED, qdatapoisson);
+  CeedOperatorSetField(op_apply, "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_apply, "du", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_apply, "v", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_apply, "dv", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+
+  // Right hand side of a known solution
+  CeedScalar *hu;
+  CeedVectorCreate(ceed, Nu, &U);
+  CeedVectorGetArray(U, CEED_MEM_HOST, &hu);
+  for (CeedInt i=0; i<Nu; i++)
+    hu[i] = sin(0.37*i) + 0.5;
+  CeedVectorRestoreArray(U, &hu);
+  CeedVectorCreate(ceed, Nu, &B);
+  CeedOperatorApply(op_apply, U, B, CEED_REQUEST_IMMEDIATE);
+
+  // Condense
+  CeedOperatorCreateStaticCondensation(op_apply, B, &Erestrictskel, &op_schur,
+                                       &op_rhs, &op_backsolve,
+                                       CEED_REQUEST_IMMEDIATE);
+  CeedElemRestrictionGetLVectorSize(Erestrictskel, &nskel);
+  if (nskel != Nu - nelem*(P-2)*(P-2))
+    // LCOV_EXCL_START
+    printf("Skeleton size %d != %d\n", nskel, Nu - nelem*(P-2)*(P-2));
+  // LCOV_EXCL_STOP
+
+  // Solve the condensed system with conjugate gradients
+  CeedScalar *hx, *hr, *hp, *hap, rr, rr0;
+  CeedElemRestrictionCreateVector(Erestrictskel, &G, NULL);
+  CeedElemRestrictionCreateVector(Erestrictskel, &Uskel, NULL);
+  CeedElemRestrictionCreateVector(Erestrictskel, &R, NULL);
+  CeedElemRestrictionCreateVector(Erestrictskel, &Pdir, NULL);
+  CeedElemRestrictionCreateVector(Erestrictskel, &AP, NULL);
+  CeedOperatorApply(op_rhs, B, G, CEED_REQUEST_IMMEDIATE);
+  CeedVectorSetValue(Uskel, 0.0);
+  const CeedScalar *hg;
+  CeedVectorGetArrayRead(G, CEED_MEM_HOST, &hg);
+  CeedVectorGetArray(R, CEED_MEM_HOST, &hr);
+  CeedVectorGetArray(Pdir, CEED_MEM_HOST, &hp);
+  rr = 0;
+  for (CeedInt i=0; i<nskel; i++) {
+    hr[i] = hp[i] = hg[i];
+    rr += hr[i]*hr[i];
+  }
+  rr0 = rr;
+  CeedVectorRestoreArrayRead(G, &hg);
+  CeedVectorRestoreArray(R, &hr);
+  CeedVectorRestoreArray(Pdir, &hp);
+  for (CeedInt it=0; it<nskel && rr > 1e-28*rr0; it++) {
+    CeedScalar pap = 0, alpha, rrnew = 0;
+    CeedOperatorApply(op_schur, Pdir, AP, CEED_REQUEST_IMMEDIATE);
+    CeedVectorGetArray(Uskel, CEED_MEM_HOST, &hx);
+    CeedVectorGetArray(R, CEED_MEM_HOST, &hr);
+    CeedVectorGetArray(Pdir, CEED_MEM_HOST, &hp);
+    CeedVectorGetArray(AP, CEED_MEM_HOST, &hap);
+    for (CeedInt i=0; i<nskel; i++)
+      pap += hp[i]*hap[i];
+    alpha = rr / pap;
+    for (CeedInt i=0; i<nskel; i++) {
+      hx[i] += alpha*hp[i];
+      hr[i] -= alpha*hap[i];
+      rrnew += hr[i]*hr[i];
+    }
+    for (CeedInt i=0; i<nskel; i++)
+      hp[i] = hr[i] + (rrnew / rr)*hp[i];
+    rr = rrnew;
+    CeedVectorRestoreArray(Uskel, &hx);
+    CeedVectorRestoreArray(R, &hr);
+    CeedVectorRestoreArray(Pdir, &hp);
+    CeedVectorRestoreArray(AP, &hap);
+  }
+
+  // Recover the full solution and compare
+  const CeedScalar *hsolve;
+  CeedVectorCreate(ceed, Nu, &Usolve);
+  CeedOperatorApply(op_backsolve, Uskel, Usolve, CEED_REQUEST_IMMEDIATE);
+  CeedVectorGetArrayRead(Usolve, CEED_MEM_HOST, &hsolve);
+  CeedVectorGetArray(U, CEED_MEM_HOST, &hu);
+  for (CeedInt i=0; i<Nu; i++)
+    if (fabs(hsolve[i] - hu[i]) > 1e-10)
+      // LCOV_EXCL_START
+      printf("Solution [%d] %f != %f\n", i, hsolve[i], hu[i]);
+  // LCOV_EXCL_STOP
+  CeedVectorRestoreArrayRead(Usolve, &hsolve);
+  CeedVectorRestoreArray(U, &hu);
+
+  // Cleanup
+  CeedQFunctionDestroy(&qf_setupmass);
+  CeedQFunctionDestroy(&qf_setuppoisson);
+  CeedQFunctionDestroy(&qf_apply);
+  CeedOperatorDestroy(&op_setupmass);
+  CeedOperatorDestroy(&op_setuppoisson);
+  CeedOperatorDestroy(&op_apply);
+  CeedOperatorDestroy(&op_schur);
+  CeedOperatorDestroy(&op_rhs);
+  CeedOperatorDestroy(&op_backsolve);
+  CeedElemRestrictionDestroy(&Erestrictx);
+  CeedElemRestrictionDestroy(&Erestrictu);
+  CeedElemRestrictionDestroy(&Erestrictqm);
+  CeedElemRestrictionDestroy(&Erestrictqp);
+  CeedElemRestrictionDestroy(&Erestrictskel);
+  CeedBasisDestroy(&bx);
+  CeedBasisDestroy(&bu);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&qdatamass);
+  CeedVectorDestroy(&qdatapoisson);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&B);
+  CeedVectorDestroy(&Usolve);
+  CeedVectorDestroy(&G);
+  CeedVectorDestroy(&Uskel);
+  CeedVectorDestroy(&R);
+  CeedVectorDestroy(&Pdir);
+  CeedVectorDestroy(&AP);
+  CeedDestroy(&ceed);
+  return 0;
+}
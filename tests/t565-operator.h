@@ -0,0 +1,33 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+CEED_QFUNCTION(apply)(void *ctx, const CeedInt Q, const CeedScalar *const *in,
+                      CeedScalar *const *out) {
+  // in[0] is mass quadrature data, size (Q)
+  // in[1] is Poisson quadrature data in Voigt convention, size (3*Q)
+  // in[2] is u, size (Q)
+  // in[3] is gradient u, size (2*Q)
+  const CeedScalar *qm = in[0], *qp = in[1], *u = in[2], *du = in[3];
+  // out[0] is v, size (Q)
+  // out[1] is gradient v, size (2*Q)
+  CeedScalar *v = out[0], *dv = out[1];
+  for (CeedInt i=0; i<Q; i++) {
+    v[i] = qm[i] * u[i];
+    dv[i+Q*0] = qp[i+Q*0]*du[i+Q*0] + qp[i+Q*2]*du[i+Q*1];
+    dv[i+Q*1] = qp[i+Q*2]*du[i+Q*0] + qp[i+Q*1]*du[i+Q*1];
+  }
+  return 0;
+}
@@ -0,0 +1,169 @@
+/// @file
+/// Test vector mass and Poisson gallery QFunctions in 3D against the scalar ones
+/// \test Test vector mass and Poisson gallery QFunctions in 3D against the scalar ones
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  const CeedInt dim = 3, ncomp = 3, P = 3, Q = 4, Q3 = Q*Q*Q;
+  const CeedInt nelem[3] = {2, 2, 1}, ne = 4;
+  CeedInt nx[3] = {nelem[0]+1, nelem[1]+1, nelem[2]+1}, Nx = nx[0]*nx[1]*nx[2];
+  CeedInt nu[3] = {nelem[0]*(P-1)+1, nelem[1]*(P-1)+1, nelem[2]*(P-1)+1};
+  CeedInt Nu = nu[0]*nu[1]*nu[2];
+  CeedInt indx[ne*8], indu[ne*P*P*P];
+  CeedScalar x[dim*Nx];
+  CeedElemRestriction Erestrictx, Erestrictu, Erestrictuvec, Erestrictqm,
+                      Erestrictqp;
+  CeedBasis bx, bu, buvec;
+  CeedQFunction qf_setup[2], qf_scalar[2], qf_vector[2];
+  CeedOperator op_setup[2], op_scalar[2], op_vector[2];
+  CeedVector X, qdata[2], U, V, Vscalar;
+
+  CeedInit(argv[1], &ceed);
+
+  // Mesh coordinates, vertices are perturbed so elements are not affine
+  for (CeedInt k=0; k<nx[2]; k++)
+    for (CeedInt j=0; j<nx[1]; j++)
+      for (CeedInt i=0; i<nx[0]; i++) {
+        CeedInt n = (k*nx[1] + j)*nx[0] + i;
+        CeedScalar shift = 0.05*((i+2*j+3*k)%3 - 1);
+        x[n+0*Nx] = (CeedScalar)i / nelem[0] + shift;
+        x[n+1*Nx] = (CeedScalar)j / nelem[1] - shift;
+        x[n+2*Nx] = (CeedScalar)k / nelem[2] + 0.5*shift;
+      }
+  for (CeedInt ez=0, e=0; ez<nelem[2]; ez++)
+    for (CeedInt ey=0; ey<nelem[1]; ey++)
+      for (CeedInt ex=0; ex<nelem[0]; ex++, e++) {
+        for (CeedInt k=0; k<2; k++)
+          for (CeedInt j=0; j<2; j++)
+            for (CeedInt i=0; i<2; i++)
+              indx[((e*2 + k)*2 + j)*2 + i] =
+                ((ez+k)*nx[1] + ey+j)*nx[0] + ex+i;
+        for (CeedInt k=0; k<P; k++)
+          for (CeedInt j=0; j<P; j++)
+            for (CeedInt i=0; i<P; i++)
+              indu[((e*P + k)*P + j)*P + i] =
+                ((ez*(P-1)+k)*nu[1] + ey*(P-1)+j)*nu[0] + ex*(P-1)+i;
+      }
+
+  // Restrictions and bases, components of the vector field are stored
+  //   consecutively
+  CeedElemRestrictionCreate(ceed, ne, 8, dim, Nx, dim*Nx, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indx, &Erestrictx);
+  CeedElemRestrictionCreate(ceed, ne, P*P*P, 1, 1, Nu, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indu, &Erestrictu);
+  CeedElemRestrictionCreate(ceed, ne, P*P*P, ncomp, Nu, ncomp*Nu,
+                            CEED_MEM_HOST, CEED_USE_POINTER, indu,
+                            &Erestrictuvec);
+  CeedElemRestrictionCreateStrided(ceed, ne, Q3, 1, ne*Q3,
+                                   CEED_STRIDES_BACKEND, &Erestrictqm);
+  CeedElemRestrictionCreateStrided(ceed, ne, Q3, 6, 6*ne*Q3,
+                                   CEED_STRIDES_BACKEND, &Erestrictqp);
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, dim, 2, Q, CEED_GAUSS, &bx);
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, 1, P, Q, CEED_GAUSS, &bu);
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, ncomp, P, Q, CEED_GAUSS, &buvec);
+
+  // Quadrature data
+  CeedVectorCreate(ceed, dim*Nx, &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+  CeedQFunctionCreateInteriorByName(ceed, "Mass3DBuild", &qf_setup[0]);
+  CeedQFunctionCreateInteriorByName(ceed, "Poisson3DBuild", &qf_setup[1]);
+  for (CeedInt i=0; i<2; i++) {
+    CeedElemRestriction Erestrictq = i ? Erestrictqp : Erestrictqm;
+    CeedOperatorCreate(ceed, qf_setup[i], CEED_QFUNCTION_NONE,
+                       CEED_QFUNCTION_NONE, &op_setup[i]);
+    CeedOperatorSetField(op_setup[i], "dx", Erestrictx, bx, CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_setup[i], "weights", CEED_ELEMRESTRICTION_NONE, bx,
+                         CEED_VECTOR_NONE);
+    CeedOperatorSetField(op_setup[i], "qdata", Erestrictq,
+                         CEED_BASIS_COLLOCATED, CEED_VECTOR_ACTIVE);
+    CeedVectorCreate(ceed, (i ? 6 : 1)*ne*Q3, &qdata[i]);
+    CeedOperatorApply(op_setup[i], X, qdata[i], CEED_REQUEST_IMMEDIATE);
+  }
+
+  // Scalar and vector operators
+  CeedQFunctionCreateInteriorByName(ceed, "MassApply", &qf_scalar[0]);
+  CeedQFunctionCreateInteriorByName(ceed, "Poisson3DApply", &qf_scalar[1]);
+  CeedQFunctionCreateVectorByName(ceed, "VectorMassApply", ncomp,
+                                  &qf_vector[0]);
+  CeedQFunctionCreateVectorByName(ceed, "VectorPoisson3DApply", ncomp,
+                                  &qf_vector[1]);
+  for (CeedInt i=0; i<2; i++) {
+    CeedElemRestriction Erestrictq = i ? Erestrictqp : Erestrictqm;
+    const char *in = i ? "du" : "u", *out = i ? "dv" : "v";
+    CeedOperatorCreate(ceed, qf_scalar[i], CEED_QFUNCTION_NONE,
+                       CEED_QFUNCTION_NONE, &op_scalar[i]);
+    CeedOperatorSetField(op_scalar[i], in, Erestrictu, bu, CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_scalar[i], "qdata", Erestrictq,
+                         CEED_BASIS_COLLOCATED, qdata[i]);
+    CeedOperatorSetField(op_scalar[i], out, Erestrictu, bu, CEED_VECTOR_ACTIVE);
+    CeedOperatorCreate(ceed, qf_vector[i], CEED_QFUNCTION_NONE,
+                       CEED_QFUNCTION_NONE, &op_vector[i]);
+    CeedOperatorSetField(op_vector[i], in, Erestrictuvec, buvec,
+                         CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_vector[i], "qdata", Erestrictq,
+                         CEED_BASIS_COLLOCATED, qdata[i]);
+    CeedOperatorSetField(op_vector[i], out, Erestrictuvec, buvec,
+                         CEED_VECTOR_ACTIVE);
+  }
+
+  // Apply vector operators and scalar operators to each component
+  CeedScalar *hu;
+  CeedVectorCreate(ceed, ncomp*Nu, &U);
+  CeedVectorCreate(ceed, ncomp*Nu, &V);
+  CeedVectorCreate(ceed, ncomp*Nu, &Vscalar);
+  CeedVectorGetArray(U, CEED_MEM_HOST, &hu);
+  for (CeedInt i=0; i<ncomp*Nu; i++)
+    hu[i] = sin(0.37*i) + 0.5;
+  CeedVectorRestoreArray(U, &hu);
+  for (CeedInt i=0; i<2; i++) {
+    CeedOperatorApply(op_vector[i], U, V, CEED_REQUEST_IMMEDIATE);
+    for (CeedInt c=0; c<ncomp; c++) {
+      CeedVector Uc, Vc;
+      CeedVectorCreateView(U, c*Nu, Nu, &Uc);
+      CeedVectorCreateView(Vscalar, c*Nu, Nu, &Vc);
+      CeedOperatorApply(op_scalar[i], Uc, Vc, CEED_REQUEST_IMMEDIATE);
+      CeedVectorDestroy(&Uc);
+      CeedVectorDestroy(&Vc);
+    }
+
+    const CeedScalar *hv, *hvscalar;
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+    CeedVectorGetArrayRead(Vscalar, CEED_MEM_HOST, &hvscalar);
+    for (CeedInt j=0; j<ncomp*Nu; j++)
+      if (fabs(hv[j] - hvscalar[j]) > 1e-13)
+        // LCOV_EXCL_START
+        printf("%s [%d] %f != %f\n", i ? "Poisson" : "Mass", j, hv[j],
+               hvscalar[j]);
+    // LCOV_EXCL_STOP
+    CeedVectorRestoreArrayRead(V, &hv);
+    CeedVectorRestoreArrayRead(Vscalar, &hvscalar);
+  }
+
+  // Cleanup
+  for (CeedInt i=0; i<2; i++) {
+    CeedQFunctionDestroy(&qf_setup[i]);
+    CeedQFunctionDestroy(&qf_scalar[i]);
+    CeedQFunctionDestroy(&qf_vector[i]);
+    CeedOperatorDestroy(&op_setup[i]);
+    CeedOperatorDestroy(&op_scalar[i]);
+    CeedOperatorDestroy(&op_vector[i]);
+    CeedVectorDestroy(&qdata[i]);
+  }
+  CeedElemRestrictionDestroy(&Erestrictx);
+  CeedElemRestrictionDestroy(&Erestrictu);
+  CeedElemRestrictionDestroy(&Erestrictuvec);
+  CeedElemRestrictionDestroy(&Erestrictqm);
+  CeedElemRestrictionDestroy(&Erestrictqp);
+  CeedBasisDestroy(&bx);
+  CeedBasisDestroy(&bu);
+  CeedBasisDestroy(&buvec);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedVectorDestroy(&Vscalar);
+  CeedDestroy(&ceed);
+  return 0;
+}
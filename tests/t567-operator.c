@@ -0,0 +1,167 @@
+/// @file
+/// Test concurrent setup of operators sharing restrictions and bases
+/// \test Test concurrent setup of operators sharing restrictions and bases
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+
+// Build restriction offsets for a box of nelem[0] x nelem[1] x nelem[2]
+//   elements with P nodes in each direction
+static void BuildOffsets(const CeedInt nelem[3], CeedInt P, CeedInt *offsets) {
+  CeedInt nnodes[3] = {nelem[0]*(P-1)+1, nelem[1]*(P-1)+1, nelem[2]*(P-1)+1};
+  for (CeedInt ez=0, e=0; ez<nelem[2]; ez++)
+    for (CeedInt ey=0; ey<nelem[1]; ey++)
+      for (CeedInt ex=0; ex<nelem[0]; ex++, e++)
+        for (CeedInt k=0; k<P; k++)
+          for (CeedInt j=0; j<P; j++)
+            for (CeedInt i=0; i<P; i++)
+              offsets[((e*P + k)*P + j)*P + i] =
+                ((ez*(P-1)+k)*nnodes[1] + ey*(P-1)+j)*nnodes[0] + ex*(P-1)+i;
+}
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  const CeedInt dim = 3, nelem[3] = {3, 2, 2}, ne = 12, P = 3, Q = 4;
+  const CeedInt Q3 = Q*Q*Q;
+  CeedInt nx[3] = {nelem[0]+1, nelem[1]+1, nelem[2]+1};
+  CeedInt Nx = nx[0]*nx[1]*nx[2];
+  CeedInt Nu = (nelem[0]*(P-1)+1)*(nelem[1]*(P-1)+1)*(nelem[2]*(P-1)+1);
+  CeedInt indx[ne*8], indu[ne*P*P*P];
+  CeedScalar x[dim*Nx];
+  CeedElemRestriction Erestrictx, Erestrictu, Erestrictqm, Erestrictqp;
+  CeedBasis bx, bu;
+  CeedQFunction qf_setupmass, qf_setuppoisson, qf_mass, qf_poisson;
+  CeedOperator op_setup[2], op[2][3];
+  CeedVector X, qdatamass, qdatapoisson, U, V[2];
+  const CeedScalar *hv[2];
+  CeedScalar *hu;
+
+  CeedInit(argv[1], &ceed);
+
+  // Mesh coordinates, vertices are perturbed so elements are not affine
+  for (CeedInt k=0; k<nx[2]; k++)
+    for (CeedInt j=0; j<nx[1]; j++)
+      for (CeedInt i=0; i<nx[0]; i++) {
+        CeedInt n = (k*nx[1] + j)*nx[0] + i;
+        CeedScalar shift = 0.05*((i+2*j+3*k)%3 - 1);
+        x[n+0*Nx] = (CeedScalar)i / nelem[0] + shift;
+        x[n+1*Nx] = (CeedScalar)j / nelem[1] - shift;
+        x[n+2*Nx] = (CeedScalar)k / nelem[2] + 0.5*shift;
+      }
+  BuildOffsets(nelem, 2, indx);
+  BuildOffsets(nelem, P, indu);
+
+  CeedElemRestrictionCreate(ceed, ne, 8, dim, Nx, dim*Nx, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indx, &Erestrictx);
+  CeedElemRestrictionCreate(ceed, ne, P*P*P, 1, 1, Nu, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indu, &Erestrictu);
+  CeedElemRestrictionCreateStrided(ceed, ne, Q3, 1, ne*Q3,
+                                   CEED_STRIDES_BACKEND, &Erestrictqm);
+  CeedElemRestrictionCreateStrided(ceed, ne, Q3, 6, 6*ne*Q3,
+                                   CEED_STRIDES_BACKEND, &Erestrictqp);
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, dim, 2, Q, CEED_GAUSS, &bx);
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, 1, P, Q, CEED_GAUSS, &bu);
+
+  // Quadrature data, the operators share the coordinate restriction and basis
+  CeedQFunctionCreateInteriorByName(ceed, "Mass3DBuild", &qf_setupmass);
+  CeedQFunctionCreateInteriorByName(ceed, "Poisson3DBuild", &qf_setuppoisson);
+  for (CeedInt i=0; i<2; i++) {
+    CeedOperatorCreate(ceed, i ? qf_setuppoisson : qf_setupmass,
+                       CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE, &op_setup[i]);
+    CeedOperatorSetField(op_setup[i], "dx", Erestrictx, bx, CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_setup[i], "weights", CEED_ELEMRESTRICTION_NONE, bx,
+                         CEED_VECTOR_NONE);
+    CeedOperatorSetField(op_setup[i], "qdata", i ? Erestrictqp : Erestrictqm,
+                         CEED_BASIS_COLLOCATED, CEED_VECTOR_ACTIVE);
+  }
+  CeedOperator op_setuplist[3] = {op_setup[0], op_setup[1], op_setup[0]};
+  CeedOperatorSetupAll(3, op_setuplist, 4);
+
+  CeedVectorCreate(ceed, dim*Nx, &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+  CeedVectorCreate(ceed, ne*Q3, &qdatamass);
+  CeedVectorCreate(ceed, 6*ne*Q3, &qdatapoisson);
+  CeedOperatorApply(op_setup[0], X, qdatamass, CEED_REQUEST_IMMEDIATE);
+  CeedOperatorApply(op_setup[1], X, qdatapoisson, CEED_REQUEST_IMMEDIATE);
+
+  // Mass, Poisson, and composite operators, set up eagerly and lazily
+  CeedQFunctionCreateInteriorByName(ceed, "MassApply", &qf_mass);
+  CeedQFunctionCreateInteriorByName(ceed, "Poisson3DApply", &qf_poisson);
+  for (CeedInt s=0; s<2; s++) {
+    CeedOperator sub[2];
+
+    CeedCompositeOperatorCreate(ceed, &op[s][2]);
+    for (CeedInt i=0; i<2; i++) {
+      for (CeedInt j=0; j<2; j++) {
+        CeedOperator *opij = j ? &sub[i] : &op[s][i];
+        if (i == 0) {
+          CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE,
+                             CEED_QFUNCTION_NONE, opij);
+          CeedOperatorSetField(*opij, "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+          CeedOperatorSetField(*opij, "qdata", Erestrictqm,
+                               CEED_BASIS_COLLOCATED, qdatamass);
+          CeedOperatorSetField(*opij, "v", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+        } else {
+          CeedOperatorCreate(ceed, qf_poisson, CEED_QFUNCTION_NONE,
+                             CEED_QFUNCTION_NONE, opij);
+          CeedOperatorSetField(*opij, "du", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+          CeedOperatorSetField(*opij, "qdata", Erestrictqp,
+                               CEED_BASIS_COLLOCATED, qdatapoisson);
+          CeedOperatorSetField(*opij, "dv", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+        }
+      }
+      CeedCompositeOperatorAddSub(op[s][2], sub[i]);
+      CeedOperatorDestroy(&sub[i]);
+    }
+  }
+  CeedOperatorSetupAll(3, op[0], 0);
+
+  // Apply and compare
+  CeedVectorCreate(ceed, Nu, &U);
+  CeedVectorCreate(ceed, Nu, &V[0]);
+  CeedVectorCreate(ceed, Nu, &V[1]);
+  CeedVectorGetArray(U, CEED_MEM_HOST, &hu);
+  for (CeedInt i=0; i<Nu; i++)
+    hu[i] = sin(0.37*i) + 0.5;
+  CeedVectorRestoreArray(U, &hu);
+  for (CeedInt i=0; i<3; i++) {
+    for (CeedInt s=0; s<2; s++)
+      CeedOperatorApply(op[s][i], U, V[s], CEED_REQUEST_IMMEDIATE);
+
+    CeedVectorGetArrayRead(V[0], CEED_MEM_HOST, &hv[0]);
+    CeedVectorGetArrayRead(V[1], CEED_MEM_HOST, &hv[1]);
+    for (CeedInt j=0; j<Nu; j++)
+      if (fabs(hv[0][j] - hv[1][j]) > 1e-14)
+        // LCOV_EXCL_START
+        printf("Operator %d [%d] eager %g != lazy %g\n", i, j, hv[0][j],
+               hv[1][j]);
+    // LCOV_EXCL_STOP
+    CeedVectorRestoreArrayRead(V[0], &hv[0]);
+    CeedVectorRestoreArrayRead(V[1], &hv[1]);
+  }
+
+  // Cleanup
+  for (CeedInt s=0; s<2; s++)
+    for (CeedInt i=0; i<3; i++)
+      CeedOperatorDestroy(&op[s][i]);
+  CeedOperatorDestroy(&op_setup[0]);
+  CeedOperatorDestroy(&op_setup[1]);
+  CeedQFunctionDestroy(&qf_setupmass);
+  CeedQFunctionDestroy(&qf_setuppoisson);
+  CeedQFunctionDestroy(&qf_mass);
+  CeedQFunctionDestroy(&qf_poisson);
+  CeedElemRestrictionDestroy(&Erestrictx);
+  CeedElemRestrictionDestroy(&Erestrictu);
+  CeedElemRestrictionDestroy(&Erestrictqm);
+  CeedElemRestrictionDestroy(&Erestrictqp);
+  CeedBasisDestroy(&bx);
+  CeedBasisDestroy(&bu);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&qdatamass);
+  CeedVectorDestroy(&qdatapoisson);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V[0]);
+  CeedVectorDestroy(&V[1]);
+  CeedDestroy(&ceed);
+  return 0;
+}
@@ -0,0 +1,140 @@
+/// @file
+/// Test mass matrix operator with a QFunction vector length that does not divide the number of quadrature points
+/// \test Test mass matrix operator with a QFunction vector length that does not divide the number of quadrature points
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "t568-operator.h"
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedElemRestriction Erestrictx, Erestrictu, Erestrictui;
+  CeedBasis bx, bu;
+  CeedQFunction qf_setup, qf_mass, qf_massaligned;
+  CeedOperator op_setup, op_mass, op_massaligned;
+  CeedVector qdata, X, U, V, Valigned;
+  CeedScalar *hu;
+  const CeedScalar *hv, *hvaligned;
+  CeedInt nelem = 7, P = 4, Q = 5;
+  CeedInt Nx = nelem+1, Nu = nelem*(P-1)+1;
+  CeedInt indx[nelem*2], indu[nelem*P];
+  CeedScalar x[Nx];
+
+  CeedInit(argv[1], &ceed);
+
+  for (CeedInt i=0; i<Nx; i++)
+    x[i] = (CeedScalar) i / (Nx - 1);
+  for (CeedInt i=0; i<nelem; i++) {
+    indx[2*i+0] = i;
+    indx[2*i+1] = i+1;
+  }
+  // Restrictions
+  CeedElemRestrictionCreate(ceed, nelem, 2, 1, 1, Nx, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indx, &Erestrictx);
+
+  for (CeedInt i=0; i<nelem; i++) {
+    for (CeedInt j=0; j<P; j++) {
+      indu[P*i+j] = 2*(i*(P-1) + j);
+    }
+  }
+  CeedElemRestrictionCreate(ceed, nelem, P, 2, 1, 2*Nu, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indu, &Erestrictu);
+  CeedInt stridesu[3] = {1, Q, Q};
+  CeedElemRestrictionCreateStrided(ceed, nelem, Q, 1, Q*nelem, stridesu,
+                                   &Erestrictui);
+
+  // Bases
+  CeedBasisCreateTensorH1Lagrange(ceed, 1, 1, 2, Q, CEED_GAUSS, &bx);
+  CeedBasisCreateTensorH1Lagrange(ceed, 1, 2, P, Q, CEED_GAUSS, &bu);
+
+  // QFunctions
+  CeedQFunctionCreateInterior(ceed, 1, setup, setup_loc, &qf_setup);
+  CeedQFunctionAddInput(qf_setup, "_weight", 1, CEED_EVAL_WEIGHT);
+  CeedQFunctionAddInput(qf_setup, "dx", 1*1, CEED_EVAL_GRAD);
+  CeedQFunctionAddOutput(qf_setup, "rho", 1, CEED_EVAL_NONE);
+
+  CeedQFunctionCreateInterior(ceed, 1, mass, mass_loc, &qf_mass);
+  CeedQFunctionAddInput(qf_mass, "rho", 1, CEED_EVAL_NONE);
+  CeedQFunctionAddInput(qf_mass, "u", 2, CEED_EVAL_INTERP);
+  CeedQFunctionAddOutput(qf_mass, "v", 2, CEED_EVAL_INTERP);
+
+  CeedQFunctionCreateInterior(ceed, 8, mass_aligned, mass_aligned_loc,
+                              &qf_massaligned);
+  CeedQFunctionAddInput(qf_massaligned, "rho", 1, CEED_EVAL_NONE);
+  CeedQFunctionAddInput(qf_massaligned, "u", 2, CEED_EVAL_INTERP);
+  CeedQFunctionAddOutput(qf_massaligned, "v", 2, CEED_EVAL_INTERP);
+
+  // Operators
+  CeedOperatorCreate(ceed, qf_setup, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_setup);
+  CeedOperatorSetField(op_setup, "_weight", CEED_ELEMRESTRICTION_NONE, bx,
+                       CEED_VECTOR_NONE);
+  CeedOperatorSetField(op_setup, "dx", Erestrictx, bx, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_setup, "rho", Erestrictui, CEED_BASIS_COLLOCATED,
+                       CEED_VECTOR_ACTIVE);
+
+  CeedVectorCreate(ceed, Nx, &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+  CeedVectorCreate(ceed, nelem*Q, &qdata);
+  CeedOperatorApply(op_setup, X, qdata, CEED_REQUEST_IMMEDIATE);
+
+  CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_mass);
+  CeedOperatorSetField(op_mass, "rho", Erestrictui, CEED_BASIS_COLLOCATED,
+                       qdata);
+  CeedOperatorSetField(op_mass, "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_mass, "v", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+
+  CeedOperatorCreate(ceed, qf_massaligned, CEED_QFUNCTION_NONE,
+                     CEED_QFUNCTION_NONE, &op_massaligned);
+  CeedOperatorSetField(op_massaligned, "rho", Erestrictui,
+                       CEED_BASIS_COLLOCATED, qdata);
+  CeedOperatorSetField(op_massaligned, "u", Erestrictu, bu,
+                       CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_massaligned, "v", Erestrictu, bu,
+                       CEED_VECTOR_ACTIVE);
+
+  // Apply and compare
+  CeedVectorCreate(ceed, 2*Nu, &U);
+  CeedVectorGetArray(U, CEED_MEM_HOST, &hu);
+  for (CeedInt i=0; i<Nu; i++) {
+    hu[2*i] = 1.0 + sin(0.3*i);
+    hu[2*i+1] = 2.0 - cos(0.7*i);
+  }
+  CeedVectorRestoreArray(U, &hu);
+  CeedVectorCreate(ceed, 2*Nu, &V);
+  CeedVectorCreate(ceed, 2*Nu, &Valigned);
+  CeedOperatorApply(op_mass, U, V, CEED_REQUEST_IMMEDIATE);
+  CeedOperatorApply(op_massaligned, U, Valigned, CEED_REQUEST_IMMEDIATE);
+
+  CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+  CeedVectorGetArrayRead(Valigned, CEED_MEM_HOST, &hvaligned);
+  for (CeedInt i=0; i<2*Nu; i++)
+    if (fabs(hv[i] - hvaligned[i]) > 1e-14)
+      // LCOV_EXCL_START
+      printf("[%d] Aligned %f != Reference %f\n", i, hvaligned[i], hv[i]);
+  // LCOV_EXCL_STOP
+  CeedVectorRestoreArrayRead(V, &hv);
+  CeedVectorRestoreArrayRead(Valigned, &hvaligned);
+
+  // Cleanup
+  CeedQFunctionDestroy(&qf_setup);
+  CeedQFunctionDestroy(&qf_mass);
+  CeedQFunctionDestroy(&qf_massaligned);
+  CeedOperatorDestroy(&op_setup);
+  CeedOperatorDestroy(&op_mass);
+  CeedOperatorDestroy(&op_massaligned);
+  CeedElemRestrictionDestroy(&Erestrictu);
+  CeedElemRestrictionDestroy(&Erestrictx);
+  CeedElemRestrictionDestroy(&Erestrictui);
+  CeedBasisDestroy(&bu);
+  CeedBasisDestroy(&bx);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedVectorDestroy(&Valigned);
+  CeedVectorDestroy(&qdata);
+  CeedDestroy(&ceed);
+  return 0;
+}
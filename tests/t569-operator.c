@@ -0,0 +1,129 @@
+/// @file
+/// Test repeated application of an operator with many elements and a context
+/// \test Test repeated application of an operator with many elements and a context
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+#include "t569-operator.h"
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  const CeedInt dim = 2, nelem[2] = {9, 7}, ne = 63, P = 3, Q = 4;
+  const CeedInt Q2 = Q*Q, nx[2] = {nelem[0]+1, nelem[1]+1};
+  const CeedInt Nx = nx[0]*nx[1];
+  const CeedInt Nu = (nelem[0]*(P-1)+1)*(nelem[1]*(P-1)+1);
+  CeedInt indx[ne*4], indu[ne*P*P];
+  CeedScalar x[dim*Nx], scale = 1.0;
+  CeedElemRestriction Erestrictx, Erestrictu, Erestrictq;
+  CeedBasis bx, bu;
+  CeedQFunction qf_setup, qf_mass;
+  CeedQFunctionContext ctx;
+  CeedOperator op_setup, op_mass;
+  CeedVector X, qdata, U, V;
+  const CeedScalar *hv;
+
+  CeedInit(argv[1], &ceed);
+
+  // Mesh of the unit square
+  for (CeedInt j=0; j<nx[1]; j++)
+    for (CeedInt i=0; i<nx[0]; i++) {
+      x[j*nx[0] + i + 0*Nx] = (CeedScalar)i / nelem[0];
+      x[j*nx[0] + i + 1*Nx] = (CeedScalar)j / nelem[1];
+    }
+  for (CeedInt ey=0, e=0; ey<nelem[1]; ey++)
+    for (CeedInt ex=0; ex<nelem[0]; ex++, e++) {
+      for (CeedInt j=0; j<2; j++)
+        for (CeedInt i=0; i<2; i++)
+          indx[(e*2 + j)*2 + i] = (ey + j)*nx[0] + ex + i;
+      for (CeedInt j=0; j<P; j++)
+        for (CeedInt i=0; i<P; i++)
+          indu[(e*P + j)*P + i] = (ey*(P-1) + j)*(nelem[0]*(P-1)+1) +
+                                  ex*(P-1) + i;
+    }
+
+  CeedElemRestrictionCreate(ceed, ne, 4, dim, Nx, dim*Nx, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indx, &Erestrictx);
+  CeedElemRestrictionCreate(ceed, ne, P*P, 1, 1, Nu, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indu, &Erestrictu);
+  CeedElemRestrictionCreateStrided(ceed, ne, Q2, 1, ne*Q2,
+                                   CEED_STRIDES_BACKEND, &Erestrictq);
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, dim, 2, Q, CEED_GAUSS, &bx);
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, 1, P, Q, CEED_GAUSS, &bu);
+
+  // Quadrature data
+  CeedQFunctionCreateInteriorByName(ceed, "Mass2DBuild", &qf_setup);
+  CeedOperatorCreate(ceed, qf_setup, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_setup);
+  CeedOperatorSetField(op_setup, "dx", Erestrictx, bx, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_setup, "weights", CEED_ELEMRESTRICTION_NONE, bx,
+                       CEED_VECTOR_NONE);
+  CeedOperatorSetField(op_setup, "qdata", Erestrictq, CEED_BASIS_COLLOCATED,
+                       CEED_VECTOR_ACTIVE);
+  CeedVectorCreate(ceed, dim*Nx, &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+  CeedVectorCreate(ceed, ne*Q2, &qdata);
+  CeedOperatorApply(op_setup, X, qdata, CEED_REQUEST_IMMEDIATE);
+
+  // Scaled mass operator
+  CeedQFunctionCreateInterior(ceed, 1, scaled_mass, scaled_mass_loc, &qf_mass);
+  CeedQFunctionAddInput(qf_mass, "u", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddInput(qf_mass, "qdata", 1, CEED_EVAL_NONE);
+  CeedQFunctionAddOutput(qf_mass, "v", 1, CEED_EVAL_INTERP);
+  CeedQFunctionContextCreate(ceed, &ctx);
+  CeedQFunctionContextSetData(ctx, CEED_MEM_HOST, CEED_USE_POINTER,
+                              sizeof(scale), &scale);
+  CeedQFunctionSetContext(qf_mass, ctx);
+  CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_mass);
+  CeedOperatorSetField(op_mass, "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_mass, "qdata", Erestrictq, CEED_BASIS_COLLOCATED,
+                       qdata);
+  CeedOperatorSetField(op_mass, "v", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+
+  // Apply repeatedly, changing the context; the sum of v is scale * area
+  CeedVectorCreate(ceed, Nu, &U);
+  CeedVectorSetValue(U, 1.0);
+  CeedVectorCreate(ceed, Nu, &V);
+  for (CeedInt k=0; k<16; k++) {
+    CeedScalar *hscale, sum = 0;
+
+    CeedQFunctionContextGetData(ctx, CEED_MEM_HOST, &hscale);
+    *hscale = 1.0 + 0.5*k;
+    CeedQFunctionContextRestoreData(ctx, &hscale);
+    if (k == 8) {
+      // Replace the context data
+      CeedScalar newscale = 1.0 + 0.5*k;
+      CeedQFunctionContextSetData(ctx, CEED_MEM_HOST, CEED_COPY_VALUES,
+                                  sizeof(newscale), &newscale);
+    }
+    CeedOperatorApply(op_mass, U, V, CEED_REQUEST_IMMEDIATE);
+
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+    for (CeedInt i=0; i<Nu; i++)
+      sum += hv[i];
+    if (fabs(sum - (1.0 + 0.5*k)) > 1e-12)
+      // LCOV_EXCL_START
+      printf("Application %d: computed area %g != true area %g\n", k, sum,
+             1.0 + 0.5*k);
+    // LCOV_EXCL_STOP
+    CeedVectorRestoreArrayRead(V, &hv);
+  }
+
+  // Cleanup
+  CeedQFunctionDestroy(&qf_setup);
+  CeedQFunctionDestroy(&qf_mass);
+  CeedQFunctionContextDestroy(&ctx);
+  CeedOperatorDestroy(&op_setup);
+  CeedOperatorDestroy(&op_mass);
+  CeedElemRestrictionDestroy(&Erestrictx);
+  CeedElemRestrictionDestroy(&Erestrictu);
+  CeedElemRestrictionDestroy(&Erestrictq);
+  CeedBasisDestroy(&bx);
+  CeedBasisDestroy(&bu);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&qdata);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedDestroy(&ceed);
+  return 0;
+}
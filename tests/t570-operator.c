@@ -0,0 +1,112 @@
+/// @file
+/// Test mass matrix operator and its inner product with element counts that are not a multiple of the block size
+/// \test Test mass matrix operator and its inner product with element counts that are not a multiple of the block size
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+#include "t570-operator.h"
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  const CeedInt Q = 3, maxnelem = 17;
+  CeedInt indx[2*maxnelem];
+  CeedScalar x[maxnelem+1];
+
+  CeedInit(argv[1], &ceed);
+
+  for (CeedInt nelem=1; nelem<=maxnelem; nelem++) {
+    const CeedInt Nx = nelem+1;
+    CeedElemRestriction Erestrictx, Erestrictq;
+    CeedBasis bx;
+    CeedQFunction qf_setup, qf_mass;
+    CeedOperator op_setup, op_mass;
+    CeedVector X, qdata, V;
+    const CeedScalar *hv;
+
+    // Graded mesh of the unit interval
+    for (CeedInt i=0; i<Nx; i++)
+      x[i] = ((CeedScalar)i / nelem) * ((CeedScalar)i / nelem);
+    for (CeedInt i=0; i<nelem; i++) {
+      indx[2*i+0] = i;
+      indx[2*i+1] = i+1;
+    }
+    CeedElemRestrictionCreate(ceed, nelem, 2, 1, 1, Nx, CEED_MEM_HOST,
+                              CEED_USE_POINTER, indx, &Erestrictx);
+    CeedElemRestrictionCreateStrided(ceed, nelem, Q, 1, nelem*Q,
+                                     CEED_STRIDES_BACKEND, &Erestrictq);
+    CeedBasisCreateTensorH1Lagrange(ceed, 1, 1, 2, Q, CEED_GAUSS, &bx);
+
+    // QFunctions, with a vector length that does not divide the number of
+    //   quadrature points
+    CeedQFunctionCreateInterior(ceed, 4, setup, setup_loc, &qf_setup);
+    CeedQFunctionAddInput(qf_setup, "weight", 1, CEED_EVAL_WEIGHT);
+    CeedQFunctionAddInput(qf_setup, "dx", 1, CEED_EVAL_GRAD);
+    CeedQFunctionAddOutput(qf_setup, "qdata", 1, CEED_EVAL_NONE);
+    CeedQFunctionCreateInterior(ceed, 4, mass, mass_loc, &qf_mass);
+    CeedQFunctionAddInput(qf_mass, "qdata", 1, CEED_EVAL_NONE);
+    CeedQFunctionAddInput(qf_mass, "u", 1, CEED_EVAL_INTERP);
+    CeedQFunctionAddOutput(qf_mass, "v", 1, CEED_EVAL_INTERP);
+
+    // Operators
+    CeedOperatorCreate(ceed, qf_setup, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                       &op_setup);
+    CeedOperatorSetField(op_setup, "weight", CEED_ELEMRESTRICTION_NONE, bx,
+                         CEED_VECTOR_NONE);
+    CeedOperatorSetField(op_setup, "dx", Erestrictx, bx, CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_setup, "qdata", Erestrictq, CEED_BASIS_COLLOCATED,
+                         CEED_VECTOR_ACTIVE);
+    CeedVectorCreate(ceed, Nx, &X);
+    CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+    CeedVectorCreate(ceed, nelem*Q, &qdata);
+    CeedOperatorApply(op_setup, X, qdata, CEED_REQUEST_IMMEDIATE);
+
+    CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                       &op_mass);
+    CeedOperatorSetField(op_mass, "qdata", Erestrictq, CEED_BASIS_COLLOCATED,
+                         qdata);
+    CeedOperatorSetField(op_mass, "u", Erestrictx, bx, CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_mass, "v", Erestrictx, bx, CEED_VECTOR_ACTIVE);
+
+    // Integral of x over the interval, with u interpolating x
+    CeedVectorCreate(ceed, Nx, &V);
+    CeedOperatorApply(op_mass, X, V, CEED_REQUEST_IMMEDIATE);
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+    CeedScalar sum = 0;
+    for (CeedInt i=0; i<Nx; i++)
+      sum += hv[i];
+    if (fabs(sum - 0.5) > 1e-12)
+      // LCOV_EXCL_START
+      printf("%d elements: computed integral %g != true integral 0.5\n", nelem,
+             sum);
+    // LCOV_EXCL_STOP
+    CeedVectorRestoreArrayRead(V, &hv);
+
+    // Energy inner product, reduced over the element blocks, against the
+    //   inner product of the L-vectors
+    CeedScalar dot, dotl = 0;
+    CeedOperatorApplyWithDot(op_mass, X, V, &dot, CEED_REQUEST_IMMEDIATE);
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+    for (CeedInt i=0; i<Nx; i++)
+      dotl += x[i]*hv[i];
+    if (fabs(dot - dotl) > 1e-12)
+      // LCOV_EXCL_START
+      printf("%d elements: inner product %g != %g\n", nelem, dot, dotl);
+    // LCOV_EXCL_STOP
+    CeedVectorRestoreArrayRead(V, &hv);
+
+    // Cleanup
+    CeedQFunctionDestroy(&qf_setup);
+    CeedQFunctionDestroy(&qf_mass);
+    CeedOperatorDestroy(&op_setup);
+    CeedOperatorDestroy(&op_mass);
+    CeedElemRestrictionDestroy(&Erestrictx);
+    CeedElemRestrictionDestroy(&Erestrictq);
+    CeedBasisDestroy(&bx);
+    CeedVectorDestroy(&X);
+    CeedVectorDestroy(&qdata);
+    CeedVectorDestroy(&V);
+  }
+
+  CeedDestroy(&ceed);
+  return 0;
+}
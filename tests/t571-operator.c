@@ -0,0 +1,219 @@
+/// @file
+/// Test operator application with the energy inner product of input and output
+/// \test Test operator application with the energy inner product of input and output
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+#include "t571-operator.h"
+
+// Inner product of two L-vectors
+static CeedScalar VectorDot(CeedVector x, CeedVector y) {
+  CeedInt length;
+  const CeedScalar *hx, *hy;
+  CeedScalar sum = 0;
+  CeedVectorGetLength(x, &length);
+  CeedVectorGetArrayRead(x, CEED_MEM_HOST, &hx);
+  CeedVectorGetArrayRead(y, CEED_MEM_HOST, &hy);
+  for (CeedInt i=0; i<length; i++)
+    sum += hx[i]*hy[i];
+  CeedVectorRestoreArrayRead(x, &hx);
+  CeedVectorRestoreArrayRead(y, &hy);
+  return sum;
+}
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedElemRestriction Erestrictx, Erestrictu, Erestrictucopy, Erestrictqm,
+                      Erestrictqp;
+  CeedBasis bx, bu;
+  CeedQFunction qf_setupmass, qf_setuppoisson, qf_apply, qf_applyvec, qf_mass;
+  CeedOperator op_setupmass, op_setuppoisson, op_apply, op_applyvec, op_mass,
+               op_masscopy, op_composite;
+  CeedVector X, qdatamass, qdatapoisson, U, V;
+  CeedInt nelemx = 3, nelemy = 5, nelem = nelemx*nelemy, dim = 2, P = 3, Q = 4;
+  CeedInt nx = nelemx*(P-1)+1, ny = nelemy*(P-1)+1, Nu = nx*ny;
+  CeedInt Nx = (nelemx+1)*(nelemy+1);
+  CeedInt indx[nelem*4], indu[nelem*P*P];
+  CeedScalar x[dim*Nx], dot, dotapply;
+
+  CeedInit(argv[1], &ceed);
+
+  // Mesh coordinates, perturbed so elements are not affine
+  for (CeedInt j=0; j<nelemy+1; j++)
+    for (CeedInt i=0; i<nelemx+1; i++) {
+      CeedScalar shift = 0.05*((i+2*j)%3 - 1);
+      x[i+j*(nelemx+1)+0*Nx] = (CeedScalar) i / nelemx + shift;
+      x[i+j*(nelemx+1)+1*Nx] = (CeedScalar) j / nelemy - shift;
+    }
+  for (CeedInt e=0; e<nelem; e++) {
+    CeedInt ex = e % nelemx, ey = e / nelemx;
+    for (CeedInt j=0; j<2; j++)
+      for (CeedInt i=0; i<2; i++)
+        indx[e*4+j*2+i] = (ey+j)*(nelemx+1) + ex+i;
+    for (CeedInt j=0; j<P; j++)
+      for (CeedInt i=0; i<P; i++)
+        indu[e*P*P+j*P+i] = (ey*(P-1)+j)*nx + ex*(P-1)+i;
+  }
+  CeedElemRestrictionCreate(ceed, nelem, 4, dim, Nx, dim*Nx, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indx, &Erestrictx);
+  CeedElemRestrictionCreate(ceed, nelem, P*P, 1, 1, Nu, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indu, &Erestrictu);
+  CeedElemRestrictionCreate(ceed, nelem, P*P, 1, 1, Nu, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indu, &Erestrictucopy);
+  CeedElemRestrictionCreateStrided(ceed, nelem, Q*Q, 1, nelem*Q*Q,
+                                   CEED_STRIDES_BACKEND, &Erestrictqm);
+  CeedElemRestrictionCreateStrided(ceed, nelem, Q*Q, 3, 3*nelem*Q*Q,
+                                   CEED_STRIDES_BACKEND, &Erestrictqp);
+
+  // Bases
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, dim, 2, Q, CEED_GAUSS, &bx);
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, 1, P, Q, CEED_GAUSS, &bu);
+
+  // Quadrature data
+  CeedQFunctionCreateInteriorByName(ceed, "Mass2DBuild", &qf_setupmass);
+  CeedQFunctionCreateInteriorByName(ceed, "Poisson2DBuild", &qf_setuppoisson);
+  CeedOperatorCreate(ceed, qf_setupmass, CEED_QFUNCTION_NONE,
+                     CEED_QFUNCTION_NONE, &op_setupmass);
+  CeedOperatorSetField(op_setupmass, "dx", Erestrictx, bx, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_setupmass, "weights", CEED_ELEMRESTRICTION_NONE, bx,
+                       CEED_VECTOR_NONE);
+  CeedOperatorSetField(op_setupmass, "qdata", Erestrictqm,
+                       CEED_BASIS_COLLOCATED, CEED_VECTOR_ACTIVE);
+  CeedOperatorCreate(ceed, qf_setuppoisson, CEED_QFUNCTION_NONE,
+                     CEED_QFUNCTION_NONE, &op_setuppoisson);
+  CeedOperatorSetField(op_setuppoisson, "dx", Erestrictx, bx,
+                       CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_setuppoisson, "weights", CEED_ELEMRESTRICTION_NONE,
+                       bx, CEED_VECTOR_NONE);
+  CeedOperatorSetField(op_setuppoisson, "qdata", Erestrictqp,
+                       CEED_BASIS_COLLOCATED, CEED_VECTOR_ACTIVE);
+
+  CeedVectorCreate(ceed, dim*Nx, &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+  CeedVectorCreate(ceed, nelem*Q*Q, &qdatamass);
+  CeedVectorCreate(ceed, 3*nelem*Q*Q, &qdatapoisson);
+  CeedOperatorApply(op_setupmass, X, qdatamass, CEED_REQUEST_IMMEDIATE);
+  CeedOperatorApply(op_setuppoisson, X, qdatapoisson, CEED_REQUEST_IMMEDIATE);
+
+  // Mass plus diffusion operator, with two active inputs and outputs
+  CeedQFunctionCreateInterior(ceed, 1, apply, apply_loc, &qf_apply);
+  CeedQFunctionAddInput(qf_apply, "qdatamass", 1, CEED_EVAL_NONE);
+  CeedQFunctionAddInput(qf_apply, "qdatapoisson", 3, CEED_EVAL_NONE);
+  CeedQFunctionAddInput(qf_apply, "u", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddInput(qf_apply, "du", dim, CEED_EVAL_GRAD);
+  CeedQFunctionAddOutput(qf_apply, "v", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddOutput(qf_apply, "dv", dim, CEED_EVAL_GRAD);
+  CeedOperatorCreate(ceed, qf_apply, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_apply);
+  CeedOperatorSetField(op_apply, "qdatamass", Erestrictqm,
+                       CEED_BASIS_COLLOCATED, qdatamass);
+  CeedOperatorSetField(op_apply, "qdatapoisson", Erestrictqp,
+                       CEED_BASIS_COLLOCATED, qdatapoisson);
+  CeedOperatorSetField(op_apply, "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_apply, "du", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_apply, "v", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_apply, "dv", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+
+  // The same operator with a QFunction vector length that does not divide
+  //   the quadrature points of the partial last element block
+  CeedQFunctionCreateInterior(ceed, 32, apply, apply_loc, &qf_applyvec);
+  CeedQFunctionAddInput(qf_applyvec, "qdatamass", 1, CEED_EVAL_NONE);
+  CeedQFunctionAddInput(qf_applyvec, "qdatapoisson", 3, CEED_EVAL_NONE);
+  CeedQFunctionAddInput(qf_applyvec, "u", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddInput(qf_applyvec, "du", dim, CEED_EVAL_GRAD);
+  CeedQFunctionAddOutput(qf_applyvec, "v", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddOutput(qf_applyvec, "dv", dim, CEED_EVAL_GRAD);
+  CeedOperatorCreate(ceed, qf_applyvec, CEED_QFUNCTION_NONE,
+                     CEED_QFUNCTION_NONE, &op_applyvec);
+  CeedOperatorSetField(op_applyvec, "qdatamass", Erestrictqm,
+                       CEED_BASIS_COLLOCATED, qdatamass);
+  CeedOperatorSetField(op_applyvec, "qdatapoisson", Erestrictqp,
+                       CEED_BASIS_COLLOCATED, qdatapoisson);
+  CeedOperatorSetField(op_applyvec, "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_applyvec, "du", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_applyvec, "v", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_applyvec, "dv", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+
+  // Mass operators, the second with distinct input and output restrictions
+  CeedQFunctionCreateInteriorByName(ceed, "MassApply", &qf_mass);
+  CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_mass);
+  CeedOperatorSetField(op_mass, "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_mass, "qdata", Erestrictqm, CEED_BASIS_COLLOCATED,
+                       qdatamass);
+  CeedOperatorSetField(op_mass, "v", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_masscopy);
+  CeedOperatorSetField(op_masscopy, "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_masscopy, "qdata", Erestrictqm,
+                       CEED_BASIS_COLLOCATED, qdatamass);
+  CeedOperatorSetField(op_masscopy, "v", Erestrictucopy, bu,
+                       CEED_VECTOR_ACTIVE);
+
+  // Composite operator
+  CeedCompositeOperatorCreate(ceed, &op_composite);
+  CeedCompositeOperatorAddSub(op_composite, op_apply);
+  CeedCompositeOperatorAddSub(op_composite, op_mass);
+
+  CeedScalar *hu;
+  CeedVectorCreate(ceed, Nu, &U);
+  CeedVectorGetArray(U, CEED_MEM_HOST, &hu);
+  for (CeedInt i=0; i<Nu; i++)
+    hu[i] = sin(0.37*i) + 0.5;
+  CeedVectorRestoreArray(U, &hu);
+  CeedVectorCreate(ceed, Nu, &V);
+
+  // Apply, then check inner product against the L-vectors
+  CeedOperator ops[4] = {op_apply, op_composite, op_masscopy, op_applyvec};
+  for (CeedInt k=0; k<4; k++) {
+    CeedScalar dotl;
+    CeedOperatorApplyWithDot(ops[k], U, V, &dot, CEED_REQUEST_IMMEDIATE);
+    dotl = VectorDot(U, V);
+    if (fabs(dot - dotl) > 1e-12*fabs(dotl))
+      // LCOV_EXCL_START
+      printf("Operator %d: inner product %.16e != %.16e\n", k, dot, dotl);
+    // LCOV_EXCL_STOP
+  }
+
+  // Apply and add; the inner product is of the added contribution
+  CeedOperatorApplyWithDot(op_apply, U, V, &dotapply, CEED_REQUEST_IMMEDIATE);
+  CeedOperatorApplyAddWithDot(op_apply, U, V, &dot, CEED_REQUEST_IMMEDIATE);
+  if (fabs(dot - dotapply) > 1e-12*fabs(dotapply))
+    // LCOV_EXCL_START
+    printf("Apply add: inner product %.16e != %.16e\n", dot, dotapply);
+  // LCOV_EXCL_STOP
+  dot = VectorDot(U, V);
+  if (fabs(dot - 2*dotapply) > 1e-12*fabs(dotapply))
+    // LCOV_EXCL_START
+    printf("Apply add: output inner product %.16e != %.16e\n", dot,
+           2*dotapply);
+  // LCOV_EXCL_STOP
+
+  // Cleanup
+  CeedQFunctionDestroy(&qf_setupmass);
+  CeedQFunctionDestroy(&qf_setuppoisson);
+  CeedQFunctionDestroy(&qf_apply);
+  CeedQFunctionDestroy(&qf_applyvec);
+  CeedQFunctionDestroy(&qf_mass);
+  CeedOperatorDestroy(&op_setupmass);
+  CeedOperatorDestroy(&op_setuppoisson);
+  CeedOperatorDestroy(&op_apply);
+  CeedOperatorDestroy(&op_applyvec);
+  CeedOperatorDestroy(&op_mass);
+  CeedOperatorDestroy(&op_masscopy);
+  CeedOperatorDestroy(&op_composite);
+  CeedElemRestrictionDestroy(&Erestrictx);
+  CeedElemRestrictionDestroy(&Erestrictu);
+  CeedElemRestrictionDestroy(&Erestrictucopy);
+  CeedElemRestrictionDestroy(&Erestrictqm);
+  CeedElemRestrictionDestroy(&Erestrictqp);
+  CeedBasisDestroy(&bx);
+  CeedBasisDestroy(&bu);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&qdatamass);
+  CeedVectorDestroy(&qdatapoisson);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedDestroy(&ceed);
+  return 0;
+}
@@ -0,0 +1,151 @@
+/// @file
+/// Test interleaved application of several operators sharing scratch memory
+/// \test Test interleaved application of several operators sharing scratch memory
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+#include "t572-operator.h"
+
+#define NUMOPS 3
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  const CeedInt dim = 2, nelem[2] = {9, 7}, ne = 63, Q = 5;
+  const CeedInt Q2 = Q*Q, nx[2] = {nelem[0]+1, nelem[1]+1};
+  const CeedInt Nx = nx[0]*nx[1];
+  CeedInt indx[ne*4], Nu[NUMOPS], *indu[NUMOPS];
+  CeedScalar x[dim*Nx];
+  CeedElemRestriction Erestrictx, Erestrictq, Erestrictu[NUMOPS];
+  CeedBasis bx, bu[NUMOPS];
+  CeedQFunction qf_setup, qf_mass;
+  CeedOperator op_setup, op_mass[NUMOPS];
+  CeedVector X, qdata, U[NUMOPS], V[NUMOPS], W;
+  const CeedScalar *hv, *hw;
+
+  CeedInit(argv[1], &ceed);
+
+  // Mesh of the unit square
+  for (CeedInt j=0; j<nx[1]; j++)
+    for (CeedInt i=0; i<nx[0]; i++) {
+      x[j*nx[0] + i + 0*Nx] = (CeedScalar)i / nelem[0];
+      x[j*nx[0] + i + 1*Nx] = (CeedScalar)j / nelem[1];
+    }
+  for (CeedInt ey=0, e=0; ey<nelem[1]; ey++)
+    for (CeedInt ex=0; ex<nelem[0]; ex++, e++)
+      for (CeedInt j=0; j<2; j++)
+        for (CeedInt i=0; i<2; i++)
+          indx[(e*2 + j)*2 + i] = (ey + j)*nx[0] + ex + i;
+
+  CeedElemRestrictionCreate(ceed, ne, 4, dim, Nx, dim*Nx, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indx, &Erestrictx);
+  CeedElemRestrictionCreateStrided(ceed, ne, Q2, 1, ne*Q2,
+                                   CEED_STRIDES_BACKEND, &Erestrictq);
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, dim, 2, Q, CEED_GAUSS, &bx);
+
+  // Quadrature data
+  CeedQFunctionCreateInteriorByName(ceed, "Mass2DBuild", &qf_setup);
+  CeedOperatorCreate(ceed, qf_setup, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_setup);
+  CeedOperatorSetField(op_setup, "dx", Erestrictx, bx, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_setup, "weights", CEED_ELEMRESTRICTION_NONE, bx,
+                       CEED_VECTOR_NONE);
+  CeedOperatorSetField(op_setup, "qdata", Erestrictq, CEED_BASIS_COLLOCATED,
+                       CEED_VECTOR_ACTIVE);
+  CeedVectorCreate(ceed, dim*Nx, &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+  CeedVectorCreate(ceed, ne*Q2, &qdata);
+  CeedOperatorApply(op_setup, X, qdata, CEED_REQUEST_IMMEDIATE);
+
+  // Mass operators of increasing order, with increasing scratch demand
+  CeedQFunctionCreateInterior(ceed, 1, mass, mass_loc, &qf_mass);
+  CeedQFunctionAddInput(qf_mass, "u", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddInput(qf_mass, "qdata", 1, CEED_EVAL_NONE);
+  CeedQFunctionAddOutput(qf_mass, "v", 1, CEED_EVAL_INTERP);
+  for (CeedInt k=0; k<NUMOPS; k++) {
+    const CeedInt P = k + 2, nu[2] = {nelem[0]*(P-1)+1, nelem[1]*(P-1)+1};
+    Nu[k] = nu[0]*nu[1];
+    indu[k] = malloc(ne*P*P*sizeof(CeedInt));
+    for (CeedInt ey=0, e=0; ey<nelem[1]; ey++)
+      for (CeedInt ex=0; ex<nelem[0]; ex++, e++)
+        for (CeedInt j=0; j<P; j++)
+          for (CeedInt i=0; i<P; i++)
+            indu[k][(e*P + j)*P + i] = (ey*(P-1) + j)*nu[0] + ex*(P-1) + i;
+    CeedElemRestrictionCreate(ceed, ne, P*P, 1, 1, Nu[k], CEED_MEM_HOST,
+                              CEED_USE_POINTER, indu[k], &Erestrictu[k]);
+    CeedBasisCreateTensorH1Lagrange(ceed, dim, 1, P, Q, CEED_GAUSS, &bu[k]);
+    CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                       &op_mass[k]);
+    CeedOperatorSetField(op_mass[k], "u", Erestrictu[k], bu[k],
+                         CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_mass[k], "qdata", Erestrictq,
+                         CEED_BASIS_COLLOCATED, qdata);
+    CeedOperatorSetField(op_mass[k], "v", Erestrictu[k], bu[k],
+                         CEED_VECTOR_ACTIVE);
+
+    // Smooth input, so the output depends on every E-vector entry
+    CeedScalar *hu;
+    CeedVectorCreate(ceed, Nu[k], &U[k]);
+    CeedVectorGetArray(U[k], CEED_MEM_HOST, &hu);
+    for (CeedInt i=0; i<Nu[k]; i++)
+      hu[i] = 1.0 + 0.01*(i % 17);
+    CeedVectorRestoreArray(U[k], &hu);
+    CeedVectorCreate(ceed, Nu[k], &V[k]);
+  }
+
+  // Apply from the largest to the smallest operator
+  for (CeedInt k=NUMOPS-1; k>=0; k--)
+    CeedOperatorApply(op_mass[k], U[k], V[k], CEED_REQUEST_IMMEDIATE);
+
+  // Apply again interleaved, in the other order; results must not change
+  for (CeedInt k=0; k<NUMOPS; k++) {
+    CeedOperatorApply(op_mass[(k+1)%NUMOPS], U[(k+1)%NUMOPS],
+                      V[(k+1)%NUMOPS], CEED_REQUEST_IMMEDIATE);
+    CeedVectorCreate(ceed, Nu[k], &W);
+    CeedOperatorApply(op_mass[k], U[k], W, CEED_REQUEST_IMMEDIATE);
+    CeedVectorGetArrayRead(V[k], CEED_MEM_HOST, &hv);
+    CeedVectorGetArrayRead(W, CEED_MEM_HOST, &hw);
+    for (CeedInt i=0; i<Nu[k]; i++)
+      if (fabs(hv[i] - hw[i]) > 1e-15)
+        // LCOV_EXCL_START
+        printf("Operator %d: [%d] %g != %g\n", k, i, hw[i], hv[i]);
+    // LCOV_EXCL_STOP
+    CeedVectorRestoreArrayRead(V[k], &hv);
+    CeedVectorRestoreArrayRead(W, &hw);
+    CeedVectorDestroy(&W);
+  }
+
+  // The sum of v with u = 1 is the area
+  for (CeedInt k=0; k<NUMOPS; k++) {
+    CeedScalar sum = 0;
+    CeedVectorSetValue(U[k], 1.0);
+    CeedOperatorApply(op_mass[k], U[k], V[k], CEED_REQUEST_IMMEDIATE);
+    CeedVectorGetArrayRead(V[k], CEED_MEM_HOST, &hv);
+    for (CeedInt i=0; i<Nu[k]; i++)
+      sum += hv[i];
+    if (fabs(sum - 1.0) > 1e-12)
+      // LCOV_EXCL_START
+      printf("Operator %d: computed area %g != true area 1\n", k, sum);
+    // LCOV_EXCL_STOP
+    CeedVectorRestoreArrayRead(V[k], &hv);
+  }
+
+  // Cleanup
+  for (CeedInt k=0; k<NUMOPS; k++) {
+    CeedOperatorDestroy(&op_mass[k]);
+    CeedElemRestrictionDestroy(&Erestrictu[k]);
+    CeedBasisDestroy(&bu[k]);
+    CeedVectorDestroy(&U[k]);
+    CeedVectorDestroy(&V[k]);
+    free(indu[k]);
+  }
+  CeedQFunctionDestroy(&qf_setup);
+  CeedQFunctionDestroy(&qf_mass);
+  CeedOperatorDestroy(&op_setup);
+  CeedElemRestrictionDestroy(&Erestrictx);
+  CeedElemRestrictionDestroy(&Erestrictq);
+  CeedBasisDestroy(&bx);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&qdata);
+  CeedDestroy(&ceed);
+  return 0;
+}
@@ -0,0 +1,140 @@
+/// @file
+/// Test several operators sharing a passive input through the same restriction
+/// \test Test several operators sharing a passive input through the same restriction
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+#include "t573-operator.h"
+
+#define NUMOPS 3
+
+static void scale(CeedVector vec, CeedInt n, CeedScalar alpha) {
+  CeedScalar *h;
+  CeedVectorGetArray(vec, CEED_MEM_HOST, &h);
+  for (CeedInt i=0; i<n; i++)
+    h[i] *= alpha;
+  CeedVectorRestoreArray(vec, &h);
+}
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  const CeedInt dim = 2, nelem[2] = {9, 7}, ne = 63, P = 3, Q = 4;
+  const CeedInt Q2 = Q*Q, nx[2] = {nelem[0]+1, nelem[1]+1};
+  const CeedInt Nx = nx[0]*nx[1];
+  const CeedInt Nu = (nelem[0]*(P-1)+1)*(nelem[1]*(P-1)+1);
+  CeedInt indx[ne*4], indu[ne*P*P];
+  CeedScalar x[dim*Nx];
+  CeedElemRestriction Erestrictx, Erestrictu, Erestrictq;
+  CeedBasis bx, bu;
+  CeedQFunction qf_setup, qf_mass;
+  CeedOperator op_setup, op_mass[NUMOPS];
+  CeedVector X, qdata, qdata2, U, V;
+  const CeedScalar *hv;
+
+  CeedInit(argv[1], &ceed);
+
+  // Mesh of the unit square
+  for (CeedInt j=0; j<nx[1]; j++)
+    for (CeedInt i=0; i<nx[0]; i++) {
+      x[j*nx[0] + i + 0*Nx] = (CeedScalar)i / nelem[0];
+      x[j*nx[0] + i + 1*Nx] = (CeedScalar)j / nelem[1];
+    }
+  for (CeedInt ey=0, e=0; ey<nelem[1]; ey++)
+    for (CeedInt ex=0; ex<nelem[0]; ex++, e++) {
+      for (CeedInt j=0; j<2; j++)
+        for (CeedInt i=0; i<2; i++)
+          indx[(e*2 + j)*2 + i] = (ey + j)*nx[0] + ex + i;
+      for (CeedInt j=0; j<P; j++)
+        for (CeedInt i=0; i<P; i++)
+          indu[(e*P + j)*P + i] = (ey*(P-1) + j)*(nelem[0]*(P-1)+1) +
+                                  ex*(P-1) + i;
+    }
+
+  CeedElemRestrictionCreate(ceed, ne, 4, dim, Nx, dim*Nx, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indx, &Erestrictx);
+  CeedElemRestrictionCreate(ceed, ne, P*P, 1, 1, Nu, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indu, &Erestrictu);
+  CeedElemRestrictionCreateStrided(ceed, ne, Q2, 1, ne*Q2,
+                                   CEED_STRIDES_BACKEND, &Erestrictq);
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, dim, 2, Q, CEED_GAUSS, &bx);
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, 1, P, Q, CEED_GAUSS, &bu);
+
+  // Quadrature data
+  CeedQFunctionCreateInteriorByName(ceed, "Mass2DBuild", &qf_setup);
+  CeedOperatorCreate(ceed, qf_setup, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_setup);
+  CeedOperatorSetField(op_setup, "dx", Erestrictx, bx, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_setup, "weights", CEED_ELEMRESTRICTION_NONE, bx,
+                       CEED_VECTOR_NONE);
+  CeedOperatorSetField(op_setup, "qdata", Erestrictq, CEED_BASIS_COLLOCATED,
+                       CEED_VECTOR_ACTIVE);
+  CeedVectorCreate(ceed, dim*Nx, &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+  CeedVectorCreate(ceed, ne*Q2, &qdata);
+  CeedOperatorApply(op_setup, X, qdata, CEED_REQUEST_IMMEDIATE);
+
+  // Doubled quadrature data, a different vector on the same restriction
+  CeedVectorCreate(ceed, ne*Q2, &qdata2);
+  CeedOperatorApply(op_setup, X, qdata2, CEED_REQUEST_IMMEDIATE);
+  scale(qdata2, ne*Q2, 2.0);
+
+  // Mass operators; the last one uses the doubled quadrature data
+  CeedQFunctionCreateInterior(ceed, 1, mass, mass_loc, &qf_mass);
+  CeedQFunctionAddInput(qf_mass, "u", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddInput(qf_mass, "qdata", 1, CEED_EVAL_NONE);
+  CeedQFunctionAddOutput(qf_mass, "v", 1, CEED_EVAL_INTERP);
+  for (CeedInt k=0; k<NUMOPS; k++) {
+    CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                       &op_mass[k]);
+    CeedOperatorSetField(op_mass[k], "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_mass[k], "qdata", Erestrictq,
+                         CEED_BASIS_COLLOCATED,
+                         k == NUMOPS-1 ? qdata2 : qdata);
+    CeedOperatorSetField(op_mass[k], "v", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  }
+
+  CeedVectorCreate(ceed, Nu, &U);
+  CeedVectorSetValue(U, 1.0);
+  CeedVectorCreate(ceed, Nu, &V);
+
+  // Apply all operators three times: as set up, after scaling the shared
+  //   quadrature data, and after destroying the first operator
+  for (CeedInt pass=0; pass<3; pass++) {
+    if (pass > 0)
+      scale(qdata, ne*Q2, 2.0);
+    if (pass == 2)
+      CeedOperatorDestroy(&op_mass[0]);
+    for (CeedInt k=(pass == 2); k<NUMOPS; k++) {
+      CeedScalar sum = 0, area = k == NUMOPS-1 ? 2.0 : (1 << pass);
+      CeedOperatorApply(op_mass[k], U, V, CEED_REQUEST_IMMEDIATE);
+      CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+      for (CeedInt i=0; i<Nu; i++)
+        sum += hv[i];
+      if (fabs(sum - area) > 1e-12)
+        // LCOV_EXCL_START
+        printf("Pass %d, operator %d: computed area %g != true area %g\n",
+               pass, k, sum, area);
+      // LCOV_EXCL_STOP
+      CeedVectorRestoreArrayRead(V, &hv);
+    }
+  }
+
+  // Cleanup
+  for (CeedInt k=1; k<NUMOPS; k++)
+    CeedOperatorDestroy(&op_mass[k]);
+  CeedQFunctionDestroy(&qf_setup);
+  CeedQFunctionDestroy(&qf_mass);
+  CeedOperatorDestroy(&op_setup);
+  CeedElemRestrictionDestroy(&Erestrictx);
+  CeedElemRestrictionDestroy(&Erestrictu);
+  CeedElemRestrictionDestroy(&Erestrictq);
+  CeedBasisDestroy(&bx);
+  CeedBasisDestroy(&bu);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&qdata);
+  CeedVectorDestroy(&qdata2);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedDestroy(&ceed);
+  return 0;
+}
@@ -0,0 +1,151 @@
+/// @file
+/// Test operator with a constant passive input field
+/// \test Test operator with a constant passive input field
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+#include "t574-operator.h"
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  const CeedInt dim = 2, nelem[2] = {9, 7}, ne = 63, P = 3, Q = 4;
+  const CeedInt Q2 = Q*Q, nx[2] = {nelem[0]+1, nelem[1]+1};
+  const CeedInt Nx = nx[0]*nx[1];
+  const CeedInt Nu = (nelem[0]*(P-1)+1)*(nelem[1]*(P-1)+1);
+  CeedInt indx[ne*4], indu[ne*P*P];
+  CeedScalar x[dim*Nx], coef[2] = {2.0, 0.5}, *hc, *hu;
+  CeedElemRestriction Erestrictx, Erestrictu, Erestrictq, Erestrictc;
+  CeedBasis bx, bu;
+  CeedQFunction qf_setup, qf_mass;
+  CeedOperator op_setup, op_const, op_full;
+  CeedVector X, qdata, C, U, V, W;
+  const CeedScalar *hv, *hw;
+
+  CeedInit(argv[1], &ceed);
+
+  // Mesh of the unit square
+  for (CeedInt j=0; j<nx[1]; j++)
+    for (CeedInt i=0; i<nx[0]; i++) {
+      x[j*nx[0] + i + 0*Nx] = (CeedScalar)i / nelem[0];
+      x[j*nx[0] + i + 1*Nx] = (CeedScalar)j / nelem[1];
+    }
+  for (CeedInt ey=0, e=0; ey<nelem[1]; ey++)
+    for (CeedInt ex=0; ex<nelem[0]; ex++, e++) {
+      for (CeedInt j=0; j<2; j++)
+        for (CeedInt i=0; i<2; i++)
+          indx[(e*2 + j)*2 + i] = (ey + j)*nx[0] + ex + i;
+      for (CeedInt j=0; j<P; j++)
+        for (CeedInt i=0; i<P; i++)
+          indu[(e*P + j)*P + i] = (ey*(P-1) + j)*(nelem[0]*(P-1)+1) +
+                                  ex*(P-1) + i;
+    }
+
+  CeedElemRestrictionCreate(ceed, ne, 4, dim, Nx, dim*Nx, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indx, &Erestrictx);
+  CeedElemRestrictionCreate(ceed, ne, P*P, 1, 1, Nu, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indu, &Erestrictu);
+  CeedElemRestrictionCreateStrided(ceed, ne, Q2, 1, ne*Q2,
+                                   CEED_STRIDES_BACKEND, &Erestrictq);
+  CeedElemRestrictionCreateStrided(ceed, ne, Q2, 2, ne*Q2*2,
+                                   CEED_STRIDES_BACKEND, &Erestrictc);
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, dim, 2, Q, CEED_GAUSS, &bx);
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, 1, P, Q, CEED_GAUSS, &bu);
+
+  // Quadrature data
+  CeedQFunctionCreateInteriorByName(ceed, "Mass2DBuild", &qf_setup);
+  CeedOperatorCreate(ceed, qf_setup, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_setup);
+  CeedOperatorSetField(op_setup, "dx", Erestrictx, bx, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_setup, "weights", CEED_ELEMRESTRICTION_NONE, bx,
+                       CEED_VECTOR_NONE);
+  CeedOperatorSetField(op_setup, "qdata", Erestrictq, CEED_BASIS_COLLOCATED,
+                       CEED_VECTOR_ACTIVE);
+  CeedVectorCreate(ceed, dim*Nx, &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+  CeedVectorCreate(ceed, ne*Q2, &qdata);
+  CeedOperatorApply(op_setup, X, qdata, CEED_REQUEST_IMMEDIATE);
+
+  // Mass operators with the coefficient as a constant field and as a full
+  //   vector holding the same values at all quadrature points
+  CeedQFunctionCreateInterior(ceed, 1, coef_mass, coef_mass_loc, &qf_mass);
+  CeedQFunctionAddInput(qf_mass, "u", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddInput(qf_mass, "qdata", 1, CEED_EVAL_NONE);
+  CeedQFunctionAddInput(qf_mass, "coef", 2, CEED_EVAL_NONE);
+  CeedQFunctionAddOutput(qf_mass, "v", 1, CEED_EVAL_INTERP);
+  CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_const);
+  CeedOperatorSetField(op_const, "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_const, "qdata", Erestrictq, CEED_BASIS_COLLOCATED,
+                       qdata);
+  CeedOperatorSetFieldConstant(op_const, "coef", coef);
+  CeedOperatorSetField(op_const, "v", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+
+  CeedVectorCreate(ceed, ne*Q2*2, &C);
+  CeedVectorGetArray(C, CEED_MEM_HOST, &hc);
+  for (CeedInt e=0; e<ne; e++)
+    for (CeedInt k=0; k<2; k++)
+      for (CeedInt i=0; i<Q2; i++)
+        hc[(e*2 + k)*Q2 + i] = coef[k];
+  CeedVectorRestoreArray(C, &hc);
+  CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_full);
+  CeedOperatorSetField(op_full, "u", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_full, "qdata", Erestrictq, CEED_BASIS_COLLOCATED,
+                       qdata);
+  CeedOperatorSetField(op_full, "coef", Erestrictc, CEED_BASIS_COLLOCATED, C);
+  CeedOperatorSetField(op_full, "v", Erestrictu, bu, CEED_VECTOR_ACTIVE);
+
+  // Smooth input; both operators must agree
+  CeedVectorCreate(ceed, Nu, &U);
+  CeedVectorGetArray(U, CEED_MEM_HOST, &hu);
+  for (CeedInt i=0; i<Nu; i++)
+    hu[i] = 1.0 + 0.01*(i % 17);
+  CeedVectorRestoreArray(U, &hu);
+  CeedVectorCreate(ceed, Nu, &V);
+  CeedVectorCreate(ceed, Nu, &W);
+  CeedOperatorApply(op_const, U, V, CEED_REQUEST_IMMEDIATE);
+  CeedOperatorApply(op_full, U, W, CEED_REQUEST_IMMEDIATE);
+  CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+  CeedVectorGetArrayRead(W, CEED_MEM_HOST, &hw);
+  for (CeedInt i=0; i<Nu; i++)
+    if (fabs(hv[i] - hw[i]) > 1e-14)
+      // LCOV_EXCL_START
+      printf("[%d] %g != %g\n", i, hv[i], hw[i]);
+  // LCOV_EXCL_STOP
+  CeedVectorRestoreArrayRead(V, &hv);
+  CeedVectorRestoreArrayRead(W, &hw);
+
+  // The sum of v with u = 1 is (c0 + c1) times the area
+  CeedScalar sum = 0;
+  CeedVectorSetValue(U, 1.0);
+  CeedOperatorApply(op_const, U, V, CEED_REQUEST_IMMEDIATE);
+  CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+  for (CeedInt i=0; i<Nu; i++)
+    sum += hv[i];
+  if (fabs(sum - (coef[0] + coef[1])) > 1e-12)
+    // LCOV_EXCL_START
+    printf("Computed area %g != true area %g\n", sum, coef[0] + coef[1]);
+  // LCOV_EXCL_STOP
+  CeedVectorRestoreArrayRead(V, &hv);
+
+  // Cleanup
+  CeedQFunctionDestroy(&qf_setup);
+  CeedQFunctionDestroy(&qf_mass);
+  CeedOperatorDestroy(&op_setup);
+  CeedOperatorDestroy(&op_const);
+  CeedOperatorDestroy(&op_full);
+  CeedElemRestrictionDestroy(&Erestrictx);
+  CeedElemRestrictionDestroy(&Erestrictu);
+  CeedElemRestrictionDestroy(&Erestrictq);
+  CeedElemRestrictionDestroy(&Erestrictc);
+  CeedBasisDestroy(&bx);
+  CeedBasisDestroy(&bu);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&qdata);
+  CeedVectorDestroy(&C);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedVectorDestroy(&W);
+  CeedDestroy(&ceed);
+  return 0;
+}
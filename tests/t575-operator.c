@@ -0,0 +1,158 @@
+/// @file
+/// Test composite operator applying its suboperators concurrently
+/// \test Test composite operator applying its suboperators concurrently
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  const CeedInt numranges = 4, nelem[4] = {5000, 3000, 6000, 2000};
+  const CeedInt numsub = 5, P = 4, Q = 5;
+  const CeedInt ne = 16000, Nx = ne+1, Nu = ne*(P-1)+1;
+  CeedInt *indx, *indu;
+  CeedScalar *x, *hu;
+  CeedElemRestriction Erestrictx[numranges], Erestrictu[numranges],
+                      Erestrictq[numranges];
+  CeedBasis bx, bu;
+  CeedQFunction qf_setup, qf_mass;
+  CeedOperator op_setup, op_mass[numsub], op_serial, op_threads;
+  CeedVector X, qdata[numranges], U, V, W;
+  const CeedScalar *hv, *hw;
+
+  CeedInit(argv[1], &ceed);
+
+  // Mesh of the unit interval with graded elements
+  indx = malloc(ne*2*sizeof(CeedInt));
+  indu = malloc(ne*P*sizeof(CeedInt));
+  x = malloc(Nx*sizeof(CeedScalar));
+  for (CeedInt i=0; i<Nx; i++)
+    x[i] = (CeedScalar)i*i / (ne*ne);
+  for (CeedInt e=0; e<ne; e++) {
+    for (CeedInt i=0; i<2; i++)
+      indx[2*e + i] = e + i;
+    for (CeedInt i=0; i<P; i++)
+      indu[P*e + i] = e*(P-1) + i;
+  }
+  CeedVectorCreate(ceed, Nx, &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+
+  CeedBasisCreateTensorH1Lagrange(ceed, 1, 1, 2, Q, CEED_GAUSS, &bx);
+  CeedBasisCreateTensorH1Lagrange(ceed, 1, 1, P, Q, CEED_GAUSS, &bu);
+  CeedQFunctionCreateInteriorByName(ceed, "Mass1DBuild", &qf_setup);
+  CeedQFunctionCreateInteriorByName(ceed, "MassApply", &qf_mass);
+
+  // One mass operator per range of elements, all acting on the same L-vector
+  //   and sharing the QFunction and bases
+  CeedCompositeOperatorCreate(ceed, &op_serial);
+  CeedCompositeOperatorCreate(ceed, &op_threads);
+  CeedCompositeOperatorSetNumThreads(op_threads, 4);
+  for (CeedInt s=0, first=0; s<numranges; first+=nelem[s], s++) {
+    CeedElemRestrictionCreate(ceed, nelem[s], 2, 1, 1, Nx, CEED_MEM_HOST,
+                              CEED_USE_POINTER, &indx[2*first],
+                              &Erestrictx[s]);
+    CeedElemRestrictionCreate(ceed, nelem[s], P, 1, 1, Nu, CEED_MEM_HOST,
+                              CEED_USE_POINTER, &indu[P*first],
+                              &Erestrictu[s]);
+    CeedElemRestrictionCreateStrided(ceed, nelem[s], Q, 1, nelem[s]*Q,
+                                     CEED_STRIDES_BACKEND, &Erestrictq[s]);
+
+    CeedOperatorCreate(ceed, qf_setup, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                       &op_setup);
+    CeedOperatorSetField(op_setup, "dx", Erestrictx[s], bx, CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_setup, "weights", CEED_ELEMRESTRICTION_NONE, bx,
+                         CEED_VECTOR_NONE);
+    CeedOperatorSetField(op_setup, "qdata", Erestrictq[s],
+                         CEED_BASIS_COLLOCATED, CEED_VECTOR_ACTIVE);
+    CeedVectorCreate(ceed, nelem[s]*Q, &qdata[s]);
+    CeedOperatorApply(op_setup, X, qdata[s], CEED_REQUEST_IMMEDIATE);
+    CeedOperatorDestroy(&op_setup);
+
+    CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                       &op_mass[s]);
+    CeedOperatorSetField(op_mass[s], "u", Erestrictu[s], bu,
+                         CEED_VECTOR_ACTIVE);
+    CeedOperatorSetField(op_mass[s], "qdata", Erestrictq[s],
+                         CEED_BASIS_COLLOCATED, qdata[s]);
+    CeedOperatorSetField(op_mass[s], "v", Erestrictu[s], bu,
+                         CEED_VECTOR_ACTIVE);
+  }
+
+  // A second mass operator on the first range also shares its restrictions
+  //   and passive quadrature data
+  CeedOperatorCreate(ceed, qf_mass, CEED_QFUNCTION_NONE, CEED_QFUNCTION_NONE,
+                     &op_mass[numranges]);
+  CeedOperatorSetField(op_mass[numranges], "u", Erestrictu[0], bu,
+                       CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_mass[numranges], "qdata", Erestrictq[0],
+                       CEED_BASIS_COLLOCATED, qdata[0]);
+  CeedOperatorSetField(op_mass[numranges], "v", Erestrictu[0], bu,
+                       CEED_VECTOR_ACTIVE);
+  for (CeedInt s=0; s<numsub; s++) {
+    CeedCompositeOperatorAddSub(op_serial, op_mass[s]);
+    CeedCompositeOperatorAddSub(op_threads, op_mass[s]);
+  }
+
+  // Serial and concurrent application must agree
+  CeedVectorCreate(ceed, Nu, &U);
+  CeedVectorGetArray(U, CEED_MEM_HOST, &hu);
+  for (CeedInt i=0; i<Nu; i++)
+    hu[i] = 1.0 + 0.01*(i % 13);
+  CeedVectorRestoreArray(U, &hu);
+  CeedVectorCreate(ceed, Nu, &V);
+  CeedVectorCreate(ceed, Nu, &W);
+  CeedOperatorApply(op_serial, U, V, CEED_REQUEST_IMMEDIATE);
+  CeedOperatorApply(op_threads, U, W, CEED_REQUEST_IMMEDIATE);
+  for (CeedInt k=0; k<4; k++) {
+    CeedOperatorApplyAdd(op_serial, U, V, CEED_REQUEST_IMMEDIATE);
+    CeedOperatorApplyAdd(op_threads, U, W, CEED_REQUEST_IMMEDIATE);
+  }
+  CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+  CeedVectorGetArrayRead(W, CEED_MEM_HOST, &hw);
+  for (CeedInt i=0; i<Nu; i++)
+    if (fabs(hv[i] - hw[i]) > 1e-14)
+      // LCOV_EXCL_START
+      printf("[%d] %g != %g\n", i, hv[i], hw[i]);
+  // LCOV_EXCL_STOP
+  CeedVectorRestoreArrayRead(V, &hv);
+  CeedVectorRestoreArrayRead(W, &hw);
+
+  // The sum of v with u = 1 is the length of the interval plus the length of
+  //   the first range
+  CeedScalar sum = 0, length = 1. + x[nelem[0]];
+  CeedVectorSetValue(U, 1.0);
+  CeedOperatorApply(op_threads, U, W, CEED_REQUEST_IMMEDIATE);
+  CeedVectorGetArrayRead(W, CEED_MEM_HOST, &hw);
+  for (CeedInt i=0; i<Nu; i++)
+    sum += hw[i];
+  if (fabs(sum - length) > 1e-10)
+    // LCOV_EXCL_START
+    printf("Computed length %g != true length %g\n", sum, length);
+  // LCOV_EXCL_STOP
+  CeedVectorRestoreArrayRead(W, &hw);
+
+  // Cleanup
+  CeedQFunctionDestroy(&qf_setup);
+  CeedQFunctionDestroy(&qf_mass);
+  for (CeedInt s=0; s<numsub; s++)
+    CeedOperatorDestroy(&op_mass[s]);
+  for (CeedInt s=0; s<numranges; s++) {
+    CeedElemRestrictionDestroy(&Erestrictx[s]);
+    CeedElemRestrictionDestroy(&Erestrictu[s]);
+    CeedElemRestrictionDestroy(&Erestrictq[s]);
+    CeedVectorDestroy(&qdata[s]);
+  }
+  CeedOperatorDestroy(&op_serial);
+  CeedOperatorDestroy(&op_threads);
+  CeedBasisDestroy(&bx);
+  CeedBasisDestroy(&bu);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedVectorDestroy(&W);
+  free(indx);
+  free(indu);
+  free(x);
+  CeedDestroy(&ceed);
+  return 0;
+}
@@ -84,6 +84,15 @@ for ((i=0;i<${#backends[@]};++i)); do
         continue;
     fi
 
+    # t559 selects the block size of the opt and avx blocked backends
+    if [[ "$backend" != /cpu/self/opt/blocked && "$backend" != /cpu/self/avx/blocked ]] \
+            && [[ "$1" = t559* ]] ; then
+        printf "ok $i0 # SKIP - no block size selection for $backend\n"
+        printf "ok $i1 # SKIP - no block size selection for $backend stdout\n"
+        printf "ok $i2 # SKIP - no block size selection for $backend stderr\n"
+        continue;
+    fi
+
     # Run in subshell
     (build/$1 ${args/\{ceed_resource\}/$backend} || false) > ${output}.out 2> ${output}.err
     status=$?
@@ -115,6 +124,15 @@ for ((i=0;i<${#backends[@]};++i)); do
         continue
     fi
 
+    # grep to pass test t122 on error
+    if grep -F -q -e 'access' ${output}.err \
+            && [[ "$1" = "t122"* ]] ; then
+        printf "ok $i0 PASS - expected failure $1 $backend\n"
+        printf "ok $i1 PASS - expected failure $1 $backend stdout\n"
+        printf "ok $i2 PASS - expected failure $1 $backend stderr\n"
+        continue
+    fi
+
     # grep to pass test t303 on error
     if grep -F -q -e 'vectors incompatible' ${output}.err \
             && [[ "$1" = "t303"* ]] ; then